@@ -10,6 +10,7 @@ function(load_dependencies type)
     if ("${type}" STREQUAL "shared")
         set(is_shared ON)
     endif ()
+    find_dependency(Threads REQUIRED)
 endfunction()
 
 @SHARED_STATIC_TEMPLATE@
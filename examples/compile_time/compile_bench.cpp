@@ -0,0 +1,465 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <argparser.hpp>
+#include <tinytc/builder.hpp>
+#include <tinytc/tinytc.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace tinytc;
+
+#ifndef TINYTC_LIT_DIR
+#define TINYTC_LIT_DIR "test/lit"
+#endif
+#ifndef TINYTC_FLASH_ATTENTION_TEMPLATE
+#define TINYTC_FLASH_ATTENTION_TEMPLATE "examples/flash_attention/flash_attention.template"
+#endif
+
+struct args {
+    std::int32_t opt_level = 2;
+    std::int32_t repetitions = 3;
+    std::int32_t scale = 1;
+    char const *device = "pvc";
+    char const *output = nullptr;
+    char const *flash_attention_template = TINYTC_FLASH_ATTENTION_TEMPLATE;
+    bool no_lit = false;
+    bool no_synthetic = false;
+    std::vector<char const *> paths;
+};
+
+struct benchmark {
+    std::string name;
+    std::string kind;
+    //! Parses or builds the program; input files are read before the benchmark runs
+    std::function<shared_handle<tinytc_prog_t>(tinytc_compiler_context_t)> make_prog;
+};
+
+struct measurement {
+    bool ok = false;
+    double parse_ms = 0.0;
+    double pipeline_ms = 0.0;
+    double spirv_conversion_ms = 0.0;
+    double assembly_ms = 0.0;
+    std::size_t binary_size = 0;
+    //! IR nodes allocated by the pass pipeline; each node used to be a separate heap allocation
+    std::uint64_t ir_node_allocations = 0;
+    //! Heap allocations made by the pass pipeline for IR nodes (arena chunks and large nodes)
+    std::uint64_t heap_allocations = 0;
+    std::string passes = "[]";
+    //! Time to load the program from a source file with tinytc_parse_file
+    double parse_file_ms = 0.0;
+    //! Time to load the program from a bytecode file with tinytc_prog_deserialize_file
+    double bytecode_load_ms = 0.0;
+    std::size_t source_size = 0;
+    std::size_t bytecode_size = 0;
+
+    auto total_ms() const { return parse_ms + pipeline_ms + spirv_conversion_ms + assembly_ms; }
+};
+
+/**
+ * Peak memory is read from the resident set size high-water mark, which is reset before every
+ * benchmark. If the high-water mark cannot be reset (e.g. not on Linux) the reported peak is
+ * the process-wide peak.
+ */
+void reset_peak_rss() {
+    auto clear_refs = std::ofstream("/proc/self/clear_refs");
+    if (clear_refs) {
+        clear_refs << "5";
+    }
+}
+
+auto peak_rss_kib() -> std::int64_t {
+    auto status = std::ifstream("/proc/self/status");
+    auto line = std::string{};
+    while (std::getline(status, line)) {
+        if (line.starts_with("VmHWM:")) {
+            return std::stoll(line.substr(6));
+        }
+    }
+    return -1;
+}
+
+auto read_file(char const *path) -> std::string {
+    auto file = std::ifstream(path);
+    if (!file) {
+        throw std::runtime_error(std::string("Could not open ") + path);
+    }
+    auto oss = std::ostringstream{};
+    oss << file.rdbuf();
+    return std::move(oss).str();
+}
+
+auto ms_since(std::chrono::steady_clock::time_point start) -> double {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+//! Sums a numeric field (e.g. "time_ms") of the pass summary
+auto sum_pass_field(std::string const &pass_json, std::string_view field) -> double {
+    auto const key = "\"" + std::string(field) + "\": ";
+    double sum = 0.0;
+    for (auto pos = pass_json.find(key); pos != std::string::npos;
+         pos = pass_json.find(key, pos + key.size())) {
+        sum += std::stod(pass_json.substr(pos + key.size()));
+    }
+    return sum;
+}
+
+//! Extracts the "passes" array from the pass statistics
+auto pass_array(std::string const &pass_json) -> std::string {
+    auto const begin = pass_json.find('[');
+    auto const end = pass_json.rfind(']');
+    if (begin == std::string::npos || end == std::string::npos) {
+        return "[]";
+    }
+    return pass_json.substr(begin, end - begin + 1);
+}
+
+/**
+ * The program is written as source and as bytecode to the temporary directory, and both files
+ * are loaded into a fresh compiler context.
+ */
+void measure_load(tinytc_prog_t prog, measurement &m) {
+    auto const tmp = std::filesystem::temp_directory_path();
+    auto const source_path = tmp / "tinytc-compile-bench.ir";
+    auto const bytecode_path = tmp / "tinytc-compile-bench.ttcb";
+    print_to_file(prog, source_path.c_str());
+    serialize_to_file(prog, bytecode_path.c_str());
+    m.source_size = std::filesystem::file_size(source_path);
+    m.bytecode_size = std::filesystem::file_size(bytecode_path);
+
+    auto ctx = create_compiler_context();
+    set_error_reporter(ctx.get(), [](char const *, const tinytc_location_t *, void *) {});
+    auto start = std::chrono::steady_clock::now();
+    parse_file(source_path.c_str(), ctx.get());
+    m.parse_file_ms = ms_since(start);
+
+    ctx = create_compiler_context();
+    start = std::chrono::steady_clock::now();
+    deserialize_file(bytecode_path.c_str(), ctx.get());
+    m.bytecode_load_ms = ms_since(start);
+
+    std::filesystem::remove(source_path);
+    std::filesystem::remove(bytecode_path);
+}
+
+auto measure(benchmark const &b, tinytc_core_info_t info, std::int32_t opt_level) -> measurement {
+    auto m = measurement{};
+    auto ctx = create_compiler_context();
+    set_error_reporter(ctx.get(), [](char const *, const tinytc_location_t *, void *) {});
+    set_optimization_level(ctx.get(), opt_level);
+    set_pass_statistics(ctx.get(), true);
+    try {
+        auto start = std::chrono::steady_clock::now();
+        auto prog = b.make_prog(ctx.get());
+        m.parse_ms = ms_since(start);
+
+        measure_load(prog.get(), m);
+
+        start = std::chrono::steady_clock::now();
+        auto mod = compile_to_spirv(prog.get(), info);
+        auto const compile_ms = ms_since(start);
+
+        start = std::chrono::steady_clock::now();
+        auto bin = spirv_assemble(mod.get());
+        m.assembly_ms = ms_since(start);
+
+        auto const pass_json = std::string(get_pass_statistics(ctx.get(), false).get());
+        m.passes = pass_array(pass_json);
+        m.pipeline_ms = sum_pass_field(pass_json, "time_ms");
+        m.ir_node_allocations =
+            static_cast<std::uint64_t>(sum_pass_field(pass_json, "num_allocations"));
+        m.heap_allocations =
+            static_cast<std::uint64_t>(sum_pass_field(pass_json, "num_heap_allocations"));
+        m.spirv_conversion_ms = std::max(0.0, compile_ms - m.pipeline_ms);
+        m.binary_size = get_raw(bin.get()).data_size;
+        m.ok = true;
+    } catch (status const &) {
+        m.ok = false;
+    }
+    return m;
+}
+
+void write_json_string(std::ostream &os, std::string_view str) {
+    os << '"';
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            os << '\\';
+        }
+        os << c;
+    }
+    os << '"';
+}
+
+/*
+ * Synthetic kernels
+ */
+
+//! Chain of n gemms, where the result of every gemm is the A operand of the next gemm
+auto make_gemm_chain(tinytc_compiler_context_t ctx, std::int32_t n, std::int64_t size)
+    -> shared_handle<tinytc_prog_t> {
+    auto f32_ty = get<f32_type>(ctx);
+    auto index_ty = get<index_type>(ctx);
+    auto void_ty = get<void_type>(ctx);
+    auto mat_ty = get<memref_type>(f32_ty, array_view{size, size}, array_view<std::int64_t>{},
+                                   address_space::global);
+
+    auto fn = create_func("gemm_chain", {get<group_type>(mat_ty, dynamic, 0), mat_ty}, void_ty);
+    auto fn_body = get_body(fn.get());
+    auto params = std::array<tinytc_value_t, 2u>{};
+    get_parameters(fn_body, params);
+
+    auto bb = region_builder{fn_body};
+    auto alpha = bb.constant_one(f32_ty);
+    auto beta = bb.constant_zero(f32_ty);
+    auto load_matrix = [&](std::int64_t i) {
+        auto idx = bb.create<constant_inst>(i, index_ty);
+        return bb.create<load_inst>(params[0], array_view{idx}, mat_ty);
+    };
+    auto A = load_matrix(0);
+    for (std::int32_t i = 1; i <= n; ++i) {
+        auto C = load_matrix(i);
+        bb.create<gemm_inst>(false, transpose::N, transpose::N, alpha, A, params[1], beta, C);
+        A = C;
+    }
+
+    auto p = create_prog(ctx);
+    add_function(p.get(), std::move(fn));
+    return p;
+}
+
+//! Long chain of scalar arithmetic, about 3 instructions per step
+auto make_scalar_chain(tinytc_compiler_context_t ctx, std::int32_t n)
+    -> shared_handle<tinytc_prog_t> {
+    auto f32_ty = get<f32_type>(ctx);
+    auto void_ty = get<void_type>(ctx);
+    auto const vec_shape = std::array<std::int64_t, 1u>{64};
+    auto vec_ty =
+        get<memref_type>(f32_ty, vec_shape, array_view<std::int64_t>{}, address_space::global);
+
+    auto fn = create_func("scalar_chain", {f32_ty, vec_ty, vec_ty}, void_ty);
+    auto fn_body = get_body(fn.get());
+    auto params = std::array<tinytc_value_t, 3u>{};
+    get_parameters(fn_body, params);
+
+    auto bb = region_builder{fn_body};
+    auto x = params[0];
+    for (std::int32_t i = 0; i < n; ++i) {
+        auto c = bb.create<constant_inst>(1.0 + 1.0 / (i + 1), f32_ty);
+        auto y = bb.create<mul_inst>(x, c, f32_ty);
+        x = bb.create<add_inst>(y, params[0], f32_ty);
+    }
+    auto beta = bb.constant_one(f32_ty);
+    bb.create<axpby_inst>(false, transpose::N, x, params[1], beta, params[2]);
+
+    auto p = create_prog(ctx);
+    add_function(p.get(), std::move(fn));
+    return p;
+}
+
+auto flash_attention_code(std::string const &tmpl, char const *dtype, std::int64_t headdim,
+                          std::int64_t block_size) -> std::string {
+    auto code = std::ostringstream{};
+    code << "$dtype = " << dtype << "\n";
+    code << "$headdim = " << headdim << "\n";
+    code << "$block_size = " << block_size << "\n";
+    code << tmpl;
+    return std::move(code).str();
+}
+
+void add_lit_benchmarks(std::vector<benchmark> &benchmarks, std::filesystem::path const &path) {
+    auto files = std::vector<std::filesystem::path>{};
+    if (std::filesystem::is_directory(path)) {
+        for (auto const &entry : std::filesystem::recursive_directory_iterator(path)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".ir") {
+                files.emplace_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+    } else {
+        files.emplace_back(path);
+    }
+    for (auto const &file : files) {
+        auto source = read_file(file.c_str());
+        auto name = file.lexically_relative(path).generic_string();
+        if (name.empty() || name == ".") {
+            name = file.filename().generic_string();
+        }
+        benchmarks.emplace_back(
+            benchmark{"lit/" + name, "lit", [source](tinytc_compiler_context_t ctx) {
+                          return parse_string(source, ctx);
+                      }});
+    }
+}
+
+void add_synthetic_benchmarks(std::vector<benchmark> &benchmarks, args const &a) {
+    for (std::int32_t n : {8, 64}) {
+        n *= a.scale;
+        benchmarks.emplace_back(benchmark{
+            "gemm_chain_" + std::to_string(n), "builder",
+            [n](tinytc_compiler_context_t ctx) { return make_gemm_chain(ctx, n, 64); }});
+    }
+    for (std::int32_t n : {1000, 5000}) {
+        n *= a.scale;
+        benchmarks.emplace_back(benchmark{
+            "scalar_chain_" + std::to_string(n), "builder",
+            [n](tinytc_compiler_context_t ctx) { return make_scalar_chain(ctx, n); }});
+    }
+
+    auto tmpl = std::string{};
+    try {
+        tmpl = read_file(a.flash_attention_template);
+    } catch (std::exception const &e) {
+        std::cerr << e.what() << " -- skipping flash attention" << std::endl;
+        return;
+    }
+    struct fa_config {
+        char const *dtype;
+        std::int64_t headdim;
+    };
+    for (auto const &cfg : {fa_config{"f16", 64}, fa_config{"f16", 128}, fa_config{"f32", 64}}) {
+        auto const block_size = 512 / (cfg.headdim / 64);
+        auto source = flash_attention_code(tmpl, cfg.dtype, cfg.headdim, block_size);
+        benchmarks.emplace_back(benchmark{
+            "flash_attention_" + std::string(cfg.dtype) + "_" + std::to_string(cfg.headdim),
+            "template",
+            [source](tinytc_compiler_context_t ctx) { return parse_string(source, ctx); }});
+    }
+}
+
+int main(int argc, char **argv) {
+    auto a = args{};
+    bool help = false;
+
+    auto parser = cmd::arg_parser{};
+    try {
+        parser.set_short_opt('O', &a.opt_level, "Optimization level (default: 2)")
+            .validator([](std::int32_t level) { return 0 <= level; });
+        parser
+            .set_short_opt('r', &a.repetitions,
+                           "Number of repetitions; the fastest repetition is reported (default: 3)")
+            .validator([](std::int32_t rep) { return 0 < rep; });
+        parser.set_short_opt('s', &a.scale, "Size multiplier of synthetic kernels (default: 1)")
+            .validator([](std::int32_t scale) { return 0 < scale; });
+        parser.set_short_opt('d', &a.device, "Device name (default: pvc)");
+        parser.set_short_opt('o', &a.output, "Write JSON to file instead of stdout");
+        parser.set_long_opt("flash-attention-template", &a.flash_attention_template,
+                            "Path to flash attention template");
+        parser.set_long_opt("no-lit", &a.no_lit, "Skip lit corpus");
+        parser.set_long_opt("no-synthetic", &a.no_synthetic, "Skip synthetic kernels");
+        parser.set_short_opt('h', &help, "Show help");
+        parser.set_long_opt("help", &help, "Show help");
+        parser.add_positional_arg("path", &a.paths,
+                                  "IR files or directories searched for *.ir files (default: "
+                                  "lit corpus)");
+
+        parser.parse(argc, argv);
+    } catch (std::exception const &e) {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+    if (help) {
+        parser.print_help(std::cout, "tinytc-compile-bench", "");
+        return 0;
+    }
+
+    try {
+        auto info = create_core_info_intel_from_name(a.device);
+
+        auto benchmarks = std::vector<benchmark>{};
+        if (!a.no_lit) {
+            if (a.paths.empty()) {
+                a.paths.emplace_back(TINYTC_LIT_DIR);
+            }
+            for (auto const &path : a.paths) {
+                add_lit_benchmarks(benchmarks, path);
+            }
+        }
+        if (!a.no_synthetic) {
+            add_synthetic_benchmarks(benchmarks, a);
+        }
+
+        auto file = std::ofstream{};
+        if (a.output) {
+            file.open(a.output);
+            if (!file) {
+                std::cerr << "Could not open " << a.output << std::endl;
+                return 1;
+            }
+        }
+        std::ostream &os = a.output ? file : std::cout;
+
+        os << "{\n  \"device\": ";
+        write_json_string(os, a.device);
+        os << ",\n  \"opt_level\": " << a.opt_level << ",\n  \"repetitions\": " << a.repetitions
+           << ",\n  \"benchmarks\": [";
+        for (std::size_t i = 0; i < benchmarks.size(); ++i) {
+            auto const &b = benchmarks[i];
+            reset_peak_rss();
+            auto best = measurement{};
+            auto best_total = std::numeric_limits<double>::max();
+            for (std::int32_t r = 0; r < a.repetitions; ++r) {
+                auto m = measure(b, info.get(), a.opt_level);
+                if (!m.ok) {
+                    best = std::move(m);
+                    break;
+                }
+                if (m.total_ms() < best_total) {
+                    best_total = m.total_ms();
+                    best = std::move(m);
+                }
+            }
+
+            os << (i > 0 ? ",\n" : "\n") << "    {\"name\": ";
+            write_json_string(os, b.name);
+            os << ", \"kind\": ";
+            write_json_string(os, b.kind);
+            os << ", \"status\": " << (best.ok ? "\"ok\"" : "\"error\"");
+            if (best.ok) {
+                os << ", \"parse_ms\": " << best.parse_ms
+                   << ", \"pipeline_ms\": " << best.pipeline_ms
+                   << ", \"spirv_conversion_ms\": " << best.spirv_conversion_ms
+                   << ", \"assembly_ms\": " << best.assembly_ms
+                   << ", \"total_ms\": " << best.total_ms()
+                   << ", \"binary_size\": " << best.binary_size
+                   << ", \"ir_node_allocations\": " << best.ir_node_allocations
+                   << ", \"heap_allocations\": " << best.heap_allocations
+                   << ", \"parse_file_ms\": " << best.parse_file_ms
+                   << ", \"bytecode_load_ms\": " << best.bytecode_load_ms
+                   << ", \"source_size\": " << best.source_size
+                   << ", \"bytecode_size\": " << best.bytecode_size;
+            }
+            os << ", \"peak_rss_kib\": " << peak_rss_kib();
+            if (best.ok) {
+                os << ",\n     \"passes\": " << best.passes;
+            }
+            os << "}";
+        }
+        os << (benchmarks.empty() ? "]" : "\n  ]") << "\n}" << std::endl;
+    } catch (status const &st) {
+        std::cerr << "Error (" << static_cast<int>(st) << "): " << to_string(st) << std::endl;
+        return 1;
+    } catch (std::exception const &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,163 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <argparser.hpp>
+#include <tinytc/builder.hpp>
+#include <tinytc/tinytc.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tinytc;
+
+struct args {
+    std::int32_t max_threads = 0;
+    std::int32_t num_functions = 1000;
+    std::int32_t num_shapes = 64;
+};
+
+/**
+ * Build functions with a builder, where every function uses a different combination of shapes.
+ *
+ * @return Interned types and attributes in a canonical order; must be equal for all threads
+ */
+auto build(tinytc_compiler_context_t ctx, args const &a, std::int32_t thread_id)
+    -> std::vector<void const *> {
+    auto f32_ty = get<f32_type>(ctx);
+    auto index_ty = get<index_type>(ctx);
+    auto void_ty = get<void_type>(ctx);
+    auto const shape = [&](std::int32_t i) -> std::int64_t { return 8 * (1 + i % a.num_shapes); };
+
+    for (std::int32_t f = 0; f < a.num_functions; ++f) {
+        // Threads traverse the shapes in different order such that they compete for the same keys
+        auto const i = f * (1 + 2 * thread_id);
+        auto const M = shape(i), N = shape(i + 1), K = shape(i + 2);
+        auto A_ty = get<memref_type>(f32_ty, array_view{M, K}, array_view<std::int64_t>{},
+                                     address_space::global);
+        auto B_ty = get<memref_type>(f32_ty, array_view{K, N}, array_view<std::int64_t>{},
+                                     address_space::global);
+        auto C_ty = get<memref_type>(f32_ty, array_view{M, N}, array_view<std::int64_t>{},
+                                     address_space::global);
+        auto fn = create_func("kernel",
+                              {get<group_type>(A_ty, dynamic, 0), get<group_type>(B_ty, dynamic, 0),
+                               get<group_type>(C_ty, dynamic, 0)},
+                              void_ty);
+        auto align_attr = get_dictionary_attr_with_sorted(
+            ctx, tinytc_named_attr_t{get<string_attr>(ctx, "align"),
+                                     get<integer_attr>(ctx, 8 * (1 + f % 8))});
+        set_parameter_attr(fn.get(), 0, align_attr);
+        get<coopmatrix_type>(f32_ty, 8 << (f % 3), N, matrix_use::acc);
+
+        auto fn_body = get_body(fn.get());
+        auto params = std::array<tinytc_value_t, 3u>{};
+        get_parameters(fn_body, params);
+        auto bb = region_builder{fn_body};
+        auto gid = bb.create<group_id_inst>(comp3::x, index_ty);
+        auto alpha = bb.constant_one(f32_ty);
+        auto beta = bb.constant_zero(f32_ty);
+        auto A = bb.create<load_inst>(params[0], array_view{gid}, A_ty);
+        auto B = bb.create<load_inst>(params[1], array_view{gid}, B_ty);
+        auto C = bb.create<load_inst>(params[2], array_view{gid}, C_ty);
+        bb.create<gemm_inst>(false, transpose::N, transpose::N, alpha, A, B, beta, C);
+    }
+
+    auto interned = std::vector<void const *>{};
+    for (std::int32_t i = 0; i < a.num_shapes; ++i) {
+        for (std::int32_t j = 0; j < a.num_shapes; ++j) {
+            auto ty = get<memref_type>(f32_ty, array_view{shape(i), shape(j)},
+                                       array_view<std::int64_t>{}, address_space::global);
+            interned.emplace_back(ty);
+            interned.emplace_back(get<group_type>(ty, dynamic, 0));
+        }
+        interned.emplace_back(get<integer_attr>(ctx, 8 * (1 + i % 8)));
+    }
+    return interned;
+}
+
+int main(int argc, char **argv) {
+    auto a = args{};
+    bool help = false;
+
+    auto parser = cmd::arg_parser{};
+    try {
+        parser
+            .set_short_opt('j', &a.max_threads,
+                           "Maximum number of threads (default: number of hardware threads)")
+            .validator([](std::int32_t num) { return 0 <= num; });
+        parser
+            .set_short_opt('n', &a.num_functions,
+                           "Number of functions built per thread (default: 1000)")
+            .validator([](std::int32_t num) { return 0 < num; });
+        parser.set_short_opt('s', &a.num_shapes, "Number of distinct extents (default: 64)")
+            .validator([](std::int32_t num) { return 0 < num; });
+        parser.set_short_opt('h', &help, "Show help");
+        parser.set_long_opt("help", &help, "Show help");
+
+        parser.parse(argc, argv);
+    } catch (std::exception const &e) {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+    if (help) {
+        parser.print_help(std::cout, "tinytc-intern-stress", "");
+        return 0;
+    }
+    if (a.max_threads == 0) {
+        a.max_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::cout << "num_threads,time,functions_per_second,consistent" << std::endl;
+    try {
+        for (std::int32_t num_threads = 1; num_threads <= a.max_threads;
+             num_threads = num_threads < a.max_threads ? std::min(2 * num_threads, a.max_threads)
+                                                       : num_threads + 1) {
+            // All threads share a single compiler context
+            auto ctx = create_compiler_context();
+            auto interned = std::vector<std::vector<void const *>>(num_threads);
+            auto errors = std::vector<std::exception_ptr>(num_threads);
+
+            auto const start = std::chrono::steady_clock::now();
+            auto threads = std::vector<std::thread>{};
+            for (std::int32_t t = 0; t < num_threads; ++t) {
+                threads.emplace_back([&, t] {
+                    try {
+                        interned[t] = build(ctx.get(), a, t);
+                    } catch (...) {
+                        errors[t] = std::current_exception();
+                    }
+                });
+            }
+            for (auto &t : threads) {
+                t.join();
+            }
+            auto const end = std::chrono::steady_clock::now();
+            for (auto &e : errors) {
+                if (e) {
+                    std::rethrow_exception(e);
+                }
+            }
+
+            auto const time = std::chrono::duration<double>(end - start).count();
+            bool const consistent = std::all_of(interned.begin(), interned.end(),
+                                                [&](auto const &i) { return i == interned[0]; });
+            std::cout << num_threads << "," << time << ","
+                      << num_threads * a.num_functions / time << ","
+                      << (consistent ? "yes" : "no") << std::endl;
+        }
+    } catch (status const &st) {
+        std::cerr << "Error (" << static_cast<int>(st) << "): " << to_string(st) << std::endl;
+        return 1;
+    } catch (std::exception const &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
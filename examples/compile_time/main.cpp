@@ -0,0 +1,145 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <argparser.hpp>
+#include <tinytc/tinytc.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tinytc;
+
+struct args {
+    std::int32_t max_threads = 0;
+    std::int32_t repetitions = 3;
+    std::vector<std::int32_t> num_functions;
+};
+
+auto make_source(std::int32_t num_functions) -> std::string {
+    constexpr std::int64_t sizes[] = {16, 24, 32, 48, 64, 96, 128};
+    constexpr std::int64_t num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    auto oss = std::ostringstream{};
+    for (std::int32_t f = 0; f < num_functions; ++f) {
+        auto const M = sizes[f % num_sizes];
+        auto const N = sizes[(f / num_sizes) % num_sizes];
+        auto const K = sizes[(f / (num_sizes * num_sizes)) % num_sizes];
+        oss << "func @kernel" << f << "(%alpha: f32, %A: group<memref<f32x" << M << "x" << K
+            << ">x?>, %B: group<memref<f32x" << K << "x" << N << ">x?>, %C: group<memref<f32x" << M
+            << "x" << N << ">x?>) {\n"
+            << "    %gid = group_id.x : index\n"
+            << "    %a = load %A[%gid] : memref<f32x" << M << "x" << K << ">\n"
+            << "    %b = load %B[%gid] : memref<f32x" << K << "x" << N << ">\n"
+            << "    %c = load %C[%gid] : memref<f32x" << M << "x" << N << ">\n"
+            << "    %zero = constant 0.0 : f32\n"
+            << "    %one = constant 1.0 : f32\n"
+            << "    gemm %alpha, %a, %b, %zero, %c\n"
+            << "    axpby %one, %a, %alpha, %a\n"
+            << "}\n";
+    }
+    return std::move(oss).str();
+}
+
+auto compile(std::string const &source, tinytc_core_info_t info, std::int32_t num_threads,
+             double &seconds) -> shared_handle<tinytc_binary_t> {
+    auto ctx = create_compiler_context();
+    set_error_reporter(ctx.get(), [](char const *what, const tinytc_location_t *, void *) {
+        std::cerr << what << std::endl;
+    });
+    set_num_threads(ctx.get(), num_threads);
+    auto prog = parse_string(source, ctx.get());
+
+    auto const start = std::chrono::steady_clock::now();
+    auto bin = compile_to_spirv_and_assemble(prog.get(), info);
+    auto const end = std::chrono::steady_clock::now();
+    seconds = std::chrono::duration<double>(end - start).count();
+    return bin;
+}
+
+auto same_binary(tinytc_binary_t a, tinytc_binary_t b) -> bool {
+    auto const ra = get_raw(a);
+    auto const rb = get_raw(b);
+    return ra.data_size == rb.data_size && std::memcmp(ra.data, rb.data, ra.data_size) == 0;
+}
+
+int main(int argc, char **argv) {
+    auto a = args{};
+    bool help = false;
+
+    auto parser = cmd::arg_parser{};
+    try {
+        parser
+            .set_short_opt('j', &a.max_threads,
+                           "Maximum number of compiler threads (default: number of hardware "
+                           "threads)")
+            .validator([](std::int32_t num) { return 0 <= num; });
+        parser
+            .set_short_opt('r', &a.repetitions,
+                           "Number of repetitions; the minimum time is reported (default: 3)")
+            .validator([](std::int32_t rep) { return 0 < rep; });
+        parser.set_short_opt('h', &help, "Show help");
+        parser.set_long_opt("help", &help, "Show help");
+        parser.add_positional_arg("num-functions", &a.num_functions, "Number of kernels in program")
+            .validator([](std::int32_t num) { return 0 < num; });
+
+        parser.parse(argc, argv);
+    } catch (std::exception const &e) {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+    if (help || a.num_functions.empty()) {
+        parser.print_help(std::cout, "tinytc-compile-time", "");
+        return !help ? -1 : 0;
+    }
+    if (a.max_threads == 0) {
+        a.max_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::cout << "num_functions,num_threads,time,speedup,deterministic" << std::endl;
+    try {
+        auto info = create_core_info_intel_from_arch(intel_gpu_architecture::pvc);
+        for (auto const num_functions : a.num_functions) {
+            auto const source = make_source(num_functions);
+            auto reference = shared_handle<tinytc_binary_t>{};
+            double serial_time = 0.0;
+            for (std::int32_t num_threads = 1; num_threads <= a.max_threads;
+                 num_threads = num_threads < a.max_threads
+                                   ? std::min(2 * num_threads, a.max_threads)
+                                   : num_threads + 1) {
+                double min_time = std::numeric_limits<double>::max();
+                bool deterministic = true;
+                for (std::int32_t r = 0; r < a.repetitions; ++r) {
+                    double time = 0.0;
+                    auto bin = compile(source, info.get(), num_threads, time);
+                    if (!reference) {
+                        reference = bin;
+                    }
+                    deterministic = deterministic && same_binary(reference.get(), bin.get());
+                    min_time = std::min(min_time, time);
+                }
+                if (num_threads == 1) {
+                    serial_time = min_time;
+                }
+                std::cout << num_functions << "," << num_threads << "," << min_time << ","
+                          << serial_time / min_time << "," << (deterministic ? "yes" : "no")
+                          << std::endl;
+            }
+        }
+    } catch (status const &st) {
+        std::cerr << "Error (" << static_cast<int>(st) << "): " << to_string(st) << std::endl;
+        return 1;
+    } catch (std::exception const &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
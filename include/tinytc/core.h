@@ -346,11 +346,81 @@ TINYTC_EXPORT tinytc_status_t tinytc_parse_stdin(tinytc_prog_t *prg, tinytc_comp
 TINYTC_EXPORT tinytc_status_t tinytc_parse_string(tinytc_prog_t *prg, size_t source_size,
                                                   char const *source,
                                                   tinytc_compiler_context_t ctx);
+
+////////////////////////////
+///////// Bytecode /////////
+////////////////////////////
+
+/**
+ * @brief Serialize program to compact binary bytecode
+ *
+ * The user is responsible to dispose the bytecode with tinytc_bytecode_destroy.
+ *
+ * @param prg [in] program object
+ * @param data_size [out] size of bytecode in bytes
+ * @param data [out] pointer to bytecode
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_prog_serialize(tinytc_prog_t prg, size_t *data_size,
+                                                    uint8_t **data);
+
+/**
+ * @brief Serialize program to bytecode file
+ *
+ * @param prg [in] program object
+ * @param filename [in] filename
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_prog_serialize_to_file(tinytc_prog_t prg,
+                                                            char const *filename);
+
+/**
+ * @brief Delete bytecode returned by tinytc_prog_serialize
+ *
+ * @param data [in] bytecode
+ */
+TINYTC_EXPORT void tinytc_bytecode_destroy(uint8_t *data);
+
+/**
+ * @brief Deserialize program from bytecode
+ *
+ * The bytecode must have been created by tinytc_prog_serialize of the same bytecode version;
+ * tinytc_status_invalid_bytecode is returned otherwise.
+ *
+ * @param prg [out] pointer to prog object created
+ * @param data_size [in] size of bytecode in bytes
+ * @param data [in] bytecode
+ * @param ctx [inout][optional] context object; a new context is created if ctx is nullptr
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_prog_deserialize(tinytc_prog_t *prg, size_t data_size,
+                                                      uint8_t const *data,
+                                                      tinytc_compiler_context_t ctx);
+
+/**
+ * @brief Deserialize program from bytecode file
+ *
+ * The file is memory-mapped and read in-place where supported.
+ *
+ * @param prg [out] pointer to prog object created
+ * @param filename [in] path to bytecode file
+ * @param ctx [inout][optional] context object; a new context is created if ctx is nullptr
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_prog_deserialize_file(tinytc_prog_t *prg,
+                                                           char const *filename,
+                                                           tinytc_compiler_context_t ctx);
+
 /**
  * @brief Create context
  *
  * The context stores the tensor language source and reports enhaces error messages with
  * source code context. Moreover, the context caches data such as types and constants.
+ * Types and attributes may be queried concurrently from multiple threads sharing the same context.
  *
  * @param ctx [out] pointer to the context object created
  *
@@ -415,6 +485,104 @@ TINYTC_EXPORT tinytc_status_t tinytc_compiler_context_set_optimization_flag(
 TINYTC_EXPORT tinytc_status_t
 tinytc_compiler_context_set_optimization_level(tinytc_compiler_context_t ctx, int32_t level);
 
+/**
+ * @brief Enable or disable the on-disk binary cache
+ *
+ * When the binary cache is enabled, tinytc_prog_compile_to_spirv_and_assemble looks up the
+ * compiled binary in the cache directory before running the compiler. The cache key comprises
+ * the printed program, the core info, the optimization level and flags, and the library version.
+ * On a cache hit, the program is not modified and the returned binary references the
+ * memory-mapped cache file. Multiple processes may share the same cache directory.
+ *
+ * The binary cache of a newly created context is enabled if the environment variable
+ * TINYTC_CACHE_DIR is set; the size limit may be set with the environment variable
+ * TINYTC_CACHE_MAX_SIZE (in bytes).
+ *
+ * @param ctx [inout] context object
+ * @param path [in][optional] cache directory; the directory is created if it does not exist;
+ * the binary cache is disabled if path is nullptr or the empty string
+ * @param max_size [in] size limit in bytes; least recently used entries are removed when the
+ * limit is exceeded; set to 0 to use the default limit (256 MiB)
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_compiler_context_set_binary_cache(
+    tinytc_compiler_context_t ctx, char const *path, uint64_t max_size);
+
+/**
+ * @brief Enable or disable the tuning database
+ *
+ * The tuning database stores GEMM configurations found by tinytc_autotune_gemm.
+ * When a GEMM is compiled for a device and shape that is in the database, the tuned
+ * subgroup size, work-group size, register blocking, and K block size are used instead of the
+ * heuristics. The subgroup size and work-group size of a function are taken from the entry of the
+ * GEMM with the largest result in the function.
+ *
+ * The tuning database of a newly created context is enabled if the environment variable
+ * TINYTC_TUNING_DB is set to a file name.
+ *
+ * @param ctx [inout] context object
+ * @param filename [in][optional] database file; the file is read if it exists and is written
+ * whenever a new entry is stored. If filename is the empty string, the database is kept in memory.
+ * The tuning database is disabled if filename is nullptr
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_compiler_context_set_tuning_database(
+    tinytc_compiler_context_t ctx, char const *filename);
+
+/**
+ * @brief Set number of threads used by the compiler
+ *
+ * The functions of a program are optimized and analysed concurrently when more than one thread
+ * is used. The compilation result does not depend on the number of threads.
+ * Compilations that are already running when the number of threads is changed finish with the
+ * previous number of threads.
+ *
+ * @param ctx [inout] context object
+ * @param num_threads [in] number of threads; 1 selects serial compilation (default) and 0 selects
+ * the number of hardware threads
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_compiler_context_set_num_threads(tinytc_compiler_context_t ctx,
+                                                                      int32_t num_threads);
+
+/**
+ * @brief Enable or disable collection of pass statistics
+ *
+ * When enabled, every function pass run with the context records the wall time,
+ * the number of instructions before and after the pass, and the number and size of IR node
+ * allocations made by the pass. Enabling pass statistics discards previously collected
+ * statistics.
+ *
+ * @param ctx [inout] context object
+ * @param enable [in] true to enable collection and false to disable collection
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_compiler_context_set_pass_statistics(
+    tinytc_compiler_context_t ctx, tinytc_bool_t enable);
+
+/**
+ * @brief Get pass statistics as JSON
+ *
+ * The JSON object contains the array "passes" with statistics accumulated per pass.
+ * If per_function is true, the JSON object additionally contains the array "records" with
+ * the statistics of every pass run on every function.
+ * The string is empty if pass statistics are disabled.
+ *
+ * The user is responsible to dispose the string with tinytc_string_destroy.
+ *
+ * @param ctx [in] context object
+ * @param per_function [in] include statistics of individual pass runs
+ * @param json [out] pointer to string
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_compiler_context_get_pass_statistics(
+    const_tinytc_compiler_context_t ctx, tinytc_bool_t per_function, char **json);
+
 /**
  * @brief Report an error and augment the error with source context
  *
@@ -444,6 +612,27 @@ TINYTC_EXPORT tinytc_status_t tinytc_compiler_context_report_error(
 TINYTC_EXPORT tinytc_status_t tinytc_run_function_pass(char const *pass_name, tinytc_prog_t prg,
                                                        const_tinytc_core_info_t info);
 
+/**
+ * @brief Run a pipeline of function passes on every function of a program
+ *
+ * The pipeline is a comma-separated list of pass names, e.g.
+ * "constant-propagation,dead-code-elimination,lower-linalg".
+ * Pass names are resolved once before any pass is run and every pass is run on all functions
+ * before the next pass is run.
+ * Analysis results are shared between the passes of the pipeline and are only recomputed
+ * after a pass changed the function.
+ *
+ * @param pipeline [in] comma-separated list of function pass names; cf. tinytc_list_function_passes
+ * @param prg [inout] tensor program; modified as compiler passes are run
+ * @param info [in][optional] core info object; might be nullptr if core info is not required for
+ * passes
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_run_function_pass_pipeline(char const *pipeline,
+                                                                tinytc_prog_t prg,
+                                                                const_tinytc_core_info_t info);
+
 /**
  * @brief List function passes
  *
@@ -479,6 +668,183 @@ TINYTC_EXPORT tinytc_status_t tinytc_prog_compile_to_spirv(tinytc_spv_mod_t *mod
 TINYTC_EXPORT tinytc_status_t tinytc_prog_compile_to_spirv_and_assemble(
     tinytc_binary_t *bin, tinytc_prog_t prg, const_tinytc_core_info_t info);
 
+/**
+ * @brief Estimate cost of a function with a static cost model
+ *
+ * The default optimization pipeline is run on a copy of the program and the cost is estimated
+ * from the lowered function. FLOPs, memory traffic, and barriers are counted per work-group.
+ * The occupancy is the fraction of the subgroup slots of a core that can be filled with
+ * work-groups of the function, respecting the shared local memory footprint.
+ *
+ * @param cost [out] pointer to the cost estimate
+ * @param prg [in] tensor program; not modified
+ * @param func_name [in] function name
+ * @param info [in] core info object
+ *
+ * @return tinytc_status_success on success, tinytc_status_invalid_arguments if the function does
+ * not exist, and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_prog_estimate_cost(tinytc_function_cost_t *cost,
+                                                        tinytc_prog_t prg, char const *func_name,
+                                                        const_tinytc_core_info_t info);
+
+/**
+ * @brief Get cost report of all functions as JSON
+ *
+ * The report contains the estimate of tinytc_prog_estimate_cost for every function.
+ * The user is responsible to dispose the string with tinytc_string_destroy.
+ *
+ * @param json [out] pointer to C string
+ * @param prg [in] tensor program; not modified
+ * @param info [in] core info object
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_prog_get_cost_report(char **json, tinytc_prog_t prg,
+                                                          const_tinytc_core_info_t info);
+
+/**
+ * @brief Specialize function for concrete shapes and strides
+ *
+ * Creates a copy of the program in which the dynamic shapes and strides of the given memref
+ * parameters of one function are replaced by constants. The specialized function accepts
+ * the same kernel arguments as the original function; the arguments of specialized modes are
+ * ignored. Hence, a specialized kernel may be used in place of the generic kernel whenever the
+ * kernel arguments match the specialization.
+ *
+ * @param specialized [out] pointer to the specialized program created
+ * @param prg [in] tensor program; not modified
+ * @param func_name [in] name of the function to specialize; other functions are copied
+ * @param spec_size [in] number of specializations
+ * @param specs [in][range(0, spec_size)] specializations; at most one per parameter
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_prog_specialize(tinytc_prog_t *specialized,
+                                                     tinytc_prog_t prg, char const *func_name,
+                                                     size_t spec_size,
+                                                     const tinytc_memref_specialization_t *specs);
+
+/**
+ * @brief Create specialization cache
+ *
+ * The specialization cache memoizes the binaries of specialized programs, keyed by the function
+ * name and the specialized values. The cache keeps a copy of the program, hence prg may be
+ * modified after the cache has been created.
+ *
+ * @param cache [out] pointer to the specialization cache object created
+ * @param prg [in] tensor program
+ * @param info [in] core info object; the reference count is increased
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_specialization_cache_create(
+    tinytc_specialization_cache_t *cache, tinytc_prog_t prg, tinytc_core_info_t info);
+
+/**
+ * @brief Get binary of specialized program
+ *
+ * The program is specialized (cf. tinytc_prog_specialize) and compiled on the first request
+ * of a specialization; later requests return the cached binary. The function is thread-safe.
+ *
+ * @param cache [inout] specialization cache object
+ * @param func_name [in] name of the function to specialize
+ * @param spec_size [in] number of specializations
+ * @param specs [in][range(0, spec_size)] specializations; at most one per parameter
+ * @param bin [out] pointer to the binary object; the reference count is increased
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_specialization_cache_get_binary(
+    tinytc_specialization_cache_t cache, char const *func_name, size_t spec_size,
+    const tinytc_memref_specialization_t *specs, tinytc_binary_t *bin);
+
+/**
+ * @brief Get number of binaries in specialization cache
+ *
+ * @param cache [in] specialization cache object
+ * @param size [out] pointer to number of cached binaries
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_specialization_cache_get_size(
+    const_tinytc_specialization_cache_t cache, size_t *size);
+
+/**
+ * @brief Compile tensor program asynchronously
+ *
+ * The job keeps a copy of the program, hence prg may be modified or released once the function
+ * returns. The reference count of info is increased; info must not be modified while the job is
+ * pending. Jobs are executed by a process-wide pool of worker threads in order of priority and,
+ * for equal priority, in order of submission.
+ *
+ * @param job [out] pointer to the compile job object created
+ * @param prg [in] tensor program
+ * @param info [in] core info object
+ * @param priority [in] job priority
+ * @param callback [in][optional] called on a worker thread when the job has finished, failed, or
+ * was cancelled; can be nullptr
+ * @param user_data [in][optional] pointer passed to callback; can be nullptr
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_prog_compile_async(tinytc_compile_job_t *job,
+                                                        tinytc_prog_t prg, tinytc_core_info_t info,
+                                                        tinytc_compile_priority_t priority,
+                                                        tinytc_compile_callback_t callback,
+                                                        void *user_data);
+
+/**
+ * @brief Get state of compile job without blocking
+ *
+ * @param job [in] compile job object
+ * @param state [out] pointer to job state
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_compile_job_get_state(const_tinytc_compile_job_t job,
+                                                           tinytc_compile_job_state_t *state);
+
+/**
+ * @brief Wait until compile job has finished
+ *
+ * The function returns once the job is finished, failed, or was cancelled. The completion
+ * callback may still be running when the function returns.
+ *
+ * @param job [inout] compile job object
+ * @param bin [out][optional] pointer to the binary object; the reference count is increased;
+ * can be nullptr
+ *
+ * @return tinytc_status_success on success, tinytc_status_compilation_cancelled if the job was
+ * cancelled, and the compilation error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_compile_job_wait(tinytc_compile_job_t job,
+                                                      tinytc_binary_t *bin);
+
+/**
+ * @brief Request cancellation of compile job
+ *
+ * A queued job is cancelled immediately. A running job is cancelled at the next checkpoint
+ * between compilation stages; it may still finish successfully. Cancelling a finished job has
+ * no effect.
+ *
+ * @param job [inout] compile job object
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_compile_job_cancel(tinytc_compile_job_t job);
+
+/**
+ * @brief Set number of worker threads used for asynchronous compilation
+ *
+ * The function blocks until all previously submitted jobs have finished.
+ *
+ * @param num_threads [in] number of worker threads; 0 selects the number of hardware threads
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_set_async_compile_num_threads(size_t num_threads);
+
 /**
  * @brief Assemble SPIR-V module
  *
@@ -546,6 +912,152 @@ TINYTC_EXPORT tinytc_status_t tinytc_binary_get_raw(const_tinytc_binary_t bin,
 TINYTC_EXPORT tinytc_status_t tinytc_binary_get_core_features(
     const_tinytc_binary_t bin, tinytc_core_feature_flags_t *core_features);
 
+////////////////////////////
+//////// Fat binary ////////
+////////////////////////////
+
+/**
+ * @brief Compile tensor program for several devices and bundle the binaries in a fat binary
+ *
+ * Every device is compiled from a copy of the program, hence prg is not modified.
+ * The devices are compiled in parallel if the compiler context has more than one thread
+ * (cf. tinytc_compiler_context_set_num_threads).
+ *
+ * @param fat [out] pointer to the fat binary object created
+ * @param prg [in] tensor program
+ * @param info_size [in] number of target devices
+ * @param infos [in][range(0, info_size)] core info objects of target devices; the core features
+ * of the core info are part of the target
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_prog_compile_to_fat_binary(
+    tinytc_fat_binary_t *fat, tinytc_prog_t prg, size_t info_size,
+    const const_tinytc_core_info_t *infos);
+
+/**
+ * @brief Create fat binary from serialized data
+ *
+ * @param fat [out] pointer to the fat binary object created
+ * @param ctx [in] compiler context of binaries taken from the fat binary
+ * @param data_size [in] size of data in bytes
+ * @param data [in][range(0, data_size)] serialized fat binary (cf. tinytc_fat_binary_get_raw);
+ * data is copied
+ *
+ * @return tinytc_status_success on success, tinytc_status_invalid_fat_binary if the data is
+ * malformed, and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_fat_binary_create(tinytc_fat_binary_t *fat,
+                                                       tinytc_compiler_context_t ctx,
+                                                       size_t data_size, uint8_t const *data);
+
+/**
+ * @brief Create fat binary from file
+ *
+ * The file is memory-mapped and binaries taken from the fat binary refer to the mapped memory.
+ *
+ * @param fat [out] pointer to the fat binary object created
+ * @param ctx [in] compiler context of binaries taken from the fat binary
+ * @param filename [in] path to fat binary file
+ *
+ * @return tinytc_status_success on success, tinytc_status_invalid_fat_binary if the file is
+ * malformed, and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_fat_binary_create_from_file(tinytc_fat_binary_t *fat,
+                                                                 tinytc_compiler_context_t ctx,
+                                                                 char const *filename);
+
+/**
+ * @brief Get serialized fat binary
+ *
+ * @param fat [in] fat binary object
+ * @param data_size [out] size of data
+ * @param data [out] data array; returned pointer is invalidated if the fat binary object is
+ * deleted
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_fat_binary_get_raw(const_tinytc_fat_binary_t fat,
+                                                        size_t *data_size, uint8_t const **data);
+
+/**
+ * @brief Get number of binaries in fat binary
+ *
+ * @param fat [in] fat binary object
+ * @param num_entries [out] pointer to number of binaries
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_fat_binary_get_size(const_tinytc_fat_binary_t fat,
+                                                         size_t *num_entries);
+
+/**
+ * @brief Select the best binary for a device
+ *
+ * A binary is eligible if it was compiled for the architecture of the device and if the core
+ * features requested for its target are a subset of the core features of info. Among the eligible
+ * binaries, the binary compiled for the most specific IP version wins, then the binary whose
+ * target requested the most core features.
+ *
+ * @param fat [in] fat binary object
+ * @param info [in] core info object of the device
+ * @param bin [out] pointer to the binary object created
+ *
+ * @return tinytc_status_success on success, tinytc_status_unsupported_device if no binary is
+ * eligible, and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_fat_binary_get_binary(const_tinytc_fat_binary_t fat,
+                                                           const_tinytc_core_info_t info,
+                                                           tinytc_binary_t *bin);
+
+////////////////////////////
+///////// Autotuning ///////
+////////////////////////////
+
+/**
+ * @brief Autotune GEMM and store the best configuration in the tuning database
+ *
+ * All candidate configurations are passed to the measurement callback and the configuration
+ * with the lowest cost is stored in the tuning database of the compiler context of the element
+ * types. An in-memory tuning database is created if the tuning database is disabled.
+ *
+ * The measurement callback may compile and time a GEMM kernel with shape M x N; the candidate is
+ * installed in the tuning database while the callback runs. Alternatively,
+ * tinytc_estimate_gemm_cost may be passed as static cost model.
+ *
+ * @param best [out] best configuration
+ * @param problem [in] GEMM problem; M, N, and K must be positive
+ * @param measure [in] measurement callback
+ * @param user_data [in][optional] user data passed to measurement callback
+ *
+ * @return tinytc_status_success on success, the status of the measurement callback if it
+ * failed, tinytc_status_runtime_error if all candidates were rejected, and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_autotune_gemm(tinytc_tuning_config_t *best,
+                                                   const tinytc_gemm_tuning_problem_t *problem,
+                                                   tinytc_tuning_measure_t measure,
+                                                   void *user_data);
+
+/**
+ * @brief Estimate cost of GEMM configuration with a static cost model
+ *
+ * The cost is the number of lane cycles a work-group spends on FMAs, loads, stores, and loop
+ * overhead, including idle subgroups and padding. Configurations that need more registers than
+ * available are penalized.
+ *
+ * The function has the signature of tinytc_tuning_measure_t.
+ *
+ * @param problem [in] GEMM problem
+ * @param config [in] configuration
+ * @param cost [out] estimated cost
+ * @param user_data [in][optional] ignored
+ *
+ * @return tinytc_status_success on success and error otherwise
+ */
+TINYTC_EXPORT tinytc_status_t tinytc_estimate_gemm_cost(const tinytc_gemm_tuning_problem_t *problem,
+                                                        const tinytc_tuning_config_t *config,
+                                                        double *cost, void *user_data);
+
 
 #ifdef __cplusplus
 }
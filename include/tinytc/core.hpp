@@ -651,6 +651,60 @@ inline void set_optimization_flag(tinytc_compiler_context_t ctx, optflag flag, s
 inline void set_optimization_level(tinytc_compiler_context_t ctx, std::int32_t level) {
     CHECK_STATUS(tinytc_compiler_context_set_optimization_level(ctx, level));
 }
+/**
+ * @brief Enable or disable the on-disk binary cache
+ *
+ * @param ctx compiler context
+ * @param path cache directory; the binary cache is disabled if path is nullptr or empty
+ * @param max_size size limit in bytes; 0 selects the default limit
+ */
+inline void set_binary_cache(tinytc_compiler_context_t ctx, char const *path,
+                             std::uint64_t max_size = 0) {
+    CHECK_STATUS(tinytc_compiler_context_set_binary_cache(ctx, path, max_size));
+}
+/**
+ * @brief Enable or disable the tuning database
+ *
+ * @param ctx compiler context
+ * @param filename database file; the database is kept in memory if filename is empty and the
+ * tuning database is disabled if filename is nullptr
+ */
+inline void set_tuning_database(tinytc_compiler_context_t ctx, char const *filename) {
+    CHECK_STATUS(tinytc_compiler_context_set_tuning_database(ctx, filename));
+}
+/**
+ * @brief Set number of threads used by the compiler
+ *
+ * @param ctx compiler context
+ * @param num_threads number of threads; 1 selects serial compilation and 0 selects the number of
+ * hardware threads
+ */
+inline void set_num_threads(tinytc_compiler_context_t ctx, std::int32_t num_threads) {
+    CHECK_STATUS(tinytc_compiler_context_set_num_threads(ctx, num_threads));
+}
+/**
+ * @brief Enable or disable collection of pass statistics
+ *
+ * @param ctx compiler context
+ * @param enable true to enable collection and false to disable collection
+ */
+inline void set_pass_statistics(tinytc_compiler_context_t ctx, bool enable) {
+    CHECK_STATUS(tinytc_compiler_context_set_pass_statistics(ctx, enable));
+}
+/**
+ * @brief Get pass statistics as JSON
+ *
+ * @param ctx compiler context
+ * @param per_function include statistics of individual pass runs
+ *
+ * @return C-string (unique handle)
+ */
+inline auto get_pass_statistics(const_tinytc_compiler_context_t ctx, bool per_function)
+    -> unique_handle<char *> {
+    char *json;
+    CHECK_STATUS(tinytc_compiler_context_get_pass_statistics(ctx, per_function, &json));
+    return unique_handle<char *>{json};
+}
 /**
  * @brief Enhance error message with compiler context; useful when builder is used
  *
@@ -957,6 +1011,66 @@ inline auto parse_string(std::string const &src, tinytc_compiler_context_t ctx =
     return shared_handle{prg};
 }
 
+////////////////////////////
+///////// Bytecode /////////
+////////////////////////////
+
+/**
+ * @brief Serialize program to compact binary bytecode
+ *
+ * @param prg Program
+ *
+ * @return Bytecode
+ */
+inline auto serialize(tinytc_prog_t prg) -> std::vector<std::uint8_t> {
+    std::size_t data_size;
+    std::uint8_t *data;
+    CHECK_STATUS(tinytc_prog_serialize(prg, &data_size, &data));
+    auto bytecode = std::vector<std::uint8_t>(data, data + data_size);
+    tinytc_bytecode_destroy(data);
+    return bytecode;
+}
+
+/**
+ * @brief Serialize program to bytecode file
+ *
+ * @param prg Program
+ * @param filename Path to file
+ */
+inline void serialize_to_file(tinytc_prog_t prg, char const *filename) {
+    CHECK_STATUS(tinytc_prog_serialize_to_file(prg, filename));
+}
+
+/**
+ * @brief Deserialize program from bytecode
+ *
+ * @param data Bytecode
+ * @param ctx Compiler context
+ *
+ * @return Program
+ */
+inline auto deserialize(array_view<std::uint8_t> data, tinytc_compiler_context_t ctx = {})
+    -> shared_handle<tinytc_prog_t> {
+    tinytc_prog_t prg;
+    CHECK_STATUS(tinytc_prog_deserialize(&prg, data.size(), data.data(), ctx));
+    return shared_handle{prg};
+}
+
+/**
+ * @brief Deserialize program from bytecode file
+ *
+ * @param filename Path to bytecode file
+ * @param ctx Compiler context
+ *
+ * @return Program
+ */
+inline auto deserialize_file(char const *filename, tinytc_compiler_context_t ctx = {})
+    -> shared_handle<tinytc_prog_t> {
+    tinytc_prog_t prg;
+    CHECK_STATUS(tinytc_prog_deserialize_file(&prg, filename, ctx));
+    return shared_handle{prg};
+}
+
 ////////////////////////////
 ///////// Compiler /////////
 ////////////////////////////
@@ -1031,6 +1145,93 @@ inline auto create_binary(tinytc_compiler_context_t ctx, bundle_format format,
     return shared_handle{bin};
 }
 
+/**
+ * @brief Compile tensor program for several devices and bundle the binaries
+ *
+ * @param prg Tensor program; not modified
+ * @param infos Core info objects of target devices
+ *
+ * @return Fat binary
+ */
+inline auto compile_to_fat_binary(tinytc_prog_t prg, array_view<const_tinytc_core_info_t> infos)
+    -> shared_handle<tinytc_fat_binary_t> {
+    tinytc_fat_binary_t fat;
+    CHECK_STATUS(tinytc_prog_compile_to_fat_binary(&fat, prg, infos.size(), infos.data()));
+    return shared_handle{fat};
+}
+
+/**
+ * @brief Create fat binary from serialized data
+ *
+ * @param ctx Compiler context
+ * @param data Serialized fat binary; data is copied
+ *
+ * @return Fat binary
+ */
+inline auto create_fat_binary(tinytc_compiler_context_t ctx, array_view<std::uint8_t> data)
+    -> shared_handle<tinytc_fat_binary_t> {
+    tinytc_fat_binary_t fat;
+    CHECK_STATUS(tinytc_fat_binary_create(&fat, ctx, data.size(), data.data()));
+    return shared_handle{fat};
+}
+
+/**
+ * @brief Create fat binary from file
+ *
+ * @param ctx Compiler context
+ * @param filename Path to fat binary file
+ *
+ * @return Fat binary
+ */
+inline auto create_fat_binary_from_file(tinytc_compiler_context_t ctx, char const *filename)
+    -> shared_handle<tinytc_fat_binary_t> {
+    tinytc_fat_binary_t fat;
+    CHECK_STATUS(tinytc_fat_binary_create_from_file(&fat, ctx, filename));
+    return shared_handle{fat};
+}
+
+/**
+ * @brief Get serialized fat binary
+ *
+ * @param fat Fat binary
+ *
+ * @return Serialized data; valid as long as the fat binary lives
+ */
+inline auto get_raw(const_tinytc_fat_binary_t fat) -> array_view<std::uint8_t> {
+    std::size_t data_size;
+    std::uint8_t const *data;
+    CHECK_STATUS(tinytc_fat_binary_get_raw(fat, &data_size, &data));
+    return array_view(data, data_size);
+}
+
+/**
+ * @brief Get number of binaries in fat binary
+ *
+ * @param fat Fat binary
+ *
+ * @return Number of binaries
+ */
+inline auto get_size(const_tinytc_fat_binary_t fat) -> std::size_t {
+    std::size_t size;
+    CHECK_STATUS(tinytc_fat_binary_get_size(fat, &size));
+    return size;
+}
+
+/**
+ * @brief Select the best binary for a device
+ *
+ * @param fat Fat binary
+ * @param info Core info of device
+ *
+ * @return Binary; throws status::unsupported_device if there is no binary for the device
+ */
+inline auto get_binary(const_tinytc_fat_binary_t fat, const_tinytc_core_info_t info)
+    -> shared_handle<tinytc_binary_t> {
+    tinytc_binary_t bin;
+    CHECK_STATUS(tinytc_fat_binary_get_binary(fat, info, &bin));
+    return shared_handle{bin};
+}
+
 /**
  * @brief Run a function pass on every function of a program
  *
@@ -1043,6 +1244,18 @@ inline void run_function_pass(char const *pass_name, tinytc_prog_t prg,
     CHECK_STATUS(tinytc_run_function_pass(pass_name, prg, info));
 }
 
+/**
+ * @brief Run a pipeline of function passes on every function of a program
+ *
+ * @param pipeline comma-separated list of function pass names; cf. list_function_passes
+ * @param prg tensor program; modified as compiler passes are run
+ * @param info core info object; might be nullptr if core info is not required for passes
+ */
+inline void run_function_pass_pipeline(char const *pipeline, tinytc_prog_t prg,
+                                       const_tinytc_core_info_t info = {}) {
+    CHECK_STATUS(tinytc_run_function_pass_pipeline(pipeline, prg, info));
+}
+
 /**
  * @brief Get function pass names
  *
@@ -1083,6 +1296,37 @@ inline auto compile_to_spirv_and_assemble(tinytc_prog_t prg, const_tinytc_core_i
     return shared_handle{bin};
 }
 
+/**
+ * @brief Estimate cost of function with the static cost model
+ *
+ * @param prg Program
+ * @param func_name Function name
+ * @param info Core info
+ *
+ * @return Cost estimate
+ */
+inline auto estimate_cost(tinytc_prog_t prg, char const *func_name, const_tinytc_core_info_t info)
+    -> function_cost {
+    function_cost cost;
+    CHECK_STATUS(tinytc_prog_estimate_cost(&cost, prg, func_name, info));
+    return cost;
+}
+
+/**
+ * @brief Get cost report of all functions as JSON
+ *
+ * @param prg Program
+ * @param info Core info
+ *
+ * @return C-string (unique handle)
+ */
+inline auto get_cost_report(tinytc_prog_t prg, const_tinytc_core_info_t info)
+    -> unique_handle<char *> {
+    char *json;
+    CHECK_STATUS(tinytc_prog_get_cost_report(&json, prg, info));
+    return unique_handle<char *>{json};
+}
+
 /**
  * @brief Assemble SPIR-V module
  *
@@ -1096,6 +1340,170 @@ inline auto spirv_assemble(tinytc_spv_mod_t mod) -> shared_handle<tinytc_binary_
     return shared_handle{bin};
 }
 
+/**
+ * @brief Specialize function for concrete shapes and strides
+ *
+ * @param prg Program; not modified
+ * @param func_name Name of the function to specialize
+ * @param specs Specializations
+ *
+ * @return Specialized program
+ */
+inline auto specialize(tinytc_prog_t prg, char const *func_name,
+                       array_view<tinytc_memref_specialization_t> specs)
+    -> shared_handle<tinytc_prog_t> {
+    tinytc_prog_t specialized;
+    CHECK_STATUS(
+        tinytc_prog_specialize(&specialized, prg, func_name, specs.size(), specs.data()));
+    return shared_handle{specialized};
+}
+
+/**
+ * @brief Create specialization cache
+ *
+ * @param prg Program
+ * @param info Core info
+ *
+ * @return Specialization cache
+ */
+inline auto create_specialization_cache(tinytc_prog_t prg, tinytc_core_info_t info)
+    -> shared_handle<tinytc_specialization_cache_t> {
+    tinytc_specialization_cache_t cache;
+    CHECK_STATUS(tinytc_specialization_cache_create(&cache, prg, info));
+    return shared_handle{cache};
+}
+
+/**
+ * @brief Get binary of specialized program; the binary is compiled on the first request
+ *
+ * @param cache Specialization cache
+ * @param func_name Name of the function to specialize
+ * @param specs Specializations
+ *
+ * @return Binary
+ */
+inline auto get_binary(tinytc_specialization_cache_t cache, char const *func_name,
+                       array_view<tinytc_memref_specialization_t> specs)
+    -> shared_handle<tinytc_binary_t> {
+    tinytc_binary_t bin;
+    CHECK_STATUS(tinytc_specialization_cache_get_binary(cache, func_name, specs.size(),
+                                                        specs.data(), &bin));
+    return shared_handle{bin};
+}
+
+/**
+ * @brief Get number of binaries in specialization cache
+ *
+ * @param cache Specialization cache
+ *
+ * @return Number of cached binaries
+ */
+inline auto get_size(const_tinytc_specialization_cache_t cache) -> std::size_t {
+    std::size_t size;
+    CHECK_STATUS(tinytc_specialization_cache_get_size(cache, &size));
+    return size;
+}
+
+/**
+ * @brief Compile tensor program asynchronously
+ *
+ * @param prg Program; copied
+ * @param info Core info; must not be modified while the job is pending
+ * @param priority Job priority
+ * @param callback Completion callback; can be nullptr
+ * @param user_data Pointer passed to callback
+ *
+ * @return Compile job
+ */
+inline auto compile_async(tinytc_prog_t prg, tinytc_core_info_t info,
+                          compile_priority priority = compile_priority::normal,
+                          tinytc_compile_callback_t callback = nullptr,
+                          void *user_data = nullptr) -> shared_handle<tinytc_compile_job_t> {
+    tinytc_compile_job_t job;
+    CHECK_STATUS(tinytc_prog_compile_async(&job, prg, info,
+                                           static_cast<tinytc_compile_priority_t>(priority),
+                                           callback, user_data));
+    return shared_handle{job};
+}
+
+/**
+ * @brief Get state of compile job
+ *
+ * @param job Compile job
+ *
+ * @return Job state
+ */
+inline auto get_state(const_tinytc_compile_job_t job) -> compile_job_state {
+    tinytc_compile_job_state_t state;
+    CHECK_STATUS(tinytc_compile_job_get_state(job, &state));
+    return compile_job_state{std::underlying_type_t<compile_job_state>(state)};
+}
+
+/**
+ * @brief Wait until compile job has finished
+ *
+ * @param job Compile job
+ *
+ * @return Binary; throws status::compilation_cancelled if the job was cancelled
+ */
+inline auto wait(tinytc_compile_job_t job) -> shared_handle<tinytc_binary_t> {
+    tinytc_binary_t bin;
+    CHECK_STATUS(tinytc_compile_job_wait(job, &bin));
+    return shared_handle{bin};
+}
+
+/**
+ * @brief Request cancellation of compile job
+ *
+ * @param job Compile job
+ */
+inline void cancel(tinytc_compile_job_t job) { CHECK_STATUS(tinytc_compile_job_cancel(job)); }
+
+/**
+ * @brief Set number of worker threads used for asynchronous compilation
+ *
+ * @param num_threads Number of worker threads; 0 selects the number of hardware threads
+ */
+inline void set_async_compile_num_threads(std::size_t num_threads) {
+    CHECK_STATUS(tinytc_set_async_compile_num_threads(num_threads));
+}
+
+////////////////////////////
+///////// Autotuning ///////
+////////////////////////////
+
+/**
+ * @brief Autotune GEMM and store the best configuration in the tuning database
+ *
+ * @param problem GEMM problem
+ * @param measure Measurement callback; the static cost model is used by default
+ * @param user_data Pointer passed to measurement callback
+ *
+ * @return Best configuration
+ */
+inline auto autotune_gemm(gemm_tuning_problem const &problem,
+                          tinytc_tuning_measure_t measure = &tinytc_estimate_gemm_cost,
+                          void *user_data = nullptr) -> tuning_config {
+    tuning_config best;
+    CHECK_STATUS(tinytc_autotune_gemm(&best, &problem, measure, user_data));
+    return best;
+}
+
+/**
+ * @brief Estimate cost of GEMM configuration with the static cost model
+ *
+ * @param problem GEMM problem
+ * @param config Configuration
+ *
+ * @return Estimated cost
+ */
+inline auto estimate_gemm_cost(gemm_tuning_problem const &problem, tuning_config const &config)
+    -> double {
+    double cost;
+    CHECK_STATUS(tinytc_estimate_gemm_cost(&problem, &config, &cost, nullptr));
+    return cost;
+}
+
 } // namespace tinytc
 
 namespace std {
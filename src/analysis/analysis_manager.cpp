@@ -0,0 +1,50 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "analysis/analysis_manager.hpp"
+#include "analysis/alias.hpp"
+#include "compiler_context.hpp"
+#include "device_info.hpp"
+#include "error.hpp"
+#include "node/func.hpp"
+#include "node/type.hpp"
+#include "tinytc/types.hpp"
+
+namespace tinytc {
+
+analysis_manager::analysis_manager(tinytc_func &fn, ::tinytc_core_info const *info)
+    : fn_(&fn), info_(info) {}
+
+auto analysis_manager::alias() -> aa_results const & {
+    if (!aa_) {
+        aa_ = alias_analysis{}.run_on_function(*fn_);
+    }
+    return *aa_;
+}
+
+auto analysis_manager::gcd() -> gcd_analysis_result const & {
+    if (!gcd_) {
+        if (!info_) {
+            throw status::invalid_core_info;
+        }
+        gcd_ = gcd_analysis{info_->alignment()}.run_on_function(*fn_);
+    }
+    return *gcd_;
+}
+
+auto analysis_manager::range() -> range_analysis_result const & {
+    if (!range_) {
+        auto const assume_small_buffers =
+            fn_->ty()->context()->opt_flag(optflag::assume_small_buffers);
+        range_ = range_analysis{assume_small_buffers}.run_on_function(*fn_);
+    }
+    return *range_;
+}
+
+void analysis_manager::invalidate() {
+    aa_ = std::nullopt;
+    gcd_ = std::nullopt;
+    range_ = std::nullopt;
+}
+
+} // namespace tinytc
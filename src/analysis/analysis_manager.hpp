@@ -0,0 +1,51 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef ANALYSIS_MANAGER_20251016_HPP
+#define ANALYSIS_MANAGER_20251016_HPP
+
+#include "analysis/aa_results.hpp"
+#include "analysis/gcd.hpp"
+#include "analysis/range.hpp"
+#include "tinytc/types.h"
+
+#include <optional>
+
+namespace tinytc {
+
+/**
+ * @brief Caches analysis results of a single function
+ *
+ * Analyses are computed on first request and kept until invalidate is called.
+ * Passes that change the IR must invalidate the cached results.
+ */
+class analysis_manager {
+  public:
+    /**
+     * @brief ctor
+     *
+     * @param fn Function
+     * @param info Core info; only required for the GCD analysis
+     */
+    analysis_manager(tinytc_func &fn, ::tinytc_core_info const *info = nullptr);
+
+    auto alias() -> aa_results const &;
+    auto gcd() -> gcd_analysis_result const &;
+    auto range() -> range_analysis_result const &;
+
+    //! Drop all cached analysis results
+    void invalidate();
+
+    inline auto fn() -> tinytc_func & { return *fn_; }
+
+  private:
+    tinytc_func *fn_;
+    ::tinytc_core_info const *info_;
+    std::optional<aa_results> aa_;
+    std::optional<gcd_analysis_result> gcd_;
+    std::optional<range_analysis_result> range_;
+};
+
+} // namespace tinytc
+
+#endif // ANALYSIS_MANAGER_20251016_HPP
@@ -0,0 +1,340 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "analysis/cost.hpp"
+#include "analysis/stack.hpp"
+#include "codegen_tools.hpp"
+#include "device_info.hpp"
+#include "node/func.hpp"
+#include "node/inst.hpp"
+#include "node/inst_view.hpp"
+#include "node/region.hpp"
+#include "node/type.hpp"
+#include "node/value.hpp"
+#include "node/visit.hpp"
+#include "number.hpp"
+#include "support/walk.hpp"
+#include "tinytc/types.hpp"
+#include "util/casting.hpp"
+#include "util/overloaded.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tinytc {
+
+namespace {
+
+struct cost_counts {
+    double flops = 0.0;
+    double global_bytes = 0.0;
+    double local_bytes = 0.0;
+    double barriers = 0.0;
+
+    auto operator+=(cost_counts const &other) -> cost_counts & {
+        flops += other.flops;
+        global_bytes += other.global_bytes;
+        local_bytes += other.local_bytes;
+        barriers += other.barriers;
+        return *this;
+    }
+    auto operator*=(double factor) -> cost_counts & {
+        flops *= factor;
+        global_bytes *= factor;
+        local_bytes *= factor;
+        barriers *= factor;
+        return *this;
+    }
+};
+
+auto max(cost_counts const &a, cost_counts const &b) -> cost_counts {
+    return {std::max(a.flops, b.flops), std::max(a.global_bytes, b.global_bytes),
+            std::max(a.local_bytes, b.local_bytes), std::max(a.barriers, b.barriers)};
+}
+
+class cost_counter {
+  public:
+    cost_counter(std::int32_t subgroup_size) : subgroup_size_(subgroup_size) {}
+
+    auto count(tinytc_region &reg, bool spmd) -> cost_counts;
+    auto register_pressure(tinytc_region &reg, bool spmd) -> std::int64_t;
+
+    inline auto dynamic_trip_count() const { return dynamic_trip_count_; }
+
+  private:
+    void count_inst(tinytc_inst &in, bool spmd, cost_counts &c);
+    auto trip_count(for_inst in) -> std::int64_t;
+    auto value_size(tinytc_value const &v, bool spmd) const -> std::int64_t;
+    auto lanes(bool spmd) const -> double { return spmd ? subgroup_size_ : 1; }
+
+    std::int32_t subgroup_size_;
+    bool dynamic_trip_count_ = false;
+};
+
+auto is_fp(tinytc_type_t ty) -> bool {
+    if (auto ct = dyn_cast<coopmatrix_type>(ty); ct) {
+        ty = ct->component_ty();
+    }
+    return isa<float_type>(*ty) || isa<complex_type>(*ty);
+}
+
+auto is_complex(tinytc_type_t ty) -> bool {
+    if (auto ct = dyn_cast<coopmatrix_type>(ty); ct) {
+        ty = ct->component_ty();
+    }
+    return isa<complex_type>(*ty);
+}
+
+void add_bytes(cost_counts &c, tinytc_value const &operand, double bytes) {
+    auto mt = dyn_cast<memref_type>(operand.ty());
+    if (mt && mt->addrspace() == address_space::local) {
+        c.local_bytes += bytes;
+    } else {
+        c.global_bytes += bytes;
+    }
+}
+
+auto cost_counter::count(tinytc_region &reg, bool spmd) -> cost_counts {
+    spmd = spmd || reg.kind() == region_kind::spmd;
+    auto c = cost_counts{};
+    for (auto &in : reg) {
+        if (auto f = dyn_cast<for_inst>(&in); f) {
+            auto body = count(f.body(), spmd);
+            body *= trip_count(f);
+            c += body;
+        } else if (auto i = dyn_cast<if_inst>(&in); i) {
+            c += max(count(i.then(), spmd), count(i.otherwise(), spmd));
+        } else if (auto a = dyn_cast<cooperative_matrix_apply_inst>(&in); a) {
+            // The body is executed once per matrix element
+            auto ct = get_coopmatrix_type(a.a());
+            auto const body_spmd = spmd || a.body().kind() == region_kind::spmd;
+            auto body = count(a.body(), spmd);
+            body *= ct->rows() * ct->cols() / lanes(body_spmd);
+            c += body;
+        } else {
+            count_inst(in, spmd, c);
+            for (auto &child : in.child_regions()) {
+                c += count(child, spmd);
+            }
+        }
+    }
+    return c;
+}
+
+void cost_counter::count_inst(tinytc_inst &in, bool spmd, cost_counts &c) {
+    auto const num_elements = [&](tinytc_value const &v) -> double {
+        if (auto ct = dyn_cast<coopmatrix_type>(v.ty()); ct) {
+            return ct->rows() * ct->cols();
+        }
+        return lanes(spmd);
+    };
+    auto const num_bytes = [&](tinytc_value const &v) -> double {
+        if (auto ct = dyn_cast<coopmatrix_type>(v.ty()); ct) {
+            return ct->rows() * ct->cols() * size(ct->component_ty());
+        }
+        if (isa<number_type>(*v.ty())) {
+            return lanes(spmd) * size(v.ty());
+        }
+        // Pointer, e.g. memref loaded from group
+        return lanes(spmd) * 8;
+    };
+
+    visit(overloaded{[&](arith_inst in) {
+                         if (is_fp(in.result().ty())) {
+                             double const flops_per_element =
+                                 !is_complex(in.result().ty()) ? 1.0
+                                 : isa<mul_inst>(in.get()) || isa<div_inst>(in.get()) ? 6.0
+                                                                                      : 2.0;
+                             c.flops += flops_per_element * num_elements(in.result());
+                         }
+                     },
+                     [&](math_unary_inst in) {
+                         if (is_fp(in.result().ty())) {
+                             c.flops += num_elements(in.result());
+                         }
+                     },
+                     [&](subgroup_operation_inst in) {
+                         if (is_fp(in.result().ty())) {
+                             c.flops += subgroup_size_;
+                         }
+                     },
+                     [&](cooperative_matrix_mul_add_inst in) {
+                         auto at = get_coopmatrix_type(in.a());
+                         auto bt = get_coopmatrix_type(in.b());
+                         double const flops_per_fma = is_complex(in.result().ty()) ? 8.0 : 2.0;
+                         c.flops += flops_per_fma * at->rows() * at->cols() * bt->cols();
+                     },
+                     [&](cooperative_matrix_scale_inst in) {
+                         c.flops += (is_complex(in.result().ty()) ? 6.0 : 1.0) *
+                                    num_elements(in.result());
+                     },
+                     [&](cooperative_matrix_reduce_inst in) {
+                         if (is_fp(in.result().ty())) {
+                             c.flops += num_elements(in.a());
+                         }
+                     },
+                     [&](cooperative_matrix_memory_read_inst in) {
+                         add_bytes(c, in.operand(), num_bytes(in.result()));
+                     },
+                     [&](cooperative_matrix_memory_write_inst in) {
+                         // Atomic updates read and write memory
+                         double const factor =
+                             isa<cooperative_matrix_atomic_update_inst>(in.get()) ? 2.0 : 1.0;
+                         add_bytes(c, in.operand(), factor * num_bytes(in.val()));
+                     },
+                     [&](memory_read_inst in) {
+                         add_bytes(c, in.operand(), num_bytes(in.result()));
+                     },
+                     [&](memory_write_inst in) {
+                         double const factor = isa<atomic_update_inst>(in.get()) ? 2.0 : 1.0;
+                         add_bytes(c, in.operand(), factor * num_bytes(in.val()));
+                     },
+                     [&](barrier_inst) { c.barriers += 1.0; }, [](inst_view) {}},
+          in);
+}
+
+auto cost_counter::trip_count(for_inst in) -> std::int64_t {
+    auto const to = get_int_constant(in.to());
+    auto const step = in.has_step() ? get_int_constant(in.step()) : std::optional<std::int64_t>{1};
+    if (!to || !step || *step <= 0) {
+        dynamic_trip_count_ = true;
+        return 1;
+    }
+    auto const from = get_int_constant(in.from()).value_or(0);
+    return std::max(std::int64_t{0}, (*to - from + *step - 1) / *step);
+}
+
+auto cost_counter::value_size(tinytc_value const &v, bool spmd) const -> std::int64_t {
+    auto ty = v.ty();
+    if (auto ct = dyn_cast<coopmatrix_type>(ty); ct) {
+        return ct->rows() * ct->cols() * size(ct->component_ty());
+    }
+    if (isa<number_type>(*ty)) {
+        // Scalar constants are encoded as immediates
+        if (v.defining_inst() && isa<constant_inst>(*v.defining_inst())) {
+            return 0;
+        }
+        return size(ty) * (spmd ? subgroup_size_ : 1);
+    }
+    if (isa<memref_type>(*ty) || isa<group_type>(*ty)) {
+        return 8;
+    }
+    return 0;
+}
+
+auto cost_counter::register_pressure(tinytc_region &reg, bool spmd) -> std::int64_t {
+    spmd = spmd || reg.kind() == region_kind::spmd;
+
+    // Live range [def, last use] of values defined in reg in terms of instruction positions;
+    // uses in nested regions count as uses by the instruction owning the nested region
+    struct live_range {
+        std::int64_t def;
+        std::int64_t last_use;
+    };
+    auto ranges = std::unordered_map<tinytc_value const *, live_range>{};
+    for (auto &p : reg.params()) {
+        ranges[&p] = {-1, -1};
+    }
+    std::int64_t pos = 0;
+    for (auto &in : reg) {
+        walk<walk_order::pre_order>(in, [&](tinytc_inst &nested) {
+            for (auto &op : nested.operands()) {
+                if (auto it = ranges.find(&op); it != ranges.end()) {
+                    it->second.last_use = pos;
+                }
+            }
+        });
+        for (auto &res : in.results()) {
+            ranges[&res] = {pos, pos};
+        }
+        ++pos;
+    }
+
+    // A value occupies registers from the instruction after its definition until its last use
+    auto delta = std::vector<std::int64_t>(pos + 1, 0);
+    for (auto const &[v, r] : ranges) {
+        if (r.last_use > r.def) {
+            auto const s = value_size(*v, spmd);
+            delta[r.def + 1] += s;
+            delta[r.last_use + 1] -= s;
+        }
+    }
+
+    std::int64_t pressure = 0;
+    std::int64_t live = 0;
+    pos = 0;
+    for (auto &in : reg) {
+        live += delta[pos++];
+        std::int64_t local = 0;
+        if (in.num_child_regions() > 0) {
+            for (auto &child : in.child_regions()) {
+                local = std::max(local, register_pressure(child, spmd));
+            }
+        } else {
+            for (auto &res : in.results()) {
+                local += value_size(res, spmd);
+            }
+        }
+        pressure = std::max(pressure, live + local);
+    }
+    return pressure;
+}
+
+} // namespace
+
+cost_analysis::cost_analysis(const_tinytc_core_info_t info) : info_(info) {}
+
+auto cost_analysis::run_on_function(tinytc_func &fn) -> function_cost {
+    auto const sgs = fn.subgroup_size();
+    auto const wgs = fn.work_group_size();
+    auto const num_subgroups = std::max(std::int64_t{1}, std::int64_t{wgs[0]} * wgs[1] / sgs);
+
+    auto counter = cost_counter{sgs};
+    auto c = counter.count(fn.body(), false);
+    auto const barriers = c.barriers;
+    c *= num_subgroups;
+
+    auto cost = function_cost{};
+    cost.subgroup_size = sgs;
+    cost.work_group_size[0] = wgs[0];
+    cost.work_group_size[1] = wgs[1];
+    cost.flops = static_cast<std::int64_t>(c.flops);
+    cost.global_bytes = static_cast<std::int64_t>(c.global_bytes);
+    cost.local_bytes = static_cast<std::int64_t>(c.local_bytes);
+    cost.arithmetic_intensity = c.global_bytes > 0.0 ? c.flops / c.global_bytes : 0.0;
+    cost.barriers = static_cast<std::int64_t>(barriers);
+    cost.slm_size = stack_high_water_mark{}.run_on_function(fn);
+    cost.register_pressure = counter.register_pressure(fn.body(), false);
+    cost.register_space = info_->get_core_config(sgs).register_space;
+    cost.dynamic_trip_count = counter.dynamic_trip_count();
+
+    // Occupancy is limited by the number of subgroup slots and by shared local memory
+    auto const max_subgroups = std::int64_t{info_->max_num_resident_subgroups(sgs)};
+    auto resident_work_groups = max_subgroups / num_subgroups;
+    auto const local_memory = info_->local_memory_size();
+    if (local_memory > 0 && cost.slm_size > 0) {
+        resident_work_groups = std::min(resident_work_groups, local_memory / cost.slm_size);
+    }
+    cost.occupancy = max_subgroups > 0 ? static_cast<double>(resident_work_groups * num_subgroups) /
+                                             max_subgroups
+                                       : 0.0;
+
+    return cost;
+}
+
+auto throughput_score(function_cost const &cost, const_tinytc_core_info_t info) -> double {
+    auto const resident_subgroups =
+        cost.occupancy * info->max_num_resident_subgroups(cost.subgroup_size);
+    auto const spill_factor =
+        std::max(1.0, static_cast<double>(cost.register_pressure) / cost.register_space);
+    return resident_subgroups / (spill_factor * spill_factor);
+}
+
+} // namespace tinytc
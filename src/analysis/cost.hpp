@@ -0,0 +1,57 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef COST_20251016_HPP
+#define COST_20251016_HPP
+
+#include "tinytc/types.h"
+#include "tinytc/types.hpp"
+
+#include <cstdint>
+
+namespace tinytc {
+
+/**
+ * @brief Static cost model of a function
+ *
+ * The analysis expects a function that went through the default optimization pipeline, i.e.
+ * all linalg and foreach instructions must be lowered and the work-group size must be set.
+ *
+ * FLOPs and bytes are counted per subgroup and multiplied by the number of subgroups in the
+ * work-group. The trip count of a for-loop is ceil((to - from) / step); a non-constant lower bound
+ * is treated as 0, as the lower bound typically is a subgroup offset. Loops with non-constant
+ * upper bound or step are counted once and dynamic_trip_count is set. For if-instructions, the
+ * more expensive branch is counted.
+ *
+ * The register pressure is the maximum size of the simultaneously live values, where live ranges
+ * are taken over structured control flow. A coopmatrix occupies rows * cols elements, a scalar in
+ * an SPMD region occupies one element per work-item, and a memref occupies one pointer. Scalar
+ * constants are assumed to be immediates and do not occupy registers.
+ */
+class cost_analysis {
+  public:
+    cost_analysis(const_tinytc_core_info_t info);
+
+    auto run_on_function(tinytc_func &fn) -> function_cost;
+
+  private:
+    const_tinytc_core_info_t info_;
+};
+
+/**
+ * @brief Estimate throughput of a function in the register file configuration of info
+ *
+ * The throughput is modelled as the number of resident subgroups per core, which is reduced by
+ * the square of the spill factor max(1, register_pressure / register_space) as spilled values
+ * cause additional memory traffic in the innermost loops.
+ *
+ * @param cost Cost estimate of the function lowered for info
+ * @param info Core info
+ *
+ * @return Throughput in arbitrary units; higher is better
+ */
+auto throughput_score(function_cost const &cost, const_tinytc_core_info_t info) -> double;
+
+} // namespace tinytc
+
+#endif // COST_20251016_HPP
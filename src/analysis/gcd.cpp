@@ -122,6 +122,18 @@ void gcd_helper::operator()(arith_inst in) {
             }
             return ga % gb == 0 ? ga / gb : 1;
         }
+        case IK::IK_shl:
+        case IK::IK_shr: {
+            auto const k = get_int_constant(in.b());
+            if (!k || *k < 0 || *k >= 62) {
+                return 1;
+            }
+            auto const p = std::int64_t{1} << *k;
+            if (in.get().type_id() == IK::IK_shl) {
+                return ga * p;
+            }
+            return ga % p == 0 ? ga / p : 1;
+        }
         default:
             break;
         }
@@ -204,6 +216,22 @@ void gcd_helper::operator()(for_inst in) {
         auto g = std::gcd(gcd_.get(in.from()), gcd_.get(in.step()));
         gcd_.set(in.loop_var(), g);
     }
+    // Induction variables j_{n+1} = j_n + c are divisible by gcd(j_0, c) if c is loop-invariant.
+    // Values defined inside the loop are not analysed yet, so only loop-invariant c has a gcd.
+    if (in.get().num_results() > 0) {
+        auto y = get_yield(in.loc(), in.body());
+        auto init = in.iter_init().begin();
+        for (std::int64_t i = 0; i < in.get().num_results(); ++i, ++init) {
+            auto &iter_arg = in.iter_arg(i);
+            if (auto add = dyn_cast<add_inst>(y.get().op(i).defining_inst()); add) {
+                auto c = &add.a() == &iter_arg ? &add.b() : &add.a();
+                auto gc = gcd_.get_if(c);
+                if ((&add.a() == &iter_arg || &add.b() == &iter_arg) && gc) {
+                    gcd_.set(iter_arg, std::gcd(gcd_.get(*init), *gc));
+                }
+            }
+        }
+    }
 }
 void gcd_helper::operator()(fuse_inst in) {
     if (auto mi = gcd_.get_memref_if(in.operand()); mi) {
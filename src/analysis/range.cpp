@@ -0,0 +1,418 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "analysis/range.hpp"
+#include "node/attr.hpp"
+#include "node/func.hpp"
+#include "node/inst.hpp"
+#include "node/inst_view.hpp"
+#include "node/type.hpp"
+#include "node/value.hpp"
+#include "node/visit.hpp"
+#include "number.hpp"
+#include "support/walk.hpp"
+#include "tinytc/types.hpp"
+#include "util/casting.hpp"
+#include "util/iterator.hpp"
+#include "util/overloaded.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+#include <variant>
+
+namespace tinytc {
+
+namespace {
+
+constexpr auto int64_min = std::numeric_limits<std::int64_t>::min();
+constexpr auto int64_max = std::numeric_limits<std::int64_t>::max();
+
+//! Level Zero and OpenCL launch at most 2^32 - 1 groups per mode
+constexpr std::int64_t max_num_groups = (std::int64_t{1} << 32) - 1;
+//! Number of bytes a memref may span if small buffers are assumed
+constexpr std::int64_t max_small_buffer_size = (std::int64_t{1} << 31) - 1;
+
+using opt_range = std::optional<value_range>;
+
+auto checked_add(std::int64_t a, std::int64_t b) -> std::optional<std::int64_t> {
+    if ((b > 0 && a > int64_max - b) || (b < 0 && a < int64_min - b)) {
+        return std::nullopt;
+    }
+    return a + b;
+}
+auto checked_sub(std::int64_t a, std::int64_t b) -> std::optional<std::int64_t> {
+    if ((b < 0 && a > int64_max + b) || (b > 0 && a < int64_min + b)) {
+        return std::nullopt;
+    }
+    return a - b;
+}
+auto checked_mul(std::int64_t a, std::int64_t b) -> std::optional<std::int64_t> {
+    if (a > 0) {
+        if ((b > 0 && a > int64_max / b) || (b <= 0 && b < int64_min / a)) {
+            return std::nullopt;
+        }
+    } else if ((b > 0 && a < int64_min / b) || (b <= 0 && a != 0 && b < int64_max / a)) {
+        return std::nullopt;
+    }
+    return a * b;
+}
+
+//! Smallest interval containing all values
+auto hull(std::initializer_list<std::optional<std::int64_t>> values) -> opt_range {
+    auto r = value_range{int64_max, int64_min};
+    for (auto const &v : values) {
+        if (!v) {
+            return std::nullopt;
+        }
+        r.lo = std::min(r.lo, *v);
+        r.hi = std::max(r.hi, *v);
+    }
+    return r;
+}
+
+auto add(value_range const &a, value_range const &b) -> opt_range {
+    return hull({checked_add(a.lo, b.lo), checked_add(a.hi, b.hi)});
+}
+auto sub(value_range const &a, value_range const &b) -> opt_range {
+    return hull({checked_sub(a.lo, b.hi), checked_sub(a.hi, b.lo)});
+}
+auto mul(value_range const &a, value_range const &b) -> opt_range {
+    return hull({checked_mul(a.lo, b.lo), checked_mul(a.lo, b.hi), checked_mul(a.hi, b.lo),
+                 checked_mul(a.hi, b.hi)});
+}
+auto div(value_range const &a, value_range const &b) -> opt_range {
+    // Truncating division is monotone in both operands if the divisor does not change sign
+    if (b.lo <= 0 && b.hi >= 0) {
+        return std::nullopt;
+    }
+    auto const checked_div = [](std::int64_t x, std::int64_t y) -> std::optional<std::int64_t> {
+        if (x == int64_min && y == -1) {
+            return std::nullopt;
+        }
+        return x / y;
+    };
+    return hull({checked_div(a.lo, b.lo), checked_div(a.lo, b.hi), checked_div(a.hi, b.lo),
+                 checked_div(a.hi, b.hi)});
+}
+auto rem(value_range const &a, value_range const &b) -> opt_range {
+    // The remainder has the sign of the dividend and is smaller than the divisor in magnitude
+    if (b.lo == int64_min) {
+        return std::nullopt;
+    }
+    auto const m = std::max(std::abs(b.lo), std::abs(b.hi)) - 1;
+    if (m < 0) {
+        return std::nullopt;
+    }
+    if (a.lo >= 0) {
+        return value_range{0, std::min(a.hi, m)};
+    }
+    if (a.hi <= 0) {
+        return value_range{std::max(a.lo, -m), 0};
+    }
+    return value_range{-m, m};
+}
+auto shl(value_range const &a, value_range const &b, std::size_t bits) -> opt_range {
+    if (b.lo != b.hi || b.lo < 0 || b.lo >= static_cast<std::int64_t>(bits) || b.lo >= 62) {
+        return std::nullopt;
+    }
+    auto const p = std::int64_t{1} << b.lo;
+    return mul(a, value_range{p, p});
+}
+auto shr(value_range const &a, value_range const &b, std::size_t bits) -> opt_range {
+    if (b.lo < 0 || b.hi >= static_cast<std::int64_t>(bits)) {
+        return std::nullopt;
+    }
+    return hull({a.lo >> b.lo, a.lo >> b.hi, a.hi >> b.lo, a.hi >> b.hi});
+}
+auto bitwise_and(value_range const &a, value_range const &b) -> opt_range {
+    if (a.lo >= 0 && b.lo >= 0) {
+        return value_range{0, std::min(a.hi, b.hi)};
+    }
+    if (a.lo >= 0) {
+        return value_range{0, a.hi};
+    }
+    if (b.lo >= 0) {
+        return value_range{0, b.hi};
+    }
+    return std::nullopt;
+}
+auto bitwise_or(value_range const &a, value_range const &b) -> opt_range {
+    if (a.lo < 0 || b.lo < 0) {
+        return std::nullopt;
+    }
+    // Bitwise or and xor cannot set bits above the highest bit of the operands
+    auto hi = std::max(a.hi, b.hi);
+    std::int64_t mask = 0;
+    while (mask < hi) {
+        mask = 2 * mask + 1;
+    }
+    return value_range{0, mask};
+}
+
+class range_helper {
+  public:
+    range_helper(tinytc_func &fn, bool assume_small_buffers);
+
+    void operator()(inst_view in);
+    void operator()(arith_inst in);
+    void operator()(arith_unary_inst in);
+    void operator()(cast_inst in);
+    void operator()(constant_inst in);
+    void operator()(for_inst in);
+    void operator()(foreach_inst in);
+    void operator()(group_id_inst in);
+    void operator()(num_groups_inst in);
+    void operator()(num_subgroups_inst in);
+    void operator()(size_inst in);
+    void operator()(subgroup_broadcast_inst in);
+    void operator()(subgroup_id_inst in);
+    void operator()(subgroup_linear_id_inst in);
+    void operator()(subgroup_local_id_inst in);
+    void operator()(subgroup_size_inst in);
+
+    auto get_result() && { return std::move(range_); }
+
+  private:
+    void set(tinytc_value const &v, opt_range r);
+    void set_loop_var(tinytc_value const &v, value_range const &from, value_range const &to);
+
+    bool assume_small_buffers_;
+    std::optional<std::int32_t> subgroup_size_;
+    std::optional<std::array<std::int32_t, 2u>> work_group_size_;
+    range_analysis_result range_;
+};
+
+range_helper::range_helper(tinytc_func &fn, bool assume_small_buffers)
+    : assume_small_buffers_{assume_small_buffers} {
+    if (get_attr(fn.attr(), "subgroup_size")) {
+        subgroup_size_ = fn.subgroup_size();
+    }
+    if (get_attr(fn.attr(), "work_group_size")) {
+        work_group_size_ = fn.work_group_size();
+    }
+}
+
+void range_helper::set(tinytc_value const &v, opt_range r) {
+    if (!isa<integer_type>(*v.ty())) {
+        return;
+    }
+    auto const type_range = value_range::of_type(v.ty());
+    range_.set(v, r && type_range.contains(*r) ? *r : type_range);
+}
+
+void range_helper::set_loop_var(tinytc_value const &v, value_range const &from,
+                                value_range const &to) {
+    // The loop variable lies in [from, to) whenever the loop body is executed
+    set(v, value_range{from.lo, to.hi > from.lo ? to.hi - 1 : from.lo});
+}
+
+void range_helper::operator()(inst_view) {}
+void range_helper::operator()(arith_inst in) {
+    auto ty = in.result().ty();
+    if (!isa<integer_type>(*ty)) {
+        return;
+    }
+    auto const a = range_.get(in.a());
+    auto const b = range_.get(in.b());
+    auto const bits = size(ty) * 8;
+    auto const r = [&]() -> opt_range {
+        switch (in.get().type_id()) {
+        case IK::IK_add:
+            return add(a, b);
+        case IK::IK_sub:
+            return sub(a, b);
+        case IK::IK_mul:
+            return mul(a, b);
+        case IK::IK_div:
+            return div(a, b);
+        case IK::IK_rem:
+            return rem(a, b);
+        case IK::IK_max:
+            return value_range{std::max(a.lo, b.lo), std::max(a.hi, b.hi)};
+        case IK::IK_min:
+            return value_range{std::min(a.lo, b.lo), std::min(a.hi, b.hi)};
+        case IK::IK_shl:
+            return shl(a, b, bits);
+        case IK::IK_shr:
+            return shr(a, b, bits);
+        case IK::IK_and:
+            return bitwise_and(a, b);
+        case IK::IK_or:
+        case IK::IK_xor:
+            return bitwise_or(a, b);
+        default:
+            break;
+        }
+        return std::nullopt;
+    }();
+    set(in.result(), r);
+}
+void range_helper::operator()(arith_unary_inst in) {
+    auto ty = in.result().ty();
+    if (!isa<integer_type>(*ty)) {
+        return;
+    }
+    auto const a = range_.get(in.a());
+    auto const r = [&]() -> opt_range {
+        switch (in.get().type_id()) {
+        case IK::IK_neg:
+            return sub(value_range{0, 0}, a);
+        case IK::IK_not:
+            return value_range{~a.hi, ~a.lo};
+        case IK::IK_abs:
+            if (a.lo >= 0) {
+                return a;
+            }
+            if (a.lo == int64_min) {
+                return std::nullopt;
+            }
+            return a.hi <= 0 ? value_range{-a.hi, -a.lo}
+                             : value_range{0, std::max(-a.lo, a.hi)};
+        default:
+            break;
+        }
+        return std::nullopt;
+    }();
+    set(in.result(), r);
+}
+void range_helper::operator()(cast_inst in) {
+    if (isa<integer_type>(*in.a().ty())) {
+        set(in.result(), range_.get(in.a()));
+    }
+}
+void range_helper::operator()(constant_inst in) {
+    auto const value = in.value();
+    if (auto v = std::get_if<std::int64_t>(&value); v) {
+        set(in.result(), value_range{*v, *v});
+    }
+}
+void range_helper::operator()(for_inst in) {
+    if (isa<integer_type>(*in.loop_var().ty())) {
+        auto const positive_step = !in.has_step() || range_.get(in.step()).lo > 0;
+        if (positive_step) {
+            set_loop_var(in.loop_var(), range_.get(in.from()), range_.get(in.to()));
+        }
+    }
+}
+void range_helper::operator()(foreach_inst in) {
+    auto from = in.from().begin();
+    auto to = in.to().begin();
+    for (auto &loop_var : in.loop_vars()) {
+        set_loop_var(loop_var, range_.get(*from++), range_.get(*to++));
+    }
+}
+void range_helper::operator()(group_id_inst in) {
+    set(in.result(), value_range{0, max_num_groups - 1});
+}
+void range_helper::operator()(num_groups_inst in) {
+    set(in.result(), value_range{1, max_num_groups});
+}
+void range_helper::operator()(num_subgroups_inst in) {
+    if (subgroup_size_ && work_group_size_) {
+        auto const n = std::array<std::int64_t, 3u>{(*work_group_size_)[0] / *subgroup_size_,
+                                                    (*work_group_size_)[1], 1};
+        auto const n_mode = n[static_cast<std::size_t>(in.mode())];
+        set(in.result(), value_range{n_mode, n_mode});
+    } else {
+        set(in.result(), value_range{1, std::numeric_limits<std::int32_t>::max()});
+    }
+}
+void range_helper::operator()(size_inst in) {
+    auto const r =
+        visit(overloaded{[&](group_type &g) -> value_range {
+                             return !is_dynamic_value(g.size()) ? value_range{g.size(), g.size()}
+                                                                : value_range{0, int64_max};
+                         },
+                         [&](memref_type &m) -> value_range {
+                             auto const s_i = m.shape(in.mode());
+                             if (!is_dynamic_value(s_i)) {
+                                 return value_range{s_i, s_i};
+                             }
+                             if (assume_small_buffers_) {
+                                 auto const element_size =
+                                     static_cast<std::int64_t>(size(m.element_ty()));
+                                 return value_range{0, max_small_buffer_size / element_size};
+                             }
+                             return value_range{0, int64_max};
+                         },
+                         [&](tinytc_type &) -> value_range { return value_range{0, int64_max}; }},
+              *in.operand().ty());
+    set(in.result(), r);
+}
+void range_helper::operator()(subgroup_broadcast_inst in) {
+    if (auto r = range_.get_if(in.a()); r) {
+        set(in.result(), *r);
+    }
+}
+void range_helper::operator()(subgroup_id_inst in) {
+    if (subgroup_size_ && work_group_size_) {
+        auto const n = std::array<std::int64_t, 3u>{(*work_group_size_)[0] / *subgroup_size_,
+                                                    (*work_group_size_)[1], 1};
+        set(in.result(), value_range{0, n[static_cast<std::size_t>(in.mode())] - 1});
+    } else {
+        set(in.result(), value_range{0, std::numeric_limits<std::int32_t>::max()});
+    }
+}
+void range_helper::operator()(subgroup_linear_id_inst in) {
+    if (subgroup_size_ && work_group_size_) {
+        auto const n = (*work_group_size_)[0] / *subgroup_size_ * (*work_group_size_)[1];
+        set(in.result(), value_range{0, n - 1});
+    } else {
+        set(in.result(), value_range{0, std::numeric_limits<std::int32_t>::max()});
+    }
+}
+void range_helper::operator()(subgroup_local_id_inst in) {
+    set(in.result(), value_range{0, subgroup_size_ ? *subgroup_size_ - 1
+                                                   : std::numeric_limits<std::int32_t>::max()});
+}
+void range_helper::operator()(subgroup_size_inst in) {
+    if (subgroup_size_) {
+        set(in.result(), value_range{*subgroup_size_, *subgroup_size_});
+    } else {
+        set(in.result(), value_range{1, std::numeric_limits<std::int32_t>::max()});
+    }
+}
+
+} // namespace
+
+auto value_range::of_type(tinytc_type_t ty) -> value_range {
+    auto const bits = size(ty) * 8;
+    if (bits >= 64) {
+        return value_range{int64_min, int64_max};
+    }
+    auto const p = std::int64_t{1} << (bits - 1);
+    return value_range{-p, p - 1};
+}
+
+auto range_analysis_result::get(::tinytc_value const &a) const -> value_range {
+    if (auto r = get_if(a); r) {
+        return *r;
+    }
+    return isa<integer_type>(*a.ty()) ? value_range::of_type(a.ty())
+                                      : value_range{int64_min, int64_max};
+}
+auto range_analysis_result::get_if(::tinytc_value const &a) const -> std::optional<value_range> {
+    if (auto it = range_.find(&a); it != range_.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+void range_analysis_result::set(::tinytc_value const &a, value_range r) { range_[&a] = r; }
+
+auto range_analysis_result::fits(::tinytc_value const &a, tinytc_type_t ty) const -> bool {
+    return value_range::of_type(ty).contains(get(a));
+}
+
+auto range_analysis::run_on_function(tinytc_func &fn) -> range_analysis_result {
+    auto visitor = range_helper{fn, assume_small_buffers_};
+
+    walk<walk_order::pre_order>(fn, [&visitor](tinytc_inst &i) { visit(visitor, i); });
+
+    return std::move(visitor).get_result();
+}
+
+} // namespace tinytc
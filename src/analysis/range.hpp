@@ -0,0 +1,71 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef RANGE_20251016_HPP
+#define RANGE_20251016_HPP
+
+#include "tinytc/types.h"
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+
+namespace tinytc {
+
+//! Closed interval [lo, hi] of integer values
+struct value_range {
+    std::int64_t lo;
+    std::int64_t hi;
+
+    //! Range of all values of integer type ty
+    static auto of_type(tinytc_type_t ty) -> value_range;
+
+    inline auto contains(value_range const &other) const -> bool {
+        return lo <= other.lo && other.hi <= hi;
+    }
+};
+
+class range_analysis_result {
+  public:
+    //! Returns the range of a or the range of the type of a if nothing is known about a
+    auto get(::tinytc_value const &a) const -> value_range;
+    auto get_if(::tinytc_value const &a) const -> std::optional<value_range>;
+    void set(::tinytc_value const &a, value_range r);
+
+    //! Checks whether the values of a are representable in type ty
+    auto fits(::tinytc_value const &a, tinytc_type_t ty) const -> bool;
+
+  private:
+    std::unordered_map<::tinytc_value const *, value_range> range_;
+};
+
+/**
+ * @brief Infer lower and upper bounds of scalar integer values
+ *
+ * Ranges are seeded from
+ *
+ * - constants,
+ * - static memref shapes and the size of dynamic modes, which is bounded by 2^31 bytes if
+ *   assume_small_buffers is set and by the index range otherwise,
+ * - group_id and num_groups, which are bounded by the 32-bit group count of the runtimes,
+ * - the subgroup builtins, which are bounded by the work-group size and subgroup size
+ *   attributes,
+ *
+ * and propagated through integer arithmetic, integer casts, and the loop variables of for- and
+ * foreach-loops. A result whose interval exceeds the range of its type may wrap around and gets
+ * the range of its type. Loop-carried values are not analysed.
+ */
+class range_analysis {
+  public:
+    inline range_analysis(bool assume_small_buffers)
+        : assume_small_buffers_(assume_small_buffers) {}
+
+    auto run_on_function(tinytc_func &fn) -> range_analysis_result;
+
+  private:
+    bool assume_small_buffers_;
+};
+
+} // namespace tinytc
+
+#endif // RANGE_20251016_HPP
@@ -0,0 +1,395 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "autotune.hpp"
+#include "compiler_context.hpp"
+#include "device_info.hpp"
+#include "error.hpp"
+#include "gemm_tools.hpp"
+#include "matrix_ext_info.hpp"
+#include "node/type.hpp"
+#include "number.hpp"
+#include "tinytc/core.h"
+#include "tinytc/types.h"
+#include "util/casting.hpp"
+#include "util/fnv1a.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace tinytc {
+
+namespace {
+
+constexpr char header_prefix[] = "# tinytc tuning database";
+
+auto ceil_div(std::int64_t a, std::int64_t b) -> std::int64_t { return 1 + (a - 1) / b; }
+
+auto device_key(tinytc_core_info const &info) -> std::string {
+    return (std::ostringstream{} << std::hex << std::setfill('0') << std::setw(16)
+                                 << fnv1a_combine(std::string_view{info.fingerprint()}))
+        .str();
+}
+
+auto entry_key(tinytc_core_info const &info, blas_shape const &shape) -> std::string {
+    auto oss = std::ostringstream{};
+    oss << device_key(info) << ' ' << (shape.is_gemm ? "gemm" : "blas") << ' '
+        << to_string(shape.op1_ty->type_id()) << ' ' << to_string(shape.op2_ty->type_id()) << ' '
+        << to_string(shape.dst_ty->type_id()) << ' ' << shape.shape[0] << ' ' << shape.shape[1];
+    return std::move(oss).str();
+}
+
+auto problem_shape(gemm_tuning_problem const &problem) -> blas_shape {
+    return blas_shape{problem.A_ty, problem.B_ty, problem.C_ty, {problem.M, problem.N}, true};
+}
+
+//! Checks the parts of a configuration that do not depend on the device or problem
+auto is_valid_config(tuning_config const &cfg) -> bool {
+    return cfg.subgroup_size > 0 && cfg.m_tiles > 0 && cfg.n_tiles > 0 && cfg.max_rows > 0 &&
+           cfg.max_rows % cfg.subgroup_size == 0 && cfg.max_cols > 0 && cfg.k_block_size > 0;
+}
+
+void check_problem(gemm_tuning_problem const &problem) {
+    if (problem.info == nullptr || problem.A_ty == nullptr || problem.B_ty == nullptr ||
+        problem.C_ty == nullptr || problem.M <= 0 || problem.N <= 0 || problem.K <= 0) {
+        throw status::invalid_arguments;
+    }
+    for (auto ty : {problem.A_ty, problem.B_ty, problem.C_ty}) {
+        if (!isa<number_type>(*ty)) {
+            throw status::ir_expected_number;
+        }
+    }
+}
+
+//! Parse "<device> <kind> <A> <B> <C> <M> <N>" into key followed by the configuration
+auto parse_entry(std::string const &line, std::string &key, tuning_config &cfg) -> bool {
+    constexpr int key_fields = 7;
+    auto iss = std::istringstream{line};
+    auto oss = std::ostringstream{};
+    auto token = std::string{};
+    for (int i = 0; i < key_fields; ++i) {
+        if (!(iss >> token)) {
+            return false;
+        }
+        oss << (i > 0 ? " " : "") << token;
+    }
+    if (!(iss >> cfg.subgroup_size >> cfg.m_tiles >> cfg.n_tiles >> cfg.max_rows >>
+          cfg.max_cols >> cfg.k_block_size) ||
+        !is_valid_config(cfg)) {
+        return false;
+    }
+    key = std::move(oss).str();
+    return true;
+}
+
+void load_entries(std::string const &path, std::map<std::string, tuning_config> &entries) {
+    auto f = std::ifstream(path);
+    auto line = std::string{};
+    if (!f || !std::getline(f, line) ||
+        line != (std::ostringstream{} << header_prefix << ' ' << tuning_database::version).str()) {
+        return;
+    }
+    auto key = std::string{};
+    auto cfg = tuning_config{};
+    while (std::getline(f, line)) {
+        if (!line.empty() && line[0] != '#' && parse_entry(line, key, cfg)) {
+            entries[key] = cfg;
+        }
+    }
+}
+
+} // namespace
+
+tuning_database::tuning_database(std::string path) : path_(std::move(path)) {
+    if (!path_.empty()) {
+        load_entries(path_, entries_);
+    }
+}
+
+auto tuning_database::from_environment() -> std::unique_ptr<tuning_database> {
+    char const *path = std::getenv(file_env_var);
+    if (path == nullptr || *path == '\0') {
+        return nullptr;
+    }
+    return std::make_unique<tuning_database>(path);
+}
+
+auto tuning_database::lookup(tinytc_core_info const &info, blas_shape const &shape) const
+    -> std::optional<tuning_config> {
+    auto const key = entry_key(info, shape);
+    auto lock = std::lock_guard{mutex_};
+    if (auto it = provisional_.find(key); it != provisional_.end()) {
+        return it->second;
+    }
+    if (auto it = entries_.find(key); it != entries_.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+void tuning_database::store(tinytc_core_info const &info, blas_shape const &shape,
+                            tuning_config const &cfg) {
+    auto const key = entry_key(info, shape);
+    auto lock = std::lock_guard{mutex_};
+    entries_[key] = cfg;
+    save();
+}
+
+void tuning_database::provisional(tinytc_core_info const &info, blas_shape const &shape,
+                                  std::optional<tuning_config> const &cfg) {
+    auto const key = entry_key(info, shape);
+    auto lock = std::lock_guard{mutex_};
+    if (cfg) {
+        provisional_[key] = *cfg;
+    } else {
+        provisional_.erase(key);
+    }
+}
+
+auto tuning_database::entries_key(tinytc_core_info const &info) const -> std::string {
+    auto const dev = device_key(info);
+    auto oss = std::ostringstream{};
+    auto lock = std::lock_guard{mutex_};
+    auto const dump = [&](std::map<std::string, tuning_config> const &entries) {
+        for (auto it = entries.lower_bound(dev); it != entries.end(); ++it) {
+            if (it->first.compare(0, dev.size(), dev) != 0) {
+                break;
+            }
+            auto const &cfg = it->second;
+            oss << it->first << ' ' << cfg.subgroup_size << ' ' << cfg.m_tiles << ' '
+                << cfg.n_tiles << ' ' << cfg.max_rows << ' ' << cfg.max_cols << ' '
+                << cfg.k_block_size << std::endl;
+        }
+    };
+    dump(provisional_);
+    oss << std::endl;
+    dump(entries_);
+    return std::move(oss).str();
+}
+
+void tuning_database::save() const {
+    if (path_.empty()) {
+        return;
+    }
+
+    // Merge with entries that other processes might have added in the meantime
+    auto merged = std::map<std::string, tuning_config>{};
+    load_entries(path_, merged);
+    for (auto const &[key, cfg] : entries_) {
+        merged[key] = cfg;
+    }
+
+    auto rd = std::random_device{};
+    auto const tmp = (std::ostringstream{} << path_ << '.' << std::hex << rd() << rd() << ".tmp")
+                         .str();
+    {
+        auto f = std::ofstream(tmp, std::ios::trunc);
+        f << header_prefix << ' ' << version << std::endl;
+        f << "# device kind A B C M N subgroup_size m_tiles n_tiles max_rows max_cols "
+             "k_block_size"
+          << std::endl;
+        for (auto const &[key, cfg] : merged) {
+            f << key << ' ' << cfg.subgroup_size << ' ' << cfg.m_tiles << ' ' << cfg.n_tiles << ' '
+              << cfg.max_rows << ' ' << cfg.max_cols << ' ' << cfg.k_block_size << std::endl;
+        }
+        f.close();
+        if (f.fail()) {
+            auto ec = std::error_code{};
+            fs::remove(tmp, ec);
+            throw status::file_io_error;
+        }
+    }
+    auto ec = std::error_code{};
+    fs::rename(tmp, path_, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+        throw status::file_io_error;
+    }
+}
+
+auto enumerate_gemm_configs(gemm_tuning_problem const &problem) -> std::vector<tuning_config> {
+    check_problem(problem);
+    auto const &info = *problem.info;
+
+    auto subgroup_sizes = std::vector<std::int32_t>{};
+    if (info.matrix().have_precision(problem.A_ty->type_id(), problem.B_ty->type_id(),
+                                     problem.C_ty->type_id())) {
+        subgroup_sizes.push_back(info.matrix().required_subgroup_size());
+    } else {
+        subgroup_sizes.insert(subgroup_sizes.end(), info.subgroup_sizes().begin(),
+                              info.subgroup_sizes().end());
+    }
+
+    auto const A_size = size(problem.A_ty);
+    auto const B_size = size(problem.B_ty);
+    auto const C_size = size(acc_type(problem.C_ty));
+    auto const C_blocks = isa<complex_type>(*problem.C_ty) ? 2 : 1;
+    constexpr auto fill_fractions =
+        std::array<std::pair<std::int32_t, std::int32_t>, 3u>{{{1, 8}, {1, 4}, {1, 2}}};
+
+    auto configs = std::vector<tuning_config>{};
+    for (auto const sgs : subgroup_sizes) {
+        auto const core_cfg = info.get_core_config(sgs);
+        auto const max_threads = core_cfg.max_work_group_size / sgs;
+
+        auto register_blocks = std::set<std::pair<std::int32_t, std::int32_t>>{};
+        for (auto const &fraction : fill_fractions) {
+            register_blocks.insert(max_register_block_gemm(
+                A_size, B_size, C_size, sgs, core_cfg.register_space, C_blocks, fraction));
+        }
+
+        auto const m_limit = std::min<std::int64_t>(ceil_div(problem.M, sgs), max_threads);
+        for (std::int32_t m = 1; m <= m_limit; m *= 2) {
+            auto const n_limit = std::min<std::int64_t>(problem.N, max_threads / m);
+            for (std::int32_t n = 1; n <= n_limit; n *= 2) {
+                for (auto const &[rows, cols] : register_blocks) {
+                    for (auto const kb : standard_K_block_sizes) {
+                        if (kb == 1 || kb <= problem.K) {
+                            configs.emplace_back(tuning_config{sgs, m, n, rows, cols, kb});
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return configs;
+}
+
+auto gemm_cost_model(gemm_tuning_problem const &problem, tuning_config const &cfg) -> double {
+    // Cycles are counted per lane
+    constexpr double bytes_per_load = 4.0;
+    constexpr double loop_overhead = 8.0;
+    constexpr double spill_penalty = 4.0;
+
+    check_problem(problem);
+    auto const sgs = cfg.subgroup_size;
+    if (!is_valid_config(cfg)) {
+        throw status::invalid_arguments;
+    }
+    auto core_cfg = core_config{};
+    try {
+        core_cfg = problem.info->get_core_config(sgs);
+    } catch (std::out_of_range const &) {
+        throw status::invalid_arguments;
+    }
+    auto const num_tiles = cfg.m_tiles * cfg.n_tiles;
+    if (num_tiles * sgs > core_cfg.max_work_group_size) {
+        throw status::invalid_arguments;
+    }
+
+    auto const A_size = static_cast<double>(size(problem.A_ty));
+    auto const B_size = static_cast<double>(size(problem.B_ty));
+    auto const C_size = static_cast<double>(size(acc_type(problem.C_ty)));
+    auto const C_blocks = isa<complex_type>(*problem.C_ty) ? 2 : 1;
+
+    // Register block as chosen by lower_linalg
+    auto const rows =
+        sgs * choose_block_size_multiple(sgs, cfg.max_rows, cfg.m_tiles, problem.M);
+    auto const cols = std::min<std::int64_t>(cfg.max_cols, ceil_div(problem.N, cfg.n_tiles));
+    auto const rounds = ceil_div(ceil_div(problem.M, rows), cfg.m_tiles) *
+                        ceil_div(ceil_div(problem.N, cols), cfg.n_tiles);
+
+    auto K_block_sizes = std::vector<std::int32_t>{};
+    for (auto const kb : standard_K_block_sizes) {
+        if (kb == 1 || kb <= cfg.k_block_size) {
+            K_block_sizes.push_back(kb);
+        }
+    }
+    auto const kb = choose_k_block_size(K_block_sizes, problem.K);
+    auto const k_iterations = problem.K / kb + problem.K % kb;
+
+    auto const K = static_cast<double>(problem.K);
+    auto const fma = static_cast<double>(rows * cols * C_blocks) * K;
+    auto const load = (rows * A_size + cols * B_size) * K / bytes_per_load;
+    auto const loop = k_iterations * sgs * loop_overhead;
+    auto const store = rows * cols * C_blocks * C_size / bytes_per_load;
+    auto cost = fma + load + loop + store;
+
+    auto const footprint =
+        rows * (cols * C_blocks * C_size + kb * A_size) + cols * kb * B_size;
+    if (footprint > core_cfg.register_space) {
+        cost *= spill_penalty;
+    }
+
+    // Idle subgroups count as busy, hence padding and load imbalance increase the cost
+    return num_tiles * rounds * cost;
+}
+
+auto tune_gemm(gemm_tuning_problem const &problem, tinytc_tuning_measure_t measure,
+               void *user_data) -> tuning_config {
+    if (measure == nullptr) {
+        throw status::invalid_arguments;
+    }
+    auto const candidates = enumerate_gemm_configs(problem);
+
+    auto db = problem.A_ty->context()->tuning_db_or_create();
+    auto const shape = problem_shape(problem);
+    auto const &info = *problem.info;
+
+    struct provisional_guard {
+        ~provisional_guard() { db->provisional(info, shape, std::nullopt); }
+        tuning_database *db;
+        tinytc_core_info const &info;
+        blas_shape const &shape;
+    } guard{db.get(), info, shape};
+
+    auto best = tuning_config{};
+    auto best_cost = std::numeric_limits<double>::infinity();
+    for (auto const &candidate : candidates) {
+        db->provisional(info, shape, candidate);
+        double cost = 0.0;
+        if (auto s = measure(&problem, &candidate, &cost, user_data); s != tinytc_status_success) {
+            throw status{std::underlying_type_t<status>(s)};
+        }
+        if (std::isfinite(cost) && cost < best_cost) {
+            best = candidate;
+            best_cost = cost;
+        }
+    }
+    if (!std::isfinite(best_cost)) {
+        throw status::runtime_error;
+    }
+
+    db->store(info, shape, best);
+    return best;
+}
+
+} // namespace tinytc
+
+using namespace tinytc;
+
+extern "C" {
+
+tinytc_status_t tinytc_autotune_gemm(tinytc_tuning_config_t *best,
+                                     const tinytc_gemm_tuning_problem_t *problem,
+                                     tinytc_tuning_measure_t measure, void *user_data) {
+    if (best == nullptr || problem == nullptr || problem->A_ty == nullptr || measure == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code(
+        [&] { *best = tune_gemm(*problem, measure, user_data); }, problem->A_ty->context());
+}
+
+tinytc_status_t tinytc_estimate_gemm_cost(const tinytc_gemm_tuning_problem_t *problem,
+                                          const tinytc_tuning_config_t *config, double *cost,
+                                          void *) {
+    if (problem == nullptr || config == nullptr || cost == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code([&] { *cost = gemm_cost_model(*problem, *config); });
+}
+}
@@ -0,0 +1,148 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef AUTOTUNE_20251016_HPP
+#define AUTOTUNE_20251016_HPP
+
+#include "tiling.hpp"
+#include "tinytc/types.h"
+#include "tinytc/types.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace tinytc {
+
+/**
+ * @brief Persistent database of tuned GEMM configurations
+ *
+ * Entries are keyed by the device (a hash of the core info fingerprint) and the blas_shape.
+ * The database is a text file with one entry per line; lines that cannot be parsed are ignored.
+ * The file is rewritten via a temporary file and a rename whenever an entry is stored, hence
+ * readers never see a partially written database.
+ *
+ * Besides the persistent entries, the database holds provisional entries that take precedence
+ * during lookup. The autotuner installs the candidate under evaluation as provisional entry such
+ * that kernels compiled by the measurement callback use the candidate.
+ *
+ * All member functions are thread-safe.
+ */
+class tuning_database {
+  public:
+    //! Environment variable that enables the tuning database and sets the file name
+    constexpr static char file_env_var[] = "TINYTC_TUNING_DB";
+    //! Version of the file format
+    constexpr static std::uint32_t version = 1;
+
+    /**
+     * @brief ctor; loads the database file if it exists
+     *
+     * @param path Database file; the database is kept in memory only if path is empty
+     */
+    tuning_database(std::string path = {});
+
+    /**
+     * @brief Create database configured by environment variables
+     *
+     * @return Database or nullptr if TINYTC_TUNING_DB is not set
+     */
+    static auto from_environment() -> std::unique_ptr<tuning_database>;
+
+    /**
+     * @brief Look up tuned configuration
+     *
+     * @param info Core info
+     * @param shape Blas shape
+     *
+     * @return Configuration or nullopt if the shape has not been tuned for the device
+     */
+    auto lookup(tinytc_core_info const &info, blas_shape const &shape) const
+        -> std::optional<tuning_config>;
+
+    /**
+     * @brief Store configuration and write the database file
+     *
+     * @param info Core info
+     * @param shape Blas shape
+     * @param cfg Configuration
+     */
+    void store(tinytc_core_info const &info, blas_shape const &shape, tuning_config const &cfg);
+
+    /**
+     * @brief Set or remove provisional configuration
+     *
+     * @param info Core info
+     * @param shape Blas shape
+     * @param cfg Configuration; the provisional entry is removed if cfg is nullopt
+     */
+    void provisional(tinytc_core_info const &info, blas_shape const &shape,
+                     std::optional<tuning_config> const &cfg);
+
+    /**
+     * @brief Serialize all entries for a device
+     *
+     * The string is part of the binary cache key, as the compiled binary depends on the entries.
+     *
+     * @param info Core info
+     *
+     * @return Entries
+     */
+    auto entries_key(tinytc_core_info const &info) const -> std::string;
+
+    inline auto path() const -> std::string const & { return path_; }
+
+  private:
+    void save() const;
+
+    std::string path_;
+    mutable std::mutex mutex_;
+    std::map<std::string, tuning_config> entries_, provisional_;
+};
+
+/**
+ * @brief Enumerate candidate configurations of a GEMM
+ *
+ * The candidates cover the subgroup sizes of the device, power-of-two local tilings that fit
+ * into the work-group, register blocks for different fill fractions of the register file, and
+ * the standard K block sizes.
+ *
+ * @param problem GEMM problem
+ *
+ * @return Candidates
+ */
+auto enumerate_gemm_configs(gemm_tuning_problem const &problem) -> std::vector<tuning_config>;
+
+/**
+ * @brief Estimate run-time of GEMM configuration with a static cost model
+ *
+ * The cost is the number of lane cycles spent per work-group, where FMA throughput,
+ * load throughput, and K-loop overhead are modelled. Padding of register blocks, load imbalance
+ * between subgroups, and register spilling increase the cost.
+ *
+ * @param problem GEMM problem
+ * @param cfg Configuration
+ *
+ * @return Cost in arbitrary units; throws status::invalid_arguments for invalid configurations
+ */
+auto gemm_cost_model(gemm_tuning_problem const &problem, tuning_config const &cfg) -> double;
+
+/**
+ * @brief Evaluate all candidates of a GEMM and store the winner in the tuning database
+ *
+ * @param problem GEMM problem
+ * @param measure Measurement callback
+ * @param user_data User data passed to measurement callback
+ *
+ * @return Best configuration
+ */
+auto tune_gemm(gemm_tuning_problem const &problem, tinytc_tuning_measure_t measure,
+               void *user_data) -> tuning_config;
+
+} // namespace tinytc
+
+#endif // AUTOTUNE_20251016_HPP
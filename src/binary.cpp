@@ -19,6 +19,12 @@ tinytc_binary::tinytc_binary(shared_handle<tinytc_compiler_context_t> ctx,
     : ctx_(std::move(ctx)), data_(std::move(data)), format_(format), core_features_(core_features) {
 }
 
+tinytc_binary::tinytc_binary(shared_handle<tinytc_compiler_context_t> ctx,
+                             std::shared_ptr<std::uint8_t const> data, std::size_t size,
+                             bundle_format format, tinytc_core_feature_flags_t core_features)
+    : ctx_(std::move(ctx)), external_data_(std::move(data)), external_size_(size),
+      format_(format), core_features_(core_features) {}
+
 extern "C" {
 
 tinytc_status_t tinytc_binary_create(tinytc_binary_t *bin, tinytc_compiler_context_t ctx,
@@ -10,6 +10,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 /**
@@ -29,15 +30,31 @@ struct tinytc_binary : tinytc::reference_counted {
     tinytc_binary(tinytc::shared_handle<tinytc_compiler_context_t> ctx,
                   std::vector<std::uint8_t> data, tinytc::bundle_format format,
                   tinytc_core_feature_flags_t core_features);
+    /**
+     * @brief Create binary from externally owned memory (e.g. a memory-mapped file)
+     *
+     * @param ctx Compiler context
+     * @param data Pointer to binary data; the memory is kept alive as long as the binary lives
+     * @param size Size of binary data in bytes
+     * @param format Binary format (SPIR-V or native device binary)
+     * @param core_features Required core features
+     */
+    tinytc_binary(tinytc::shared_handle<tinytc_compiler_context_t> ctx,
+                  std::shared_ptr<std::uint8_t const> data, std::size_t size,
+                  tinytc::bundle_format format, tinytc_core_feature_flags_t core_features);
 
     inline auto context() const -> tinytc_compiler_context_t { return ctx_.get(); }
     inline auto share_context() const -> tinytc::shared_handle<tinytc_compiler_context_t> {
         return ctx_;
     }
     //! Get raw data
-    inline auto data() const noexcept -> std::uint8_t const * { return data_.data(); }
+    inline auto data() const noexcept -> std::uint8_t const * {
+        return external_data_ ? external_data_.get() : data_.data();
+    }
     //! Get size of raw data
-    inline auto size() const noexcept -> std::size_t { return data_.size(); }
+    inline auto size() const noexcept -> std::size_t {
+        return external_data_ ? external_size_ : data_.size();
+    }
     //! Get binary format
     inline auto format() const noexcept -> tinytc::bundle_format { return format_; }
     //! Get core features
@@ -48,6 +65,8 @@ struct tinytc_binary : tinytc::reference_counted {
   private:
     tinytc::shared_handle<tinytc_compiler_context_t> ctx_;
     std::vector<std::uint8_t> data_;
+    std::shared_ptr<std::uint8_t const> external_data_;
+    std::size_t external_size_ = 0;
     tinytc::bundle_format format_;
     tinytc_core_feature_flags_t core_features_;
 };
@@ -0,0 +1,229 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "binary_cache.hpp"
+#include "autotune.hpp"
+#include "binary.hpp"
+#include "compiler_context.hpp"
+#include "device_info.hpp"
+#include "node/prog.hpp"
+#include "pass/dump_ir.hpp"
+#include "passes.hpp"
+#include "support/mapped_file.hpp"
+#include "tinytc/core.h"
+#include "tinytc/types.h"
+#include "util/fnv1a.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace tinytc {
+
+namespace {
+
+constexpr char entry_magic[8] = {'t', 'i', 'n', 'y', 't', 'c', 'b', 'c'};
+constexpr std::uint32_t entry_version = 1;
+constexpr std::size_t entry_data_alignment = 16;
+constexpr char entry_extension[] = ".bin";
+constexpr char temporary_extension[] = ".tmp";
+//! Temporary files older than this are assumed to be left-overs from crashed processes
+constexpr auto temporary_max_age = std::chrono::hours(1);
+
+struct entry_header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t format;
+    std::uint32_t core_features;
+    std::uint32_t reserved;
+    std::uint64_t key_size;
+    std::uint64_t data_size;
+};
+
+auto data_offset(std::uint64_t key_size) -> std::uint64_t {
+    auto const unaligned = sizeof(entry_header) + key_size;
+    return (1 + (unaligned - 1) / entry_data_alignment) * entry_data_alignment;
+}
+
+auto random_suffix() -> std::string {
+    auto rd = std::random_device{};
+    auto const r = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+    return (std::ostringstream{} << std::hex << std::setfill('0') << std::setw(16) << r).str();
+}
+
+} // namespace
+
+binary_cache::binary_cache(std::string dir, std::uint64_t max_size)
+    : dir_(std::move(dir)), max_size_(max_size > 0 ? max_size : default_max_size) {
+    auto ec = std::error_code{};
+    fs::create_directories(dir_, ec);
+}
+
+auto binary_cache::from_environment() -> std::unique_ptr<binary_cache> {
+    char const *dir = std::getenv(dir_env_var);
+    if (dir == nullptr || *dir == '\0') {
+        return nullptr;
+    }
+    std::uint64_t max_size = 0;
+    if (char const *max_size_str = std::getenv(max_size_env_var); max_size_str) {
+        max_size = std::strtoull(max_size_str, nullptr, 10);
+    }
+    return std::make_unique<binary_cache>(dir, max_size);
+}
+
+auto binary_cache::make_key(tinytc_prog &prg, tinytc_core_info const &info) -> std::string {
+    auto oss = std::ostringstream{};
+    auto ctx = prg.context();
+    oss << "tinytc " << TINYTC_VERSION_DESCRIPTION << " cache " << entry_version << std::endl;
+    oss << "opt_level=" << ctx->opt_level() << ";optflags=";
+    for (int flag = 0; flag < TINYTC_ENUM_NUM_OPTFLAG; ++flag) {
+        oss << ctx->opt_flag(static_cast<tinytc_optflag_t>(flag));
+    }
+    oss << std::endl << info.fingerprint() << std::endl;
+    if (auto db = ctx->tuning_db(); db) {
+        oss << db->entries_key(info) << std::endl;
+    }
+    run_function_pass(dump_ir_pass{oss}, prg);
+    return std::move(oss).str();
+}
+
+auto binary_cache::load(std::string const &key, shared_handle<tinytc_compiler_context_t> ctx) const
+    -> shared_handle<tinytc_binary_t> {
+    auto const p = path(key);
+    std::size_t file_size = 0;
+    auto mapping = map_file(p, file_size);
+    if (!mapping || file_size < sizeof(entry_header)) {
+        return {};
+    }
+
+    auto h = entry_header{};
+    std::memcpy(&h, mapping.get(), sizeof(entry_header));
+    auto const offset = data_offset(h.key_size);
+    if (std::memcmp(h.magic, entry_magic, sizeof(entry_magic)) != 0 ||
+        h.version != entry_version || h.key_size != key.size() || h.data_size == 0 ||
+        offset + h.data_size != file_size ||
+        std::memcmp(mapping.get() + sizeof(entry_header), key.data(), key.size()) != 0) {
+        return {};
+    }
+
+    // Update modification time such that eviction removes the least recently used entries
+    auto ec = std::error_code{};
+    fs::last_write_time(p, fs::file_time_type::clock::now(), ec);
+
+    auto const data_ptr = mapping.get() + offset;
+    auto data = std::shared_ptr<std::uint8_t const>(std::move(mapping), data_ptr);
+    return shared_handle{std::make_unique<tinytc_binary>(
+                             std::move(ctx), std::move(data), h.data_size,
+                             static_cast<bundle_format>(h.format), h.core_features)
+                             .release()};
+}
+
+void binary_cache::store(std::string const &key, tinytc_binary const &bin) const {
+    auto const target = path(key);
+    auto const tmp =
+        fs::path(dir_) / (target.stem().string() + '.' + random_suffix() + temporary_extension);
+
+    auto h = entry_header{};
+    std::memcpy(h.magic, entry_magic, sizeof(entry_magic));
+    h.version = entry_version;
+    h.format = static_cast<std::uint32_t>(bin.format());
+    h.core_features = bin.core_features();
+    h.reserved = 0;
+    h.key_size = key.size();
+    h.data_size = bin.size();
+    auto const padding = std::vector<char>(data_offset(key.size()) - sizeof(h) - key.size(), 0);
+
+    auto ec = std::error_code{};
+    {
+        auto f = std::ofstream(tmp, std::ios::binary | std::ios::trunc);
+        f.write(reinterpret_cast<char const *>(&h), sizeof(h));
+        f.write(key.data(), key.size());
+        f.write(padding.data(), padding.size());
+        f.write(reinterpret_cast<char const *>(bin.data()), bin.size());
+        f.close();
+        if (f.fail()) {
+            fs::remove(tmp, ec);
+            return;
+        }
+    }
+    // rename is atomic, so concurrent readers either see the old entry or the new entry
+    fs::rename(tmp, target, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+        return;
+    }
+
+    evict();
+}
+
+void binary_cache::evict() const {
+    struct entry {
+        fs::file_time_type time;
+        std::uint64_t size;
+        fs::path path;
+    };
+    auto entries = std::vector<entry>{};
+    std::uint64_t total_size = 0;
+    auto const now = fs::file_time_type::clock::now();
+
+    auto ec = std::error_code{};
+    for (auto it = fs::directory_iterator(dir_, ec); !ec && it != fs::directory_iterator{};
+         it.increment(ec)) {
+        auto const &p = it->path();
+        auto entry_ec = std::error_code{};
+        auto const time = it->last_write_time(entry_ec);
+        if (entry_ec) {
+            continue;
+        }
+        if (p.extension() == temporary_extension) {
+            if (now - time > temporary_max_age) {
+                fs::remove(p, entry_ec);
+            }
+            continue;
+        }
+        if (p.extension() != entry_extension || !it->is_regular_file(entry_ec)) {
+            continue;
+        }
+        auto const size = it->file_size(entry_ec);
+        if (entry_ec) {
+            continue;
+        }
+        entries.emplace_back(entry{time, size, p});
+        total_size += size;
+    }
+
+    if (total_size <= max_size_) {
+        return;
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](entry const &a, entry const &b) { return a.time < b.time; });
+    for (auto const &e : entries) {
+        if (total_size <= max_size_) {
+            break;
+        }
+        // Another process might have removed the entry already
+        fs::remove(e.path, ec);
+        total_size -= e.size;
+    }
+}
+
+auto binary_cache::path(std::string const &key) const -> fs::path {
+    auto const name = (std::ostringstream{} << std::hex << std::setfill('0') << std::setw(16)
+                                            << fnv1a(key) << entry_extension)
+                          .str();
+    return fs::path(dir_) / name;
+}
+
+} // namespace tinytc
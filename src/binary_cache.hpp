@@ -0,0 +1,102 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef BINARY_CACHE_20251016_HPP
+#define BINARY_CACHE_20251016_HPP
+
+#include "tinytc/types.h"
+#include "tinytc/types.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace tinytc {
+
+/**
+ * @brief Persistent on-disk cache for compiled binaries
+ *
+ * Each binary is stored in a separate file whose name is derived from a hash of the cache key.
+ * The full key is stored alongside the binary and compared on lookup, such that hash collisions
+ * are harmless. Files are written to a temporary file first and renamed afterwards, hence
+ * multiple processes may share the same cache directory. When the total size of the cache
+ * exceeds the size limit, the least recently used entries are removed.
+ *
+ * All file system errors are swallowed; a failed lookup is reported as cache miss and a failed
+ * store leaves the cache unchanged.
+ */
+class binary_cache {
+  public:
+    //! Environment variable that enables the cache and sets the cache directory
+    constexpr static char dir_env_var[] = "TINYTC_CACHE_DIR";
+    //! Environment variable that sets the size limit in bytes
+    constexpr static char max_size_env_var[] = "TINYTC_CACHE_MAX_SIZE";
+    //! Size limit used when no size limit is given
+    constexpr static std::uint64_t default_max_size = 256 * 1024 * 1024;
+
+    /**
+     * @brief ctor; creates the cache directory if it does not exist
+     *
+     * @param dir Cache directory
+     * @param max_size Size limit in bytes; default_max_size is used if max_size is 0
+     */
+    binary_cache(std::string dir, std::uint64_t max_size = 0);
+
+    /**
+     * @brief Create cache configured by environment variables
+     *
+     * @return Cache object or nullptr if TINYTC_CACHE_DIR is not set
+     */
+    static auto from_environment() -> std::unique_ptr<binary_cache>;
+
+    /**
+     * @brief Compute cache key
+     *
+     * The key comprises the library version, the optimization level and flags, the core info,
+     * and the printed program.
+     *
+     * @param prg Program
+     * @param info Core info
+     *
+     * @return Cache key
+     */
+    static auto make_key(tinytc_prog &prg, tinytc_core_info const &info) -> std::string;
+
+    /**
+     * @brief Look up binary
+     *
+     * The returned binary references the memory-mapped cache file.
+     *
+     * @param key Cache key
+     * @param ctx Compiler context of the returned binary
+     *
+     * @return Binary or empty handle on cache miss
+     */
+    auto load(std::string const &key, shared_handle<tinytc_compiler_context_t> ctx) const
+        -> shared_handle<tinytc_binary_t>;
+
+    /**
+     * @brief Store binary and evict old entries if necessary
+     *
+     * @param key Cache key
+     * @param bin Binary
+     */
+    void store(std::string const &key, tinytc_binary const &bin) const;
+
+    //! Remove least recently used entries until the cache size is within the size limit
+    void evict() const;
+
+    inline auto dir() const -> std::string const & { return dir_; }
+    inline auto max_size() const -> std::uint64_t { return max_size_; }
+
+  private:
+    auto path(std::string const &key) const -> std::filesystem::path;
+
+    std::string dir_;
+    std::uint64_t max_size_;
+};
+
+} // namespace tinytc
+
+#endif // BINARY_CACHE_20251016_HPP
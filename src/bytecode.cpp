@@ -0,0 +1,869 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "bytecode.hpp"
+#include "compiler_context.hpp"
+#include "error.hpp"
+#include "location.hpp"
+#include "node/attr.hpp"
+#include "node/func.hpp"
+#include "node/inst.hpp"
+#include "node/inst_view.hpp"
+#include "node/prog.hpp"
+#include "node/region.hpp"
+#include "node/type.hpp"
+#include "node/value.hpp"
+#include "node/visit.hpp"
+#include "support/arena.hpp"
+#include "support/mapped_file.hpp"
+#include "tinytc/core.h"
+#include "tinytc/types.h"
+#include "util/overloaded.hpp"
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace tinytc {
+
+namespace {
+
+constexpr std::uint8_t bytecode_magic[4] = {'T', 'T', 'C', 'B'};
+
+class byte_sink {
+  public:
+    void uint(std::uint64_t val) {
+        while (val >= 0x80) {
+            data_.push_back(static_cast<std::uint8_t>(val | 0x80));
+            val >>= 7;
+        }
+        data_.push_back(static_cast<std::uint8_t>(val));
+    }
+    void sint(std::int64_t val) {
+        uint((static_cast<std::uint64_t>(val) << 1) ^ static_cast<std::uint64_t>(val >> 63));
+    }
+    void f64(double val) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &val, sizeof(bits));
+        for (std::size_t i = 0; i < sizeof(bits); ++i) {
+            data_.push_back(static_cast<std::uint8_t>(bits >> (8 * i)));
+        }
+    }
+    void bytes(void const *data, std::size_t size) {
+        auto const *first = static_cast<std::uint8_t const *>(data);
+        data_.insert(data_.end(), first, first + size);
+    }
+
+    inline auto data() -> std::vector<std::uint8_t> & { return data_; }
+
+  private:
+    std::vector<std::uint8_t> data_;
+};
+
+class byte_source {
+  public:
+    byte_source(array_view<std::uint8_t> data) : pos_{data.begin()}, end_{data.end()} {}
+
+    auto uint() -> std::uint64_t {
+        std::uint64_t val = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            auto const byte = *bytes(1);
+            val |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return val;
+            }
+        }
+        throw status::invalid_bytecode;
+    }
+    auto sint() -> std::int64_t {
+        auto const val = uint();
+        return static_cast<std::int64_t>(val >> 1) ^ -static_cast<std::int64_t>(val & 1);
+    }
+    auto i32() -> std::int32_t {
+        auto const val = sint();
+        if (val < std::numeric_limits<std::int32_t>::min() ||
+            val > std::numeric_limits<std::int32_t>::max()) {
+            throw status::invalid_bytecode;
+        }
+        return static_cast<std::int32_t>(val);
+    }
+    auto f64() -> double {
+        auto const *b = bytes(sizeof(std::uint64_t));
+        std::uint64_t bits = 0;
+        for (std::size_t i = 0; i < sizeof(bits); ++i) {
+            bits |= static_cast<std::uint64_t>(b[i]) << (8 * i);
+        }
+        double val;
+        std::memcpy(&val, &bits, sizeof(val));
+        return val;
+    }
+    auto bytes(std::size_t size) -> std::uint8_t const * {
+        if (size > static_cast<std::size_t>(end_ - pos_)) {
+            throw status::invalid_bytecode;
+        }
+        auto const *b = pos_;
+        pos_ += size;
+        return b;
+    }
+    //! Read number of entries; each entry occupies at least one byte
+    auto count() -> std::int32_t {
+        auto const val = uint();
+        if (val > static_cast<std::uint64_t>(end_ - pos_) ||
+            val > static_cast<std::uint64_t>(std::numeric_limits<std::int32_t>::max())) {
+            throw status::invalid_bytecode;
+        }
+        return static_cast<std::int32_t>(val);
+    }
+    //! Read index and check that it is smaller than bound
+    auto index(std::size_t bound) -> std::size_t {
+        auto const val = uint();
+        if (val >= bound) {
+            throw status::invalid_bytecode;
+        }
+        return static_cast<std::size_t>(val);
+    }
+
+    inline auto empty() const -> bool { return pos_ == end_; }
+
+  private:
+    std::uint8_t const *pos_, *end_;
+};
+
+class bytecode_writer {
+  public:
+    inline bytecode_writer(tinytc_compiler_context_t ctx) : ctx_{ctx} {}
+
+    auto run(tinytc_prog &prg) -> std::vector<std::uint8_t>;
+
+  private:
+    auto string_index(std::string_view str) -> std::uint64_t;
+    auto type_index(tinytc_type_t ty) -> std::uint64_t;
+    auto attr_index(tinytc_attr_t a) -> std::uint64_t;
+    void write_optional_attr(byte_sink &out, tinytc_attr_t a);
+    void write_loc(byte_sink &out, location const &loc);
+    void write_value(byte_sink &out, tinytc_value &val);
+    void define_value(tinytc_value &val);
+    void write_func(tinytc_func &fn);
+    void write_region(tinytc_region &reg);
+    void write_inst(tinytc_inst &in);
+
+    tinytc_compiler_context_t ctx_;
+    byte_sink types_, attrs_, body_;
+    std::vector<std::string_view> strings_;
+    std::vector<std::uint64_t> sources_;
+    std::uint64_t num_types_ = 0, num_attrs_ = 0, num_values_ = 0;
+    std::unordered_map<std::string_view, std::uint64_t> string_map_;
+    std::unordered_map<std::int32_t, std::uint64_t> source_map_;
+    std::unordered_map<tinytc_type_t, std::uint64_t> type_map_;
+    std::unordered_map<tinytc_attr_t, std::uint64_t> attr_map_;
+    std::unordered_map<const_tinytc_value_t, std::uint64_t> value_map_;
+};
+
+auto bytecode_writer::run(tinytc_prog &prg) -> std::vector<std::uint8_t> {
+    write_loc(body_, prg.loc());
+    auto const num_funcs = std::distance(prg.begin(), prg.end());
+    body_.uint(num_funcs);
+    for (auto &fn : prg) {
+        write_func(fn);
+    }
+
+    auto out = byte_sink{};
+    out.bytes(bytecode_magic, sizeof(bytecode_magic));
+    out.uint(bytecode_version);
+    out.uint(strings_.size());
+    for (auto const &str : strings_) {
+        out.uint(str.size());
+        out.bytes(str.data(), str.size());
+    }
+    out.uint(sources_.size());
+    for (auto const &src : sources_) {
+        out.uint(src);
+    }
+    out.uint(num_types_);
+    out.bytes(types_.data().data(), types_.data().size());
+    out.uint(num_attrs_);
+    out.bytes(attrs_.data().data(), attrs_.data().size());
+    out.bytes(body_.data().data(), body_.data().size());
+    return std::move(out.data());
+}
+
+auto bytecode_writer::string_index(std::string_view str) -> std::uint64_t {
+    auto [it, inserted] = string_map_.emplace(str, strings_.size());
+    if (inserted) {
+        strings_.emplace_back(str);
+    }
+    return it->second;
+}
+
+auto bytecode_writer::type_index(tinytc_type_t ty) -> std::uint64_t {
+    if (auto it = type_map_.find(ty); it != type_map_.end()) {
+        return it->second;
+    }
+    // Referenced types are written first such that the reader only sees backward references
+    visit(overloaded{[&](coopmatrix_type &ct) {
+                         auto const component_ty = type_index(ct.component_ty());
+                         types_.uint(static_cast<std::uint64_t>(ct.type_id()));
+                         types_.uint(component_ty);
+                         types_.sint(ct.rows());
+                         types_.sint(ct.cols());
+                         types_.sint(static_cast<std::int64_t>(ct.use()));
+                     },
+                     [&](group_type &gt) {
+                         auto const element_ty = type_index(gt.element_ty());
+                         types_.uint(static_cast<std::uint64_t>(gt.type_id()));
+                         types_.uint(element_ty);
+                         types_.sint(gt.size());
+                         types_.sint(gt.offset());
+                     },
+                     [&](memref_type &mt) {
+                         auto const element_ty = type_index(mt.element_ty());
+                         types_.uint(static_cast<std::uint64_t>(mt.type_id()));
+                         types_.uint(element_ty);
+                         types_.uint(mt.dim());
+                         for (auto const &s : mt.shape()) {
+                             types_.sint(s);
+                         }
+                         for (auto const &s : mt.stride()) {
+                             types_.sint(s);
+                         }
+                         types_.sint(static_cast<std::int64_t>(mt.addrspace()));
+                     },
+                     [&](tinytc_type &t) { types_.uint(static_cast<std::uint64_t>(t.type_id())); }},
+          *ty);
+    return type_map_[ty] = num_types_++;
+}
+
+auto bytecode_writer::attr_index(tinytc_attr_t a) -> std::uint64_t {
+    if (auto it = attr_map_.find(a); it != attr_map_.end()) {
+        return it->second;
+    }
+    visit(overloaded{[&](array_attr &aa) {
+                         auto values = std::vector<std::uint64_t>{};
+                         values.reserve(aa.size());
+                         for (auto const &v : aa) {
+                             values.emplace_back(attr_index(v));
+                         }
+                         attrs_.uint(static_cast<std::uint64_t>(aa.type_id()));
+                         attrs_.uint(values.size());
+                         for (auto const &v : values) {
+                             attrs_.uint(v);
+                         }
+                     },
+                     [&](boolean_attr &ba) {
+                         attrs_.uint(static_cast<std::uint64_t>(ba.type_id()));
+                         attrs_.uint(ba.value() ? 1 : 0);
+                     },
+                     [&](dictionary_attr &da) {
+                         auto entries = std::vector<std::pair<std::uint64_t, std::uint64_t>>{};
+                         entries.reserve(da.attrs().size());
+                         for (auto const &na : da) {
+                             auto const name = attr_index(na.name);
+                             entries.emplace_back(name, attr_index(na.attr));
+                         }
+                         attrs_.uint(static_cast<std::uint64_t>(da.type_id()));
+                         attrs_.uint(entries.size());
+                         for (auto const &[name, attr] : entries) {
+                             attrs_.uint(name);
+                             attrs_.uint(attr);
+                         }
+                     },
+                     [&](integer_attr &ia) {
+                         attrs_.uint(static_cast<std::uint64_t>(ia.type_id()));
+                         attrs_.sint(ia.value());
+                     },
+                     [&](string_attr &sa) {
+                         auto const str = string_index(sa.str());
+                         attrs_.uint(static_cast<std::uint64_t>(sa.type_id()));
+                         attrs_.uint(str);
+                     }},
+          *a);
+    return attr_map_[a] = num_attrs_++;
+}
+
+void bytecode_writer::write_optional_attr(byte_sink &out, tinytc_attr_t a) {
+    out.uint(a ? attr_index(a) + 1 : 0);
+}
+
+void bytecode_writer::write_loc(byte_sink &out, location const &loc) {
+    auto const source = [&](std::int32_t source_id) -> std::uint64_t {
+        if (source_id <= 0) {
+            return 0;
+        }
+        auto it = source_map_.find(source_id);
+        if (it == source_map_.end()) {
+            auto const [name, name_size] = ctx_->source_name(source_id);
+            sources_.emplace_back(string_index(std::string_view(name, name_size)));
+            it = source_map_.emplace(source_id, sources_.size()).first;
+        }
+        return it->second;
+    };
+    out.uint(source(loc.begin.source_id));
+    out.sint(loc.begin.line);
+    out.sint(loc.begin.column);
+    out.uint(source(loc.end.source_id));
+    out.sint(loc.end.line);
+    out.sint(loc.end.column);
+}
+
+void bytecode_writer::write_value(byte_sink &out, tinytc_value &val) {
+    out.uint(val.has_name() ? string_index(val.name()) + 1 : 0);
+    write_loc(out, val.loc());
+}
+
+void bytecode_writer::define_value(tinytc_value &val) { value_map_[&val] = num_values_++; }
+
+void bytecode_writer::write_func(tinytc_func &fn) {
+    // Type and attribute indices are computed first as they may add strings to the tables
+    auto const name = string_index(fn.name());
+    auto param_types = std::vector<std::uint64_t>{};
+    param_types.reserve(fn.num_params());
+    for (auto const &p : fn.params()) {
+        param_types.emplace_back(type_index(p.ty()));
+    }
+    auto const ty = type_index(fn.ty());
+
+    body_.uint(name);
+    write_loc(body_, fn.loc());
+    body_.uint(param_types.size());
+    for (auto const &p : param_types) {
+        body_.uint(p);
+    }
+    body_.uint(ty);
+    write_optional_attr(body_, fn.attr());
+    for (std::size_t i = 0; i < fn.num_params(); ++i) {
+        write_optional_attr(body_, fn.param_attr(i));
+    }
+
+    value_map_.clear();
+    write_region(fn.body());
+}
+
+void bytecode_writer::write_region(tinytc_region &reg) {
+    body_.uint(static_cast<std::uint64_t>(reg.kind()));
+    write_loc(body_, reg.loc());
+    body_.uint(reg.num_params());
+    // Values are numbered per scope such that values are only referenced where they are visible
+    auto const scope_begin = num_values_;
+    for (auto &p : reg.params()) {
+        write_value(body_, p);
+        define_value(p);
+    }
+    body_.uint(std::distance(reg.begin(), reg.end()));
+    for (auto &in : reg) {
+        write_inst(in);
+    }
+    num_values_ = scope_begin;
+}
+
+void bytecode_writer::write_inst(tinytc_inst &in) {
+    body_.uint(static_cast<std::uint64_t>(in.type_id()));
+    body_.uint(in.num_results());
+    body_.uint(in.num_operands());
+    body_.uint(in.num_child_regions());
+    write_loc(body_, in.loc());
+    write_optional_attr(body_, in.attr());
+    for (auto &res : in.results()) {
+        body_.uint(type_index(res.ty()));
+        write_value(body_, res);
+    }
+    for (std::int32_t op_no = 0; op_no < in.num_operands(); ++op_no) {
+        auto it = value_map_.find(&in.op(op_no));
+        if (it == value_map_.end()) {
+            throw compilation_error(in.loc(), {&in.op(op_no)}, status::internal_compiler_error,
+                                    "Operand is not defined before its use");
+        }
+        body_.uint(it->second);
+    }
+    visit_operand_offsets([&](std::int32_t &offset) { body_.sint(offset); }, in);
+    visit_props(
+        [&](auto &prop) {
+            using T = std::decay_t<decltype(prop)>;
+            if constexpr (std::is_same_v<T, bool>) {
+                body_.uint(prop ? 1 : 0);
+            } else if constexpr (std::is_enum_v<T> || std::is_integral_v<T>) {
+                body_.sint(static_cast<std::int64_t>(prop));
+            } else if constexpr (std::is_same_v<T, std::vector<std::int64_t>>) {
+                body_.uint(prop.size());
+                for (auto const &p : prop) {
+                    body_.sint(p);
+                }
+            } else if constexpr (std::is_same_v<T, constant_value_type>) {
+                body_.uint(prop.index());
+                std::visit(overloaded{[&](bool p) { body_.uint(p ? 1 : 0); },
+                                      [&](std::int64_t p) { body_.sint(p); },
+                                      [&](double p) { body_.f64(p); },
+                                      [&](std::complex<double> p) {
+                                          body_.f64(p.real());
+                                          body_.f64(p.imag());
+                                      }},
+                           prop);
+            } else {
+                static_assert(sizeof(T) == 0, "Property type not supported by bytecode");
+            }
+        },
+        in);
+    for (auto &reg : in.child_regions()) {
+        write_region(reg);
+    }
+    for (auto &res : in.results()) {
+        define_value(res);
+    }
+}
+
+//! Checks whether val is an enumerator of T
+template <typename T> auto is_enumerator(std::int64_t val) -> bool {
+    if constexpr (std::is_same_v<T, address_space>) {
+        return val == static_cast<std::int64_t>(address_space::global) ||
+               val == static_cast<std::int64_t>(address_space::local);
+    } else if constexpr (std::is_same_v<T, checked_flag>) {
+        return 0 <= val && val < TINYTC_ENUM_NUM_CHECKED_FLAG;
+    } else if constexpr (std::is_same_v<T, comp3>) {
+        return 0 <= val && val < TINYTC_ENUM_NUM_COMP3;
+    } else if constexpr (std::is_same_v<T, matrix_use>) {
+        return 0 <= val && val < TINYTC_ENUM_NUM_MATRIX_USE;
+    } else if constexpr (std::is_same_v<T, memory_scope>) {
+        return 0 <= val && val < TINYTC_ENUM_NUM_MEMORY_SCOPE;
+    } else if constexpr (std::is_same_v<T, memory_semantics>) {
+        // Memory semantics are bit flags
+        switch (static_cast<memory_semantics>(val)) {
+        case memory_semantics::relaxed:
+        case memory_semantics::acquire:
+        case memory_semantics::release:
+        case memory_semantics::acquire_release:
+        case memory_semantics::sequentially_consistent:
+            return true;
+        }
+        return false;
+    } else if constexpr (std::is_same_v<T, reduce_mode>) {
+        return 0 <= val && val < TINYTC_ENUM_NUM_REDUCE_MODE;
+    } else if constexpr (std::is_same_v<T, transpose>) {
+        return 0 <= val && val < TINYTC_ENUM_NUM_TRANSPOSE;
+    } else {
+        static_assert(sizeof(T) == 0, "Enum not supported by bytecode");
+    }
+}
+
+template <typename T> auto read_enum(std::int64_t val) -> T {
+    if (!is_enumerator<T>(val)) {
+        throw status::invalid_bytecode;
+    }
+    return static_cast<T>(val);
+}
+
+class bytecode_reader {
+  public:
+    inline bytecode_reader(array_view<std::uint8_t> data,
+                           shared_handle<tinytc_compiler_context_t> ctx)
+        : src_{data}, ctx_{std::move(ctx)} {}
+
+    auto run() -> shared_handle<tinytc_prog_t>;
+
+  private:
+    void read_tables();
+    auto read_type() -> tinytc_type_t;
+    auto read_attr() -> tinytc_attr_t;
+    auto read_optional_attr() -> tinytc_attr_t;
+    auto read_loc() -> location;
+    void read_value(tinytc_value &val);
+    auto read_func() -> unique_handle<tinytc_func_t>;
+    void read_region(tinytc_region &reg);
+    auto read_inst() -> unique_handle<tinytc_inst_t>;
+
+    inline auto type() -> tinytc_type_t { return types_[src_.index(types_.size())]; }
+    inline auto attr() -> tinytc_attr_t { return attrs_[src_.index(attrs_.size())]; }
+    inline auto str() -> std::string_view { return strings_[src_.index(strings_.size())]; }
+
+    byte_source src_;
+    shared_handle<tinytc_compiler_context_t> ctx_;
+    std::vector<std::string_view> strings_;
+    std::vector<std::int32_t> sources_;
+    std::vector<tinytc_type_t> types_;
+    std::vector<tinytc_attr_t> attrs_;
+    std::vector<tinytc_value_t> values_;
+};
+
+auto bytecode_reader::run() -> shared_handle<tinytc_prog_t> {
+    if (std::memcmp(src_.bytes(sizeof(bytecode_magic)), bytecode_magic,
+                    sizeof(bytecode_magic)) != 0 ||
+        src_.uint() != bytecode_version) {
+        throw status::invalid_bytecode;
+    }
+    read_tables();
+
+    auto prg = shared_handle{std::make_unique<tinytc_prog>(ctx_, read_loc()).release()};
+    auto const num_funcs = src_.count();
+    for (std::int32_t i = 0; i < num_funcs; ++i) {
+        prg->push_back(read_func());
+    }
+    if (!src_.empty()) {
+        throw status::invalid_bytecode;
+    }
+    return prg;
+}
+
+void bytecode_reader::read_tables() {
+    auto const num_strings = src_.count();
+    strings_.reserve(num_strings);
+    for (std::int32_t i = 0; i < num_strings; ++i) {
+        auto const size = src_.count();
+        auto const *data = reinterpret_cast<char const *>(src_.bytes(size));
+        strings_.emplace_back(data, size);
+    }
+
+    auto const num_sources = src_.count();
+    sources_.reserve(num_sources);
+    for (std::int32_t i = 0; i < num_sources; ++i) {
+        sources_.emplace_back(ctx_->add_source(std::string(str()), std::string{}));
+    }
+
+    auto const num_types = src_.count();
+    types_.reserve(num_types);
+    for (std::int32_t i = 0; i < num_types; ++i) {
+        types_.emplace_back(read_type());
+    }
+
+    auto const num_attrs = src_.count();
+    attrs_.reserve(num_attrs);
+    for (std::int32_t i = 0; i < num_attrs; ++i) {
+        attrs_.emplace_back(read_attr());
+    }
+}
+
+auto bytecode_reader::read_type() -> tinytc_type_t {
+    auto const tid = src_.uint();
+    switch (static_cast<TK>(tid)) {
+    case TK::TK_boolean:
+        return boolean_type::get(ctx_.get());
+    case TK::TK_i8:
+        return i8_type::get(ctx_.get());
+    case TK::TK_i16:
+        return i16_type::get(ctx_.get());
+    case TK::TK_i32:
+        return i32_type::get(ctx_.get());
+    case TK::TK_i64:
+        return i64_type::get(ctx_.get());
+    case TK::TK_index:
+        return index_type::get(ctx_.get());
+    case TK::TK_bf16:
+        return bf16_type::get(ctx_.get());
+    case TK::TK_f16:
+        return f16_type::get(ctx_.get());
+    case TK::TK_f32:
+        return f32_type::get(ctx_.get());
+    case TK::TK_f64:
+        return f64_type::get(ctx_.get());
+    case TK::TK_c32:
+        return c32_type::get(ctx_.get());
+    case TK::TK_c64:
+        return c64_type::get(ctx_.get());
+    case TK::TK_void:
+        return void_type::get(ctx_.get());
+    case TK::TK_coopmatrix: {
+        auto const component_ty = type();
+        auto const rows = src_.sint();
+        auto const cols = src_.sint();
+        auto const use = read_enum<matrix_use>(src_.i32());
+        return coopmatrix_type::get(component_ty, rows, cols, use);
+    }
+    case TK::TK_group: {
+        auto const element_ty = type();
+        auto const size = src_.sint();
+        auto const offset = src_.sint();
+        return group_type::get(element_ty, size, offset);
+    }
+    case TK::TK_memref: {
+        auto const element_ty = type();
+        auto const dim = src_.count();
+        auto shape = std::vector<std::int64_t>(dim);
+        for (auto &s : shape) {
+            s = src_.sint();
+        }
+        auto stride = std::vector<std::int64_t>(dim);
+        for (auto &s : stride) {
+            s = src_.sint();
+        }
+        auto const addrspace = read_enum<address_space>(src_.i32());
+        return memref_type::get(element_ty, shape, stride, addrspace);
+    }
+    default:
+        break;
+    }
+    throw status::invalid_bytecode;
+}
+
+auto bytecode_reader::read_attr() -> tinytc_attr_t {
+    auto const tid = src_.uint();
+    switch (static_cast<AK>(tid)) {
+    case AK::AK_array: {
+        auto values = std::vector<tinytc_attr_t>(src_.count());
+        for (auto &v : values) {
+            v = attr();
+        }
+        return array_attr::get(ctx_.get(), values);
+    }
+    case AK::AK_boolean:
+        return boolean_attr::get(ctx_.get(), src_.uint() != 0);
+    case AK::AK_dictionary: {
+        auto entries = std::vector<tinytc_named_attr_t>(src_.count());
+        for (auto &e : entries) {
+            e.name = attr();
+            e.attr = attr();
+        }
+        // Do not trust the stream to be sorted; sort also rejects duplicate and non-string keys
+        dictionary_attr::sort(entries);
+        return dictionary_attr::get(ctx_.get(), entries);
+    }
+    case AK::AK_integer:
+        return integer_attr::get(ctx_.get(), src_.sint());
+    case AK::AK_string:
+        return string_attr::get(ctx_.get(), str());
+    default:
+        break;
+    }
+    throw status::invalid_bytecode;
+}
+
+auto bytecode_reader::read_optional_attr() -> tinytc_attr_t {
+    auto const idx = src_.index(attrs_.size() + 1);
+    return idx > 0 ? attrs_[idx - 1] : nullptr;
+}
+
+auto bytecode_reader::read_loc() -> location {
+    auto const source = [&]() -> std::int32_t {
+        auto const idx = src_.index(sources_.size() + 1);
+        return idx > 0 ? sources_[idx - 1] : 0;
+    };
+    auto loc = location{};
+    loc.begin.source_id = source();
+    loc.begin.line = src_.i32();
+    loc.begin.column = src_.i32();
+    loc.end.source_id = source();
+    loc.end.line = src_.i32();
+    loc.end.column = src_.i32();
+    return loc;
+}
+
+void bytecode_reader::read_value(tinytc_value &val) {
+    if (auto const idx = src_.index(strings_.size() + 1); idx > 0) {
+        val.name(strings_[idx - 1]);
+    }
+    val.loc(read_loc());
+}
+
+auto bytecode_reader::read_func() -> unique_handle<tinytc_func_t> {
+    auto const name = str();
+    auto const loc = read_loc();
+    auto param_types = std::vector<tinytc_type_t>(src_.count());
+    for (auto &p : param_types) {
+        p = type();
+    }
+    auto const ty = type();
+    auto fn = unique_handle{
+        std::make_unique<tinytc_func>(std::string(name), param_types, ty, loc).release()};
+    fn->attr(read_optional_attr());
+    for (std::size_t i = 0; i < param_types.size(); ++i) {
+        if (auto a = read_optional_attr(); a) {
+            fn->param_attr(i, a);
+        }
+    }
+
+    auto const arena_scope = ir_arena_scope(fn->arena());
+    read_region(fn->body());
+    return fn;
+}
+
+void bytecode_reader::read_region(tinytc_region &reg) {
+    auto const kind = src_.uint();
+    if (kind > static_cast<std::uint64_t>(region_kind::spmd)) {
+        throw status::invalid_bytecode;
+    }
+    reg.kind(static_cast<region_kind>(kind));
+    reg.loc(read_loc());
+    if (src_.uint() != reg.num_params()) {
+        throw status::invalid_bytecode;
+    }
+    auto const scope_begin = values_.size();
+    for (auto &p : reg.params()) {
+        read_value(p);
+        values_.emplace_back(&p);
+    }
+    auto const num_insts = src_.count();
+    for (std::int32_t i = 0; i < num_insts; ++i) {
+        reg.insts().push_back(read_inst().release());
+    }
+    values_.resize(scope_begin);
+}
+
+auto bytecode_reader::read_inst() -> unique_handle<tinytc_inst_t> {
+    auto const tid = src_.uint();
+    if (tid > static_cast<std::uint64_t>(std::numeric_limits<std::int32_t>::max())) {
+        throw status::invalid_bytecode;
+    }
+    auto layout = inst_layout{};
+    layout.num_results = src_.count();
+    layout.num_operands = src_.count();
+    layout.num_child_regions = src_.count();
+    try {
+        layout.sizeof_properties = properties_size(static_cast<IK>(tid));
+    } catch (status const &) {
+        throw status::invalid_bytecode;
+    }
+    auto const loc = read_loc();
+
+    auto in = unique_handle{tinytc_inst::create(static_cast<IK>(tid), layout, loc)};
+    in->attr(read_optional_attr());
+    for (std::int32_t ret_no = 0; ret_no < layout.num_results; ++ret_no) {
+        in->result(ret_no) = tinytc_value{type(), in.get(), loc};
+        read_value(in->result(ret_no));
+    }
+    for (std::int32_t op_no = 0; op_no < layout.num_operands; ++op_no) {
+        in->op(op_no, values_[src_.index(values_.size())]);
+    }
+    visit_operand_offsets([&](std::int32_t &offset) { offset = src_.i32(); }, *in);
+    visit_props(
+        [&](auto &prop) {
+            using T = std::decay_t<decltype(prop)>;
+            if constexpr (std::is_same_v<T, bool>) {
+                prop = src_.uint() != 0;
+            } else if constexpr (std::is_enum_v<T>) {
+                prop = read_enum<T>(src_.sint());
+            } else if constexpr (std::is_integral_v<T>) {
+                auto const val = src_.sint();
+                if (val < std::numeric_limits<T>::min() || val > std::numeric_limits<T>::max()) {
+                    throw status::invalid_bytecode;
+                }
+                prop = static_cast<T>(val);
+            } else if constexpr (std::is_same_v<T, std::vector<std::int64_t>>) {
+                prop.resize(src_.count());
+                for (auto &p : prop) {
+                    p = src_.sint();
+                }
+            } else if constexpr (std::is_same_v<T, constant_value_type>) {
+                switch (src_.uint()) {
+                case 0:
+                    prop = src_.uint() != 0;
+                    break;
+                case 1:
+                    prop = src_.sint();
+                    break;
+                case 2:
+                    prop = src_.f64();
+                    break;
+                case 3: {
+                    auto const re = src_.f64();
+                    prop = std::complex<double>(re, src_.f64());
+                    break;
+                }
+                default:
+                    throw status::invalid_bytecode;
+                }
+            } else {
+                static_assert(sizeof(T) == 0, "Property type not supported by bytecode");
+            }
+        },
+        *in);
+    if (!has_valid_layout(*in)) {
+        throw status::invalid_bytecode;
+    }
+    visit([](auto view) { view.setup_and_check(); }, *in);
+
+    for (auto &reg : in->child_regions()) {
+        read_region(reg);
+    }
+    for (auto &res : in->results()) {
+        values_.emplace_back(&res);
+    }
+    return in;
+}
+
+} // namespace
+
+auto serialize_program(tinytc_prog &prg) -> std::vector<std::uint8_t> {
+    return bytecode_writer{prg.context()}.run(prg);
+}
+
+auto deserialize_program(array_view<std::uint8_t> data,
+                         shared_handle<tinytc_compiler_context_t> ctx)
+    -> shared_handle<tinytc_prog_t> {
+    return bytecode_reader{data, std::move(ctx)}.run();
+}
+
+} // namespace tinytc
+
+using namespace tinytc;
+
+extern "C" {
+
+tinytc_status_t tinytc_prog_serialize(tinytc_prog_t prg, size_t *data_size, uint8_t **data) {
+    if (prg == nullptr || data_size == nullptr || data == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code([&] {
+        auto const bytecode = serialize_program(*prg);
+        *data = static_cast<uint8_t *>(malloc(bytecode.size()));
+        if (!*data) {
+            throw status::bad_alloc;
+        }
+        std::memcpy(*data, bytecode.data(), bytecode.size());
+        *data_size = bytecode.size();
+    });
+}
+
+tinytc_status_t tinytc_prog_serialize_to_file(tinytc_prog_t prg, char const *filename) {
+    if (prg == nullptr || filename == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code([&] {
+        auto const bytecode = serialize_program(*prg);
+        auto stream = std::ofstream(filename, std::ios::binary);
+        if (!stream.good()) {
+            throw status::file_io_error;
+        }
+        stream.write(reinterpret_cast<char const *>(bytecode.data()), bytecode.size());
+        if (!stream.good()) {
+            throw status::file_io_error;
+        }
+    });
+}
+
+void tinytc_bytecode_destroy(uint8_t *data) { free(data); }
+
+tinytc_status_t tinytc_prog_deserialize(tinytc_prog_t *prg, size_t data_size, uint8_t const *data,
+                                        tinytc_compiler_context_t ctx) {
+    if (prg == nullptr || (data_size > 0 && data == nullptr)) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code([&] {
+        auto ctx_ = ctx ? shared_handle{ctx, true} : create_compiler_context();
+        *prg = deserialize_program(array_view(data, data_size), std::move(ctx_)).release();
+    });
+}
+
+tinytc_status_t tinytc_prog_deserialize_file(tinytc_prog_t *prg, char const *filename,
+                                             tinytc_compiler_context_t ctx) {
+    if (prg == nullptr || filename == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code([&] {
+        std::size_t size = 0;
+        auto const mapping = map_file(filename, size);
+        if (!mapping) {
+            throw status::file_io_error;
+        }
+        auto ctx_ = ctx ? shared_handle{ctx, true} : create_compiler_context();
+        *prg = deserialize_program(array_view(mapping.get(), size), std::move(ctx_)).release();
+    });
+}
+}
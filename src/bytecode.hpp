@@ -0,0 +1,51 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef BYTECODE_20251016_HPP
+#define BYTECODE_20251016_HPP
+
+#include "tinytc/core.hpp"
+#include "tinytc/types.h"
+#include "tinytc/types.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace tinytc {
+
+//! Bytecode format version; must be increased whenever the encoding or the instruction set changes
+constexpr std::uint32_t bytecode_version = 2;
+
+/**
+ * @brief Serialize program to bytecode
+ *
+ * The bytecode starts with the magic bytes "TTCB" followed by the format version. Then follow
+ * the string table, the source name table, the type table, the attribute table, and the
+ * functions. All integers are LEB128-encoded (signed integers are zigzag-encoded); types,
+ * attributes, strings, and values are referenced by their index in the respective table.
+ *
+ * @param prg Program
+ *
+ * @return Bytecode
+ */
+auto serialize_program(tinytc_prog &prg) -> std::vector<std::uint8_t>;
+
+/**
+ * @brief Deserialize program from bytecode
+ *
+ * Strings are read in-place from the bytecode such that loading from a memory-mapped file does
+ * not copy the bytecode. Every instruction is checked as if it was created with the builder API.
+ *
+ * @param data Bytecode
+ * @param ctx Compiler context
+ *
+ * @return Program; throws status::invalid_bytecode if the bytecode is malformed or has an
+ * incompatible version
+ */
+auto deserialize_program(array_view<std::uint8_t> data,
+                         shared_handle<tinytc_compiler_context_t> ctx)
+    -> shared_handle<tinytc_prog_t>;
+
+} // namespace tinytc
+
+#endif // BYTECODE_20251016_HPP
@@ -0,0 +1,208 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "compile_job.hpp"
+#include "compiler.hpp"
+#include "error.hpp"
+#include "node/prog.hpp"
+#include "specialization.hpp"
+#include "support/thread_pool.hpp"
+#include "tinytc/core.h"
+#include "tinytc/types.h"
+#include "tinytc/types.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+using namespace tinytc;
+
+tinytc_compile_job::tinytc_compile_job(shared_handle<tinytc_prog_t> prg,
+                                       shared_handle<tinytc_core_info_t> info,
+                                       tinytc_compile_callback_t callback, void *user_data)
+    : prg_(std::move(prg)), info_(std::move(info)), callback_(callback), user_data_(user_data) {}
+
+void tinytc_compile_job::run() {
+    {
+        auto lock = std::lock_guard{mutex_};
+        if (state_ == compile_job_state::cancelled) {
+            prg_ = {};
+        } else {
+            state_ = compile_job_state::running;
+        }
+    }
+
+    auto status = tinytc_status_compilation_cancelled;
+    auto bin = shared_handle<tinytc_binary_t>{};
+    if (prg_) {
+        status = exception_to_status_code(
+            [&] { bin = compile_to_binary(*prg_, info_.get(), &cancel_requested_); },
+            prg_->context());
+        // The copy of the program is not needed anymore
+        prg_ = {};
+
+        {
+            auto lock = std::lock_guard{mutex_};
+            status_ = status;
+            bin_ = bin;
+            switch (status) {
+            case tinytc_status_success:
+                state_ = compile_job_state::success;
+                break;
+            case tinytc_status_compilation_cancelled:
+                state_ = compile_job_state::cancelled;
+                break;
+            default:
+                state_ = compile_job_state::failed;
+                break;
+            }
+        }
+        cv_.notify_all();
+    }
+
+    if (callback_) {
+        callback_(status, bin.get(), user_data_);
+    }
+}
+
+void tinytc_compile_job::cancel() {
+    {
+        auto lock = std::lock_guard{mutex_};
+        if (state_ != compile_job_state::queued) {
+            if (state_ == compile_job_state::running) {
+                cancel_requested_ = true;
+            }
+            return;
+        }
+        state_ = compile_job_state::cancelled;
+        status_ = tinytc_status_compilation_cancelled;
+    }
+    cv_.notify_all();
+}
+
+auto tinytc_compile_job::state() const -> compile_job_state {
+    auto lock = std::lock_guard{mutex_};
+    return state_;
+}
+
+auto tinytc_compile_job::wait() -> shared_handle<tinytc_binary_t> {
+    auto lock = std::unique_lock{mutex_};
+    cv_.wait(lock, [this] {
+        return state_ != compile_job_state::queued && state_ != compile_job_state::running;
+    });
+    if (status_ != tinytc_status_success) {
+        throw status{std::underlying_type_t<status>(status_)};
+    }
+    return bin_;
+}
+
+namespace tinytc {
+
+auto compile_job_queue::get() -> compile_job_queue & {
+    static compile_job_queue queue;
+    return queue;
+}
+
+compile_job_queue::~compile_job_queue() = default;
+
+void compile_job_queue::submit(shared_handle<tinytc_compile_job_t> job,
+                               compile_priority priority) {
+    auto lock = std::lock_guard{mutex_};
+    if (!pool_) {
+        pool_ = std::make_unique<thread_pool>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    pool_->submit([job = std::move(job)] { job->run(); }, static_cast<std::int32_t>(priority));
+}
+
+void compile_job_queue::num_threads(std::size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    auto old_pool = std::unique_ptr<thread_pool>{};
+    {
+        auto lock = std::lock_guard{mutex_};
+        old_pool = std::exchange(pool_, std::make_unique<thread_pool>(num_threads));
+    }
+    // Destroying the old pool outside the lock waits for its jobs without blocking new submissions
+    old_pool.reset();
+}
+
+} // namespace tinytc
+
+extern "C" {
+
+tinytc_status_t tinytc_prog_compile_async(tinytc_compile_job_t *job, tinytc_prog_t prg,
+                                          tinytc_core_info_t info,
+                                          tinytc_compile_priority_t priority,
+                                          tinytc_compile_callback_t callback, void *user_data) {
+    if (job == nullptr || prg == nullptr || info == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code(
+        [&] {
+            auto new_job = shared_handle{std::make_unique<tinytc_compile_job>(
+                                             clone_program(*prg), shared_handle{info, true},
+                                             callback, user_data)
+                                             .release()};
+            compile_job_queue::get().submit(new_job,
+                                            compile_priority{std::underlying_type_t<
+                                                compile_priority>(priority)});
+            *job = new_job.release();
+        },
+        prg->context());
+}
+
+tinytc_status_t tinytc_compile_job_get_state(const_tinytc_compile_job_t job,
+                                             tinytc_compile_job_state_t *state) {
+    if (job == nullptr || state == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code(
+        [&] { *state = static_cast<tinytc_compile_job_state_t>(job->state()); });
+}
+
+tinytc_status_t tinytc_compile_job_wait(tinytc_compile_job_t job, tinytc_binary_t *bin) {
+    if (job == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code([&] {
+        auto result = job->wait();
+        if (bin) {
+            *bin = result.release();
+        }
+    });
+}
+
+tinytc_status_t tinytc_compile_job_cancel(tinytc_compile_job_t job) {
+    if (job == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code([&] { job->cancel(); });
+}
+
+tinytc_status_t tinytc_set_async_compile_num_threads(size_t num_threads) {
+    return exception_to_status_code([&] { compile_job_queue::get().num_threads(num_threads); });
+}
+
+tinytc_status_t tinytc_compile_job_release(tinytc_compile_job_t obj) {
+    if (obj == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    auto ref_count = obj->dec_ref();
+    if (ref_count == 0) {
+        delete obj;
+    }
+    return tinytc_status_success;
+}
+
+tinytc_status_t tinytc_compile_job_retain(tinytc_compile_job_t obj) {
+    if (obj == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    obj->inc_ref();
+    return tinytc_status_success;
+}
+}
@@ -0,0 +1,86 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef COMPILE_JOB_20251016_HPP
+#define COMPILE_JOB_20251016_HPP
+
+#include "reference_counted.hpp"
+#include "tinytc/types.h"
+#include "tinytc/types.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+namespace tinytc {
+class thread_pool;
+}
+
+/**
+ * @brief Asynchronous compilation of a program
+ *
+ * The job owns a copy of the program. State, status, and binary are protected by a mutex;
+ * cancellation of a running job is signalled with an atomic flag that the compiler checks
+ * between compilation stages.
+ */
+struct tinytc_compile_job : tinytc::reference_counted {
+  public:
+    tinytc_compile_job(tinytc::shared_handle<tinytc_prog_t> prg,
+                       tinytc::shared_handle<tinytc_core_info_t> info,
+                       tinytc_compile_callback_t callback, void *user_data);
+
+    //! Compile program and invoke callback; called by a worker thread
+    void run();
+    //! Cancel queued job immediately or request cancellation of running job
+    void cancel();
+    //! Current state
+    auto state() const -> tinytc::compile_job_state;
+    //! Block until job is done; throws the job status if it is not success
+    auto wait() -> tinytc::shared_handle<tinytc_binary_t>;
+
+  private:
+    tinytc::shared_handle<tinytc_prog_t> prg_;
+    tinytc::shared_handle<tinytc_core_info_t> info_;
+    tinytc_compile_callback_t callback_;
+    void *user_data_;
+    std::atomic<bool> cancel_requested_ = false;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    tinytc::compile_job_state state_ = tinytc::compile_job_state::queued;
+    tinytc_status_t status_ = tinytc_status_success;
+    tinytc::shared_handle<tinytc_binary_t> bin_;
+};
+
+namespace tinytc {
+
+//! Process-wide pool of worker threads executing compile jobs
+class compile_job_queue {
+  public:
+    static auto get() -> compile_job_queue &;
+
+    ~compile_job_queue();
+
+    //! Enqueue job; the queue keeps a reference to the job until it has run
+    void submit(shared_handle<tinytc_compile_job_t> job, compile_priority priority);
+
+    /**
+     * @brief Replace worker threads
+     *
+     * Blocks until all previously submitted jobs have run; must not be called from a job callback.
+     *
+     * @param num_threads Number of worker threads; 0 selects the number of hardware threads
+     */
+    void num_threads(std::size_t num_threads);
+
+  private:
+    compile_job_queue() = default;
+
+    std::mutex mutex_;
+    std::unique_ptr<thread_pool> pool_;
+};
+
+} // namespace tinytc
+
+#endif // COMPILE_JOB_20251016_HPP
@@ -1,85 +1,224 @@
 // Copyright (C) 2024 Intel Corporation
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include "compiler.hpp"
+#include "analysis/cost.hpp"
+#include "binary.hpp"
+#include "binary_cache.hpp"
 #include "compiler_context.hpp"
+#include "device_info.hpp"
 #include "error.hpp"
+#include "node/func.hpp"
+#include "node/inst.hpp"
+#include "node/inst_view.hpp"
 #include "node/prog.hpp"
-// IWYU pragma: begin_keep
-#include "pass/dump_cfg.hpp"
-#include "pass/dump_def_use.hpp"
-#include "pass/dump_gcd.hpp"
-#include "pass/dump_ir.hpp"
-// IWYU pragma: end_keep
-#include "pass/check_ir.hpp"
-#include "pass/constant_propagation.hpp"
+#include "node/type.hpp"
+#include "node/value.hpp"
 #include "pass/convert_to_spirv.hpp"
-#include "pass/dead_code_elimination.hpp"
-#include "pass/insert_barrier.hpp"
-#include "pass/insert_lifetime_stop.hpp"
-#include "pass/lower_coopmatrix.hpp"
-#include "pass/lower_foreach.hpp"
-#include "pass/lower_linalg.hpp"
-#include "pass/stack.hpp"
-#include "pass/work_group_size.hpp"
-#include "passes.hpp"
+#include "pass_manager.hpp"
 #include "spv/pass/assemble.hpp"
+#include "specialization.hpp"
 #include "spv/pass/assign_ids.hpp"
+#include "support/json.hpp"
+#include "support/thread_pool.hpp"
+#include "support/walk.hpp"
 #include "tinytc/core.h"
 #include "tinytc/types.h"
 #include "tinytc/types.hpp"
+#include "util/casting.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
 #include <cstring>
-#include <iostream> // IWYU pragma: keep
+#include <memory>
+#include <sstream>
+#include <string>
 #include <utility>
+#include <vector>
 
 using namespace tinytc;
 
 namespace tinytc {
 
-template <typename PassT> struct optflag_setter {
-    PassT &pass;
-    tinytc_compiler_context_t ctx;
+namespace {
 
-    template <typename... Flags> void operator()(Flags &&...flags) {
-        (pass.set_opt_flag(flags, ctx->opt_flag(flags)), ...);
+void check_cancelled(std::atomic<bool> const *cancel) {
+    if (cancel && cancel->load()) {
+        throw status::compilation_cancelled;
     }
-};
+}
 
-void apply_default_optimization_pipeline(tinytc_prog_t prg, const_tinytc_core_info_t info) {
-    auto ctx = prg->context();
-    const auto opt_level = ctx->opt_level();
+//! Only linalg instructions and cooperative matrices occupy enough registers to spill
+auto may_spill(tinytc_prog &prg) -> bool {
+    bool result = false;
+    for (auto &fn : prg) {
+        walk<walk_order::pre_order>(fn, [&result](tinytc_inst &in) {
+            result = result || isa<blas_a2_inst>(in) || isa<blas_a3_inst>(in) ||
+                     std::any_of(in.result_begin(), in.result_end(), [](tinytc_value const &v) {
+                         return isa<coopmatrix_type>(*v.ty());
+                     });
+        });
+    }
+    return result;
+}
+
+} // namespace
 
-    // passes
-    auto cpp = constant_propagation_pass{};
-    optflag_setter{cpp, ctx}(tinytc::optflag::unsafe_fp_math);
+auto default_optimization_pipeline(tinytc_compiler_context_t ctx, const_tinytc_core_info_t info)
+    -> pass_pipeline {
+    const auto opt_level = ctx->opt_level();
+    auto pipeline = pass_pipeline{ctx, info};
 
-    run_function_pass(check_ir_pass{}, *prg);
+    pipeline.add_pass("check-ir");
 
     if (opt_level >= 1) {
         // We run constant propagation + dead code elimination early to capture dead allocas
         // (later on they are maybe "in use" due to the lifetime_stop instruction)
-        run_function_pass(cpp, *prg);
-        run_function_pass(dead_code_elimination_pass{}, *prg);
+        pipeline.add_pass("constant-propagation");
+        pipeline.add_pass("dead-code-elimination");
     }
 
-    run_function_pass(insert_lifetime_stop_pass{}, *prg);
-    run_function_pass(set_stack_ptr_pass{}, *prg);
-    run_function_pass(insert_barrier_pass{}, *prg);
-    run_function_pass(work_group_size_pass{info}, *prg);
+    pipeline.add_pass("insert-lifetime-stop");
+    pipeline.add_pass("set-stack-ptr");
+    pipeline.add_pass("insert-barrier");
+    pipeline.add_pass("work-group-size");
 
-    run_function_pass(lower_linalg_pass{info}, *prg);
+    pipeline.add_pass("lower-linalg");
     // Run set stack ptr again as lower linalg may introduce allocas for the duration of the
     // linalg op. Lower linalg is expected to insert lifetime_stop instructions, after it is done
     // so we do not need to run the lifetime stop pass again.
-    run_function_pass(set_stack_ptr_pass{}, *prg);
-    run_function_pass(lower_foreach_pass{info}, *prg);
+    pipeline.add_pass("set-stack-ptr");
+    pipeline.add_pass("lower-foreach");
     if (opt_level >= 1) {
-        run_function_pass(cpp, *prg);
-        run_function_pass(dead_code_elimination_pass{}, *prg);
+        pipeline.add_pass("constant-propagation");
+        pipeline.add_pass("dead-code-elimination");
+        pipeline.add_pass("loop-unroll");
+        // Lowering and unrolling leave index arithmetic and subviews that do not depend on the
+        // loop variable inside loop bodies; dead code elimination needs to run first such that
+        // constant if conditions do not block hoisting
+        pipeline.add_pass("loop-invariant-code-motion");
+        pipeline.add_pass("constant-propagation");
+        pipeline.add_pass("common-subexpression-elimination");
+        pipeline.add_pass("strength-reduction");
+        pipeline.add_pass("narrow-index");
+        pipeline.add_pass("dead-code-elimination");
+    }
+    pipeline.add_pass("lower-coopmatrix");
+    if (opt_level >= 1) {
+        pipeline.add_pass("common-subexpression-elimination");
+        pipeline.add_pass("dead-code-elimination");
     }
-    run_function_pass(lower_coopmatrix_pass{info}, *prg);
 
-    run_function_pass(check_ir_pass{}, *prg);
+    pipeline.add_pass("check-ir");
+    return pipeline;
+}
+
+void apply_default_optimization_pipeline(tinytc_prog_t prg, const_tinytc_core_info_t info,
+                                         std::atomic<bool> const *cancel) {
+    auto ctx = prg->context();
+    auto const pipeline = default_optimization_pipeline(ctx, info);
+    // Function passes only modify the function they run on, therefore the pipeline may run on
+    // all functions concurrently
+    auto funcs = std::vector<tinytc_func *>{};
+    for (auto &fn : *prg) {
+        funcs.emplace_back(&fn);
+    }
+    // Keep the pool alive even if the number of threads is changed concurrently
+    auto const pool = ctx->thread_pool();
+    parallel_for(pool.get(), funcs.size(), [&](std::size_t i) {
+        check_cancelled(cancel);
+        pipeline.run_on_function(*funcs[i]);
+    });
+}
+
+auto lower_program(tinytc_prog &prg, const_tinytc_core_info_t info,
+                   std::atomic<bool> const *cancel) -> shared_handle<tinytc_core_info_t> {
+    constexpr auto register_file_flags = tinytc_core_feature_flag_large_register_file |
+                                         tinytc_core_feature_flag_small_register_file;
+    if (!info->has_large_register_file() || (info->core_features() & register_file_flags) ||
+        !may_spill(prg)) {
+        apply_default_optimization_pipeline(&prg, info, cancel);
+        return {};
+    }
+
+    // The program is lowered for the small register file first; the large register file is only
+    // considered if a function is expected to spill. Lowering is destructive, hence the unlowered
+    // program needs to be kept for the retry.
+    auto large_grf_prg = clone_program(prg);
+    apply_default_optimization_pipeline(&prg, info, cancel);
+    auto const spills = [](function_cost const &cost) {
+        return cost.register_pressure > cost.register_space;
+    };
+    auto small_costs = std::vector<function_cost>{};
+    for (auto &fn : prg) {
+        small_costs.emplace_back(cost_analysis{info}.run_on_function(fn));
+    }
+    if (std::none_of(small_costs.begin(), small_costs.end(), spills)) {
+        return {};
+    }
+
+    auto large_grf_info = info->clone();
+    large_grf_info->core_features(info->core_features() |
+                                  tinytc_core_feature_flag_large_register_file);
+    apply_default_optimization_pipeline(large_grf_prg.get(), large_grf_info.get(), cancel);
+
+    // The register file is chosen for the whole binary; we compare the geometric mean of the
+    // estimated throughput over all functions
+    constexpr double min_score = 1e-6;
+    double log_ratio = 0.0;
+    std::size_t i = 0;
+    for (auto &fn : *large_grf_prg) {
+        auto const large_cost = cost_analysis{large_grf_info.get()}.run_on_function(fn);
+        auto const large_score =
+            std::max(min_score, throughput_score(large_cost, large_grf_info.get()));
+        auto const small_score = std::max(min_score, throughput_score(small_costs[i++], info));
+        log_ratio += std::log(large_score / small_score);
+    }
+    if (log_ratio <= 0.0) {
+        return {};
+    }
+    prg.swap_funcs(*large_grf_prg);
+    return large_grf_info;
+}
+
+auto compile_to_binary(tinytc_prog &prg, const_tinytc_core_info_t info,
+                       std::atomic<bool> const *cancel) -> shared_handle<tinytc_binary_t> {
+    auto const cache = prg.context()->binary_cache();
+    auto const key = cache ? binary_cache::make_key(prg, *info) : std::string{};
+    if (cache) {
+        if (auto cached = cache->load(key, prg.share_context()); cached) {
+            return cached;
+        }
+    }
+
+    check_cancelled(cancel);
+    auto const selected_info = lower_program(prg, info, cancel);
+    check_cancelled(cancel);
+    auto mod =
+        convert_to_spirv_pass{selected_info ? selected_info.get() : info}.run_on_program(prg);
+    spv::id_assigner{}.run_on_module(*mod);
+    check_cancelled(cancel);
+    auto bin = spv::assembler{}.run_on_module(*mod);
+
+    if (cache) {
+        cache->store(key, *bin);
+    }
+    return bin;
+}
+
+auto estimate_cost(tinytc_prog &prg, const_tinytc_core_info_t info)
+    -> std::vector<std::pair<std::string, function_cost>> {
+    auto lowered = clone_program(prg);
+    auto const selected_info = lower_program(*lowered, info);
+    auto analysis = cost_analysis{selected_info ? selected_info.get() : info};
+    auto costs = std::vector<std::pair<std::string, function_cost>>{};
+    for (auto &fn : *lowered) {
+        costs.emplace_back(std::string(fn.name()), analysis.run_on_function(fn));
+    }
+    return costs;
 }
 
 } // namespace tinytc
@@ -88,42 +227,35 @@ extern "C" {
 
 tinytc_status_t tinytc_run_function_pass(char const *pass_name, tinytc_prog_t prg,
                                          const_tinytc_core_info_t info) {
-    if (prg == nullptr) {
+    if (pass_name == nullptr || prg == nullptr) {
         return tinytc_status_invalid_arguments;
     }
     return exception_to_status_code(
         [&] {
-#define FUNCTION_PASS(NAME, CREATE_PASS, ...)                                                      \
-    if (strcmp(NAME, pass_name) == 0) {                                                            \
-        auto pass = CREATE_PASS;                                                                   \
-        optflag_setter{pass, prg->context()}(__VA_ARGS__);                                         \
-        return run_function_pass(std::move(pass), *prg);                                           \
-    }
-#define FUNCTION_PASS_WITH_INFO(NAME, CREATE_PASS)                                                 \
-    if (strcmp(NAME, pass_name) == 0) {                                                            \
-        return run_function_pass(CREATE_PASS(info), *prg);                                         \
-    }
-#include "passes.def"
-#undef FUNCTION_PASS
-#undef FUNCTION_PASS_WITH_INFO
-            throw status::unknown_pass_name;
+            auto pipeline = pass_pipeline{prg->context(), info};
+            pipeline.add_pass(pass_name);
+            pipeline.run_on_program(*prg);
         },
         prg->context());
 }
 
+tinytc_status_t tinytc_run_function_pass_pipeline(char const *pipeline, tinytc_prog_t prg,
+                                                  const_tinytc_core_info_t info) {
+    if (pipeline == nullptr || prg == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code(
+        [&] { pass_pipeline{pipeline, prg->context(), info}.run_on_program(*prg); },
+        prg->context());
+}
+
 tinytc_status_t tinytc_list_function_passes(size_t *names_size, char const *const **names) {
     if (names_size == nullptr || names == nullptr) {
         return tinytc_status_invalid_arguments;
     }
-#define FUNCTION_PASS(NAME, CREATE_PASS, ...) NAME,
-#define FUNCTION_PASS_WITH_INFO(NAME, CREATE_PASS) NAME,
-    static char const *const pass_names[] = {
-#include "passes.def"
-    };
-#undef FUNCTION_PASS
-#undef FUNCTION_PASS_WITH_INFO
-    *names_size = sizeof(pass_names) / sizeof(char const *);
-    *names = pass_names;
+    auto const &pass_names = pass_pipeline::pass_names();
+    *names_size = pass_names.size();
+    *names = pass_names.data();
 
     return tinytc_status_success;
 }
@@ -135,9 +267,11 @@ tinytc_status_t tinytc_prog_compile_to_spirv(tinytc_spv_mod_t *mod, tinytc_prog_
     }
     return exception_to_status_code(
         [&] {
-            apply_default_optimization_pipeline(prg, info);
+            auto const selected_info = lower_program(*prg, info);
 
-            *mod = convert_to_spirv_pass{info}.run_on_program(*prg).release();
+            *mod = convert_to_spirv_pass{selected_info ? selected_info.get() : info}
+                       .run_on_program(*prg)
+                       .release();
             spv::id_assigner{}.run_on_module(**mod);
         },
         prg->context());
@@ -148,11 +282,8 @@ tinytc_status_t tinytc_prog_compile_to_spirv_and_assemble(tinytc_binary_t *bin,
     if (bin == nullptr || prg == nullptr || info == nullptr) {
         return tinytc_status_invalid_arguments;
     }
-    tinytc_spv_mod_t mod;
-    TINYTC_CHECK_STATUS(tinytc_prog_compile_to_spirv(&mod, prg, info));
-    auto mod_ = shared_handle{mod}; // For clean-up
-    TINYTC_CHECK_STATUS(tinytc_spirv_assemble(bin, mod_.get()));
-    return tinytc_status_success;
+    return exception_to_status_code([&] { *bin = compile_to_binary(*prg, info).release(); },
+                                    prg->context());
 }
 
 tinytc_status_t tinytc_spirv_assemble(tinytc_binary_t *bin, const_tinytc_spv_mod_t mod) {
@@ -161,4 +292,59 @@ tinytc_status_t tinytc_spirv_assemble(tinytc_binary_t *bin, const_tinytc_spv_mod
     }
     return exception_to_status_code([&] { *bin = spv::assembler{}.run_on_module(*mod).release(); });
 }
+
+tinytc_status_t tinytc_prog_estimate_cost(tinytc_function_cost_t *cost, tinytc_prog_t prg,
+                                          char const *func_name, const_tinytc_core_info_t info) {
+    if (cost == nullptr || prg == nullptr || func_name == nullptr || info == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code(
+        [&] {
+            auto const costs = estimate_cost(*prg, info);
+            auto it = std::find_if(costs.begin(), costs.end(),
+                                   [&](auto const &c) { return c.first == func_name; });
+            if (it == costs.end()) {
+                throw status::invalid_arguments;
+            }
+            *cost = it->second;
+        },
+        prg->context());
+}
+
+tinytc_status_t tinytc_prog_get_cost_report(char **json, tinytc_prog_t prg,
+                                            const_tinytc_core_info_t info) {
+    if (json == nullptr || prg == nullptr || info == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code(
+        [&] {
+            auto const costs = estimate_cost(*prg, info);
+            auto oss = std::ostringstream{};
+            oss << "{\n  \"functions\": [";
+            for (std::size_t i = 0; i < costs.size(); ++i) {
+                auto const &c = costs[i].second;
+                oss << (i > 0 ? ",\n" : "\n") << "    {\"name\": ";
+                write_json_string(oss, costs[i].first);
+                oss << ", \"subgroup_size\": " << c.subgroup_size << ", \"work_group_size\": ["
+                    << c.work_group_size[0] << ", " << c.work_group_size[1]
+                    << "], \"flops\": " << c.flops << ", \"global_bytes\": " << c.global_bytes
+                    << ", \"local_bytes\": " << c.local_bytes
+                    << ", \"arithmetic_intensity\": " << c.arithmetic_intensity
+                    << ", \"barriers\": " << c.barriers << ", \"slm_size\": " << c.slm_size
+                    << ", \"register_pressure\": " << c.register_pressure
+                    << ", \"register_space\": " << c.register_space
+                    << ", \"occupancy\": " << c.occupancy << ", \"dynamic_trip_count\": "
+                    << (c.dynamic_trip_count ? "true" : "false") << "}";
+            }
+            oss << (costs.empty() ? "]" : "\n  ]") << "\n}\n";
+            auto const text = std::move(oss).str();
+            auto const length = text.size() + 1; // Need to include terminating null character
+            *json = (char *)malloc(length * sizeof(char));
+            if (!*json) {
+                throw status::bad_alloc;
+            }
+            std::strncpy(*json, text.c_str(), length);
+        },
+        prg->context());
+}
 }
@@ -0,0 +1,78 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef COMPILER_20251016_HPP
+#define COMPILER_20251016_HPP
+
+#include "pass_manager.hpp"
+#include "tinytc/types.h"
+#include "tinytc/types.hpp"
+
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tinytc {
+
+auto default_optimization_pipeline(tinytc_compiler_context_t ctx, const_tinytc_core_info_t info)
+    -> pass_pipeline;
+
+/**
+ * @brief Run default optimization pipeline on all functions of the program
+ *
+ * @param prg Program
+ * @param info Core info
+ * @param cancel If not nullptr, status::compilation_cancelled is thrown before a function is
+ * optimized when *cancel is true
+ */
+void apply_default_optimization_pipeline(tinytc_prog_t prg, const_tinytc_core_info_t info,
+                                         std::atomic<bool> const *cancel = nullptr);
+
+/**
+ * @brief Run default optimization pipeline and select the register file
+ *
+ * If the device offers a large register file and the core features of info request neither
+ * the large nor the small register file, the program is lowered for both register files and the
+ * register file with the higher estimated throughput is selected (cf. throughput_score).
+ *
+ * @param prg Program; modified by the optimization pipeline
+ * @param info Core info
+ * @param cancel Cancellation flag; may be nullptr
+ *
+ * @return Core info with the large register file enabled if the large register file was
+ * selected; nullptr if the program was lowered for info
+ */
+auto lower_program(tinytc_prog &prg, const_tinytc_core_info_t info,
+                   std::atomic<bool> const *cancel = nullptr) -> shared_handle<tinytc_core_info_t>;
+
+/**
+ * @brief Compile program to SPIR-V binary; the binary cache is used if enabled
+ *
+ * Cancellation is cooperative: *cancel is checked between compilation stages and
+ * status::compilation_cancelled is thrown if it is true.
+ *
+ * @param prg Program; modified by the optimization pipeline
+ * @param info Core info
+ * @param cancel Cancellation flag; may be nullptr
+ *
+ * @return Binary
+ */
+auto compile_to_binary(tinytc_prog &prg, const_tinytc_core_info_t info,
+                       std::atomic<bool> const *cancel = nullptr)
+    -> shared_handle<tinytc_binary_t>;
+
+/**
+ * @brief Estimate cost of all functions with the static cost model
+ *
+ * @param prg Program; not modified, as the default optimization pipeline is run on a copy
+ * @param info Core info
+ *
+ * @return Function names and cost estimates
+ */
+auto estimate_cost(tinytc_prog &prg, const_tinytc_core_info_t info)
+    -> std::vector<std::pair<std::string, function_cost>>;
+
+} // namespace tinytc
+
+#endif // COMPILER_20251016_HPP
@@ -2,14 +2,25 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include "compiler_context.hpp"
+#include "autotune.hpp"
+#include "binary_cache.hpp"
 #include "compiler_context_cache.hpp"
 #include "error.hpp"
 #include "node/value.hpp"
+#include "pass_statistics.hpp"
+#include "support/thread_pool.hpp"
 #include "tinytc/core.h"
 #include "tinytc/types.h"
 #include "tinytc/types.hpp"
 
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
 
 namespace tinytc {
 void default_error_reporter(char const *, const tinytc_location_t *, void *) {}
@@ -20,10 +31,43 @@ using namespace tinytc;
 extern "C" {
 
 tinytc_compiler_context::tinytc_compiler_context()
-    : cache_{std::make_unique<compiler_context_cache>(this)} {
+    : cache_{std::make_unique<compiler_context_cache>(this)},
+      binary_cache_{tinytc::binary_cache::from_environment()},
+      tuning_db_{tinytc::tuning_database::from_environment()} {
     opt_flags_.fill(-1);
 }
 
+void tinytc_compiler_context::num_threads(std::int32_t num_threads) {
+    if (num_threads < 0) {
+        throw status::invalid_arguments;
+    }
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // Compilations running concurrently keep the old pool alive until they are finished
+    auto old_pool = std::shared_ptr<tinytc::thread_pool>{};
+    {
+        auto lock = std::lock_guard{thread_pool_mutex_};
+        if (num_threads == num_threads_) {
+            return;
+        }
+        // The calling thread participates in parallel loops so we need one worker less
+        old_pool = std::exchange(thread_pool_,
+                                 num_threads > 1
+                                     ? std::make_shared<tinytc::thread_pool>(num_threads - 1)
+                                     : nullptr);
+        num_threads_ = num_threads;
+    }
+}
+
+auto tinytc_compiler_context::tuning_db_or_create() -> std::shared_ptr<tinytc::tuning_database> {
+    auto lock = std::lock_guard{tuning_db_mutex_};
+    if (!tuning_db_) {
+        tuning_db_ = std::make_shared<tinytc::tuning_database>();
+    }
+    return tuning_db_;
+}
+
 auto tinytc_compiler_context::source_name(std::int32_t source_id)
     -> std::pair<char const *, std::size_t> {
     if (has_source_id(source_id)) {
@@ -112,6 +156,69 @@ tinytc_status_t tinytc_compiler_context_set_optimization_level(tinytc_compiler_c
     return tinytc_status_success;
 }
 
+tinytc_status_t tinytc_compiler_context_set_binary_cache(tinytc_compiler_context_t ctx,
+                                                         char const *path, uint64_t max_size) {
+    if (ctx == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code([&] {
+        if (path == nullptr || *path == '\0') {
+            ctx->binary_cache(nullptr);
+        } else {
+            ctx->binary_cache(std::make_unique<binary_cache>(path, max_size));
+        }
+    });
+}
+
+tinytc_status_t tinytc_compiler_context_set_tuning_database(tinytc_compiler_context_t ctx,
+                                                            char const *filename) {
+    if (ctx == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code([&] {
+        if (filename == nullptr) {
+            ctx->tuning_db(nullptr);
+        } else {
+            ctx->tuning_db(std::make_unique<tuning_database>(filename));
+        }
+    });
+}
+
+tinytc_status_t tinytc_compiler_context_set_num_threads(tinytc_compiler_context_t ctx,
+                                                        int32_t num_threads) {
+    if (ctx == nullptr || num_threads < 0) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code([&] { ctx->num_threads(num_threads); });
+}
+
+tinytc_status_t tinytc_compiler_context_set_pass_statistics(tinytc_compiler_context_t ctx,
+                                                            tinytc_bool_t enable) {
+    if (ctx == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code(
+        [&] { ctx->pass_stats(enable ? std::make_unique<pass_statistics>() : nullptr); });
+}
+
+tinytc_status_t tinytc_compiler_context_get_pass_statistics(const_tinytc_compiler_context_t ctx,
+                                                            tinytc_bool_t per_function,
+                                                            char **json) {
+    if (ctx == nullptr || json == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code([&] {
+        auto const text =
+            ctx->pass_stats() ? ctx->pass_stats()->to_json(per_function) : std::string{};
+        auto const length = text.size() + 1; // Need to include terminating null character
+        *json = (char *)malloc(length * sizeof(char));
+        if (!*json) {
+            throw status::bad_alloc;
+        }
+        std::strncpy(*json, text.c_str(), length);
+    });
+}
+
 tinytc_status_t tinytc_compiler_context_report_error(tinytc_compiler_context_t ctx,
                                                      const tinytc_location_t *location,
                                                      char const *what) {
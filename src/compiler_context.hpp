@@ -4,8 +4,12 @@
 #ifndef COMPILER_CONTEXT_20240924_HPP
 #define COMPILER_CONTEXT_20240924_HPP
 
+#include "autotune.hpp"
+#include "binary_cache.hpp"
 #include "compiler_context_cache.hpp"
+#include "pass_statistics.hpp"
 #include "reference_counted.hpp"
+#include "support/thread_pool.hpp"
 #include "tinytc/core.hpp"
 #include "tinytc/types.h"
 
@@ -13,6 +17,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -27,12 +32,54 @@ struct tinytc_compiler_context : tinytc::reference_counted {
   public:
     constexpr static const char unavailable_source_name[] = "Source name unavailable";
     constexpr static std::array<std::array<bool, TINYTC_ENUM_NUM_OPTFLAG>, 3u> default_opt_flags = {
-        {{false}, {false}, {true}}};
+        {{false, false}, {false, false}, {true, false}}};
 
     tinytc_compiler_context();
 
     inline auto cache() -> tinytc::compiler_context_cache * { return cache_.get(); }
 
+    //! Returns on-disk binary cache or nullptr if the binary cache is disabled
+    //!
+    //! The cache is shared such that it stays alive for a compilation that runs concurrently to
+    //! binary_cache(cache)
+    inline auto binary_cache() const -> std::shared_ptr<tinytc::binary_cache const> {
+        auto lock = std::lock_guard{binary_cache_mutex_};
+        return binary_cache_;
+    }
+    inline void binary_cache(std::shared_ptr<tinytc::binary_cache> cache) {
+        auto lock = std::lock_guard{binary_cache_mutex_};
+        binary_cache_ = std::move(cache);
+    }
+
+    //! Returns tuning database or nullptr if the tuning database is disabled
+    inline auto tuning_db() const -> std::shared_ptr<tinytc::tuning_database> {
+        auto lock = std::lock_guard{tuning_db_mutex_};
+        return tuning_db_;
+    }
+    inline void tuning_db(std::shared_ptr<tinytc::tuning_database> db) {
+        auto lock = std::lock_guard{tuning_db_mutex_};
+        tuning_db_ = std::move(db);
+    }
+    //! Returns tuning database; an in-memory database is created if none is set
+    auto tuning_db_or_create() -> std::shared_ptr<tinytc::tuning_database>;
+
+    //! Returns thread pool for parallel compilation or nullptr if compilation is serial
+    inline auto thread_pool() const -> std::shared_ptr<tinytc::thread_pool> {
+        auto lock = std::lock_guard{thread_pool_mutex_};
+        return thread_pool_;
+    }
+    inline auto num_threads() const -> std::int32_t {
+        auto lock = std::lock_guard{thread_pool_mutex_};
+        return num_threads_;
+    }
+    void num_threads(std::int32_t num_threads);
+
+    //! Returns pass statistics collector or nullptr if pass statistics are disabled
+    inline auto pass_stats() const -> tinytc::pass_statistics * { return pass_stats_.get(); }
+    inline void pass_stats(std::unique_ptr<tinytc::pass_statistics> stats) {
+        pass_stats_ = std::move(stats);
+    }
+
     inline void set_error_reporter(tinytc_error_reporter_t reporter, void *user_data) {
         reporter_ = reporter;
         user_data_ = user_data;
@@ -79,6 +126,14 @@ struct tinytc_compiler_context : tinytc::reference_counted {
     }
 
     std::unique_ptr<tinytc::compiler_context_cache> cache_;
+    mutable std::mutex binary_cache_mutex_;
+    std::shared_ptr<tinytc::binary_cache> binary_cache_;
+    mutable std::mutex tuning_db_mutex_;
+    std::shared_ptr<tinytc::tuning_database> tuning_db_;
+    mutable std::mutex thread_pool_mutex_;
+    std::shared_ptr<tinytc::thread_pool> thread_pool_;
+    std::int32_t num_threads_ = 1;
+    std::unique_ptr<tinytc::pass_statistics> pass_stats_;
     tinytc_error_reporter_t reporter_ = &tinytc::default_error_reporter;
     void *user_data_ = nullptr;
     std::vector<source_input> sources_;
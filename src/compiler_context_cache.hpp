@@ -7,12 +7,17 @@
 #include "tinytc/types.h"
 #include "util/fnv1a.hpp"
 
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string_view>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace std {
 template <> class hash<std::pair<tinytc_type_t, std::int64_t>> {
@@ -25,12 +30,36 @@ template <> class hash<std::pair<tinytc_type_t, std::int64_t>> {
 
 namespace tinytc {
 
+/**
+ * @brief Storage for interned objects
+ *
+ * get may be called concurrently. The storage is split into shards selected by the upper bits of
+ * the hash. Each shard is a chained hash table whose buckets are atomic singly-linked lists that
+ * are only ever prepended to. Hence, lookups of existing objects do not take a lock; only
+ * insertion locks the shard's mutex. When a shard grows, a new bucket array is published and the
+ * old one is retired (but kept alive until destruction) such that concurrent readers remain valid.
+ */
 template <typename T> class unique_storage {
   public:
-    unique_storage() = default;
+    constexpr static std::size_t num_shards = 16;
+    constexpr static std::size_t initial_num_buckets = 16;
+
+    unique_storage() {
+        for (auto &s : shards_) {
+            s.tables.emplace_back(std::make_unique<table>(initial_num_buckets));
+            s.current.store(s.tables.back().get(), std::memory_order_relaxed);
+        }
+    }
     ~unique_storage() {
-        for (auto &m : map_) {
-            delete m.second;
+        for (auto &s : shards_) {
+            // Each object is contained exactly once in the current table
+            auto tab = s.current.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < tab->num_buckets; ++i) {
+                for (auto n = tab->buckets[i].load(std::memory_order_relaxed); n;
+                     n = n->next.load(std::memory_order_relaxed)) {
+                    delete n->value;
+                }
+            }
         }
     }
 
@@ -41,18 +70,84 @@ template <typename T> class unique_storage {
 
     template <typename EqualFun, typename MakeFun>
     auto get(std::uint64_t hash, EqualFun &&is_equal, MakeFun &&make) -> T {
-        auto range = map_.equal_range(hash);
-        for (auto it = range.first; it != range.second; ++it) {
-            if (is_equal(it->second)) {
-                return it->second;
-            }
+        auto &s = shards_[hash >> (64 - shard_bits)];
+        if (auto value = find(*s.current.load(std::memory_order_acquire), hash, is_equal); value) {
+            return value;
         }
 
-        return map_.emplace(hash, make())->second;
+        auto lock = std::lock_guard{s.mutex};
+        auto tab = s.current.load(std::memory_order_relaxed);
+        if (auto value = find(*tab, hash, is_equal); value) {
+            return value;
+        }
+        auto value = make();
+        if (s.size >= 2 * tab->num_buckets) {
+            tab = grow(s, *tab);
+        }
+        insert(s, *tab, hash, value);
+        ++s.size;
+        return value;
     }
 
   private:
-    std::unordered_multimap<std::uint64_t, T> map_;
+    constexpr static int shard_bits = 4;
+    static_assert(num_shards == 1 << shard_bits);
+
+    struct node {
+        std::uint64_t hash;
+        T value;
+        std::atomic<node *> next;
+    };
+    struct table {
+        inline table(std::size_t num_buckets)
+            : num_buckets{num_buckets}, buckets{std::make_unique<std::atomic<node *>[]>(num_buckets)} {
+            for (std::size_t i = 0; i < num_buckets; ++i) {
+                buckets[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+        inline auto bucket(std::uint64_t hash) -> std::atomic<node *> & {
+            return buckets[hash & (num_buckets - 1)];
+        }
+
+        std::size_t num_buckets;
+        std::unique_ptr<std::atomic<node *>[]> buckets;
+    };
+    struct shard {
+        std::atomic<table *> current;
+        std::mutex mutex;
+        std::size_t size = 0;
+        std::vector<std::unique_ptr<table>> tables; // current table + retired tables
+        std::deque<node> nodes;                      // nodes of current table + retired tables
+    };
+
+    template <typename EqualFun>
+    static auto find(table &tab, std::uint64_t hash, EqualFun &is_equal) -> T {
+        for (auto n = tab.bucket(hash).load(std::memory_order_acquire); n;
+             n = n->next.load(std::memory_order_acquire)) {
+            if (n->hash == hash && is_equal(n->value)) {
+                return n->value;
+            }
+        }
+        return nullptr;
+    }
+    static void insert(shard &s, table &tab, std::uint64_t hash, T value) {
+        auto &b = tab.bucket(hash);
+        auto &n = s.nodes.emplace_back(hash, value, b.load(std::memory_order_relaxed));
+        b.store(&n, std::memory_order_release);
+    }
+    static auto grow(shard &s, table &tab) -> table * {
+        auto &new_tab = *s.tables.emplace_back(std::make_unique<table>(2 * tab.num_buckets));
+        for (std::size_t i = 0; i < tab.num_buckets; ++i) {
+            for (auto n = tab.buckets[i].load(std::memory_order_relaxed); n;
+                 n = n->next.load(std::memory_order_relaxed)) {
+                insert(s, new_tab, n->hash, n->value);
+            }
+        }
+        s.current.store(&new_tab, std::memory_order_release);
+        return &new_tab;
+    }
+
+    std::array<shard, num_shards> shards_;
 };
 
 class compiler_context_cache {
@@ -14,6 +14,7 @@
 #include <cstring>
 #include <limits>
 #include <memory>
+#include <sstream>
 #include <stdexcept>
 #include <utility>
 
@@ -21,6 +22,20 @@ tinytc_core_info::~tinytc_core_info() {}
 
 namespace tinytc {
 
+auto core_info_common::common_fingerprint() const -> std::string {
+    auto oss = std::ostringstream{};
+    oss << "alignment=" << alignment_ << ";spirv_features=";
+    for (auto const &f : spv_feature_) {
+        oss << (f ? '1' : '0');
+    }
+    return std::move(oss).str();
+}
+
+void core_info_common::copy_common(core_info_common const &other) {
+    spv_feature_ = other.spv_feature_;
+    alignment_ = other.alignment_;
+}
+
 core_info_generic::core_info_generic(std::int32_t register_space, std::int32_t max_work_group_size,
                                      std::vector<std::int32_t> subgroup_sizes)
     : register_space_(register_space), max_work_group_size_(max_work_group_size),
@@ -42,7 +57,34 @@ auto core_info_generic::get_core_config(std::int32_t subgroup_size) const -> tin
     }
     return core_config{subgroup_size, max_work_group_size_, register_space_, &matrix_};
 }
+auto core_info_generic::max_num_resident_subgroups(std::int32_t subgroup_size) const
+    -> std::int32_t {
+    return std::max(1, max_work_group_size_ / subgroup_size);
+}
+
+auto core_info_generic::local_memory_size() const -> std::int64_t { return 0; }
+
 auto core_info_generic::matrix() const -> matrix_ext_info const & { return matrix_; }
+auto core_info_generic::fingerprint() const -> std::string {
+    auto oss = std::ostringstream{};
+    oss << "generic;register_space=" << register_space_
+        << ";max_work_group_size=" << max_work_group_size_ << ";subgroup_sizes=";
+    for (auto const &sgs : subgroup_sizes_) {
+        oss << sgs << ',';
+    }
+    oss << ';' << common_fingerprint();
+    return std::move(oss).str();
+}
+auto core_info_generic::ip_version() const -> std::uint32_t { return 0u; }
+
+auto core_info_generic::has_large_register_file() const -> bool { return false; }
+
+auto core_info_generic::clone() const -> shared_handle<tinytc_core_info_t> {
+    auto copy =
+        std::make_unique<core_info_generic>(register_space_, max_work_group_size_, subgroup_sizes_);
+    copy->copy_common(*this);
+    return shared_handle<tinytc_core_info_t>{copy.release()};
+}
 
 core_info_intel::core_info_intel(std::uint32_t ip_version, std::int32_t num_eus_per_subslice,
                                  std::int32_t num_threads_per_eu,
@@ -100,7 +142,13 @@ auto core_info_intel::core_features() const -> tinytc_core_feature_flags_t {
     return core_features_;
 }
 
-void core_info_intel::core_features(tinytc_core_feature_flags_t flags) { core_features_ = flags; }
+void core_info_intel::core_features(tinytc_core_feature_flags_t flags) {
+    if ((flags & tinytc_core_feature_flag_large_register_file) &&
+        (flags & tinytc_core_feature_flag_small_register_file)) {
+        throw status::invalid_arguments;
+    }
+    core_features_ = flags;
+}
 
 auto core_info_intel::max_work_group_size(std::int32_t subgroup_size) const -> std::int32_t {
     auto const num_threads_per_eu_due_to_register_use =
@@ -131,8 +179,46 @@ auto core_info_intel::get_core_config(std::int32_t subgroup_size) const -> core_
                        &matrix_};
 }
 
+auto core_info_intel::max_num_resident_subgroups(std::int32_t subgroup_size) const
+    -> std::int32_t {
+    return max_work_group_size(subgroup_size) / subgroup_size;
+}
+
+auto core_info_intel::local_memory_size() const -> std::int64_t {
+    if (is_arch(tinytc_intel_gpu_architecture_pvc) || is_arch(tinytc_intel_gpu_architecture_bmg)) {
+        return 128 * 1024;
+    }
+    return 64 * 1024;
+}
+
 auto core_info_intel::matrix() const -> matrix_ext_info const & { return matrix_; }
 
+auto core_info_intel::fingerprint() const -> std::string {
+    auto oss = std::ostringstream{};
+    oss << "intel;ip_version=" << ip_version_ << ";num_eus_per_subslice=" << num_eus_per_subslice_
+        << ";num_threads_per_eu=" << num_threads_per_eu_ << ";core_features=" << core_features_
+        << ";subgroup_sizes=";
+    for (auto const &sgs : subgroup_sizes_) {
+        oss << sgs << ',';
+    }
+    oss << ';' << common_fingerprint();
+    return std::move(oss).str();
+}
+
+auto core_info_intel::ip_version() const -> std::uint32_t { return ip_version_; }
+
+auto core_info_intel::has_large_register_file() const -> bool {
+    return num_reg_large_grf() > num_reg_small_grf();
+}
+
+auto core_info_intel::clone() const -> shared_handle<tinytc_core_info_t> {
+    auto copy = std::make_unique<core_info_intel>(ip_version_, num_eus_per_subslice_,
+                                                  num_threads_per_eu_, subgroup_sizes_);
+    copy->copy_common(*this);
+    copy->core_features_ = core_features_;
+    return shared_handle<tinytc_core_info_t>{copy.release()};
+}
+
 } // namespace tinytc
 
 using namespace tinytc;
@@ -11,6 +11,7 @@
 
 #include <array>
 #include <cstdint>
+#include <string>
 #include <vector>
 
 namespace tinytc {
@@ -43,11 +44,23 @@ struct tinytc_core_info : tinytc::reference_counted {
     virtual auto minmax_work_group_size() const -> std::int32_t = 0;
     //! Return core config for specific subgroup size and number of registers per tile
     virtual auto get_core_config(std::int32_t subgroup_size) const -> tinytc::core_config = 0;
+    //! Returns the maximum number of subgroups that may be resident on a core at the same time
+    virtual auto max_num_resident_subgroups(std::int32_t subgroup_size) const -> std::int32_t = 0;
+    //! Returns the shared local memory size of a core in bytes or 0 if unknown
+    virtual auto local_memory_size() const -> std::int64_t = 0;
     virtual void set_spirv_feature(tinytc::spirv_feature f, bool available) = 0;
     virtual auto have_spirv_feature(tinytc::spirv_feature f) const -> bool = 0;
     virtual auto matrix() const -> tinytc::matrix_ext_info const & = 0;
     virtual auto alignment() const -> std::int32_t = 0;
     virtual void alignment(std::int32_t alignment) = 0;
+    //! Returns a string that uniquely identifies all properties relevant for code generation
+    virtual auto fingerprint() const -> std::string = 0;
+    //! Returns IP version of the device or 0 if the device is not an Intel GPU
+    virtual auto ip_version() const -> std::uint32_t = 0;
+    //! Returns true if the device offers a large register file in addition to the default one
+    virtual auto has_large_register_file() const -> bool = 0;
+    //! Returns a copy of the core info
+    virtual auto clone() const -> tinytc::shared_handle<tinytc_core_info_t> = 0;
 };
 
 namespace tinytc {
@@ -63,6 +76,10 @@ class core_info_common : public ::tinytc_core_info {
     inline auto alignment() const -> std::int32_t override { return alignment_; }
     inline void alignment(std::int32_t alignment) override { alignment_ = alignment; }
 
+  protected:
+    auto common_fingerprint() const -> std::string;
+    void copy_common(core_info_common const &other);
+
   private:
     std::array<bool, TINYTC_ENUM_NUM_SPIRV_FEATURE> spv_feature_ = {};
     std::int32_t alignment_ = 128;
@@ -78,7 +95,13 @@ class core_info_generic : public core_info_common {
     void core_features(tinytc_core_feature_flags_t flags) override;
     auto minmax_work_group_size() const -> std::int32_t override;
     auto get_core_config(std::int32_t subgroup_size) const -> tinytc::core_config override;
+    auto max_num_resident_subgroups(std::int32_t subgroup_size) const -> std::int32_t override;
+    auto local_memory_size() const -> std::int64_t override;
     auto matrix() const -> matrix_ext_info const & override;
+    auto fingerprint() const -> std::string override;
+    auto ip_version() const -> std::uint32_t override;
+    auto has_large_register_file() const -> bool override;
+    auto clone() const -> shared_handle<tinytc_core_info_t> override;
 
   private:
     std::int32_t register_space_;
@@ -113,7 +136,19 @@ class core_info_intel : public core_info_common {
     auto minmax_work_group_size() const -> std::int32_t override;
     //! @copydoc ::tinytc_core_info::get_core_config
     auto get_core_config(std::int32_t subgroup_size) const -> core_config override;
+    //! @copydoc ::tinytc_core_info::max_num_resident_subgroups
+    auto max_num_resident_subgroups(std::int32_t subgroup_size) const -> std::int32_t override;
+    //! @copydoc ::tinytc_core_info::local_memory_size
+    auto local_memory_size() const -> std::int64_t override;
     auto matrix() const -> matrix_ext_info const & override;
+    //! @copydoc ::tinytc_core_info::fingerprint
+    auto fingerprint() const -> std::string override;
+    //! @copydoc ::tinytc_core_info::ip_version
+    auto ip_version() const -> std::uint32_t override;
+    //! @copydoc ::tinytc_core_info::has_large_register_file
+    auto has_large_register_file() const -> bool override;
+    //! @copydoc ::tinytc_core_info::clone
+    auto clone() const -> shared_handle<tinytc_core_info_t> override;
 
   private:
     inline auto is_arch(tinytc_intel_gpu_architecture_t arch) const -> bool {
@@ -0,0 +1,264 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "fat_binary.hpp"
+#include "binary.hpp"
+#include "compiler.hpp"
+#include "compiler_context.hpp"
+#include "device_info.hpp"
+#include "error.hpp"
+#include "node/prog.hpp"
+#include "specialization.hpp"
+#include "support/mapped_file.hpp"
+#include "support/thread_pool.hpp"
+#include "tinytc/core.h"
+#include "tinytc/types.h"
+#include "util/casting.hpp"
+
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+using namespace tinytc;
+
+namespace {
+
+constexpr char fat_binary_magic[4] = {'T', 'T', 'C', 'F'};
+//! Format version; must be increased whenever the layout changes
+constexpr std::uint32_t fat_binary_version = 2;
+constexpr std::size_t header_size = 16;
+constexpr std::size_t entry_size = 32;
+constexpr std::size_t data_alignment = 16;
+
+template <typename T> auto read_le(std::uint8_t const *src) -> T {
+    T val = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        val |= static_cast<T>(src[i]) << (8 * i);
+    }
+    return val;
+}
+
+template <typename T> void write_le(std::uint8_t *dst, T val) {
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        dst[i] = static_cast<std::uint8_t>(val >> (8 * i));
+    }
+}
+
+auto serialize_fat_binary(array_view<std::uint32_t> ip_versions,
+                          array_view<tinytc_core_feature_flags_t> target_core_features,
+                          array_view<shared_handle<tinytc_binary_t>> bins)
+    -> std::vector<std::uint8_t> {
+    auto const align = [](std::size_t offset) {
+        return (offset + data_alignment - 1) / data_alignment * data_alignment;
+    };
+    std::size_t total_size = header_size + bins.size() * entry_size;
+    for (auto const &bin : bins) {
+        total_size = align(total_size) + bin->size();
+    }
+
+    auto data = std::vector<std::uint8_t>(total_size, 0);
+    std::memcpy(data.data(), fat_binary_magic, sizeof(fat_binary_magic));
+    write_le<std::uint32_t>(data.data() + 4, fat_binary_version);
+    write_le<std::uint32_t>(data.data() + 8, static_cast<std::uint32_t>(bins.size()));
+
+    std::size_t offset = header_size + bins.size() * entry_size;
+    for (std::size_t i = 0; i < bins.size(); ++i) {
+        auto const &bin = *bins[i];
+        offset = align(offset);
+        auto e = data.data() + header_size + i * entry_size;
+        write_le<std::uint32_t>(e, ip_versions[i]);
+        write_le<std::uint32_t>(e + 4, bin.core_features());
+        write_le<std::uint32_t>(e + 8, static_cast<std::uint32_t>(bin.format()));
+        write_le<std::uint32_t>(e + 12, target_core_features[i]);
+        write_le<std::uint64_t>(e + 16, offset);
+        write_le<std::uint64_t>(e + 24, bin.size());
+        std::memcpy(data.data() + offset, bin.data(), bin.size());
+        offset += bin.size();
+    }
+    return data;
+}
+
+auto make_shared_data(std::vector<std::uint8_t> data) -> std::shared_ptr<std::uint8_t const> {
+    auto owner = std::make_shared<std::vector<std::uint8_t>>(std::move(data));
+    return std::shared_ptr<std::uint8_t const>(owner, owner->data());
+}
+
+} // namespace
+
+tinytc_fat_binary::tinytc_fat_binary(shared_handle<tinytc_compiler_context_t> ctx,
+                                     std::shared_ptr<std::uint8_t const> data, std::size_t size)
+    : ctx_(std::move(ctx)), data_(std::move(data)), size_(size) {
+    auto const d = data_.get();
+    if (size_ < header_size ||
+        std::memcmp(d, fat_binary_magic, sizeof(fat_binary_magic)) != 0 ||
+        read_le<std::uint32_t>(d + 4) != fat_binary_version) {
+        throw status::invalid_fat_binary;
+    }
+    auto const num_entries = read_le<std::uint32_t>(d + 8);
+    if (num_entries > (size_ - header_size) / entry_size) {
+        throw status::invalid_fat_binary;
+    }
+    entries_.reserve(num_entries);
+    for (std::size_t i = 0; i < num_entries; ++i) {
+        auto const e = d + header_size + i * entry_size;
+        auto const format = read_le<std::uint32_t>(e + 8);
+        auto const offset = read_le<std::uint64_t>(e + 16);
+        auto const entry_data_size = read_le<std::uint64_t>(e + 24);
+        if (format >= TINYTC_ENUM_NUM_BUNDLE_FORMAT || offset > size_ ||
+            entry_data_size > size_ - offset) {
+            throw status::invalid_fat_binary;
+        }
+        entries_.emplace_back(entry{read_le<std::uint32_t>(e), read_le<std::uint32_t>(e + 4),
+                                    enum_cast<bundle_format>(format),
+                                    read_le<std::uint32_t>(e + 12), offset, entry_data_size});
+    }
+}
+
+auto tinytc_fat_binary::get(tinytc_core_info const &info) const -> shared_handle<tinytc_binary_t> {
+    auto const ip_version = info.ip_version();
+    auto const core_features = info.core_features();
+    auto const is_eligible = [&](entry const &e) {
+        return e.ip_version <= ip_version &&
+               ip_version <= e.ip_version + TINYTC_INTEL_GPU_ARCHITECTURE_SUB_VERSION_BITS &&
+               (e.target_core_features & ~core_features) == 0;
+    };
+    entry const *best = nullptr;
+    for (auto const &e : entries_) {
+        if (is_eligible(e) &&
+            (!best || e.ip_version > best->ip_version ||
+             (e.ip_version == best->ip_version &&
+              std::popcount(e.target_core_features) >
+                  std::popcount(best->target_core_features)))) {
+            best = &e;
+        }
+    }
+    if (!best) {
+        throw status::unsupported_device;
+    }
+    // The binary shares ownership of the fat binary data such that no copy is made
+    auto bin_data = std::shared_ptr<std::uint8_t const>(data_, data_.get() + best->offset);
+    return shared_handle{std::make_unique<tinytc_binary>(ctx_, std::move(bin_data), best->size,
+                                                         best->format, best->core_features)
+                             .release()};
+}
+
+namespace tinytc {
+
+auto compile_fat_binary(tinytc_prog &prg, array_view<const_tinytc_core_info_t> infos)
+    -> shared_handle<tinytc_fat_binary_t> {
+    auto ctx = prg.context();
+    auto ip_versions = std::vector<std::uint32_t>(infos.size());
+    auto target_core_features = std::vector<tinytc_core_feature_flags_t>(infos.size());
+    auto bins = std::vector<shared_handle<tinytc_binary_t>>(infos.size());
+    auto const pool = ctx->thread_pool();
+    parallel_for(pool.get(), infos.size(), [&](std::size_t i) {
+        auto copy = clone_program(prg);
+        ip_versions[i] = infos[i]->ip_version();
+        target_core_features[i] = infos[i]->core_features();
+        bins[i] = compile_to_binary(*copy, infos[i]);
+    });
+    auto data = serialize_fat_binary(ip_versions, target_core_features, bins);
+    auto const size = data.size();
+    return shared_handle{std::make_unique<tinytc_fat_binary>(prg.share_context(),
+                                                             make_shared_data(std::move(data)),
+                                                             size)
+                             .release()};
+}
+
+} // namespace tinytc
+
+extern "C" {
+
+tinytc_status_t tinytc_prog_compile_to_fat_binary(tinytc_fat_binary_t *fat, tinytc_prog_t prg,
+                                                  size_t info_size,
+                                                  const const_tinytc_core_info_t *infos) {
+    if (fat == nullptr || prg == nullptr || (info_size > 0 && infos == nullptr)) {
+        return tinytc_status_invalid_arguments;
+    }
+    for (size_t i = 0; i < info_size; ++i) {
+        if (infos[i] == nullptr) {
+            return tinytc_status_invalid_arguments;
+        }
+    }
+    return exception_to_status_code(
+        [&] { *fat = compile_fat_binary(*prg, array_view(infos, info_size)).release(); },
+        prg->context());
+}
+
+tinytc_status_t tinytc_fat_binary_create(tinytc_fat_binary_t *fat, tinytc_compiler_context_t ctx,
+                                         size_t data_size, uint8_t const *data) {
+    if (fat == nullptr || ctx == nullptr || (data_size > 0 && data == nullptr)) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code([&] {
+        auto copy = make_shared_data(std::vector<std::uint8_t>(data, data + data_size));
+        *fat = std::make_unique<tinytc_fat_binary>(shared_handle{ctx, true}, std::move(copy),
+                                                   data_size)
+                   .release();
+    });
+}
+
+tinytc_status_t tinytc_fat_binary_create_from_file(tinytc_fat_binary_t *fat,
+                                                   tinytc_compiler_context_t ctx,
+                                                   char const *filename) {
+    if (fat == nullptr || ctx == nullptr || filename == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code([&] {
+        std::size_t size = 0;
+        auto mapping = map_file(filename, size);
+        if (!mapping) {
+            throw status::file_io_error;
+        }
+        *fat = std::make_unique<tinytc_fat_binary>(shared_handle{ctx, true}, std::move(mapping),
+                                                   size)
+                   .release();
+    });
+}
+
+tinytc_status_t tinytc_fat_binary_get_raw(const_tinytc_fat_binary_t fat, size_t *data_size,
+                                          uint8_t const **data) {
+    if (fat == nullptr || data_size == nullptr || data == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    *data_size = fat->size();
+    *data = fat->data();
+    return tinytc_status_success;
+}
+
+tinytc_status_t tinytc_fat_binary_get_size(const_tinytc_fat_binary_t fat, size_t *num_entries) {
+    if (fat == nullptr || num_entries == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    *num_entries = fat->entries().size();
+    return tinytc_status_success;
+}
+
+tinytc_status_t tinytc_fat_binary_get_binary(const_tinytc_fat_binary_t fat,
+                                             const_tinytc_core_info_t info, tinytc_binary_t *bin) {
+    if (fat == nullptr || info == nullptr || bin == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code([&] { *bin = fat->get(*info).release(); });
+}
+
+tinytc_status_t tinytc_fat_binary_release(tinytc_fat_binary_t obj) {
+    if (obj == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    auto ref_count = obj->dec_ref();
+    if (ref_count == 0) {
+        delete obj;
+    }
+    return tinytc_status_success;
+}
+
+tinytc_status_t tinytc_fat_binary_retain(tinytc_fat_binary_t obj) {
+    if (obj == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    obj->inc_ref();
+    return tinytc_status_success;
+}
+}
@@ -0,0 +1,97 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef FAT_BINARY_20251016_HPP
+#define FAT_BINARY_20251016_HPP
+
+#include "reference_counted.hpp"
+#include "tinytc/core.hpp"
+#include "tinytc/types.h"
+#include "tinytc/types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Bundle of binaries compiled for different devices
+ *
+ * The serialized fat binary starts with a 16 byte header (magic bytes "TTCF", format version,
+ * number of entries, reserved word) followed by the entry table. Every entry occupies 32 bytes:
+ * IP version, core features of the binary, bundle format, core features of the compilation target,
+ * and the 64-bit offset and size of the binary data. All integers are little-endian. The binary
+ * data is 16 byte aligned such that the fat binary can be memory-mapped and entries are used
+ * in-place.
+ */
+struct tinytc_fat_binary : tinytc::reference_counted {
+  public:
+    //! Entry of the fat binary
+    struct entry {
+        std::uint32_t ip_version;                         ///< IP version of target device
+        tinytc_core_feature_flags_t core_features;        ///< Core features used by the binary
+        tinytc::bundle_format format;                     ///< Format of binary data
+        tinytc_core_feature_flags_t target_core_features; ///< Core features of target device
+        std::uint64_t offset;                             ///< Offset of binary data in bytes
+        std::uint64_t size;                               ///< Size of binary data in bytes
+    };
+
+    /**
+     * @brief Create fat binary from serialized data
+     *
+     * @param ctx Compiler context of binaries returned by get
+     * @param data Serialized fat binary; the memory is kept alive as long as the fat binary or
+     * any binary returned by get lives
+     * @param size Size of data in bytes
+     *
+     * Throws status::invalid_fat_binary if data is malformed or has an incompatible version.
+     */
+    tinytc_fat_binary(tinytc::shared_handle<tinytc_compiler_context_t> ctx,
+                      std::shared_ptr<std::uint8_t const> data, std::size_t size);
+
+    /**
+     * @brief Select the best entry for a device
+     *
+     * An entry is eligible if its IP version matches the architecture of the device and if the
+     * core features of its target are a subset of the core features of the device. Among the
+     * eligible entries, the entry with the most specific IP version and then the one with most
+     * target core features wins. The core features of the target and of the binary differ if the
+     * register file was selected automatically.
+     *
+     * @param info Core info of device
+     *
+     * @return Binary; throws status::unsupported_device if no entry is eligible
+     */
+    auto get(tinytc_core_info const &info) const -> tinytc::shared_handle<tinytc_binary_t>;
+
+    inline auto context() const -> tinytc_compiler_context_t { return ctx_.get(); }
+    inline auto data() const -> std::uint8_t const * { return data_.get(); }
+    inline auto size() const -> std::size_t { return size_; }
+    inline auto entries() const -> std::vector<entry> const & { return entries_; }
+
+  private:
+    tinytc::shared_handle<tinytc_compiler_context_t> ctx_;
+    std::shared_ptr<std::uint8_t const> data_;
+    std::size_t size_;
+    std::vector<entry> entries_;
+};
+
+namespace tinytc {
+
+/**
+ * @brief Compile program for several devices and bundle the binaries
+ *
+ * Every device gets its own copy of the program, hence prg is not modified. The devices are
+ * compiled concurrently on the thread pool of the compiler context.
+ *
+ * @param prg Program
+ * @param infos Core infos of target devices
+ *
+ * @return Fat binary
+ */
+auto compile_fat_binary(tinytc_prog &prg, array_view<const_tinytc_core_info_t> infos)
+    -> shared_handle<tinytc_fat_binary_t>;
+
+} // namespace tinytc
+
+#endif // FAT_BINARY_20251016_HPP
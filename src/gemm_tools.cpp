@@ -3,6 +3,7 @@
 
 #include "gemm_tools.hpp"
 
+#include <algorithm>
 #include <cstddef>
 
 namespace tinytc {
@@ -120,4 +121,30 @@ auto choose_k_block_size(array_view<std::int32_t> block_sizes, std::int64_t K) -
     return block_sizes[j];
 }
 
+auto choose_k_splits(std::int32_t num_tiles, std::int32_t num_subgroups, std::int64_t K)
+    -> std::int32_t {
+    if (num_tiles <= 0 || is_dynamic_value(K)) {
+        return 1;
+    }
+    std::int32_t splits = 1;
+    while (2 * splits * num_tiles <= num_subgroups && 2 * splits * min_split_k_size <= K) {
+        splits *= 2;
+    }
+    return splits;
+}
+
+auto choose_batch_packing(std::int32_t num_tiles, std::int32_t num_subgroups,
+                          std::int64_t batch_size) -> std::int32_t {
+    if (num_tiles <= 0) {
+        return 1;
+    }
+    auto const max_subgroups = std::min(num_subgroups, batch_packing_subgroups);
+    std::int32_t packs = 1;
+    while (2 * packs * num_tiles <= max_subgroups &&
+           (is_dynamic_value(batch_size) || 2 * packs <= batch_size)) {
+        packs *= 2;
+    }
+    return packs;
+}
+
 } // namespace tinytc
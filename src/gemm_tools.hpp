@@ -13,6 +13,17 @@
 namespace tinytc {
 
 constexpr static std::array<std::int32_t, 4u> standard_K_block_sizes = {1, 2, 4, 8};
+//! Partial unroll factor of the K loop of GEMMs that use the matrix extension
+constexpr static std::int32_t k_loop_unroll_factor = 2;
+//! Default number of K blocks that A and B are prefetched ahead of the K loop of GEMMs that use
+//! the matrix extension; can be overriden with the prefetch_distance function attribute
+constexpr static std::int32_t default_prefetch_distance = 3;
+//! Maximum number of K blocks in a K panel of GEMMs that stage A and B in shared local memory
+constexpr static std::int32_t max_slm_k_panel_blocks = 4;
+//! Minimum size of the K range of a part of a GEMM whose K loop is split over subgroups
+constexpr static std::int32_t min_split_k_size = 256;
+//! Number of subgroups up to which problems of a batched GEMM with few blocks of C are packed
+constexpr static std::int32_t batch_packing_subgroups = 8;
 
 /**
  * @brief Calculate maximum register blocking size of GEMM
@@ -40,6 +51,34 @@ auto choose_block_size_multiple(std::int32_t min_block_size, std::int32_t max_bl
 auto choose_block_size(array_view<std::int32_t> block_sizes, std::int32_t num_tiles,
                        std::int64_t size) -> std::int32_t;
 auto choose_k_block_size(array_view<std::int32_t> block_sizes, std::int64_t K) -> std::int32_t;
+/**
+ * @brief Choose the number of parts the K loop of a GEMM is split into
+ *
+ * Subgroups that do not have a block of C to compute are put to work by splitting the K loop,
+ * as long as every part has a K range of at least min_split_k_size.
+ *
+ * @param num_tiles Number of subgroups that have a block of C to compute
+ * @param num_subgroups Number of subgroups in the work-group
+ * @param K Size of K mode
+ *
+ * @return Power of two number of parts; 1 if the K loop shall not be split
+ */
+auto choose_k_splits(std::int32_t num_tiles, std::int32_t num_subgroups, std::int64_t K)
+    -> std::int32_t;
+/**
+ * @brief Choose the number of problems of a batched GEMM that are packed into one work-group
+ *
+ * Problems with few blocks of C are packed until the work-group has batch_packing_subgroups
+ * subgroups.
+ *
+ * @param num_tiles Number of blocks of C of a single problem
+ * @param num_subgroups Maximum number of subgroups in the work-group
+ * @param batch_size Number of problems; may be dynamic
+ *
+ * @return Power of two number of problems; 1 if problems shall not be packed
+ */
+auto choose_batch_packing(std::int32_t num_tiles, std::int32_t num_subgroups,
+                          std::int64_t batch_size) -> std::int32_t;
 
 } // namespace tinytc
 
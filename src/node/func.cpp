@@ -21,7 +21,7 @@ using namespace tinytc;
 
 tinytc_func::tinytc_func(std::string name, tinytc::array_view<tinytc_type_t> params,
                          tinytc_type_t ty, tinytc_location const &lc)
-    : name_(std::move(name)), ty_{ty}, loc_{lc} {
+    : name_(std::move(name)), ty_{ty}, arena_{tinytc::arena::create()}, loc_{lc} {
     body_.kind(tinytc::region_kind::collective);
     body_.loc(loc_);
     body_.set_params(std::move(params));
@@ -5,6 +5,7 @@
 #define FUNC_20250626_HPP
 
 #include "node/region.hpp"
+#include "support/arena.hpp"
 #include "tinytc/core.hpp"
 #include "tinytc/types.h"
 
@@ -39,12 +40,16 @@ struct tinytc_func final {
     void param_attr(std::size_t param_no, tinytc_attr_t a);
     auto param_attr(std::size_t param_no) const -> tinytc_attr_t;
 
+    //! Arena serving the IR nodes of the function body
+    inline auto arena() const noexcept -> tinytc::arena * { return arena_.get(); }
+
     auto subgroup_size() const -> std::int32_t;
     auto work_group_size() const -> std::array<std::int32_t, 2u>;
 
   private:
     std::string name_;
     tinytc_type_t ty_;
+    tinytc::arena_ptr arena_; // must outlive body_
     tinytc_region body_;
     tinytc_location loc_;
     tinytc_attr_t attr_ = nullptr;
@@ -6,6 +6,8 @@
 #include "node/region.hpp"
 #include "node/value.hpp"
 #include "node/visit.hpp"
+#include "support/allocation_counter.hpp"
+#include "support/arena.hpp"
 #include "tinytc/builder.h"
 #include "tinytc/types.hpp"
 #include "util/overloaded.hpp"
@@ -27,21 +29,30 @@ static_assert(alignof(tinytc_region) == alignof(tinytc_inst));
 static_assert(alignof(tinytc_inst) <= alignof(std::max_align_t));
 
 auto tinytc_inst::create(IK tid, inst_layout layout, tinytc_location const &lc) -> tinytc_inst_t {
-    std::size_t size = 0;
-    size += sizeof(tinytc_value) * layout.num_results;
-    size += sizeof(tinytc_inst);
-    size += sizeof(use) * layout.num_operands;
-    size += layout.sizeof_properties;
-    size += sizeof(tinytc_region) * layout.num_child_regions;
+    const std::size_t size = allocation_size(layout);
 
+    auto mem_arena = current_ir_arena();
     struct del {
-        void operator()(std::uint8_t *p) const { std::free(p); }
+        tinytc::arena *mem_arena;
+        std::size_t size;
+        void operator()(std::uint8_t *p) const {
+            if (mem_arena) {
+                mem_arena->deallocate(p, size);
+            } else {
+                std::free(p);
+            }
+        }
     };
-    auto raw_mem =
-        std::unique_ptr<std::uint8_t, del>(static_cast<std::uint8_t *>(std::malloc(size)));
+    auto raw_mem = std::unique_ptr<std::uint8_t, del>(
+        static_cast<std::uint8_t *>(mem_arena ? mem_arena->allocate(size) : std::malloc(size)),
+        del{mem_arena, size});
     if (raw_mem.get() == nullptr) {
         throw status::bad_alloc;
     }
+    ir_allocation_counter().count(size);
+    if (!mem_arena) {
+        ir_allocation_counter().count_heap(size);
+    }
 
     // initialize results
     tinytc_value_t first_result = reinterpret_cast<tinytc_value_t>(raw_mem.get());
@@ -53,6 +64,7 @@ auto tinytc_inst::create(IK tid, inst_layout layout, tinytc_location const &lc)
     // initialize inst
     tinytc_inst_t in = reinterpret_cast<tinytc_inst_t>(last_result);
     new (in) tinytc_inst(tid, layout, lc);
+    in->arena_ = mem_arena;
 
     // initialize uses
     use *first_use = reinterpret_cast<use *>(in + 1);
@@ -84,8 +96,24 @@ auto tinytc_inst::create(IK tid, inst_layout layout, tinytc_location const &lc)
 
 void tinytc_inst::destroy(tinytc_inst_t in) {
     void *raw_mem = reinterpret_cast<tinytc_value_t>(in) - in->layout_.num_results;
+    auto mem_arena = in->arena_;
+    const std::size_t size = allocation_size(in->layout_);
     in->~tinytc_inst();
-    std::free(raw_mem);
+    if (mem_arena) {
+        mem_arena->deallocate(raw_mem, size);
+    } else {
+        std::free(raw_mem);
+    }
+}
+
+auto tinytc_inst::allocation_size(inst_layout const &layout) -> std::size_t {
+    std::size_t size = 0;
+    size += sizeof(tinytc_value) * layout.num_results;
+    size += sizeof(tinytc_inst);
+    size += sizeof(use) * layout.num_operands;
+    size += layout.sizeof_properties;
+    size += sizeof(tinytc_region) * layout.num_child_regions;
+    return size;
 }
 
 tinytc_inst::~tinytc_inst() {
@@ -43,6 +43,7 @@ struct inst_layout {
 };
 
 enum class IK;
+class arena;
 
 } // namespace tinytc
 
@@ -108,6 +109,9 @@ struct alignas(8) tinytc_inst : tinytc::ilist_node_with_parent<tinytc_inst, tiny
         : tid_(tid), layout_(layout), loc_{lc} {}
     ~tinytc_inst();
 
+    //! Size of the memory block holding results, instruction, uses, properties, and regions
+    static auto allocation_size(tinytc::inst_layout const &layout) -> std::size_t;
+
     tinytc_inst(tinytc_inst const &other) = delete;
     tinytc_inst(tinytc_inst &&other) = delete;
     tinytc_inst &operator=(tinytc_inst const &other) = delete;
@@ -125,6 +129,7 @@ struct alignas(8) tinytc_inst : tinytc::ilist_node_with_parent<tinytc_inst, tiny
     tinytc::inst_layout layout_;
     tinytc::location loc_;
     tinytc_attr_t attr_ = nullptr;
+    tinytc::arena *arena_ = nullptr; ///< nullptr if allocated on the heap
 };
 
 #endif // INST_20250626_HPP
@@ -910,6 +910,52 @@ void gemm_inst::setup_and_check() {
     }
 }
 
+void gemm_batched_inst::setup_and_check() {
+    blas_a3_inst::setup_and_check();
+
+    auto a = get_memref_type(loc(), A());
+    auto b = get_memref_type(loc(), B());
+    auto c = get_memref_type(loc(), C());
+
+    if (a->dim() != 2 && a->dim() != 3) {
+        throw compilation_error(loc(), {&A()}, status::ir_expected_memref_order_2_or_3);
+    }
+    if (b->dim() != 2 && b->dim() != 3) {
+        throw compilation_error(loc(), {&B()}, status::ir_expected_memref_order_2_or_3);
+    }
+    if (c->dim() != 3) {
+        throw compilation_error(loc(), {&C()}, status::ir_expected_memref_order_3);
+    }
+
+    auto ak = tA() == transpose::T ? 0 : 1;
+    auto bk = tB() == transpose::T ? 1 : 0;
+    auto M = c->shape(0);
+    auto N = c->shape(1);
+    auto K = a->shape(ak);
+    auto batch = c->shape(2);
+    auto const batch_matches = [&batch](memref_type const *t) {
+        return t->dim() == 2 || t->shape(2) == batch;
+    };
+    if (a->shape(1 - ak) != M || b->shape(bk) != K || b->shape(1 - bk) != N ||
+        !batch_matches(a) || !batch_matches(b)) {
+        auto const dump_shape = [](std::ostream &os, memref_type const *t) {
+            for (std::int64_t i = 0; i < t->dim(); ++i) {
+                os << (i > 0 ? "x" : "") << t->shape(i);
+            }
+        };
+        std::ostringstream oss;
+        oss << "Got ";
+        oss << "A=";
+        dump_shape(oss, a);
+        oss << ", B=";
+        dump_shape(oss, b);
+        oss << ", C=";
+        dump_shape(oss, c);
+        throw compilation_error(loc(), {&A(), &B(), &C()}, status::ir_incompatible_shapes,
+                                oss.str());
+    }
+}
+
 void gemv_inst::setup_and_check() {
     blas_a3_inst::setup_and_check();
 
@@ -37,6 +37,8 @@ struct tinytc_prog final : tinytc::reference_counted {
     inline void push_back(tinytc::unique_handle<tinytc_func_t> &&fun) {
         funcs_.push_back(std::move(fun));
     }
+    //! Exchange the functions of both programs; the programs must share the compiler context
+    inline void swap_funcs(tinytc_prog &other) noexcept { funcs_.swap(other.funcs_); }
 
   private:
     tinytc::shared_handle<tinytc_compiler_context_t> ctx_;
@@ -36,6 +36,13 @@ void parse_context::pop_region() { regions_.pop(); }
 auto parse_context::top_region() -> tinytc_region_t { return regions_.top(); }
 auto parse_context::has_regions() -> bool { return !regions_.empty(); }
 
+void parse_context::use_arena(arena *a) {
+    arena_scope_.reset();
+    if (a) {
+        arena_scope_.emplace(a);
+    }
+}
+
 void parse_context::add_function(std::string const &name, unique_handle<tinytc_func_t> fun) {
     auto const &loc = fun->loc();
     if (auto other = global_names_.find(name); other != global_names_.end()) {
@@ -4,10 +4,12 @@
 #ifndef PARSE_CONTEXT_20231221_HPP
 #define PARSE_CONTEXT_20231221_HPP
 
+#include "support/arena.hpp"
 #include "tinytc/types.h"
 #include "tinytc/types.hpp"
 
 #include <cstdint>
+#include <optional>
 #include <stack>
 #include <string>
 #include <unordered_map>
@@ -41,6 +43,9 @@ class parse_context {
     auto top_region() -> tinytc_region_t;
     auto has_regions() -> bool;
 
+    //! Allocate IR nodes from the arena (heap if nullptr) until the next call
+    void use_arena(arena *a);
+
     void add_function(std::string const &name, unique_handle<tinytc_func_t> fun);
     void add_def(std::string const &id, def_rhs &&rhs, location const &lc);
 
@@ -54,6 +59,7 @@ class parse_context {
     std::stack<tinytc_region_t> regions_;
     std::unordered_map<std::string, location> global_names_;
     std::vector<std::unordered_map<std::string, std::pair<def_rhs, location>>> def_map_;
+    std::optional<ir_arena_scope> arena_scope_; // declared last to be reset before program_ dies
 };
 
 } // namespace tinytc
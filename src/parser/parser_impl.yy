@@ -210,6 +210,7 @@
     CUMSUM                          "cumsum"
     SUM                             "sum"
     GEMM                            "gemm"
+    GEMM_BATCHED                    "gemm_batched"
     GEMV                            "gemv"
     GER                             "ger"
     HADAMARD                        "hadamard"
@@ -360,10 +361,12 @@ global:
                     ++name_it;
                 }
                 ctx.push_region(&func_node->body());
+                ctx.use_arena(func_node->arena());
                 ctx.add_function($GLOBAL_IDENTIFIER, std::move(func_node));
             },
             loc);
     }[prototype] region {
+        ctx.use_arena(nullptr);
         ctx.pop_region();
         ctx.pop_scope();
     }
@@ -666,6 +669,16 @@ instruction:
     }
 ;
 
+instruction:
+    GEMM_BATCHED atomic transpose_opt2[tr] var[alpha] COMMA var[a] COMMA var[b] COMMA var[beta] COMMA var[c] {
+        yytry(ctx, [&] {
+            $$ = gemm_batched_inst::create($atomic, $tr.first, $tr.second, std::move($alpha),
+                                           std::move($a), std::move($b), std::move($beta),
+                                           std::move($c), @instruction);
+        });
+    }
+;
+
 instruction:
     GEMV atomic transpose_opt[ta] var[alpha] COMMA var[a] COMMA var[b] COMMA var[beta] COMMA var[c] {
         yytry(ctx, [&] {
@@ -3,14 +3,18 @@
 
 #include "pass/clone.hpp"
 #include "node/inst.hpp"
+#include "node/inst_view.hpp"
 #include "node/region.hpp"
+#include "node/type.hpp"
 #include "node/visit.hpp"
 #include "tinytc/types.hpp"
+#include "util/casting.hpp"
 #include "util/ilist.hpp"
 #include "util/ilist_base.hpp"
 
 #include <cstdint>
 #include <iterator>
+#include <type_traits>
 #include <utility>
 
 namespace tinytc {
@@ -41,6 +45,13 @@ auto inst_cloner::clone_instruction(tinytc_inst &in) -> unique_handle<tinytc_ins
             for (std::int32_t op_no = 0; op_no < layout.num_operands; ++op_no) {
                 clone->op(op_no, subs(&view.get().op(op_no)));
             }
+            // A load from a group yields the element type of the group, which changes if the
+            // group was substituted by a group with a more specific element type
+            if constexpr (std::is_same_v<decltype(view), load_inst>) {
+                if (auto gr = dyn_cast<group_type>(clone->op(0).ty()); gr) {
+                    clone->result(0) = tinytc_value{gr->element_ty(), clone.get(), lc};
+                }
+            }
 
             auto clone_view = decltype(view)(clone.get());
             clone_view.props() = view.props();
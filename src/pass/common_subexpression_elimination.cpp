@@ -0,0 +1,181 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "pass/common_subexpression_elimination.hpp"
+#include "node/func.hpp"
+#include "node/inst.hpp"
+#include "node/inst_view.hpp"
+#include "node/region.hpp"
+#include "node/value.hpp"
+#include "node/visit.hpp"
+#include "support/fnv1a_array_view.hpp" // IWYU pragma: keep
+#include "tinytc/core.hpp"
+#include "tinytc/types.hpp"
+#include "util/fnv1a.hpp"
+#include "util/ilist.hpp"
+#include "util/ilist_base.hpp"
+#include "util/overloaded.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <complex>
+#include <utility>
+#include <variant>
+
+namespace tinytc {
+
+/**
+ * @brief Append properties of an instruction to the value key
+ *
+ * Returns false if the instruction must not be numbered, i.e. if it has side effects, reads
+ * memory, or communicates across lanes.
+ */
+class value_key_builder {
+  public:
+    value_key_builder(std::vector<std::uint64_t> &key) : key_(key) {}
+
+    auto operator()(inst_view) -> bool { return false; }
+    auto operator()(arith_inst) -> bool { return true; }
+    auto operator()(arith_unary_inst) -> bool { return true; }
+    auto operator()(cast_inst) -> bool { return true; }
+    auto operator()(compare_inst) -> bool { return true; }
+    auto operator()(constant_inst in) -> bool;
+    auto operator()(expand_inst in) -> bool;
+    auto operator()(fuse_inst in) -> bool;
+    auto operator()(math_unary_inst) -> bool { return true; }
+    auto operator()(size_inst in) -> bool;
+    auto operator()(subview_inst in) -> bool;
+
+    auto operator()(group_id_inst in) -> bool;
+    auto operator()(num_groups_inst in) -> bool;
+    auto operator()(num_subgroups_inst in) -> bool;
+    auto operator()(subgroup_id_inst in) -> bool;
+    auto operator()(subgroup_linear_id_inst) -> bool { return true; }
+    auto operator()(subgroup_local_id_inst) -> bool { return true; }
+    auto operator()(subgroup_size_inst) -> bool { return true; }
+
+  private:
+    template <typename T> void add(T const &val) {
+        key_.emplace_back(static_cast<std::uint64_t>(val));
+    }
+    void add(array_view<std::int64_t> vals) {
+        add(vals.size());
+        for (auto const &v : vals) {
+            add(v);
+        }
+    }
+
+    std::vector<std::uint64_t> &key_;
+};
+
+auto value_key_builder::operator()(constant_inst in) -> bool {
+    std::visit(overloaded{[&](bool v) { add(v); }, [&](std::int64_t v) { add(v); },
+                          [&](double v) { add(std::bit_cast<std::uint64_t>(v)); },
+                          [&](std::complex<double> v) {
+                              add(std::bit_cast<std::uint64_t>(v.real()));
+                              add(std::bit_cast<std::uint64_t>(v.imag()));
+                          }},
+               in.value());
+    add(in.value().index());
+    return true;
+}
+auto value_key_builder::operator()(expand_inst in) -> bool {
+    add(in.expanded_mode());
+    add(in.static_expand_shape());
+    return true;
+}
+auto value_key_builder::operator()(fuse_inst in) -> bool {
+    add(in.from());
+    add(in.to());
+    return true;
+}
+auto value_key_builder::operator()(size_inst in) -> bool {
+    add(in.mode());
+    return true;
+}
+auto value_key_builder::operator()(subview_inst in) -> bool {
+    add(in.static_offsets());
+    add(in.static_sizes());
+    return true;
+}
+auto value_key_builder::operator()(group_id_inst in) -> bool {
+    add(in.mode());
+    return true;
+}
+auto value_key_builder::operator()(num_groups_inst in) -> bool {
+    add(in.mode());
+    return true;
+}
+auto value_key_builder::operator()(num_subgroups_inst in) -> bool {
+    add(in.mode());
+    return true;
+}
+auto value_key_builder::operator()(subgroup_id_inst in) -> bool {
+    add(in.mode());
+    return true;
+}
+
+auto is_commutative(tinytc_inst &in) -> bool {
+    return isa<add_inst>(in) || isa<mul_inst>(in) || isa<and_inst>(in) || isa<or_inst>(in) ||
+           isa<xor_inst>(in) || isa<equal_inst>(in) || isa<not_equal_inst>(in);
+}
+
+auto common_subexpression_elimination_pass::key_hash::operator()(
+    std::vector<std::uint64_t> const &key) const -> std::size_t {
+    return fnv1a_step(fnv1a0(), array_view<std::uint64_t>(key));
+}
+
+auto common_subexpression_elimination_pass::run_on_function(tinytc_func &fn) -> bool {
+    available_.clear();
+    return run_on_region(fn.body());
+}
+
+auto common_subexpression_elimination_pass::run_on_region(tinytc_region &reg) -> bool {
+    bool changed = false;
+    // Values numbered in this region are only available in this region and its child regions
+    auto scope = std::vector<std::vector<std::uint64_t>>{};
+    auto it = reg.begin();
+    while (it != reg.end()) {
+        for (auto &subreg : it->child_regions()) {
+            changed = run_on_region(subreg) || changed;
+        }
+
+        auto key = std::vector<std::uint64_t>{};
+        if (it->num_results() != 1 || it->num_child_regions() != 0 ||
+            !visit(value_key_builder{key}, *it)) {
+            ++it;
+            continue;
+        }
+        key.emplace_back(static_cast<std::uint64_t>(it->type_id()));
+        key.emplace_back(std::bit_cast<std::uintptr_t>(it->result(0).ty()));
+        auto const num_props = key.size();
+        for (auto &op : it->operands()) {
+            key.emplace_back(std::bit_cast<std::uintptr_t>(&op));
+        }
+        if (is_commutative(*it)) {
+            std::sort(key.begin() + num_props, key.end());
+        }
+
+        auto [available, inserted] = available_.emplace(key, &it->result(0));
+        if (inserted) {
+            scope.emplace_back(std::move(key));
+            ++it;
+            continue;
+        }
+
+        auto &r = it->result(0);
+        auto u = r.use_begin();
+        while (r.has_uses()) {
+            u->set(available->second);
+            u = r.use_begin();
+        }
+        it = reg.insts().erase(it);
+        changed = true;
+    }
+    for (auto const &key : scope) {
+        available_.erase(key);
+    }
+    return changed;
+}
+
+} // namespace tinytc
@@ -0,0 +1,39 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef COMMON_SUBEXPRESSION_ELIMINATION_20251016_HPP
+#define COMMON_SUBEXPRESSION_ELIMINATION_20251016_HPP
+
+#include "tinytc/types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace tinytc {
+
+/**
+ * @brief Replace pure instructions that recompute an available value
+ *
+ * The pass numbers values with a scoped hash table: an instruction is replaced by an earlier
+ * instruction with the same kind, operands, result types, and properties, if the earlier
+ * instruction is located in the same region or in an enclosing region. Operands of commutative
+ * instructions are put into canonical order before lookup.
+ */
+class common_subexpression_elimination_pass {
+  public:
+    auto run_on_function(::tinytc_func &fn) -> bool;
+    auto run_on_region(::tinytc_region &reg) -> bool;
+
+  private:
+    struct key_hash {
+        auto operator()(std::vector<std::uint64_t> const &key) const -> std::size_t;
+    };
+
+    std::unordered_map<std::vector<std::uint64_t>, tinytc_value_t, key_hash> available_;
+};
+
+} // namespace tinytc
+
+#endif // COMMON_SUBEXPRESSION_ELIMINATION_20251016_HPP
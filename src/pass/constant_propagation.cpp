@@ -19,19 +19,23 @@
 
 namespace tinytc {
 
-void constant_propagation_pass::run_on_function(tinytc_func &fn) { run_on_region(fn.body()); }
+auto constant_propagation_pass::run_on_function(tinytc_func &fn) -> bool {
+    return run_on_region(fn.body());
+}
 
-void constant_propagation_pass::run_on_region(tinytc_region &reg) {
+auto constant_propagation_pass::run_on_region(tinytc_region &reg) -> bool {
+    bool changed = false;
     for (auto it = reg.begin(); it != reg.end(); ++it) {
         for (auto &subreg : it->child_regions()) {
-            run_on_region(subreg);
+            changed = run_on_region(subreg) || changed;
         }
 
-        const auto update_uses = [&it](tinytc_value_t with) {
+        const auto update_uses = [&it, &changed](tinytc_value_t with) {
             if (it->num_results() != 1) {
                 throw status::internal_compiler_error;
             }
             auto r = it->result_begin();
+            changed = changed || r->has_uses();
             auto u = r->use_begin();
             while (r->has_uses()) {
                 u->set(with);
@@ -56,12 +60,14 @@ void constant_propagation_pass::run_on_region(tinytc_region &reg) {
                                       update_uses(&*new_constant->result_begin());
                                       // insert new constant
                                       it = reg.insts().insert(it, new_constant.release());
+                                      changed = true;
                                       // skip over constant
                                       ++it;
                                   }
                               }},
                    fr);
     }
+    return changed;
 }
 
 void constant_propagation_pass::set_opt_flag(tinytc::optflag flag, bool enabled) {
@@ -12,8 +12,8 @@ enum class optflag;
 
 class constant_propagation_pass {
   public:
-    void run_on_function(::tinytc_func &fn);
-    void run_on_region(::tinytc_region &reg);
+    auto run_on_function(::tinytc_func &fn) -> bool;
+    auto run_on_region(::tinytc_region &reg) -> bool;
 
     void set_opt_flag(tinytc::optflag flag, bool enabled);
 
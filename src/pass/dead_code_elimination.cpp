@@ -87,9 +87,12 @@ auto dead_code_analysis::operator()(for_inst in) -> int {
     return not_dead;
 }
 
-void dead_code_elimination_pass::run_on_function(tinytc_func &fn) { run_on_region(fn.body()); }
+auto dead_code_elimination_pass::run_on_function(tinytc_func &fn) -> bool {
+    return run_on_region(fn.body());
+}
 
-void dead_code_elimination_pass::run_on_region(tinytc_region &reg) {
+auto dead_code_elimination_pass::run_on_region(tinytc_region &reg) -> bool {
+    bool changed = false;
     auto prev_it = reg.end();
     while (prev_it != reg.begin()) {
         auto it = --prev_it;
@@ -97,6 +100,7 @@ void dead_code_elimination_pass::run_on_region(tinytc_region &reg) {
         if (state == dead) {
             // Instruction is dead so we can erase it
             prev_it = reg.insts().erase(it);
+            changed = true;
         } else if (state >= merge_region) {
             // Instruction always takes the same branch, so we can merge the branch into the parent
             // region and delete other branches
@@ -141,13 +145,15 @@ void dead_code_elimination_pass::run_on_region(tinytc_region &reg) {
             // Note that prev_it is set such that we run dead code analysis on all instructions that
             // were just merged
             prev_it = reg.insts().erase(it);
+            changed = true;
         } else {
             // Run on subgregions for non-dead, non-merge instructions
             for (auto &subreg : it->child_regions()) {
-                run_on_region(subreg);
+                changed = run_on_region(subreg) || changed;
             }
         }
     }
+    return changed;
 }
 
 } // namespace tinytc
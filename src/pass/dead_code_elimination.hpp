@@ -10,8 +10,8 @@ namespace tinytc {
 
 class dead_code_elimination_pass {
   public:
-    void run_on_function(::tinytc_func &fn);
-    void run_on_region(::tinytc_region &reg);
+    auto run_on_function(::tinytc_func &fn) -> bool;
+    auto run_on_region(::tinytc_region &reg) -> bool;
 };
 
 } // namespace tinytc
@@ -2,8 +2,8 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include "pass/dump_gcd.hpp"
+#include "analysis/analysis_manager.hpp"
 #include "analysis/gcd.hpp"
-#include "device_info.hpp"
 #include "node/func.hpp"
 #include "node/inst.hpp"
 #include "node/region.hpp"
@@ -25,9 +25,14 @@ dump_gcd_pass::dump_gcd_pass(std::ostream &os, ::tinytc_core_info const *info)
     : os_(&os), info_{info} {}
 
 void dump_gcd_pass::run_on_function(tinytc_func &fn) {
+    auto am = analysis_manager{fn, info_};
+    run_on_function(fn, am);
+}
+
+void dump_gcd_pass::run_on_function(tinytc_func &fn, analysis_manager &am) {
     auto dump_ir = dump_ir_pass(*os_, 0);
     dump_ir.init_slot_tracker(fn);
-    auto gcd = gcd_analysis{info_->alignment()}.run_on_function(fn);
+    auto const &gcd = am.gcd();
 
     auto const dump_range = [&](auto begin, auto end) {
         *os_ << "[";
@@ -10,11 +10,14 @@
 
 namespace tinytc {
 
+class analysis_manager;
+
 class dump_gcd_pass {
   public:
     dump_gcd_pass(std::ostream &os, ::tinytc_core_info const *info);
 
     void run_on_function(tinytc_func &fn);
+    void run_on_function(tinytc_func &fn, analysis_manager &am);
 
   private:
     std::ostream *os_;
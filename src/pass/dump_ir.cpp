@@ -37,7 +37,10 @@ void dump_ir_pass::operator()(dictionary_attr const &a) {
     auto const is_keyword = [](std::string_view str) {
         switch (fnv1a(str)) {
         case "alignment"_fnv1a:
+        case "prefetch_distance"_fnv1a:
         case "shape_gcd"_fnv1a:
+        case "slm_staging"_fnv1a:
+        case "software_pipelining"_fnv1a:
         case "stride_gcd"_fnv1a:
         case "subgroup_size"_fnv1a:
         case "unroll"_fnv1a:
@@ -349,10 +352,11 @@ void dump_ir_pass::operator()(cooperative_matrix_apply_inst c) {
     dump_val(c.col());
     *os_ << ",";
     dump_val(c.val());
-    *os_ << ") in ";
+    *os_ << ")=";
     dump_val(c.a());
     *os_ << " -> ";
     visit(*this, *c.result().ty());
+    *os_ << " ";
     dump_region(c.body());
 }
 
@@ -541,6 +545,20 @@ void dump_ir_pass::operator()(gemm_inst g) {
     dump_blas_a3(static_cast<blas_a3_inst>(g));
 }
 
+void dump_ir_pass::operator()(gemm_batched_inst g) {
+    *os_ << "gemm_batched";
+    if (g.atomic()) {
+        *os_ << ".atomic";
+    }
+    if (g.tA() != transpose::N || g.tB() != transpose::N) {
+        *os_ << "." << to_string(g.tA());
+    }
+    if (g.tB() != transpose::N) {
+        *os_ << "." << to_string(g.tB());
+    }
+    dump_blas_a3(static_cast<blas_a3_inst>(g));
+}
+
 void dump_ir_pass::operator()(gemv_inst g) {
     *os_ << "gemv";
     if (g.atomic()) {
@@ -68,6 +68,7 @@ class dump_ir_pass {
     void operator()(load_inst l);
     void operator()(lifetime_stop_inst l);
     void operator()(gemm_inst g);
+    void operator()(gemm_batched_inst g);
     void operator()(gemv_inst g);
     void operator()(ger_inst g);
     void operator()(for_inst p);
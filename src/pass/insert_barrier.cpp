@@ -3,7 +3,7 @@
 
 #include "pass/insert_barrier.hpp"
 #include "analysis/aa_results.hpp"
-#include "analysis/alias.hpp"
+#include "analysis/analysis_manager.hpp"
 #include "analysis/cfg.hpp"
 #include "error.hpp"
 #include "node/func.hpp"
@@ -124,7 +124,8 @@ auto insert_barrier_pass::reads_writes::address_space_to_index(address_space as)
     throw internal_compiler_error{};
 }
 
-void insert_barrier_pass::run_on_region(tinytc_region &reg, aa_results const &aa) {
+auto insert_barrier_pass::run_on_region(tinytc_region &reg, aa_results const &aa) -> bool {
+    bool changed = false;
     // irw = reads and writes invisible to other threads
     auto irw_in = std::unordered_map<tinytc_inst_t, reads_writes>{};
     auto irw_out = std::unordered_map<tinytc_inst_t, reads_writes>{};
@@ -208,6 +209,7 @@ void insert_barrier_pass::run_on_region(tinytc_region &reg, aa_results const &aa
                 // update cfg
                 cfg.insert_before(n, new_barrier);
                 q.push(new_barrier);
+                changed = true;
             }
         }
 
@@ -218,12 +220,17 @@ void insert_barrier_pass::run_on_region(tinytc_region &reg, aa_results const &aa
             }
         }
     }
+    return changed;
 }
 
 /* Function nodes */
-void insert_barrier_pass::run_on_function(tinytc_func &fn) {
-    auto aa = alias_analysis{}.run_on_function(fn);
-    run_on_region(fn.body(), aa);
+auto insert_barrier_pass::run_on_function(tinytc_func &fn) -> bool {
+    auto am = analysis_manager{fn};
+    return run_on_function(fn, am);
+}
+
+auto insert_barrier_pass::run_on_function(tinytc_func &fn, analysis_manager &am) -> bool {
+    return run_on_region(fn.body(), am.alias());
 }
 
 } // namespace tinytc
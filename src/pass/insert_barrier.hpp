@@ -14,10 +14,12 @@
 namespace tinytc {
 
 class aa_results;
+class analysis_manager;
 
 class insert_barrier_pass {
   public:
-    void run_on_function(tinytc_func &fn);
+    auto run_on_function(tinytc_func &fn) -> bool;
+    auto run_on_function(tinytc_func &fn, analysis_manager &am) -> bool;
 
   private:
     class reads_writes {
@@ -46,7 +48,7 @@ class insert_barrier_pass {
         std::array<std::unordered_set<::tinytc_value const *>, address_spaces.size()> reads, writes;
     };
 
-    void run_on_region(tinytc_region &reg, aa_results const &aa);
+    auto run_on_region(tinytc_region &reg, aa_results const &aa) -> bool;
 };
 
 } // namespace tinytc
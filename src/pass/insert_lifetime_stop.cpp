@@ -3,7 +3,7 @@
 
 #include "pass/insert_lifetime_stop.hpp"
 #include "analysis/aa_results.hpp"
-#include "analysis/alias.hpp"
+#include "analysis/analysis_manager.hpp"
 #include "node/func.hpp"
 #include "node/inst.hpp"
 #include "node/inst_view.hpp"
@@ -22,7 +22,8 @@
 
 namespace tinytc {
 
-auto insert_lifetime_stop_pass::run_on_region(tinytc_region &reg, aa_results const &aa)
+auto insert_lifetime_stop_pass::run_on_region(tinytc_region &reg, aa_results const &aa,
+                                              bool &changed)
     -> std::unordered_set<const_tinytc_value_t> {
     if (reg.empty()) {
         return {};
@@ -40,7 +41,7 @@ auto insert_lifetime_stop_pass::run_on_region(tinytc_region &reg, aa_results con
     while (prev_it != reg.begin()) {
         auto &i = *(--prev_it);
         for (auto &subreg : i.child_regions()) {
-            rgn_ops.merge(run_on_region(subreg, aa));
+            rgn_ops.merge(run_on_region(subreg, aa, changed));
         }
         for (auto &v : i.operands()) {
             if (isa<memref_type>(*v.ty())) {
@@ -60,6 +61,7 @@ auto insert_lifetime_stop_pass::run_on_region(tinytc_region &reg, aa_results con
                     prev_it, lifetime_stop_inst::create(*alloca_it, {}).release());
                 --prev_it;
                 alloca_it = allocas.erase(alloca_it);
+                changed = true;
             } else {
                 ++alloca_it;
             }
@@ -68,9 +70,15 @@ auto insert_lifetime_stop_pass::run_on_region(tinytc_region &reg, aa_results con
     return rgn_ops;
 }
 
-void insert_lifetime_stop_pass::run_on_function(tinytc_func &fn) {
-    auto aa = alias_analysis{}.run_on_function(fn);
-    run_on_region(fn.body(), aa);
+auto insert_lifetime_stop_pass::run_on_function(tinytc_func &fn) -> bool {
+    auto am = analysis_manager{fn};
+    return run_on_function(fn, am);
+}
+
+auto insert_lifetime_stop_pass::run_on_function(tinytc_func &fn, analysis_manager &am) -> bool {
+    bool changed = false;
+    run_on_region(fn.body(), am.alias(), changed);
+    return changed;
 }
 
 } // namespace tinytc
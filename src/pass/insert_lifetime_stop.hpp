@@ -12,13 +12,15 @@
 namespace tinytc {
 
 class aa_results;
+class analysis_manager;
 
 class insert_lifetime_stop_pass {
   public:
-    void run_on_function(tinytc_func &fn);
+    auto run_on_function(tinytc_func &fn) -> bool;
+    auto run_on_function(tinytc_func &fn, analysis_manager &am) -> bool;
 
   private:
-    auto run_on_region(tinytc_region &reg, aa_results const &aa)
+    auto run_on_region(tinytc_region &reg, aa_results const &aa, bool &changed)
         -> std::unordered_set<::tinytc_value const *>;
 };
 
@@ -0,0 +1,138 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "pass/loop_invariant_code_motion.hpp"
+#include "node/func.hpp"
+#include "node/inst.hpp"
+#include "node/inst_view.hpp"
+#include "node/region.hpp"
+#include "node/type.hpp"
+#include "node/value.hpp"
+#include "node/visit.hpp"
+#include "support/walk.hpp"
+#include "tinytc/types.hpp"
+#include "util/ilist.hpp"
+#include "util/ilist_base.hpp"
+
+#include <unordered_set>
+
+namespace tinytc {
+
+/**
+ * @brief Check whether an instruction is free of side effects and may be executed speculatively
+ *
+ * Memory reads are excluded as stores in the loop body might alias. Subgroup operations and
+ * cooperative matrix instructions are excluded as hoisting them would move cross-lane
+ * communication. Instructions of any class that produce a cooperative matrix are rejected
+ * separately (has_coopmatrix_result) as hoisting would extend the live range of register-heavy
+ * values.
+ */
+class is_hoistable {
+  public:
+    auto operator()(inst_view) -> bool { return false; }
+    auto operator()(arith_inst in) -> bool;
+    auto operator()(arith_unary_inst) -> bool { return true; }
+    auto operator()(builtin_inst) -> bool { return true; }
+    auto operator()(cast_inst) -> bool { return true; }
+    auto operator()(compare_inst) -> bool { return true; }
+    auto operator()(constant_inst) -> bool { return true; }
+    auto operator()(expand_inst) -> bool { return true; }
+    auto operator()(fuse_inst) -> bool { return true; }
+    auto operator()(math_unary_inst) -> bool { return true; }
+    auto operator()(size_inst) -> bool { return true; }
+    auto operator()(subview_inst) -> bool { return true; }
+};
+
+auto is_hoistable::operator()(arith_inst in) -> bool {
+    // Division and remainder might trap if the loop is never executed, unless the divisor is a
+    // non-zero constant
+    if (isa<div_inst>(in.get()) || isa<rem_inst>(in.get())) {
+        auto b = dyn_cast<constant_inst>(in.b().defining_inst());
+        return b && !b.is_zero();
+    }
+    return true;
+}
+
+namespace {
+auto has_coopmatrix_result(tinytc_inst &in) -> bool {
+    for (auto &res : in.results()) {
+        if (isa<coopmatrix_type>(*res.ty())) {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace
+
+auto loop_invariant_code_motion_pass::run_on_function(tinytc_func &fn) -> bool {
+    return run_on_region(fn.body(), false);
+}
+
+auto loop_invariant_code_motion_pass::run_on_region(tinytc_region &reg, bool inside_spmd_region)
+    -> bool {
+    bool changed = false;
+    for (auto it = reg.begin(); it != reg.end(); ++it) {
+        // Inner loops first
+        for (auto &subreg : it->child_regions()) {
+            changed = run_on_region(subreg, inside_spmd_region ||
+                                                subreg.kind() == region_kind::spmd) ||
+                      changed;
+        }
+        if (isa<loop_inst>(*it)) {
+            // Hoisted instructions are inserted in front of it, so it stays valid
+            changed = hoist(it, reg, inside_spmd_region) || changed;
+        }
+    }
+    return changed;
+}
+
+auto loop_invariant_code_motion_pass::hoist(tinytc_region::iterator loop_it, tinytc_region &reg,
+                                            bool inside_spmd_region) -> bool {
+    auto &body = loop_it->child_region(0);
+
+    auto variant = std::unordered_set<tinytc_value const *>{};
+    for (auto &p : body.params()) {
+        variant.insert(&p);
+    }
+    walk<walk_order::pre_order>(*loop_it, [&variant](tinytc_inst &in) {
+        for (auto &subreg : in.child_regions()) {
+            for (auto &p : subreg.params()) {
+                variant.insert(&p);
+            }
+        }
+        for (auto &res : in.results()) {
+            variant.insert(&res);
+        }
+    });
+
+    auto const is_invariant = [&variant](tinytc_inst &in) {
+        for (auto &op : in.operands()) {
+            if (variant.contains(&op)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    bool changed = false;
+    auto it = body.begin();
+    while (it != body.end()) {
+        auto &in = *it;
+        bool const may_call = in.kind() != inst_execution_kind::spmd || inside_spmd_region;
+        if (in.num_child_regions() == 0 && in.num_results() > 0 && may_call &&
+            !has_coopmatrix_result(in) && visit(is_hoistable{}, in) && is_invariant(in)) {
+            auto instr = it.get();
+            it = body.insts().unlink(it);
+            reg.insts().insert(loop_it, instr);
+            for (auto &res : instr->results()) {
+                variant.erase(&res);
+            }
+            changed = true;
+        } else {
+            ++it;
+        }
+    }
+    return changed;
+}
+
+} // namespace tinytc
@@ -0,0 +1,34 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LOOP_INVARIANT_CODE_MOTION_20251016_HPP
+#define LOOP_INVARIANT_CODE_MOTION_20251016_HPP
+
+#include "node/region.hpp"
+#include "tinytc/types.h"
+
+namespace tinytc {
+
+/**
+ * @brief Hoist loop-invariant pure instructions out of loops
+ *
+ * An instruction in the body of a loop is hoisted in front of the loop if it has no side effects,
+ * if all of its operands are defined outside of the loop, and if it may be called from the
+ * region that contains the loop, i.e. SPMD instructions are never hoisted into a collective
+ * region. Loops are processed inside-out such that instructions move through several loop
+ * levels. Instructions nested in child regions of the loop body (e.g. if-branches) are not
+ * hoisted as they are executed conditionally.
+ */
+class loop_invariant_code_motion_pass {
+  public:
+    auto run_on_function(::tinytc_func &fn) -> bool;
+    auto run_on_region(::tinytc_region &reg, bool inside_spmd_region) -> bool;
+
+  private:
+    auto hoist(::tinytc_region::iterator loop_it, ::tinytc_region &reg, bool inside_spmd_region)
+        -> bool;
+};
+
+} // namespace tinytc
+
+#endif // LOOP_INVARIANT_CODE_MOTION_20251016_HPP
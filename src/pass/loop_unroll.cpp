@@ -0,0 +1,271 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "pass/loop_unroll.hpp"
+#include "analysis/analysis_manager.hpp"
+#include "analysis/gcd.hpp"
+#include "codegen_tools.hpp"
+#include "error.hpp"
+#include "node/attr.hpp"
+#include "node/func.hpp"
+#include "node/inst.hpp"
+#include "node/inst_view.hpp"
+#include "node/region.hpp"
+#include "node/value.hpp"
+#include "pass/clone.hpp"
+#include "tinytc/builder.hpp"
+#include "tinytc/types.hpp"
+#include "util/casting.hpp"
+#include "util/ilist.hpp"
+#include "util/ilist_base.hpp"
+
+#include <cstddef>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+namespace tinytc {
+
+namespace {
+
+//! Unroll factor 0 requests a full unroll
+constexpr std::int64_t full_unroll = 0;
+
+auto trip_count(std::int64_t from, std::int64_t to, std::int64_t step) -> std::int64_t {
+    return from < to ? (to - from + step - 1) / step : 0;
+}
+
+//! Remove the unroll attribute but keep the other attributes of the loop
+void drop_unroll_attr(tinytc_inst &in) {
+    auto dict = in.attr() ? dyn_cast<dictionary_attr>(in.attr()) : nullptr;
+    if (!dict) {
+        return;
+    }
+    auto attrs = std::vector<tinytc_named_attr_t>{};
+    for (auto const &na : dict->attrs()) {
+        auto name = dyn_cast<string_attr>(na.name);
+        if (!name || name->str() != "unroll") {
+            attrs.emplace_back(na);
+        }
+    }
+    in.attr(attrs.empty() ? nullptr : get<dictionary_attr>(in.context(), attrs));
+}
+
+auto choose_unroll_factor(for_inst in, std::int64_t step, gcd_analysis_result const &gcd)
+    -> std::optional<std::int64_t> {
+    auto unroll = get_attr(in.get().attr(), "unroll");
+    if (!unroll) {
+        return std::nullopt;
+    }
+
+    auto const from = get_int_constant(in.from());
+    auto const to = get_int_constant(in.to());
+    auto const const_trip_count =
+        from && to ? std::make_optional(trip_count(*from, *to, step)) : std::nullopt;
+
+    if (auto ia = dyn_cast<integer_attr>(unroll); ia) {
+        auto const factor = ia->value();
+        if (factor <= 1) {
+            return std::nullopt;
+        }
+        if (const_trip_count && factor >= *const_trip_count) {
+            return full_unroll;
+        }
+        return factor;
+    }
+    auto ba = dyn_cast<boolean_attr>(unroll);
+    if (!ba) {
+        throw compilation_error(in.loc(), status::ir_expected_boolean_attribute);
+    }
+    if (!ba->value()) {
+        return std::nullopt;
+    }
+    if (const_trip_count) {
+        if (*const_trip_count <= loop_unroll_pass::max_full_unroll_trip_count) {
+            return full_unroll;
+        }
+        return *const_trip_count % 4 == 0 || *const_trip_count % 2 != 0 ? 4 : 2;
+    }
+    // Prefer the factor that does not need a remainder loop
+    auto const span_gcd = std::gcd(gcd.get(in.from()), gcd.get(in.to()));
+    return span_gcd % (4 * step) == 0 || span_gcd % (2 * step) != 0 ? 4 : 2;
+}
+
+/**
+ * @brief Clone body of loop into a region
+ *
+ * The loop variable is substituted by loop_var and the iteration arguments are substituted by
+ * iter_args. The yield instruction is not cloned; the yielded values are returned instead.
+ */
+auto clone_body(for_inst loop, tinytc_region &target, tinytc_region::iterator ip,
+                tinytc_value_t loop_var, std::vector<tinytc_value_t> const &iter_args)
+    -> std::vector<tinytc_value_t> {
+    auto cloner = inst_cloner{};
+    cloner.set_subs(&loop.loop_var(), loop_var);
+    for (std::size_t i = 0; i < iter_args.size(); ++i) {
+        cloner.set_subs(&loop.iter_arg(i), iter_args[i]);
+    }
+    auto yielded = iter_args;
+    for (auto &in : loop.body()) {
+        if (auto y = dyn_cast<yield_inst>(&in); y) {
+            for (std::size_t i = 0; i < yielded.size(); ++i) {
+                yielded[i] = cloner.subs(&y.get().op(i));
+            }
+        } else {
+            target.insts().insert(ip, cloner.clone_instruction(in).release());
+        }
+    }
+    return yielded;
+}
+
+void replace_results(for_inst loop, std::vector<tinytc_value_t> const &values) {
+    auto value = values.begin();
+    for (auto &r : loop.results()) {
+        auto v = *value++;
+        auto u = r.use_begin();
+        while (r.has_uses()) {
+            u->set(v);
+            u = r.use_begin();
+        }
+    }
+}
+
+auto iter_init_values(for_inst loop) -> std::vector<tinytc_value_t> {
+    auto values = std::vector<tinytc_value_t>{};
+    for (auto &init : loop.iter_init()) {
+        values.emplace_back(&init);
+    }
+    return values;
+}
+
+} // namespace
+
+auto loop_unroll_pass::run_on_function(tinytc_func &fn, analysis_manager &am) -> bool {
+    return run_on_region(fn.body(), am.gcd());
+}
+
+auto loop_unroll_pass::run_on_region(tinytc_region &reg, gcd_analysis_result const &gcd) -> bool {
+    bool changed = false;
+    auto it = reg.begin();
+    while (it != reg.end()) {
+        for (auto &subreg : it->child_regions()) {
+            changed = run_on_region(subreg, gcd) || changed;
+        }
+
+        auto loop = dyn_cast<for_inst>(it.get());
+        if (!loop) {
+            ++it;
+            continue;
+        }
+        auto const step = loop.has_step() ? get_int_constant(loop.step()) : std::int64_t{1};
+        auto const factor = step && *step > 0 ? choose_unroll_factor(loop, *step, gcd)
+                                              : std::nullopt;
+        if (!factor) {
+            ++it;
+            continue;
+        }
+
+        auto &loop_var = loop.loop_var();
+        auto ty = loop_var.ty();
+        auto const lc = loop.loc();
+        auto const insert = [&](unique_handle<tinytc_inst_t> &&in) -> tinytc_value_t {
+            auto result = &in->result(0);
+            reg.insts().insert(it, in.release());
+            return result;
+        };
+        auto const constant = [&](std::int64_t value) {
+            return insert(create<constant_inst>(value, ty, lc));
+        };
+
+        if (*factor == full_unroll) {
+            auto const from = *get_int_constant(loop.from());
+            auto const num_trips = trip_count(from, *get_int_constant(loop.to()), *step);
+            auto values = iter_init_values(loop);
+            for (std::int64_t k = 0; k < num_trips; ++k) {
+                values = clone_body(loop, reg, it, constant(from + k * *step), values);
+            }
+            replace_results(loop, values);
+            it = reg.insts().erase(it);
+            changed = true;
+            continue;
+        }
+
+        // Upper bound of main loop: from + (trip_count / factor) * factor * step
+        auto const main_step = *factor * *step;
+        auto const from = get_int_constant(loop.from());
+        auto const to = get_int_constant(loop.to());
+        tinytc_value_t main_to = nullptr;
+        bool needs_remainder = true;
+        if (from && to) {
+            auto const num_trips = trip_count(*from, *to, *step);
+            main_to = constant(*from + num_trips / *factor * main_step);
+            needs_remainder = num_trips % *factor != 0;
+        } else {
+            auto const span_gcd = std::gcd(gcd.get(loop.from()), gcd.get(loop.to()));
+            auto span = insert(create<sub_inst>(&loop.to(), &loop.from(), ty, lc));
+            if (*step > 1) {
+                if (span_gcd % *step != 0) {
+                    span = insert(create<add_inst>(span, constant(*step - 1), ty, lc));
+                }
+                span = insert(create<div_inst>(span, constant(*step), ty, lc));
+            }
+            span = insert(create<max_inst>(span, constant(0), ty, lc));
+            auto main_trips = insert(create<div_inst>(span, constant(*factor), ty, lc));
+            auto main_span = insert(create<mul_inst>(main_trips, constant(main_step), ty, lc));
+            main_to = insert(create<add_inst>(&loop.from(), main_span, ty, lc));
+            needs_remainder = span_gcd % main_step != 0;
+        }
+
+        auto result_tys = std::vector<tinytc_type_t>{};
+        for (auto &r : loop.results()) {
+            result_tys.emplace_back(r.ty());
+        }
+        auto init = iter_init_values(loop);
+        auto main_loop_handle = create<for_inst>(&loop.from(), main_to, constant(main_step), init,
+                                                 result_tys, lc);
+        auto main_loop = for_inst(main_loop_handle.get());
+        auto &main_body = main_loop.body();
+        auto values = std::vector<tinytc_value_t>{};
+        for (std::size_t i = 0; i < init.size(); ++i) {
+            values.emplace_back(&main_loop.iter_arg(i));
+        }
+        for (std::int64_t k = 0; k < *factor; ++k) {
+            tinytc_value_t var = &main_loop.loop_var();
+            if (k > 0) {
+                auto offset = create<constant_inst>(k * *step, ty, lc);
+                auto offset_val = &offset->result(0);
+                main_body.insts().push_back(offset.release());
+                auto add = create<add_inst>(&main_loop.loop_var(), offset_val, ty, lc);
+                var = &add->result(0);
+                main_body.insts().push_back(add.release());
+            }
+            values = clone_body(loop, main_body, main_body.end(), var, values);
+        }
+        if (!values.empty()) {
+            main_body.insts().push_back(create<yield_inst>(values, lc).release());
+        }
+        auto main_results = std::vector<tinytc_value_t>{};
+        for (auto &r : main_loop.results()) {
+            main_results.emplace_back(&r);
+        }
+        reg.insts().insert(it, main_loop_handle.release());
+
+        if (needs_remainder) {
+            // The original loop becomes the remainder loop
+            loop.get().op(0, main_to);
+            auto const iter_init_offset = loop.get().num_operands() - main_results.size();
+            for (std::size_t i = 0; i < main_results.size(); ++i) {
+                loop.get().op(iter_init_offset + i, main_results[i]);
+            }
+            drop_unroll_attr(loop.get());
+            ++it;
+        } else {
+            replace_results(loop, main_results);
+            it = reg.insts().erase(it);
+        }
+        changed = true;
+    }
+    return changed;
+}
+
+} // namespace tinytc
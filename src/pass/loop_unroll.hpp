@@ -0,0 +1,42 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LOOP_UNROLL_20251016_HPP
+#define LOOP_UNROLL_20251016_HPP
+
+#include "tinytc/types.h"
+
+#include <cstdint>
+
+namespace tinytc {
+
+class analysis_manager;
+class gcd_analysis_result;
+
+/**
+ * @brief Unroll for-loops according to the unroll attribute
+ *
+ * - unroll = <integer>: partial unroll with the given factor
+ * - unroll = true: full unroll if the trip count is a constant of at most
+ *   max_full_unroll_trip_count, otherwise partial unroll with factor 4 or 2, where the factor
+ *   is chosen such that the trip count is known to be divisible by the factor if possible
+ * - unroll = false or no unroll attribute: the loop is left unchanged
+ *
+ * Partial unrolling creates a main loop whose body contains factor copies of the original body
+ * and keeps the original loop as remainder loop. The remainder loop is removed if the trip count
+ * is known to be divisible by the factor, either because it is constant or due to the GCD
+ * analysis of the loop bounds. Loops with non-constant step are not unrolled.
+ *
+ * The unroll attribute is consumed, i.e. removed from the unrolled loops.
+ */
+class loop_unroll_pass {
+  public:
+    constexpr static std::int64_t max_full_unroll_trip_count = 16;
+
+    auto run_on_function(::tinytc_func &fn, analysis_manager &am) -> bool;
+    auto run_on_region(::tinytc_region &reg, gcd_analysis_result const &gcd) -> bool;
+};
+
+} // namespace tinytc
+
+#endif // LOOP_UNROLL_20251016_HPP
@@ -2,11 +2,17 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include "pass/lower_linalg.hpp"
+#include "analysis/aa_results.hpp"
+#include "analysis/analysis_manager.hpp"
+#include "autotune.hpp"
 #include "codegen_tools.hpp"
+#include "compiler_context.hpp"
 #include "device_info.hpp"
 #include "error.hpp"
 #include "gemm_tools.hpp"
 #include "matrix_ext_info.hpp"
+#include "node/attr.hpp"
+#include "node/func.hpp"
 #include "node/inst.hpp"
 #include "node/inst_view.hpp"
 #include "node/region.hpp"
@@ -14,6 +20,7 @@
 #include "node/value.hpp"
 #include "node/visit.hpp"
 #include "number.hpp"
+#include "pass/clone.hpp"
 #include "support/walk.hpp"
 #include "tiling.hpp"
 #include "tinytc/builder.hpp"
@@ -24,9 +31,12 @@
 #include "util/ilist.hpp"
 #include "util/ilist_base.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <functional>
+#include <limits>
+#include <numeric>
 #include <optional>
 #include <stdexcept>
 #include <tuple>
@@ -35,6 +45,399 @@
 
 namespace tinytc {
 
+namespace {
+
+//! Scalar instructions without side effects that may be moved in front of a gemm or cloned into
+//! the action of a cooperative matrix apply
+class is_scalar_op {
+  public:
+    auto operator()(inst_view) -> bool { return false; }
+    auto operator()(arith_inst in) -> bool;
+    auto operator()(arith_unary_inst) -> bool { return true; }
+    auto operator()(cast_inst) -> bool { return true; }
+    auto operator()(compare_inst) -> bool { return true; }
+    auto operator()(constant_inst) -> bool { return true; }
+    auto operator()(math_unary_inst) -> bool { return true; }
+    auto operator()(size_inst) -> bool { return true; }
+};
+
+auto is_scalar_op::operator()(arith_inst in) -> bool {
+    // Integer division might trap on the padding of a tile
+    return !isa<integer_type>(*in.result().ty()) ||
+           (!isa<div_inst>(in.get()) && !isa<rem_inst>(in.get()));
+}
+
+auto is_scalar(tinytc_inst &in) -> bool {
+    return in.num_results() == 1 && !isa<coopmatrix_type>(*in.result(0).ty()) &&
+           visit(is_scalar_op{}, in);
+}
+
+//! Dynamic modes might differ at run-time, hence only C itself or fully static shapes match
+auto has_shape_of(tinytc_value const &v, tinytc_value const &C, memref_type const *ct) -> bool {
+    if (&v == &C) {
+        return true;
+    }
+    auto vt = dyn_cast<memref_type>(v.ty());
+    return vt && vt->dim() == ct->dim() &&
+           std::none_of(vt->shape().begin(), vt->shape().end(), is_dynamic_value) &&
+           std::equal(vt->shape().begin(), vt->shape().end(), ct->shape().begin());
+}
+
+//! foreach (i,j) { ... = load X[i,j] ... store ..., D[i,j] } with scalar instructions in between
+struct elementwise_foreach {
+    tinytc_value_t X;
+    tinytc_value_t D;
+    tinytc_value_t result;
+};
+
+auto get_elementwise_foreach(foreach_inst in, tinytc_value &C, memref_type const *ct)
+    -> std::optional<elementwise_foreach> {
+    if (in.dim() != 2) {
+        return std::nullopt;
+    }
+    for (std::int32_t k = 0; k < 2; ++k) {
+        auto from = get_int_constant(in.from()[k]);
+        if (!from || *from != 0) {
+            return std::nullopt;
+        }
+        auto &to = in.to()[k];
+        if (auto to_cst = get_int_constant(to); to_cst) {
+            if (*to_cst != ct->shape(k)) {
+                return std::nullopt;
+            }
+        } else if (auto s = dyn_cast<size_inst>(to.defining_inst());
+                   !s || &s.operand() != &C || s.mode() != k) {
+            return std::nullopt;
+        }
+    }
+
+    auto &body = in.body();
+    auto const is_elementwise_access = [&](tinytc_value &operand, op_range index_list) {
+        return has_shape_of(operand, C, ct) && index_list.size() == 2 &&
+               &index_list[0] == &body.param(0) && &index_list[1] == &body.param(1);
+    };
+
+    auto ew = elementwise_foreach{nullptr, nullptr, nullptr};
+    for (auto it = body.begin(); it != body.end(); ++it) {
+        if (auto ld = dyn_cast<load_inst>(it.get()); ld) {
+            if (!is_elementwise_access(ld.operand(), ld.index_list()) ||
+                (ew.X && ew.X != &ld.operand())) {
+                return std::nullopt;
+            }
+            ew.X = &ld.operand();
+        } else if (auto st = dyn_cast<store_inst>(it.get()); st) {
+            if (std::next(it) != body.end() ||
+                !is_elementwise_access(st.operand(), st.index_list())) {
+                return std::nullopt;
+            }
+            ew.D = &st.operand();
+            ew.result = &st.val();
+        } else if (!is_scalar(*it)) {
+            return std::nullopt;
+        }
+    }
+    if (!ew.X || !ew.D ||
+        get_memref_type(*ew.X)->element_ty() != get_memref_type(*ew.D)->element_ty()) {
+        return std::nullopt;
+    }
+    return ew;
+}
+
+} // namespace
+
+/**
+ * @brief Element-wise instructions on the result of a gemm that are fused into the gemm
+ *
+ * The epilogue consists of the axpby, hadamard, and foreach instructions directly following a
+ * gemm that access memrefs with the shape of C element-wise only. A subgroup then owns the same
+ * elements of every memref in the epilogue as it owns of C, so the epilogue is applied to the
+ * accumulator tiles in registers instead of storing C and reading it back. Every memref is loaded
+ * at most once per tile and only the final value of every written memref is stored. Stores to
+ * stack temporaries that are not used outside the gemm and its epilogue are dropped.
+ */
+class gemm_epilogue {
+  public:
+    gemm_epilogue() = default;
+    //! Collects the epilogue of the gemm at gemm_it without modifying the region
+    gemm_epilogue(tinytc_region &reg, tinytc_region::iterator gemm_it, aa_results const &aa);
+
+    inline auto empty() const -> bool { return ops_.empty(); }
+
+    //! Moves scalar instructions interleaved with the epilogue in front of ip
+    void hoist(tinytc_region &reg, tinytc_region::iterator ip);
+    //! Erases the instructions of the epilogue
+    void erase(tinytc_region &reg);
+
+    //! Applies the epilogue on the tile c of C at (pos0, pos1) and stores the result
+    void store(region_builder &bb, tinytc_value_t c, tinytc_value_t pos0, tinytc_value_t pos1,
+               checked_flag check, location const &loc) const;
+
+  private:
+    struct access {
+        tinytc_value_t operand;
+        bool is_write;
+    };
+
+    auto add_accesses(std::vector<access> const &accesses, aa_results const &aa) -> bool;
+    auto is_dead_temporary(tinytc_value &v, tinytc_inst_t gemm) const -> bool;
+
+    tinytc_value_t C_ = nullptr;
+    std::vector<tinytc_inst_t> ops_;
+    std::vector<tinytc_inst_t> hoisted_;
+    std::vector<access> accesses_;
+    std::vector<tinytc_value_t> dead_temporaries_;
+};
+
+gemm_epilogue::gemm_epilogue(tinytc_region &reg, tinytc_region::iterator gemm_it,
+                             aa_results const &aa) {
+    auto g = gemm_inst(gemm_it.get());
+    if (g.atomic()) {
+        return;
+    }
+    C_ = &g.C();
+    auto ct = get_memref_type(*C_);
+    accesses_ = {{&g.A(), false}, {&g.B(), false}, {C_, true}};
+
+    auto pending = std::vector<tinytc_inst_t>{};
+    for (auto it = std::next(gemm_it); it != reg.end(); ++it) {
+        if (isa<barrier_inst>(*it)) {
+            continue;
+        }
+        if (is_scalar(*it)) {
+            pending.emplace_back(it.get());
+            continue;
+        }
+        auto accesses = std::vector<access>{};
+        if (auto a = dyn_cast<axpby_inst>(it.get()); a) {
+            if (a.atomic() || a.tA() != transpose::N || !has_shape_of(a.A(), *C_, ct) ||
+                !has_shape_of(a.B(), *C_, ct)) {
+                break;
+            }
+            accesses = {{&a.A(), false}, {&a.B(), true}};
+        } else if (auto h = dyn_cast<hadamard_inst>(it.get()); h) {
+            if (h.atomic() || !has_shape_of(h.A(), *C_, ct) || !has_shape_of(h.B(), *C_, ct) ||
+                !has_shape_of(h.C(), *C_, ct)) {
+                break;
+            }
+            accesses = {{&h.A(), false}, {&h.B(), false}, {&h.C(), true}};
+        } else if (auto f = dyn_cast<foreach_inst>(it.get()); f) {
+            auto ew = get_elementwise_foreach(f, *C_, ct);
+            if (!ew) {
+                break;
+            }
+            accesses = {{ew->X, false}, {ew->D, true}};
+        } else {
+            break;
+        }
+        if (!add_accesses(accesses, aa)) {
+            break;
+        }
+        ops_.emplace_back(it.get());
+        hoisted_.insert(hoisted_.end(), pending.begin(), pending.end());
+        pending.clear();
+    }
+
+    for (auto const &acc : accesses_) {
+        if (acc.is_write && is_dead_temporary(*acc.operand, gemm_it.get()) &&
+            std::find(dead_temporaries_.begin(), dead_temporaries_.end(), acc.operand) ==
+                dead_temporaries_.end()) {
+            dead_temporaries_.emplace_back(acc.operand);
+        }
+    }
+}
+
+auto gemm_epilogue::add_accesses(std::vector<access> const &accesses, aa_results const &aa)
+    -> bool {
+    // The epilogue must not write memory that is read by other subgroups during the gemm, and
+    // distinct memrefs that might alias might access the elements of another subgroup
+    auto const gemm_A = accesses_[0].operand;
+    auto const gemm_B = accesses_[1].operand;
+    for (auto const &acc : accesses) {
+        if (acc.is_write && (aa.alias(*acc.operand, *gemm_A) || aa.alias(*acc.operand, *gemm_B))) {
+            return false;
+        }
+        auto const conflicts = [&](access const &other) {
+            return (acc.is_write || other.is_write) && acc.operand != other.operand &&
+                   aa.alias(*acc.operand, *other.operand);
+        };
+        if (std::any_of(accesses_.begin(), accesses_.end(), conflicts) ||
+            std::any_of(accesses.begin(), accesses.end(), conflicts)) {
+            return false;
+        }
+    }
+    accesses_.insert(accesses_.end(), accesses.begin(), accesses.end());
+    return true;
+}
+
+auto gemm_epilogue::is_dead_temporary(tinytc_value &v, tinytc_inst_t gemm) const -> bool {
+    auto def = v.defining_inst();
+    if (!def || !isa<alloca_inst>(*def)) {
+        return false;
+    }
+    for (auto &u : v.uses()) {
+        auto owner = u.owner();
+        if (owner != gemm && !isa<lifetime_stop_inst>(*owner) &&
+            std::find(ops_.begin(), ops_.end(), owner) == ops_.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void gemm_epilogue::hoist(tinytc_region &reg, tinytc_region::iterator ip) {
+    for (auto &in : hoisted_) {
+        reg.insts().unlink(in->iterator());
+        reg.insts().insert(ip, in);
+    }
+}
+
+void gemm_epilogue::erase(tinytc_region &reg) {
+    for (auto &in : ops_) {
+        reg.insts().erase(in->iterator());
+    }
+}
+
+void gemm_epilogue::store(region_builder &bb, tinytc_value_t c, tinytc_value_t pos0,
+                          tinytc_value_t pos1, checked_flag check, location const &loc) const {
+    auto c_ty = get_coopmatrix_type(*c);
+    auto const tile_ty = [&](tinytc_value const &operand) {
+        return get<coopmatrix_type>(get_memref_type(operand)->element_ty(), c_ty->rows(),
+                                    c_ty->cols(), matrix_use::acc);
+    };
+
+    // Current value of the tile of every memref that has been loaded or computed
+    auto tiles = std::vector<std::pair<tinytc_value_t, tinytc_value_t>>{{C_, c}};
+    auto written = std::vector<tinytc_value_t>{C_};
+    auto const find_tile = [&](tinytc_value_t operand) {
+        return std::find_if(tiles.begin(), tiles.end(),
+                            [&operand](auto const &t) { return t.first == operand; });
+    };
+    auto const get_tile = [&](tinytc_value_t operand) -> tinytc_value_t {
+        if (auto t = find_tile(operand); t != tiles.end()) {
+            return t->second;
+        }
+        auto tile = bb.create<cooperative_matrix_load_inst>(transpose::N, check, operand, pos0,
+                                                            pos1, tile_ty(*operand), loc);
+        tiles.emplace_back(operand, tile);
+        return tile;
+    };
+    auto const set_tile = [&](tinytc_value_t operand, tinytc_value_t tile) {
+        if (auto t = find_tile(operand); t != tiles.end()) {
+            t->second = tile;
+        } else {
+            tiles.emplace_back(operand, tile);
+        }
+        if (std::find(written.begin(), written.end(), operand) == written.end()) {
+            written.emplace_back(operand);
+        }
+    };
+    auto const convert = [&](tinytc_value_t tile, tinytc_type_t ty) -> tinytc_value_t {
+        if (tile->ty() != ty) {
+            return bb.create<cast_inst>(tile, ty, loc);
+        }
+        return tile;
+    };
+    auto const update = [&](tinytc_value_t alpha, tinytc_value_t ab, tinytc_value_t beta,
+                            tinytc_value_t D) {
+        auto alpha_ab = mixed_precision_coopmatrix_scale(bb, alpha, ab, loc);
+        auto beta_d = mixed_precision_coopmatrix_scale(bb, beta, get_tile(D), loc);
+        set_tile(D, bb.create<add_inst>(alpha_ab, beta_d, alpha_ab->ty(), loc));
+    };
+
+    auto ct = get_memref_type(*C_);
+    for (auto &op : ops_) {
+        if (auto a = dyn_cast<axpby_inst>(op); a) {
+            auto d_ty = tile_ty(a.B());
+            update(&a.alpha(), convert(get_tile(&a.A()), d_ty), &a.beta(), &a.B());
+        } else if (auto h = dyn_cast<hadamard_inst>(op); h) {
+            auto d_ty = tile_ty(h.C());
+            auto a = convert(get_tile(&h.A()), d_ty);
+            auto b = convert(get_tile(&h.B()), d_ty);
+            update(&h.alpha(), bb.create<mul_inst>(a, b, d_ty, loc), &h.beta(), &h.C());
+        } else if (auto f = dyn_cast<foreach_inst>(op); f) {
+            auto ew = *get_elementwise_foreach(f, *C_, ct);
+            auto x = get_tile(ew.X);
+            auto apply_h = create<cooperative_matrix_apply_inst>(x, x->ty(), loc);
+            auto apply = cooperative_matrix_apply_inst(apply_h.get());
+            auto abb = region_builder{&apply.body()};
+
+            // Loop variables used in the action are replaced by row and column of the tile
+            auto cloner = inst_cloner{};
+            auto const pos = std::array<tinytc_value_t, 2u>{pos0, pos1};
+            auto const rc = std::array<tinytc_value_t, 2u>{&apply.row(), &apply.col()};
+            for (std::int32_t k = 0; k < 2; ++k) {
+                auto &lv = f.body().param(k);
+                auto const used_in_action = std::any_of(
+                    lv.uses().begin(), lv.uses().end(), [](auto const &u) {
+                        return !isa<load_inst>(*u.owner()) && !isa<store_inst>(*u.owner());
+                    });
+                if (used_in_action) {
+                    auto offset = convert(pos[k], lv.ty());
+                    auto idx = abb.create<cast_inst>(rc[k], lv.ty(), loc);
+                    cloner.set_subs(&lv, abb.create<add_inst>(idx, offset, lv.ty(), loc));
+                }
+            }
+            for (auto &in : f.body()) {
+                if (auto ld = dyn_cast<load_inst>(&in); ld) {
+                    cloner.set_subs(&ld.result(), &apply.val());
+                } else if (!isa<store_inst>(in)) {
+                    abb.add(cloner.clone_instruction(in));
+                }
+            }
+            abb.create<yield_inst>(array_view<tinytc_value_t>{cloner.subs(ew.result)}, loc);
+            set_tile(ew.D, bb.add(std::move(apply_h)));
+        }
+    }
+
+    for (auto &operand : written) {
+        if (std::find(dead_temporaries_.begin(), dead_temporaries_.end(), operand) ==
+            dead_temporaries_.end()) {
+            auto tile = find_tile(operand)->second;
+            bb.create<cooperative_matrix_store_inst>(transpose::N, check, tile, operand, pos0, pos1,
+                                                     loc);
+        }
+    }
+}
+
+/**
+ * @brief K panels of A and B that a work-group stages in shared local memory
+ *
+ * A and B hold two K panels each (double buffering), stored with the same transposition as the
+ * gemm operands; the panel with buffer offset o starts at logical column o of A and at logical
+ * row o of B. The copy function is executed by all subgroups of the work-group and copies the
+ * K panel starting at k from global memory into the buffer at offset o, filling elements outside
+ * of the operands with zeros.
+ */
+struct gemm_slm_panels {
+    tinytc_value_t A;
+    tinytc_value_t B;
+    tinytc_value_t m_block; ///< Row of the subgroup's block within the A panel
+    tinytc_value_t n_block; ///< Column of the subgroup's block within the B panel
+    std::int32_t k_block_size;
+    std::int32_t k_panel_size; ///< Multiple of k_block_size
+    std::function<void(region_builder &, tinytc_value_t k, tinytc_value_t offset)> copy;
+};
+
+/**
+ * @brief Split of the K loop of a GEMM over the subgroups of a work-group
+ *
+ * The subgroup multiplies the K range [k_begin, k_end) only. If partials is not null, the
+ * subgroups of parts 1 to num_parts - 1 store their partial block of C at column
+ * (part - 1) * part_stride + slot of the shared local memory buffer partials, and the subgroup of
+ * part 0 sums the partial blocks and updates C. Otherwise, every part adds its contribution to C
+ * with atomics. Subgroups with part >= num_parts are idle. The reduction is collective, hence all
+ * subgroups of the work-group must reach the microkernel.
+ */
+struct gemm_split_k {
+    tinytc_value_t k_begin;
+    tinytc_value_t k_end;
+    tinytc_value_t part;
+    std::int32_t num_parts;
+    tinytc_value_t partials;
+    tinytc_value_t slot;
+    std::int32_t part_stride;
+};
+
 void gemm_microkernel(region_builder &bb, transpose tA, transpose tB, bool atomic,
                       tinytc_value_t alpha, tinytc_value_t A, tinytc_value_t B, tinytc_value_t beta,
                       tinytc_value_t C, tinytc_value_t K, tinytc_value_t m_block,
@@ -42,7 +445,9 @@ void gemm_microkernel(region_builder &bb, transpose tA, transpose tB, bool atomi
                       tinytc_value_t n_block, std::int32_t n_block_size, std::int32_t num_n_blocks,
                       bool n_check, array_view<std::int32_t> K_block_sizes, tinytc_type_t a_ty,
                       tinytc_type_t b_ty, tinytc_type_t c_ty, tinytc_attr_t for_attributes,
-                      location const &loc) {
+                      tinytc_attr_t k_loop_attributes, bool software_pipelining,
+                      std::int32_t prefetch_distance, gemm_slm_panels const *slm, gemm_split_k const *split_k,
+                      gemm_epilogue const *epilogue, location const &loc) {
     auto ctx = m_block->context();
     auto bool_ty = boolean_type::get(ctx);
     auto index_ty = index_type::get(ctx);
@@ -72,10 +477,8 @@ void gemm_microkernel(region_builder &bb, transpose tA, transpose tB, bool atomi
     auto coopmatrix_c_ty = get<coopmatrix_type>(c_ty, m_block_size, n_block_size, matrix_use::acc);
     auto coopmatrix_c_acc_ty =
         get<coopmatrix_type>(c_acc_ty, m_block_size, n_block_size, matrix_use::acc);
-    auto const compute_c_step = [&](region_builder &bb, std::int32_t k_block_size, tinytc_value_t k,
-                                    array_view<tinytc_value_t> const &c_acc,
-                                    array_view<tinytc_type_t> const &c_acc_tys,
-                                    bool check_k = false) {
+    auto const load_a_from = [&](region_builder &bb, std::int32_t k_block_size, tinytc_value_t A,
+                                 tinytc_value_t m_block, tinytc_value_t k, checked_flag check) {
         tinytc_value_t pos_a[2] = {m_block, k};
         int amode = 0;
         if (tA == transpose::T) {
@@ -84,17 +487,24 @@ void gemm_microkernel(region_builder &bb, transpose tA, transpose tB, bool atomi
         }
         auto coopmatrix_a_ty =
             get<coopmatrix_type>(a_ty, m_block_size, k_block_size, matrix_use::a);
-        const auto my_check_a = check_k ? add_check(check_a, checked_flag::cols) : check_a;
         auto a = std::vector<tinytc_value_t>{};
         a.reserve(num_m_blocks);
         for (std::int32_t i = 0; i < num_m_blocks; ++i) {
-            a.emplace_back(bb.create<cooperative_matrix_load_inst>(tA, my_check_a, A, pos_a[0],
-                                                                   pos_a[1], coopmatrix_a_ty));
+            a.emplace_back(bb.create<cooperative_matrix_load_inst>(tA, check, A, pos_a[0], pos_a[1],
+                                                                   coopmatrix_a_ty));
             if (i + 1 < num_m_blocks) {
                 pos_a[amode] = bb.create<add_inst>(pos_a[amode], c_m_block_size, index_ty, loc);
             }
         }
-
+        return a;
+    };
+    auto const load_a = [&](region_builder &bb, std::int32_t k_block_size, tinytc_value_t k,
+                            bool check_k) {
+        const auto my_check_a = check_k ? add_check(check_a, checked_flag::cols) : check_a;
+        return load_a_from(bb, k_block_size, A, m_block, k, my_check_a);
+    };
+    auto const load_b_from = [&](region_builder &bb, std::int32_t k_block_size, tinytc_value_t B,
+                                 tinytc_value_t n_block, tinytc_value_t k, checked_flag check) {
         tinytc_value_t pos_b[2] = {k, n_block};
         int bmode = 1;
         if (tB == transpose::T) {
@@ -103,17 +513,43 @@ void gemm_microkernel(region_builder &bb, transpose tA, transpose tB, bool atomi
         }
         auto coopmatrix_b_ty =
             get<coopmatrix_type>(b_ty, k_block_size, n_block_size, matrix_use::b);
-        const auto my_check_b = check_k ? add_check(check_b, checked_flag::rows) : check_b;
         auto b = std::vector<tinytc_value_t>{};
         b.reserve(num_n_blocks);
         for (std::int32_t i = 0; i < num_n_blocks; ++i) {
-            b.emplace_back(bb.create<cooperative_matrix_load_inst>(tB, my_check_b, B, pos_b[0],
-                                                                   pos_b[1], coopmatrix_b_ty));
+            b.emplace_back(bb.create<cooperative_matrix_load_inst>(tB, check, B, pos_b[0], pos_b[1],
+                                                                   coopmatrix_b_ty));
             if (i + 1 < num_n_blocks) {
                 pos_b[bmode] = bb.create<add_inst>(pos_b[bmode], c_n_block_size, index_ty, loc);
             }
         }
-
+        return b;
+    };
+    auto const load_b = [&](region_builder &bb, std::int32_t k_block_size, tinytc_value_t k,
+                            bool check_k) {
+        const auto my_check_b = check_k ? add_check(check_b, checked_flag::rows) : check_b;
+        return load_b_from(bb, k_block_size, B, n_block, k, my_check_b);
+    };
+    auto const prefetch_ab = [&](region_builder &bb, std::int32_t k_block_size, tinytc_value_t k) {
+        tinytc_value_t pos_a[2] = {m_block, k};
+        std::int32_t shape_a[2] = {m_block_size * num_m_blocks, k_block_size};
+        if (tA == transpose::T) {
+            std::swap(pos_a[0], pos_a[1]);
+            std::swap(shape_a[0], shape_a[1]);
+        }
+        bb.create<cooperative_matrix_prefetch_inst>(0, shape_a[0], shape_a[1], A, pos_a[0],
+                                                    pos_a[1], loc);
+        tinytc_value_t pos_b[2] = {k, n_block};
+        std::int32_t shape_b[2] = {k_block_size, n_block_size * num_n_blocks};
+        if (tB == transpose::T) {
+            std::swap(pos_b[0], pos_b[1]);
+            std::swap(shape_b[0], shape_b[1]);
+        }
+        bb.create<cooperative_matrix_prefetch_inst>(0, shape_b[0], shape_b[1], B, pos_b[0],
+                                                    pos_b[1], loc);
+    };
+    auto const mul_add = [&](region_builder &bb, array_view<tinytc_value_t> a,
+                             array_view<tinytc_value_t> b, array_view<tinytc_value_t> c_acc,
+                             array_view<tinytc_type_t> c_acc_tys) {
         auto c_next = std::vector<tinytc_value_t>{};
         c_next.reserve(num_m_blocks * num_n_blocks);
         for (std::int32_t n = 0; n < num_n_blocks; ++n) {
@@ -127,6 +563,7 @@ void gemm_microkernel(region_builder &bb, transpose tA, transpose tB, bool atomi
     auto const compute_c = [&](region_builder &bb, std::int32_t k_block_size, tinytc_value_t K0,
                                tinytc_value_t K1, std::vector<tinytc_value_t> const &c_acc,
                                std::vector<tinytc_type_t> const &c_acc_tys,
+                               tinytc_attr_t attributes,
                                bool check_k = false) -> std::vector<tinytc_value_t> {
         auto c_step = bb.create<constant_inst>(k_block_size, index_ty, loc);
         auto return_values = bb.for_loop(
@@ -134,12 +571,133 @@ void gemm_microkernel(region_builder &bb, transpose tA, transpose tB, bool atomi
             [&](region_builder &bb, array_view<tinytc_value_t> p) {
                 const auto k = p[0];
                 auto c_acc_iter = array_view<tinytc_value_t>(p.begin() + 1, p.end());
-                auto c_next = compute_c_step(bb, k_block_size, k, c_acc_iter, c_acc_tys, check_k);
+                auto a = load_a(bb, k_block_size, k, check_k);
+                auto b = load_b(bb, k_block_size, k, check_k);
+                auto c_next = mul_add(bb, a, b, c_acc_iter, c_acc_tys);
                 bb.create<yield_inst>(c_next, loc);
             },
-            for_attributes);
+            attributes);
+        return return_values;
+    };
+    // Software-pipelined variant of compute_c for K1 - K0 divisible by k_block_size:
+    // A and B of the next K block are loaded and carried to the next iteration, such that the
+    // loads are in flight during the mul_add of the current K block, and A and B are prefetched
+    // prefetch_distance K blocks ahead if prefetch_distance is positive
+    auto const compute_c_pipelined =
+        [&](region_builder &bb, std::int32_t k_block_size, tinytc_value_t K0, tinytc_value_t K1,
+            std::vector<tinytc_value_t> const &c_acc, std::vector<tinytc_type_t> const &c_acc_tys,
+            tinytc_attr_t attributes) -> std::vector<tinytc_value_t> {
+        auto c_step = bb.create<constant_inst>(k_block_size, index_ty, loc);
+        auto c_prefetch_offset =
+            prefetch_distance > 0
+                ? bb.create<constant_inst>(prefetch_distance * k_block_size, index_ty, loc)
+                : nullptr;
+        // The loop might have zero trips, hence the first load must be checked unless we know
+        // that K1 is positive
+        const auto const_K1 = get_int_constant(K1);
+        const bool check_first = !const_K1 || *const_K1 <= 0;
+        auto a_first = load_a(bb, k_block_size, K0, check_first);
+        auto b_first = load_b(bb, k_block_size, K0, check_first);
+        // Last K block that the loop loads from; the last iteration re-loads this K block
+        auto k_last = instant_constant_fold_add(bb, create<sub_inst>(K1, c_step, index_ty, loc));
+
+        auto init = c_acc;
+        init.insert(init.end(), a_first.begin(), a_first.end());
+        init.insert(init.end(), b_first.begin(), b_first.end());
+        auto init_tys = c_acc_tys;
+        for (auto &a : a_first) {
+            init_tys.emplace_back(a->ty());
+        }
+        for (auto &b : b_first) {
+            init_tys.emplace_back(b->ty());
+        }
+
+        const auto num_c = c_acc.size();
+        auto return_values = bb.for_loop(
+            K0, K1, c_step, init, init_tys,
+            [&](region_builder &bb, array_view<tinytc_value_t> p) {
+                const auto k = p[0];
+                auto c_acc_iter = array_view<tinytc_value_t>(p.begin() + 1, num_c);
+                auto a = array_view<tinytc_value_t>(p.begin() + 1 + num_c, num_m_blocks);
+                auto b = array_view<tinytc_value_t>(p.begin() + 1 + num_c + num_m_blocks,
+                                                    num_n_blocks);
+                if (c_prefetch_offset) {
+                    auto k_prefetch = bb.create<add_inst>(k, c_prefetch_offset, index_ty, loc);
+                    prefetch_ab(bb, k_block_size, k_prefetch);
+                }
+                auto k_next0 = bb.create<add_inst>(k, c_step, index_ty, loc);
+                auto k_next = bb.create<min_inst>(k_next0, k_last, index_ty, loc);
+                auto a_next = load_a(bb, k_block_size, k_next, false);
+                auto b_next = load_b(bb, k_block_size, k_next, false);
+                auto yielded = mul_add(bb, a, b, c_acc_iter, c_acc_tys);
+                yielded.insert(yielded.end(), a_next.begin(), a_next.end());
+                yielded.insert(yielded.end(), b_next.begin(), b_next.end());
+                bb.create<yield_inst>(yielded, loc);
+            },
+            attributes);
+        return_values.resize(num_c);
         return return_values;
     };
+    // Variant of compute_c for K panels staged in shared local memory: K is rounded up to a
+    // multiple of the panel size (the copies fill in zeros) and the next K panel is copied into
+    // the other buffer while the current K panel is multiplied. A single barrier per K panel
+    // suffices: it orders the copy of a buffer before its reads and the reads of the previous
+    // K panel before the buffer is overwritten.
+    auto const compute_c_slm = [&](region_builder &bb, std::vector<tinytc_value_t> const &c_acc,
+                                   std::vector<tinytc_type_t> const &c_acc_tys) {
+        const auto k_block_size = slm->k_block_size;
+        const auto k_panel_size = slm->k_panel_size;
+        const auto local_fence = static_cast<tinytc_address_spaces_t>(address_space::local);
+        auto c_zero = bb.constant_zero(index_ty, loc);
+        auto c_one = bb.create<constant_inst>(1, index_ty, loc);
+        auto c_panel = bb.create<constant_inst>(k_panel_size, index_ty, loc);
+        auto c_panel_1 = bb.create<constant_inst>(k_panel_size - 1, index_ty, loc);
+        auto tmp0 = instant_constant_fold_add(bb, create<add_inst>(K, c_panel_1, index_ty, loc));
+        auto tmp1 = instant_constant_fold_add(bb, create<div_inst>(tmp0, c_panel, index_ty, loc));
+        auto K1 = instant_constant_fold_add(bb, create<mul_inst>(tmp1, c_panel, index_ty, loc));
+
+        // Other subgroups might still read the buffers from the previous block of C
+        bb.create<barrier_inst>(local_fence, loc);
+        slm->copy(bb, c_zero, c_zero);
+        return bb.for_loop(
+            c_zero, K1, c_panel, c_acc, c_acc_tys,
+            [&](region_builder &bb, array_view<tinytc_value_t> p) {
+                const auto k = p[0];
+                auto panel = bb.create<div_inst>(k, c_panel, index_ty, loc);
+                auto buffer = bb.create<and_inst>(panel, c_one, index_ty, loc);
+                auto offset = bb.create<mul_inst>(buffer, c_panel, index_ty, loc);
+                auto next_offset = bb.create<sub_inst>(c_panel, offset, index_ty, loc);
+                bb.create<barrier_inst>(local_fence, loc);
+                auto k_next = bb.create<add_inst>(k, c_panel, index_ty, loc);
+                auto has_next = bb.create<less_than_inst>(k_next, K1, bool_ty, loc);
+                bb.if_condition(
+                    has_next, [&](region_builder &bb) { slm->copy(bb, k_next, next_offset); },
+                    loc);
+
+                auto c_next = std::vector<tinytc_value_t>(p.begin() + 1, p.end());
+                for (std::int32_t kb = 0; kb < k_panel_size; kb += k_block_size) {
+                    auto c_kb = bb.create<constant_inst>(kb, index_ty, loc);
+                    auto k_local = bb.create<add_inst>(offset, c_kb, index_ty, loc);
+                    auto a = load_a_from(bb, k_block_size, slm->A, slm->m_block, k_local,
+                                         checked_flag::none);
+                    auto b = load_b_from(bb, k_block_size, slm->B, slm->n_block, k_local,
+                                         checked_flag::none);
+                    c_next = mul_add(bb, a, b, c_next, c_acc_tys);
+                }
+                bb.create<yield_inst>(c_next, loc);
+            },
+            for_attributes);
+    };
+    auto const compute_c_main = [&](region_builder &bb, std::int32_t k_block_size,
+                                    tinytc_value_t K0, tinytc_value_t K1,
+                                    std::vector<tinytc_value_t> const &c_acc,
+                                    std::vector<tinytc_type_t> const &c_acc_tys) {
+        if (software_pipelining) {
+            return compute_c_pipelined(bb, k_block_size, K0, K1, c_acc, c_acc_tys,
+                                       k_loop_attributes);
+        }
+        return compute_c(bb, k_block_size, K0, K1, c_acc, c_acc_tys, k_loop_attributes);
+    };
 
     auto c_acc = std::vector<tinytc_value_t>{};
     c_acc.reserve(num_m_blocks * num_n_blocks);
@@ -155,121 +713,245 @@ void gemm_microkernel(region_builder &bb, transpose tA, transpose tB, bool atomi
         ty = coopmatrix_c_ty;
     }
 
-    auto k_block_size = K_block_sizes.back();
+    if (slm) {
+        c_acc = compute_c_slm(bb, c_acc, c_acc_tys);
+    } else {
+        auto k_block_size = K_block_sizes.back();
 
-    const auto const_K = get_int_constant(K);
-    if (const_K) {
-        k_block_size = choose_k_block_size(K_block_sizes, *const_K);
-    }
+        const auto const_K = get_int_constant(K);
+        if (const_K) {
+            k_block_size = choose_k_block_size(K_block_sizes, *const_K);
+        }
 
-    auto c_zero = bb.constant_zero(index_ty, loc);
-    auto c_k_block_size = bb.create<constant_inst>(k_block_size, index_ty, loc);
-    auto tmp = instant_constant_fold_add(bb, create<div_inst>(K, c_k_block_size, index_ty, loc));
-    auto K0 = instant_constant_fold_add(bb, create<mul_inst>(tmp, c_k_block_size, index_ty, loc));
-    auto needs_remainder =
-        instant_constant_fold_add(bb, create<less_than_inst>(K0, K, bool_ty, loc));
-    auto r = get_bool_constant(needs_remainder);
-    if (r) {
-        if (*r != 0) {
-            c_acc = compute_c(bb, k_block_size, c_zero, K0, c_acc, c_acc_tys);
-            const auto K_block_size = K_block_sizes.front();
-            c_acc = compute_c(bb, K_block_size, K0, K, c_acc, c_acc_tys, K_block_size > 1);
+        auto c_zero = bb.constant_zero(index_ty, loc);
+        auto c_k_block_size = bb.create<constant_inst>(k_block_size, index_ty, loc);
+        auto k_from = split_k ? split_k->k_begin : c_zero;
+        auto k_to = split_k ? split_k->k_end : K;
+        auto K0 = [&]() -> tinytc_value_t {
+            if (split_k) {
+                auto len = bb.create<sub_inst>(k_to, k_from, index_ty, loc);
+                auto tmp = bb.create<div_inst>(len, c_k_block_size, index_ty, loc);
+                auto len0 = bb.create<mul_inst>(tmp, c_k_block_size, index_ty, loc);
+                return bb.create<add_inst>(k_from, len0, index_ty, loc);
+            }
+            auto tmp =
+                instant_constant_fold_add(bb, create<div_inst>(K, c_k_block_size, index_ty, loc));
+            return instant_constant_fold_add(
+                bb, create<mul_inst>(tmp, c_k_block_size, index_ty, loc));
+        }();
+        auto needs_remainder =
+            instant_constant_fold_add(bb, create<less_than_inst>(K0, k_to, bool_ty, loc));
+        auto r = get_bool_constant(needs_remainder);
+        if (r) {
+            if (*r != 0) {
+                c_acc = compute_c_main(bb, k_block_size, k_from, K0, c_acc, c_acc_tys);
+                const auto K_block_size = K_block_sizes.front();
+                c_acc = compute_c(bb, K_block_size, K0, k_to, c_acc, c_acc_tys, for_attributes,
+                                  K_block_size > 1);
+            } else {
+                c_acc = compute_c_main(bb, k_block_size, k_from, K0, c_acc, c_acc_tys);
+            }
         } else {
-            c_acc = compute_c(bb, k_block_size, c_zero, K0, c_acc, c_acc_tys);
+            c_acc = compute_c_main(bb, k_block_size, k_from, K0, c_acc, c_acc_tys);
+            auto remainder = bb.ifelse(
+                needs_remainder,
+                [&](region_builder &bb) {
+                    const auto K_block_size = K_block_sizes.front();
+                    auto c_next = compute_c(bb, K_block_size, K0, k_to, c_acc, c_acc_tys,
+                                            for_attributes, K_block_size > 1);
+                    bb.create<yield_inst>(c_next, loc);
+                },
+                [&](region_builder &bb) { bb.create<yield_inst>(c_acc, loc); }, c_acc_tys, loc);
+            c_acc = std::move(remainder);
         }
-    } else {
-        c_acc = compute_c(bb, k_block_size, c_zero, K0, c_acc, c_acc_tys);
-        auto remainder = bb.ifelse(
-            needs_remainder,
-            [&](region_builder &bb) {
-                const auto K_block_size = K_block_sizes.front();
-                auto c_next =
-                    compute_c(bb, K_block_size, K0, K, c_acc, c_acc_tys, K_block_size > 1);
-                bb.create<yield_inst>(c_next, loc);
-            },
-            [&](region_builder &bb) { bb.create<yield_inst>(c_acc, loc); }, c_acc_tys, loc);
-        c_acc = std::move(remainder);
     }
 
-    for (auto &a : c_acc) {
-        a = mixed_precision_coopmatrix_scale(bb, alpha, a, loc);
-    }
+    // Scales the accumulator with alpha and updates C
+    auto const update_c = [&](region_builder &bb, std::vector<tinytc_value_t> c_acc) {
+        for (auto &a : c_acc) {
+            a = mixed_precision_coopmatrix_scale(bb, alpha, a, loc);
+        }
 
-    const bool needs_final_cast = coopmatrix_c_ty != coopmatrix_c_acc_ty;
-    if (atomic) {
-        auto const make_stores = [&](auto &&make_store) {
+        const bool needs_final_cast = coopmatrix_c_ty != coopmatrix_c_acc_ty;
+        if (atomic) {
+            auto const make_stores = [&](auto &&make_store) {
+                for (std::int32_t n = 0; n < num_n_blocks; ++n) {
+                    auto pos1_offset = bb.create<constant_inst>(n * n_block_size, index_ty, loc);
+                    auto pos1 = bb.create<add_inst>(n_block, pos1_offset, index_ty, loc);
+                    for (std::int32_t m = 0; m < num_m_blocks; ++m) {
+                        auto pos0_offset =
+                            bb.create<constant_inst>(m * m_block_size, index_ty, loc);
+                        auto pos0 = bb.create<add_inst>(m_block, pos0_offset, index_ty, loc);
+                        auto alpha_ab_mn = c_acc[m + n * num_m_blocks];
+                        if (needs_final_cast) {
+                            alpha_ab_mn = bb.create<cast_inst>(alpha_ab_mn, coopmatrix_c_ty, loc);
+                        }
+                        make_store(alpha_ab_mn, pos0, pos1);
+                    }
+                }
+            };
+            const auto scope = memory_scope::work_group;
+            const auto semantics = memory_semantics::relaxed;
+            constant_inst beta_cst = dyn_cast<constant_inst>(beta->defining_inst());
+            if (beta_cst && beta_cst.is_zero()) {
+                make_stores([&bb, &check_c, &scope, &semantics, &C,
+                             &loc](tinytc_value_t alpha_ab_mn, tinytc_value_t pos0,
+                                   tinytc_value_t pos1) {
+                    bb.create<cooperative_matrix_atomic_store_inst>(
+                        transpose::N, check_c, scope, semantics, alpha_ab_mn, C, pos0, pos1, loc);
+                });
+            } else if (beta_cst && beta_cst.is_identity()) {
+                make_stores([&bb, &check_c, &scope, &semantics, &C,
+                             &loc](tinytc_value_t alpha_ab_mn, tinytc_value_t pos0,
+                                   tinytc_value_t pos1) {
+                    bb.create<cooperative_matrix_atomic_add_inst>(transpose::N, check_c, scope,
+                                                                  semantics, alpha_ab_mn, C, pos0,
+                                                                  pos1, alpha_ab_mn->ty(), loc);
+                });
+            } else {
+                throw compilation_error(loc, status::ir_invalid_beta);
+            }
+        } else {
             for (std::int32_t n = 0; n < num_n_blocks; ++n) {
                 auto pos1_offset = bb.create<constant_inst>(n * n_block_size, index_ty, loc);
                 auto pos1 = bb.create<add_inst>(n_block, pos1_offset, index_ty, loc);
                 for (std::int32_t m = 0; m < num_m_blocks; ++m) {
                     auto pos0_offset = bb.create<constant_inst>(m * m_block_size, index_ty, loc);
                     auto pos0 = bb.create<add_inst>(m_block, pos0_offset, index_ty, loc);
-                    auto alpha_ab_mn = c_acc[m + n * num_m_blocks];
-                    if (needs_final_cast) {
-                        alpha_ab_mn = bb.create<cast_inst>(alpha_ab_mn, coopmatrix_c_ty, loc);
-                    }
-                    make_store(alpha_ab_mn, pos0, pos1);
-                }
-            }
-        };
-        const auto scope = memory_scope::work_group;
-        const auto semantics = memory_semantics::relaxed;
-        constant_inst beta_cst = dyn_cast<constant_inst>(beta->defining_inst());
-        if (beta_cst && beta_cst.is_zero()) {
-            make_stores([&bb, &check_c, &scope, &semantics, &C, &loc](
-                            tinytc_value_t alpha_ab_mn, tinytc_value_t pos0, tinytc_value_t pos1) {
-                bb.create<cooperative_matrix_atomic_store_inst>(
-                    transpose::N, check_c, scope, semantics, alpha_ab_mn, C, pos0, pos1, loc);
-            });
-        } else if (beta_cst && beta_cst.is_identity()) {
-            make_stores([&bb, &check_c, &scope, &semantics, &C, &c_ty, &loc](
-                            tinytc_value_t alpha_ab_mn, tinytc_value_t pos0, tinytc_value_t pos1) {
-                bb.create<cooperative_matrix_atomic_add_inst>(
-                    transpose::N, check_c, scope, semantics, alpha_ab_mn, C, pos0, pos1, c_ty, loc);
-            });
-        } else {
-            throw compilation_error(loc, status::ir_invalid_beta);
-        }
-    } else {
-        for (std::int32_t n = 0; n < num_n_blocks; ++n) {
-            auto pos1_offset = bb.create<constant_inst>(n * n_block_size, index_ty, loc);
-            auto pos1 = bb.create<add_inst>(n_block, pos1_offset, index_ty, loc);
-            for (std::int32_t m = 0; m < num_m_blocks; ++m) {
-                auto pos0_offset = bb.create<constant_inst>(m * m_block_size, index_ty, loc);
-                auto pos0 = bb.create<add_inst>(m_block, pos0_offset, index_ty, loc);
-                auto c_load = bb.create<cooperative_matrix_load_inst>(transpose::N, check_c, C,
-                                                                      pos0, pos1, coopmatrix_c_ty);
-                auto &alpha_ab_mn = c_acc[m + n * num_m_blocks];
-                auto alpha_ab_plus_beta_c = [&] {
-                    if (needs_final_cast) {
-                        auto c_load_acc = bb.create<cast_inst>(c_load, coopmatrix_c_acc_ty, loc);
-                        auto beta_c = mixed_precision_coopmatrix_scale(bb, beta, c_load_acc, loc);
-                        auto alpha_ab_plus_beta_c =
-                            bb.create<add_inst>(alpha_ab_mn, beta_c, alpha_ab_mn->ty(), loc);
-                        return bb.create<cast_inst>(alpha_ab_plus_beta_c, coopmatrix_c_ty, loc);
+                    auto c_load = bb.create<cooperative_matrix_load_inst>(
+                        transpose::N, check_c, C, pos0, pos1, coopmatrix_c_ty);
+                    auto &alpha_ab_mn = c_acc[m + n * num_m_blocks];
+                    auto alpha_ab_plus_beta_c = [&] {
+                        if (needs_final_cast) {
+                            auto c_load_acc =
+                                bb.create<cast_inst>(c_load, coopmatrix_c_acc_ty, loc);
+                            auto beta_c =
+                                mixed_precision_coopmatrix_scale(bb, beta, c_load_acc, loc);
+                            auto alpha_ab_plus_beta_c =
+                                bb.create<add_inst>(alpha_ab_mn, beta_c, alpha_ab_mn->ty(), loc);
+                            return bb.create<cast_inst>(alpha_ab_plus_beta_c, coopmatrix_c_ty, loc);
+                        } else {
+                            auto beta_c = mixed_precision_coopmatrix_scale(bb, beta, c_load, loc);
+                            return bb.create<add_inst>(alpha_ab_mn, beta_c, alpha_ab_mn->ty(), loc);
+                        }
+                    }();
+                    if (epilogue) {
+                        epilogue->store(bb, alpha_ab_plus_beta_c, pos0, pos1, check_c, loc);
                     } else {
-                        auto beta_c = mixed_precision_coopmatrix_scale(bb, beta, c_load, loc);
-                        return bb.create<add_inst>(alpha_ab_mn, beta_c, alpha_ab_mn->ty(), loc);
+                        bb.create<cooperative_matrix_store_inst>(
+                            transpose::N, check_c, alpha_ab_plus_beta_c, C, pos0, pos1, loc);
                     }
-                }();
-                bb.create<cooperative_matrix_store_inst>(transpose::N, check_c,
-                                                         alpha_ab_plus_beta_c, C, pos0, pos1, loc);
+                }
             }
         }
+    };
+
+    if (!split_k) {
+        update_c(bb, std::move(c_acc));
+        return;
     }
+
+    auto c_zero = bb.constant_zero(index_ty, loc);
+    auto c_num_parts = bb.create<constant_inst>(split_k->num_parts, index_ty, loc);
+    if (!split_k->partials) {
+        auto is_active = bb.create<less_than_inst>(split_k->part, c_num_parts, bool_ty, loc);
+        bb.if_condition(is_active, [&](region_builder &bb) { update_c(bb, c_acc); }, loc);
+        return;
+    }
+
+    const auto local_fence = static_cast<tinytc_address_spaces_t>(address_space::local);
+    auto c_one = bb.create<constant_inst>(1, index_ty, loc);
+    auto c_part_stride = bb.create<constant_inst>(split_k->part_stride, index_ty, loc);
+    auto const partial_pos = [&](region_builder &bb, tinytc_value_t col, std::int32_t m,
+                                 std::int32_t n) {
+        auto pos0 = bb.create<constant_inst>(m * m_block_size, index_ty, loc);
+        auto pos1_offset = bb.create<constant_inst>(n * n_block_size, index_ty, loc);
+        auto pos1 = bb.create<add_inst>(col, pos1_offset, index_ty, loc);
+        return std::make_pair(pos0, pos1);
+    };
+    // The partial blocks of a previous GEMM might still be read
+    bb.create<barrier_inst>(local_fence, loc);
+    auto is_not_first = bb.create<less_than_inst>(c_zero, split_k->part, bool_ty, loc);
+    auto is_active = bb.create<less_than_inst>(split_k->part, c_num_parts, bool_ty, loc);
+    auto stores_partial = bb.create<and_inst>(is_not_first, is_active, bool_ty, loc);
+    bb.if_condition(
+        stores_partial,
+        [&](region_builder &bb) {
+            auto part_1 = bb.create<sub_inst>(split_k->part, c_one, index_ty, loc);
+            auto tmp = bb.create<mul_inst>(part_1, c_part_stride, index_ty, loc);
+            auto col = bb.create<add_inst>(tmp, split_k->slot, index_ty, loc);
+            for (std::int32_t n = 0; n < num_n_blocks; ++n) {
+                for (std::int32_t m = 0; m < num_m_blocks; ++m) {
+                    auto [pos0, pos1] = partial_pos(bb, col, m, n);
+                    bb.create<cooperative_matrix_store_inst>(transpose::N, checked_flag::none,
+                                                             c_acc[m + n * num_m_blocks],
+                                                             split_k->partials, pos0, pos1, loc);
+                }
+            }
+        },
+        loc);
+    bb.create<barrier_inst>(local_fence, loc);
+
+    auto is_first = bb.create<equal_inst>(split_k->part, c_zero, bool_ty, loc);
+    bb.if_condition(
+        is_first,
+        [&](region_builder &bb) {
+            auto c_sum = bb.for_loop(
+                c_one, c_num_parts, nullptr, c_acc, c_acc_tys,
+                [&](region_builder &bb, array_view<tinytc_value_t> p) {
+                    auto part_1 = bb.create<sub_inst>(p[0], c_one, index_ty, loc);
+                    auto tmp = bb.create<mul_inst>(part_1, c_part_stride, index_ty, loc);
+                    auto col = bb.create<add_inst>(tmp, split_k->slot, index_ty, loc);
+                    auto c_next = std::vector<tinytc_value_t>{};
+                    c_next.reserve(num_m_blocks * num_n_blocks);
+                    for (std::int32_t n = 0; n < num_n_blocks; ++n) {
+                        for (std::int32_t m = 0; m < num_m_blocks; ++m) {
+                            auto [pos0, pos1] = partial_pos(bb, col, m, n);
+                            auto partial = bb.create<cooperative_matrix_load_inst>(
+                                transpose::N, checked_flag::none, split_k->partials, pos0, pos1,
+                                coopmatrix_c_acc_ty, loc);
+                            auto c_mn = p[1 + m + n * num_m_blocks];
+                            c_next.emplace_back(
+                                bb.create<add_inst>(c_mn, partial, coopmatrix_c_acc_ty, loc));
+                        }
+                    }
+                    bb.create<yield_inst>(c_next, loc);
+                },
+                for_attributes, loc);
+            update_c(bb, std::move(c_sum));
+        },
+        loc);
 }
 
+//! Register blocking of a GEMM; the blocks of C are num_blocks0 x num_blocks1 multiples of
+//! block_size0 x block_size1
+struct gemm_blocking {
+    std::int32_t max_rows;
+    std::int32_t max_cols;
+    std::int32_t block_size0;
+    std::int32_t num_blocks0;
+    std::int32_t block_size1;
+    std::int32_t num_blocks1;
+    bool do_tile_uniformly;
+    std::vector<std::int32_t> K_block_sizes;
+};
+
 class linalg_generator {
   public:
-    linalg_generator(local_tiling const &tiling, core_config const &core_cfg, tinytc_region &reg,
-                     tinytc_inst_iterator_t ip)
-        : tiling_{tiling}, core_cfg_{core_cfg}, bb_{&reg, ip} {}
+    linalg_generator(local_tiling const &tiling, core_config const &core_cfg,
+                     tinytc_core_info const &info, tuning_database const *tuning_db,
+                     bool software_pipelining, std::int32_t prefetch_distance, bool slm_staging,
+                     gemm_epilogue const *epilogue, tinytc_region &reg, tinytc_inst_iterator_t ip)
+        : tiling_{tiling}, core_cfg_{core_cfg}, info_{info}, tuning_db_{tuning_db},
+          software_pipelining_{software_pipelining}, prefetch_distance_{prefetch_distance},
+          slm_staging_{slm_staging}, epilogue_{epilogue}, bb_{&reg, ip} {}
     inline void operator()(inst_view in) {
         throw compilation_error(in.loc(), status::not_implemented);
     }
     void operator()(axpby_inst in);
     void operator()(cumsum_inst in);
     void operator()(gemm_inst in);
+    void operator()(gemm_batched_inst in);
     void operator()(gemv_inst in);
     void operator()(ger_inst in);
     void operator()(hadamard_inst in);
@@ -279,9 +961,18 @@ class linalg_generator {
 
   private:
     auto get_memref_type(tinytc_value const &v) const -> const memref_type *;
+    auto gemm_block_sizes(memref_type const *at, memref_type const *bt, memref_type const *ct,
+                          std::optional<std::int64_t> const_shape0,
+                          std::optional<std::int64_t> const_shape1) const -> gemm_blocking;
 
     local_tiling const &tiling_;
     core_config const &core_cfg_;
+    tinytc_core_info const &info_;
+    tuning_database const *tuning_db_;
+    bool software_pipelining_;
+    std::int32_t prefetch_distance_;
+    bool slm_staging_;
+    gemm_epilogue const *epilogue_;
     region_builder bb_;
 };
 
@@ -528,6 +1219,78 @@ void linalg_generator::operator()(cumsum_inst in) {
     }
 }
 
+auto linalg_generator::gemm_block_sizes(memref_type const *at, memref_type const *bt,
+                                        memref_type const *ct,
+                                        std::optional<std::int64_t> const_shape0,
+                                        std::optional<std::int64_t> const_shape1) const
+    -> gemm_blocking {
+    auto [max_rows, max_cols] = max_register_block_gemm(
+        size(at->element_ty()), size(bt->element_ty()), size(acc_type(ct->element_ty())),
+        core_cfg_.subgroup_size, core_cfg_.register_space,
+        isa<complex_type>(*ct->element_ty()) ? 2 : 1);
+    auto max_K_block_size = std::numeric_limits<std::int32_t>::max();
+    if (tuning_db_) {
+        auto const shape = blas_shape{at->element_ty(),
+                                      bt->element_ty(),
+                                      ct->element_ty(),
+                                      {ct->shape(0), ct->shape(1)},
+                                      true};
+        if (auto tuned = tuning_db_->lookup(info_, shape);
+            tuned && tuned->subgroup_size == core_cfg_.subgroup_size) {
+            max_rows = tuned->max_rows;
+            max_cols = tuned->max_cols;
+            max_K_block_size = tuned->k_block_size;
+        }
+    }
+    // Block sizes are sorted in ascending order; the smallest block size is always kept
+    auto const limit_K_block_sizes = [&max_K_block_size](std::vector<std::int32_t> block_sizes) {
+        block_sizes.erase(
+            std::upper_bound(block_sizes.begin() + 1, block_sizes.end(), max_K_block_size),
+            block_sizes.end());
+        return block_sizes;
+    };
+
+    if (auto ext_type = core_cfg_.matrix->get_precision(at->element_ty()->type_id(),
+                                                        bt->element_ty()->type_id(),
+                                                        ct->element_ty()->type_id());
+        ext_type) {
+        const auto M_bs = ext_type->M_block_sizes();
+        // @todo Think about what do if we have multiple sizes for M
+        const auto block_size0 = M_bs.back();
+        const auto shape0 = const_shape0 ? *const_shape0 : max_rows;
+        const auto num_blocks0 =
+            choose_block_size_multiple(block_size0, max_rows, tiling_.m_tiles(), shape0);
+
+        // @todo Think about what do for multiple N sizes
+        const auto N_bs = ext_type->N_block_sizes(block_size0);
+        const auto block_size1 = N_bs.back();
+        const auto shape1 = const_shape1 ? *const_shape1 : max_cols;
+        const auto num_blocks1 =
+            choose_block_size_multiple(block_size1, max_cols, tiling_.n_tiles(), shape1);
+        const auto K_bs = ext_type->K_block_sizes(block_size0, block_size1);
+
+        return {max_rows,    max_cols, block_size0, num_blocks0, block_size1,
+                num_blocks1, false,    limit_K_block_sizes(K_bs)};
+    }
+
+    const auto block_size0 = core_cfg_.subgroup_size;
+    const auto shape0 = const_shape0 ? *const_shape0 : max_rows;
+    const auto num_blocks0 =
+        choose_block_size_multiple(block_size0, max_rows, tiling_.m_tiles(), shape0);
+    const auto block_size1 = max_cols;
+    const auto num_blocks1 = 1;
+
+    return {max_rows,
+            max_cols,
+            block_size0,
+            num_blocks0,
+            block_size1,
+            num_blocks1,
+            const_shape1.has_value(),
+            limit_K_block_sizes(std::vector<std::int32_t>(standard_K_block_sizes.begin(),
+                                                          standard_K_block_sizes.end()))};
+}
+
 void linalg_generator::operator()(gemm_inst in) {
     auto parallel = create<parallel_inst>(in.loc());
     tinytc_region_t body = &parallel->child_region(0);
@@ -544,11 +1307,6 @@ void linalg_generator::operator()(gemm_inst in) {
     auto sg_m = bb.create<subgroup_id_inst>(comp3::x, i32_ty, in.loc());
     auto sg_n = bb.create<subgroup_id_inst>(comp3::y, i32_ty, in.loc());
 
-    auto [max_rows, max_cols] = max_register_block_gemm(
-        size(at->element_ty()), size(bt->element_ty()), size(acc_type(ct->element_ty())),
-        core_cfg_.subgroup_size, core_cfg_.register_space,
-        isa<complex_type>(*ct->element_ty()) ? 2 : 1);
-
     auto c_shape0 =
         instant_constant_fold_add(bb, create<size_inst>(0, &in.C(), index_ty, in.loc()));
     auto c_shape1 =
@@ -559,46 +1317,169 @@ void linalg_generator::operator()(gemm_inst in) {
     auto const_shape0 = get_int_constant(c_shape0);
     auto const_shape1 = get_int_constant(c_shape1);
 
-    const auto [block_size0, num_blocks0, block_size1, num_blocks1, do_tile_uniformly,
-                K_block_sizes] =
-        [&]() -> std::tuple<std::int32_t, std::int32_t, std::int32_t, std::int32_t, bool,
-                            std::vector<std::int32_t>> {
-        if (auto ext_type = core_cfg_.matrix->get_precision(at->element_ty()->type_id(),
-                                                            bt->element_ty()->type_id(),
-                                                            ct->element_ty()->type_id());
-            ext_type) {
-            const auto M_bs = ext_type->M_block_sizes();
-            // @todo Think about what do if we have multiple sizes for M
-            const auto block_size0 = M_bs.back();
-            const auto shape0 = const_shape0 ? *const_shape0 : max_rows;
-            const auto num_blocks0 =
-                choose_block_size_multiple(block_size0, max_rows, tiling_.m_tiles(), shape0);
-
-            // @todo Think about what do for multiple N sizes
-            const auto N_bs = ext_type->N_block_sizes(block_size0);
-            const auto block_size1 = N_bs.back();
-            const auto shape1 = const_shape1 ? *const_shape1 : max_cols;
-            const auto num_blocks1 =
-                choose_block_size_multiple(block_size1, max_cols, tiling_.n_tiles(), shape1);
-            const auto K_bs = ext_type->K_block_sizes(block_size0, block_size1);
-
-            return std::make_tuple(block_size0, num_blocks0, block_size1, num_blocks1, false, K_bs);
-        }
-
-        const auto block_size0 = core_cfg_.subgroup_size;
-        const auto shape0 = const_shape0 ? *const_shape0 : max_rows;
-        const auto num_blocks0 =
-            choose_block_size_multiple(block_size0, max_rows, tiling_.m_tiles(), shape0);
-        const auto block_size1 = max_cols;
-        const auto num_blocks1 = 1;
-
-        return std::make_tuple(block_size0, num_blocks0, block_size1, num_blocks1,
-                               const_shape1.has_value(),
-                               std::vector<std::int32_t>(standard_K_block_sizes.begin(),
-                                                         standard_K_block_sizes.end()));
+    const auto [max_rows, max_cols, block_size0, num_blocks0, block_size1, num_blocks1,
+                do_tile_uniformly, K_block_sizes] =
+        gemm_block_sizes(at, bt, ct, const_shape0, const_shape1);
+
+    auto no_unroll = get_dictionary_attr_with_sorted(
+        ctx, tinytc_named_attr_t{get<string_attr>(ctx, "unroll"), get<boolean_attr>(ctx, false)});
+    auto const has_matrix_ext = core_cfg_.matrix->get_precision(at->element_ty()->type_id(),
+                                                                bt->element_ty()->type_id(),
+                                                                ct->element_ty()->type_id()) !=
+                                nullptr;
+    // With the matrix extension, the K loop is software-pipelined and unrolled such that the
+    // loads of the next K block overlap with the DPAS of the current K block
+    auto k_unroll =
+        has_matrix_ext
+            ? get_dictionary_attr_with_sorted(
+                  ctx, tinytc_named_attr_t{get<string_attr>(ctx, "unroll"),
+                                           get<integer_attr>(ctx, k_loop_unroll_factor)})
+            : no_unroll;
+
+    // Rows and columns of C that the work-group computes at once
+    const auto wg_rows = block_size0 * num_blocks0 * tiling_.m_tiles();
+    const auto wg_cols = block_size1 * num_blocks1 * tiling_.n_tiles();
+    const auto k_block_size = [&]() -> std::int32_t {
+        if (auto const_K = get_int_constant(K); const_K) {
+            return choose_k_block_size(K_block_sizes, *const_K);
+        }
+        return K_block_sizes.back();
     }();
-
-    if (do_tile_uniformly) {
+    // K panel size of the SLM-staged variant or 0 if A and B are read from global memory.
+    // The panels are copied in tiles of subgroup size rows, so the rows of the panels as laid out
+    // in memory must be a multiple of the subgroup size, and the double-buffered panels may
+    // occupy at most half of the shared local memory.
+    const auto slm_k_panel_size = [&]() -> std::int32_t {
+        if (!slm_staging_ || !has_matrix_ext) {
+            return 0;
+        }
+        const auto sgs = core_cfg_.subgroup_size;
+        const auto a_size = static_cast<std::int64_t>(size(at->element_ty()));
+        const auto b_size = static_cast<std::int64_t>(size(bt->element_ty()));
+        for (std::int32_t blocks = max_slm_k_panel_blocks; blocks >= 1; blocks /= 2) {
+            const auto k_panel_size = blocks * k_block_size;
+            const auto a_rows = in.tA() == transpose::T ? k_panel_size : wg_rows;
+            const auto b_rows = in.tB() == transpose::T ? wg_cols : k_panel_size;
+            const auto bytes = 2 * k_panel_size * (wg_rows * a_size + wg_cols * b_size);
+            if (a_rows % sgs == 0 && b_rows % sgs == 0 &&
+                bytes <= info_.local_memory_size() / 2) {
+                return k_panel_size;
+            }
+        }
+        return 0;
+    }();
+    // Atomic updates with beta = 1 accumulate the parts of a split K loop in C directly
+    constant_inst beta_cst = dyn_cast<constant_inst>(in.beta().defining_inst());
+    const bool reduce_in_slm = !in.atomic() || !beta_cst || !beta_cst.is_identity();
+    // Split of the K loop for GEMMs with few blocks of C, such that subgroups that do not have a
+    // block of C to compute work on a part of the K loop. The blocks of C start as large as if a
+    // single subgroup computed the whole of C and are halved while the K loop cannot be split
+    // further but half of the subgroups would be idle. The split is limited by the shared local
+    // memory that is needed for the reduction of the partial blocks.
+    const auto [split_rows, split_cols, k_splits] =
+        [&]() -> std::tuple<std::int32_t, std::int32_t, std::int32_t> {
+        const auto const_K = get_int_constant(K);
+        if (!const_shape0 || !const_shape1 || !const_K || *const_shape0 <= 0 ||
+            *const_shape1 <= 0) {
+            return {0, 0, 1};
+        }
+        const auto M = *const_shape0;
+        const auto N = *const_shape1;
+        const auto num_subgroups = tiling_.m_tiles() * tiling_.n_tiles();
+        auto nb0 = choose_block_size_multiple(block_size0, max_rows, 1, M);
+        auto nb1 = has_matrix_ext ? choose_block_size_multiple(block_size1, max_cols, 1, N) : 1;
+        auto cols = block_size1 * nb1;
+        if (!has_matrix_ext) {
+            // Distribute the columns evenly
+            const auto num_col_tiles = 1 + (N - 1) / block_size1;
+            cols = static_cast<std::int32_t>(1 + (N - 1) / num_col_tiles);
+        }
+        const auto acc_size = static_cast<std::int64_t>(size(acc_type(ct->element_ty())));
+        auto splits = std::int32_t{1};
+        for (;;) {
+            const auto rows = block_size0 * nb0;
+            const auto num_tiles = (1 + (M - 1) / rows) * (1 + (N - 1) / cols);
+            if (num_tiles > num_subgroups) {
+                return {0, 0, 1};
+            }
+            splits =
+                choose_k_splits(static_cast<std::int32_t>(num_tiles), num_subgroups, *const_K);
+            while (splits > 1 && reduce_in_slm &&
+                   (splits - 1) * num_tiles * rows * cols * acc_size >
+                       info_.local_memory_size() / 2) {
+                splits /= 2;
+            }
+            if (2 * num_tiles * splits > num_subgroups) {
+                break;
+            }
+            if (nb0 > 1 && rows >= cols) {
+                nb0 /= 2;
+            } else if (has_matrix_ext && nb1 > 1) {
+                nb1 /= 2;
+                cols = block_size1 * nb1;
+            } else if (!has_matrix_ext && cols > 1) {
+                cols = 1 + (cols - 1) / 2;
+            } else if (nb0 > 1) {
+                nb0 /= 2;
+            } else {
+                break;
+            }
+        }
+        return {block_size0 * nb0, cols, splits};
+    }();
+    auto slm_buffers = std::vector<tinytc_value_t>{};
+
+    if (k_splits > 1) {
+        const auto loc = in.loc();
+        const auto M = *const_shape0;
+        const auto N = *const_shape1;
+        const auto num_m_tiles = static_cast<std::int32_t>(1 + (M - 1) / split_rows);
+        const auto num_tiles = num_m_tiles * static_cast<std::int32_t>(1 + (N - 1) / split_cols);
+        const auto n_block_size = has_matrix_ext ? block_size1 : split_cols;
+
+        auto sg_id = bb.create<cast_inst>(bb.create<subgroup_linear_id_inst>(i32_ty, loc),
+                                          index_ty, loc);
+        auto c_num_tiles = bb.create<constant_inst>(num_tiles, index_ty, loc);
+        auto c_num_m_tiles = bb.create<constant_inst>(num_m_tiles, index_ty, loc);
+        auto c_rows = bb.create<constant_inst>(split_rows, index_ty, loc);
+        auto c_cols = bb.create<constant_inst>(split_cols, index_ty, loc);
+        auto part = bb.create<div_inst>(sg_id, c_num_tiles, index_ty, loc);
+        auto tile = bb.create<rem_inst>(sg_id, c_num_tiles, index_ty, loc);
+        auto tile_m = bb.create<rem_inst>(tile, c_num_m_tiles, index_ty, loc);
+        auto tile_n = bb.create<div_inst>(tile, c_num_m_tiles, index_ty, loc);
+        auto m_block = bb.create<mul_inst>(tile_m, c_rows, index_ty, loc);
+        auto n_block = bb.create<mul_inst>(tile_n, c_cols, index_ty, loc);
+
+        // The K range of a part is a multiple of the K block size, such that only the last part
+        // needs a remainder loop
+        const auto const_K = *get_int_constant(K);
+        const auto num_k_blocks = 1 + (const_K - 1) / k_block_size;
+        const auto k_part_size = (1 + (num_k_blocks - 1) / k_splits) * k_block_size;
+        auto c_k_part_size = bb.create<constant_inst>(k_part_size, index_ty, loc);
+        auto tmp = bb.create<mul_inst>(part, c_k_part_size, index_ty, loc);
+        auto k_begin = bb.create<min_inst>(tmp, K, index_ty, loc);
+        tmp = bb.create<add_inst>(k_begin, c_k_part_size, index_ty, loc);
+        auto k_end = bb.create<min_inst>(tmp, K, index_ty, loc);
+
+        auto partials = tinytc_value_t{nullptr};
+        if (reduce_in_slm) {
+            auto shape = std::array<std::int64_t, 2u>{split_rows,
+                                                      split_cols * num_tiles * (k_splits - 1)};
+            auto mt = get<memref_type>(acc_type(ct->element_ty()), shape,
+                                       array_view<std::int64_t>{}, address_space::local);
+            partials = slm_buffers.emplace_back(bb_.create<alloca_inst>(mt, loc));
+        }
+        auto slot = bb.create<mul_inst>(tile, c_cols, index_ty, loc);
+        auto split = gemm_split_k{k_begin, k_end,    part, k_splits,
+                                  partials, slot, split_cols * num_tiles};
+        gemm_microkernel(bb, in.tA(), in.tB(), in.atomic(), &in.alpha(), &in.A(), &in.B(),
+                         &in.beta(), &in.C(), K, m_block, block_size0, split_rows / block_size0,
+                         M % split_rows != 0, n_block, n_block_size, split_cols / n_block_size,
+                         N % split_cols != 0, K_block_sizes, at->element_ty(), bt->element_ty(),
+                         ct->element_ty(), no_unroll, k_unroll,
+                         has_matrix_ext && software_pipelining_, prefetch_distance_, nullptr,
+                         &split, epilogue_, loc);
+    } else if (do_tile_uniformly) {
         tile_loop_uniformly(
             bb, c_shape1, block_size1 * num_blocks1, tiling_.n_tiles(), sg_n,
             [&](region_builder &bb, tinytc_value_t n_block, tinytc_value_t trip_count) {
@@ -613,13 +1494,115 @@ void linalg_generator::operator()(gemm_inst in) {
                                          &in.B(), &in.beta(), &in.C(), K, m_block, block_size0,
                                          num_blocks0, m_check, n_block, *const_trip_count,
                                          num_blocks1, false, K_block_sizes, at->element_ty(),
-                                         bt->element_ty(), ct->element_ty(), nullptr, in.loc());
+                                         bt->element_ty(), ct->element_ty(), nullptr, nullptr,
+                                         false, 0, nullptr, nullptr, epilogue_, in.loc());
                     });
             });
+    } else if (slm_k_panel_size > 0) {
+        const auto loc = in.loc();
+        const auto sgs = core_cfg_.subgroup_size;
+        const auto k_panel_size = slm_k_panel_size;
+        const auto tA = in.tA();
+        const auto tB = in.tB();
+        auto const slm_memref = [&](tinytc_type_t ty, std::int64_t rows, std::int64_t cols) {
+            auto shape = std::array<std::int64_t, 2u>{rows, cols};
+            auto mt = get<memref_type>(ty, shape, array_view<std::int64_t>{}, address_space::local);
+            return slm_buffers.emplace_back(bb_.create<alloca_inst>(mt, loc));
+        };
+        auto A_slm = tA == transpose::T
+                         ? slm_memref(at->element_ty(), 2 * k_panel_size, wg_rows)
+                         : slm_memref(at->element_ty(), wg_rows, 2 * k_panel_size);
+        auto B_slm = tB == transpose::T
+                         ? slm_memref(bt->element_ty(), wg_cols, 2 * k_panel_size)
+                         : slm_memref(bt->element_ty(), 2 * k_panel_size, wg_cols);
+
+        auto c_zero = bb.constant_zero(index_ty, loc);
+        auto c_sgs = bb.create<constant_inst>(sgs, index_ty, loc);
+        auto c_num_subgroups =
+            bb.create<constant_inst>(tiling_.m_tiles() * tiling_.n_tiles(), index_ty, loc);
+        auto sg_id = bb.create<cast_inst>(bb.create<subgroup_linear_id_inst>(i32_ty, loc),
+                                          index_ty, loc);
+        // Copies the rows x cols block of src at (src0, src1) to dst at (dst0, dst1); the subgroups
+        // of the work-group copy tiles with subgroup size rows round-robin
+        auto const copy_block = [&](region_builder &bb, tinytc_value_t src, tinytc_value_t src0,
+                                    tinytc_value_t src1, tinytc_value_t dst, tinytc_value_t dst0,
+                                    tinytc_value_t dst1, std::int32_t rows, std::int32_t cols) {
+            const auto tile_cols = std::gcd(cols, 16);
+            const auto row_tiles = rows / sgs;
+            auto tile_ty = get<coopmatrix_type>(get_memref_type(*src)->element_ty(), sgs,
+                                                tile_cols, matrix_use::acc);
+            auto c_row_tiles = bb.create<constant_inst>(row_tiles, index_ty, loc);
+            auto c_tile_cols = bb.create<constant_inst>(tile_cols, index_ty, loc);
+            auto c_num_tiles =
+                bb.create<constant_inst>(row_tiles * (cols / tile_cols), index_ty, loc);
+            bb.for_loop(
+                sg_id, c_num_tiles, c_num_subgroups,
+                [&](region_builder &bb, tinytc_value_t tile) {
+                    auto tile0 = bb.create<rem_inst>(tile, c_row_tiles, index_ty, loc);
+                    auto tile1 = bb.create<div_inst>(tile, c_row_tiles, index_ty, loc);
+                    auto offset0 = bb.create<mul_inst>(tile0, c_sgs, index_ty, loc);
+                    auto offset1 = bb.create<mul_inst>(tile1, c_tile_cols, index_ty, loc);
+                    auto pos0 = bb.create<add_inst>(src0, offset0, index_ty, loc);
+                    auto pos1 = bb.create<add_inst>(src1, offset1, index_ty, loc);
+                    auto val = bb.create<cooperative_matrix_load_inst>(
+                        transpose::N, checked_flag::both, src, pos0, pos1, tile_ty, loc);
+                    pos0 = bb.create<add_inst>(dst0, offset0, index_ty, loc);
+                    pos1 = bb.create<add_inst>(dst1, offset1, index_ty, loc);
+                    bb.create<cooperative_matrix_store_inst>(transpose::N, checked_flag::none, val,
+                                                             dst, pos0, pos1, loc);
+                },
+                no_unroll, loc);
+        };
+
+        // All subgroups iterate over the blocks of C in lockstep as the copies are collective
+        auto c_wg_rows = bb.create<constant_inst>(wg_rows, index_ty, loc);
+        auto c_wg_cols = bb.create<constant_inst>(wg_cols, index_ty, loc);
+        auto c_sg_rows = bb.create<constant_inst>(block_size0 * num_blocks0, index_ty, loc);
+        auto c_sg_cols = bb.create<constant_inst>(block_size1 * num_blocks1, index_ty, loc);
+        auto sg_m_index = bb.create<cast_inst>(sg_m, index_ty, loc);
+        auto sg_n_index = bb.create<cast_inst>(sg_n, index_ty, loc);
+        auto m_local = bb.create<mul_inst>(sg_m_index, c_sg_rows, index_ty, loc);
+        auto n_local = bb.create<mul_inst>(sg_n_index, c_sg_cols, index_ty, loc);
+        const bool m_check = !const_shape0 || *const_shape0 % wg_rows != 0;
+        const bool n_check = !const_shape1 || *const_shape1 % wg_cols != 0;
+        bb.for_loop(
+            c_zero, c_shape1, c_wg_cols,
+            [&](region_builder &bb, tinytc_value_t n_wg) {
+                bb.for_loop(
+                    c_zero, c_shape0, c_wg_rows,
+                    [&](region_builder &bb, tinytc_value_t m_wg) {
+                        auto const copy = [&](region_builder &bb, tinytc_value_t k,
+                                              tinytc_value_t offset) {
+                            if (tA == transpose::T) {
+                                copy_block(bb, &in.A(), k, m_wg, A_slm, offset, c_zero,
+                                           k_panel_size, wg_rows);
+                            } else {
+                                copy_block(bb, &in.A(), m_wg, k, A_slm, c_zero, offset, wg_rows,
+                                           k_panel_size);
+                            }
+                            if (tB == transpose::T) {
+                                copy_block(bb, &in.B(), n_wg, k, B_slm, c_zero, offset, wg_cols,
+                                           k_panel_size);
+                            } else {
+                                copy_block(bb, &in.B(), k, n_wg, B_slm, offset, c_zero,
+                                           k_panel_size, wg_cols);
+                            }
+                        };
+                        auto panels = gemm_slm_panels{A_slm,        B_slm,        m_local, n_local,
+                                                      k_block_size, k_panel_size, copy};
+                        auto m_block = bb.create<add_inst>(m_wg, m_local, index_ty, loc);
+                        auto n_block = bb.create<add_inst>(n_wg, n_local, index_ty, loc);
+                        gemm_microkernel(bb, tA, tB, in.atomic(), &in.alpha(), &in.A(), &in.B(),
+                                         &in.beta(), &in.C(), K, m_block, block_size0,
+                                         num_blocks0, m_check, n_block, block_size1, num_blocks1,
+                                         n_check, K_block_sizes, at->element_ty(), bt->element_ty(),
+                                         ct->element_ty(), no_unroll, no_unroll, false, 0,
+                                         &panels, nullptr, epilogue_, loc);
+                    },
+                    no_unroll, loc);
+            },
+            no_unroll, loc);
     } else {
-        auto no_unroll = get_dictionary_attr_with_sorted(
-            ctx,
-            tinytc_named_attr_t{get<string_attr>(ctx, "unroll"), get<boolean_attr>(ctx, false)});
         tile_loop_by_sgs(
             bb, c_shape1, block_size1 * num_blocks1, tiling_.n_tiles(), sg_n,
             [&](region_builder &bb, tinytc_value_t n_block, bool n_check, tinytc_value_t) {
@@ -630,7 +1613,10 @@ void linalg_generator::operator()(gemm_inst in) {
                                          &in.B(), &in.beta(), &in.C(), K, m_block, block_size0,
                                          num_blocks0, m_check, n_block, block_size1, num_blocks1,
                                          n_check, K_block_sizes, at->element_ty(), bt->element_ty(),
-                                         ct->element_ty(), no_unroll, in.loc());
+                                         ct->element_ty(), no_unroll, k_unroll,
+                                         has_matrix_ext && software_pipelining_,
+                                         prefetch_distance_, nullptr, nullptr, epilogue_,
+                                         in.loc());
                     },
                     no_unroll);
             },
@@ -638,6 +1624,175 @@ void linalg_generator::operator()(gemm_inst in) {
     }
 
     bb_.add(std::move(parallel));
+    for (auto &buffer : slm_buffers) {
+        bb_.create<lifetime_stop_inst>(buffer, in.loc());
+    }
+}
+
+void linalg_generator::operator()(gemm_batched_inst in) {
+    auto const loc = in.loc();
+    auto at = get_memref_type(in.A());
+    auto bt = get_memref_type(in.B());
+    auto ct = get_memref_type(in.C());
+
+    auto ctx = in.alpha().context();
+    auto i32_ty = get<i32_type>(ctx);
+    auto index_ty = get<index_type>(ctx);
+
+    // Matrix of the batch index; an operand of order 2 is broadcast over all problems
+    auto const batch_view = [&](region_builder &bb, tinytc_value &operand,
+                                tinytc_value_t batch_idx) -> tinytc_value_t {
+        auto ot = get_memref_type(operand);
+        if (ot->dim() == 2) {
+            return &operand;
+        }
+        auto static_offset = std::array<std::int64_t, 3u>{0, 0, dynamic};
+        auto static_size = std::array<std::int64_t, 3u>{ot->shape(0), ot->shape(1), 0};
+        auto sizes = std::vector<tinytc_value_t>{};
+        for (std::int64_t i = 0; i < 2; ++i) {
+            if (is_dynamic_value(ot->shape(i))) {
+                sizes.emplace_back(bb.create<size_inst>(i, &operand, index_ty, loc));
+            }
+        }
+        auto shape = std::array<std::int64_t, 2u>{ot->shape(0), ot->shape(1)};
+        auto stride = std::array<std::int64_t, 2u>{ot->stride(0), ot->stride(1)};
+        auto sub_ty = get<memref_type>(ot->element_ty(), shape, stride, ot->addrspace());
+        return bb.create<subview_inst>(static_offset, static_size, &operand,
+                                       array_view{batch_idx}, sizes, sub_ty, loc);
+    };
+
+    auto const static_mode = [](std::int64_t s) -> std::optional<std::int64_t> {
+        return is_dynamic_value(s) ? std::nullopt : std::make_optional(s);
+    };
+    const auto const_shape0 = static_mode(ct->shape(0));
+    const auto const_shape1 = static_mode(ct->shape(1));
+    const auto [max_rows, max_cols, block_size0, num_blocks0, block_size1, num_blocks1,
+                do_tile_uniformly, K_block_sizes] =
+        gemm_block_sizes(at, bt, ct, const_shape0, const_shape1);
+    auto const has_matrix_ext = core_cfg_.matrix->get_precision(at->element_ty()->type_id(),
+                                                                bt->element_ty()->type_id(),
+                                                                ct->element_ty()->type_id()) !=
+                                nullptr;
+
+    // Problems whose blocks of C occupy at most half of the subgroups are packed into one
+    // work-group; the blocks of C are as large as if a single subgroup computed the whole of C
+    const auto [rows, cols, num_tiles, packs] =
+        [&]() -> std::tuple<std::int32_t, std::int32_t, std::int32_t, std::int32_t> {
+        if (!const_shape0 || !const_shape1 || *const_shape0 <= 0 || *const_shape1 <= 0) {
+            return {0, 0, 0, 1};
+        }
+        const auto M = *const_shape0;
+        const auto N = *const_shape1;
+        const auto rows = block_size0 * choose_block_size_multiple(block_size0, max_rows, 1, M);
+        auto cols = block_size1;
+        if (has_matrix_ext) {
+            cols *= choose_block_size_multiple(block_size1, max_cols, 1, N);
+        } else {
+            // Distribute the columns evenly
+            const auto num_col_tiles = 1 + (N - 1) / block_size1;
+            cols = static_cast<std::int32_t>(1 + (N - 1) / num_col_tiles);
+        }
+        const auto num_tiles = (1 + (M - 1) / rows) * (1 + (N - 1) / cols);
+        const auto num_subgroups = tiling_.m_tiles() * tiling_.n_tiles();
+        if (2 * num_tiles > num_subgroups) {
+            return {0, 0, 0, 1};
+        }
+        return {rows, cols, static_cast<std::int32_t>(num_tiles),
+                static_cast<std::int32_t>(num_subgroups / num_tiles)};
+    }();
+
+    auto batch = instant_constant_fold_add(bb_, create<size_inst>(2, &in.C(), index_ty, loc));
+    auto no_unroll = get_dictionary_attr_with_sorted(
+        ctx, tinytc_named_attr_t{get<string_attr>(ctx, "unroll"), get<boolean_attr>(ctx, false)});
+
+    if (packs > 1) {
+        auto k_unroll = has_matrix_ext ? get_dictionary_attr_with_sorted(
+                                             ctx, tinytc_named_attr_t{
+                                                      get<string_attr>(ctx, "unroll"),
+                                                      get<integer_attr>(ctx, k_loop_unroll_factor)})
+                                       : no_unroll;
+        const auto M = *const_shape0;
+        const auto N = *const_shape1;
+        const auto num_m_tiles = static_cast<std::int32_t>(1 + (M - 1) / rows);
+        const auto n_block_size = has_matrix_ext ? block_size1 : cols;
+
+        auto parallel = create<parallel_inst>(loc);
+        auto bb = region_builder{&parallel->child_region(0)};
+
+        auto sg_id = bb.create<cast_inst>(bb.create<subgroup_linear_id_inst>(i32_ty, loc),
+                                          index_ty, loc);
+        auto c_num_tiles = bb.create<constant_inst>(num_tiles, index_ty, loc);
+        auto c_num_m_tiles = bb.create<constant_inst>(num_m_tiles, index_ty, loc);
+        auto c_rows = bb.create<constant_inst>(rows, index_ty, loc);
+        auto c_cols = bb.create<constant_inst>(cols, index_ty, loc);
+        auto c_packs = bb.create<constant_inst>(packs, index_ty, loc);
+        auto first = bb.create<div_inst>(sg_id, c_num_tiles, index_ty, loc);
+        auto tile = bb.create<rem_inst>(sg_id, c_num_tiles, index_ty, loc);
+        auto tile_m = bb.create<rem_inst>(tile, c_num_m_tiles, index_ty, loc);
+        auto tile_n = bb.create<div_inst>(tile, c_num_m_tiles, index_ty, loc);
+        auto m_block = bb.create<mul_inst>(tile_m, c_rows, index_ty, loc);
+        auto n_block = bb.create<mul_inst>(tile_n, c_cols, index_ty, loc);
+        auto K = instant_constant_fold_add(
+            bb, create<size_inst>(in.tA() == transpose::T ? 0 : 1, &in.A(), index_ty, loc));
+
+        auto const batch_loop = [&](region_builder &bb) {
+            bb.for_loop(
+                first, batch, c_packs,
+                [&](region_builder &bb, tinytc_value_t batch_idx) {
+                    auto a = batch_view(bb, in.A(), batch_idx);
+                    auto b = batch_view(bb, in.B(), batch_idx);
+                    auto c = batch_view(bb, in.C(), batch_idx);
+                    gemm_microkernel(bb, in.tA(), in.tB(), in.atomic(), &in.alpha(), a, b,
+                                     &in.beta(), c, K, m_block, block_size0, rows / block_size0,
+                                     M % rows != 0, n_block, n_block_size, cols / n_block_size,
+                                     N % cols != 0, K_block_sizes, at->element_ty(),
+                                     bt->element_ty(), ct->element_ty(), no_unroll, k_unroll,
+                                     has_matrix_ext && software_pipelining_,
+                                     prefetch_distance_, nullptr, nullptr, nullptr, loc);
+                },
+                no_unroll, loc);
+        };
+        // Left-over subgroups must not start a batch loop as they would duplicate problems
+        if (packs * num_tiles < tiling_.m_tiles() * tiling_.n_tiles()) {
+            auto bool_ty = get<boolean_type>(ctx);
+            auto c_active = bb.create<constant_inst>(packs * num_tiles, index_ty, loc);
+            auto active = bb.create<less_than_inst>(sg_id, c_active, bool_ty, loc);
+            bb.if_condition(active, batch_loop, loc);
+        } else {
+            batch_loop(bb);
+        }
+
+        bb_.add(std::move(parallel));
+    } else {
+        // The work-group computes one problem after the other with the GEMM lowering
+        auto c_zero = bb_.constant_zero(index_ty, loc);
+        auto loop_handle = create<for_inst>(c_zero, batch, nullptr, array_view<tinytc_value_t>{},
+                                            array_view<tinytc_type_t>{}, loc);
+        auto loop = for_inst(loop_handle.get());
+        loop.get().attr(no_unroll);
+        auto &body = loop.body();
+        auto bb = region_builder{&body};
+        auto a = batch_view(bb, in.A(), &loop.loop_var());
+        auto b = batch_view(bb, in.B(), &loop.loop_var());
+        auto c = batch_view(bb, in.C(), &loop.loop_var());
+        bb.create<gemm_inst>(in.atomic(), in.tA(), in.tB(), &in.alpha(), a, b, &in.beta(), c, loc);
+
+        auto gemm_it = --body.end();
+        auto gen = linalg_generator{tiling_,
+                                    core_cfg_,
+                                    info_,
+                                    tuning_db_,
+                                    software_pipelining_,
+                                    prefetch_distance_,
+                                    slm_staging_,
+                                    nullptr,
+                                    body,
+                                    gemm_it.get()};
+        visit(gen, *gemm_it);
+        body.insts().erase(gen.insertion_point());
+
+        bb_.add(std::move(loop_handle));
+    }
 }
 
 void linalg_generator::operator()(gemv_inst in) {
@@ -815,15 +1970,58 @@ lower_linalg_pass::lower_linalg_pass(::tinytc_core_info const *info) : info_(std
     }
 }
 
-void lower_linalg_pass::run_on_function(tinytc_func &fn) {
+void lower_linalg_pass::run_on_function(tinytc_func &fn, analysis_manager &am) {
     auto [core_cfg, tiling] = get_core_config_and_tiling(fn, info_);
+    auto const tuning_db = fn.ty()->context()->tuning_db();
+    auto const software_pipelining = [&]() -> bool {
+        if (auto sp_attr = get_attr(fn.attr(), "software_pipelining"); sp_attr) {
+            return dyn_cast_or_throw<boolean_attr>(sp_attr, [&] {
+                       return compilation_error(fn.loc(), status::ir_expected_boolean_attribute);
+                   })->value();
+        }
+        return true;
+    }();
+    auto const prefetch_distance = [&]() -> std::int32_t {
+        if (auto pd_attr = get_attr(fn.attr(), "prefetch_distance"); pd_attr) {
+            auto pd = dyn_cast_or_throw<integer_attr>(pd_attr, [&] {
+                return compilation_error(fn.loc(), status::ir_expected_integer_attribute);
+            });
+            if (pd->value() < 0) {
+                throw compilation_error(fn.loc(), status::ir_out_of_bounds,
+                                        "Prefetch distance must not be negative");
+            }
+            return pd->value();
+        }
+        return default_prefetch_distance;
+    }();
+    auto const slm_staging = [&]() -> bool {
+        if (auto slm_attr = get_attr(fn.attr(), "slm_staging"); slm_attr) {
+            return dyn_cast_or_throw<boolean_attr>(slm_attr, [&] {
+                       return compilation_error(fn.loc(), status::ir_expected_boolean_attribute);
+                   })->value();
+        }
+        return false;
+    }();
 
     walk<walk_order::post_order>(fn, [&](tinytc_region &reg) {
         auto it = reg.begin();
         while (it != reg.end()) {
             if (isa<blas_a2_inst>(*it) || isa<blas_a3_inst>(*it)) {
-                auto gen = linalg_generator{tiling, core_cfg, reg, it.get()};
+                auto epilogue = isa<gemm_inst>(*it) ? gemm_epilogue{reg, it, am.alias()}
+                                                    : gemm_epilogue{};
+                epilogue.hoist(reg, it);
+                auto gen = linalg_generator{tiling,
+                                            core_cfg,
+                                            *info_,
+                                            tuning_db.get(),
+                                            software_pipelining,
+                                            prefetch_distance,
+                                            slm_staging,
+                                            epilogue.empty() ? nullptr : &epilogue,
+                                            reg,
+                                            it.get()};
                 visit(gen, *it);
+                epilogue.erase(reg);
                 it = reg.insts().erase(gen.insertion_point());
             } else {
                 ++it;
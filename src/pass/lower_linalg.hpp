@@ -8,11 +8,13 @@
 
 namespace tinytc {
 
+class analysis_manager;
+
 class lower_linalg_pass {
   public:
     lower_linalg_pass(::tinytc_core_info const *info);
 
-    void run_on_function(::tinytc_func &fn);
+    void run_on_function(::tinytc_func &fn, analysis_manager &am);
 
   private:
     ::tinytc_core_info const *info_;
@@ -0,0 +1,279 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "pass/narrow_index.hpp"
+#include "analysis/analysis_manager.hpp"
+#include "analysis/range.hpp"
+#include "codegen_tools.hpp"
+#include "node/func.hpp"
+#include "node/inst.hpp"
+#include "node/inst_view.hpp"
+#include "node/region.hpp"
+#include "node/type.hpp"
+#include "node/value.hpp"
+#include "tinytc/types.hpp"
+#include "util/casting.hpp"
+#include "util/ilist.hpp"
+#include "util/ilist_base.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace tinytc {
+
+namespace {
+
+constexpr auto int32_max = std::int64_t{std::numeric_limits<std::int32_t>::max()};
+
+auto create_arith(IK kind, tinytc_value_t a, tinytc_value_t b, tinytc_type_t ty,
+                  location const &loc) -> unique_handle<tinytc_inst_t> {
+    switch (kind) {
+    case IK::IK_add:
+        return create<add_inst>(a, b, ty, loc);
+    case IK::IK_sub:
+        return create<sub_inst>(a, b, ty, loc);
+    case IK::IK_mul:
+        return create<mul_inst>(a, b, ty, loc);
+    case IK::IK_div:
+        return create<div_inst>(a, b, ty, loc);
+    case IK::IK_rem:
+        return create<rem_inst>(a, b, ty, loc);
+    case IK::IK_max:
+        return create<max_inst>(a, b, ty, loc);
+    case IK::IK_min:
+        return create<min_inst>(a, b, ty, loc);
+    case IK::IK_shl:
+        return create<shl_inst>(a, b, ty, loc);
+    case IK::IK_shr:
+        return create<shr_inst>(a, b, ty, loc);
+    case IK::IK_and:
+        return create<and_inst>(a, b, ty, loc);
+    case IK::IK_or:
+        return create<or_inst>(a, b, ty, loc);
+    case IK::IK_xor:
+        return create<xor_inst>(a, b, ty, loc);
+    default:
+        break;
+    }
+    return {};
+}
+
+auto create_arith_unary(IK kind, tinytc_value_t a, tinytc_type_t ty, location const &loc)
+    -> unique_handle<tinytc_inst_t> {
+    switch (kind) {
+    case IK::IK_neg:
+        return create<neg_inst>(a, ty, loc);
+    case IK::IK_not:
+        return create<not_inst>(a, ty, loc);
+    case IK::IK_abs:
+        return create<abs_inst>(a, ty, loc);
+    default:
+        break;
+    }
+    return {};
+}
+
+void replace_all_uses(tinytc_value &from, tinytc_value_t to) {
+    auto u = from.use_begin();
+    while (from.has_uses()) {
+        u->set(to);
+        u = from.use_begin();
+    }
+}
+
+class index_narrower {
+  public:
+    index_narrower(tinytc_func &fn, range_analysis_result range);
+
+    auto run_on_region(tinytc_region &reg) -> bool;
+
+  private:
+    auto fits(tinytc_value const &v) const -> bool { return range_.fits(v, i32_ty_); }
+    //! Returns the i32 value of an index value that fits into i32
+    auto narrow(tinytc_value &v) -> tinytc_value_t;
+    //! Inserts narrowed instruction in front of it and replaces uses by the widened result
+    void replace(tinytc_region &reg, tinytc_region::iterator it,
+                 unique_handle<tinytc_inst_t> narrowed);
+    auto narrow_arith(tinytc_region &reg, tinytc_region::iterator it) -> bool;
+    auto narrow_loop(tinytc_region &reg, tinytc_region::iterator loop_it)
+        -> tinytc_region::iterator;
+
+    tinytc_type_t i32_ty_;
+    tinytc_type_t index_ty_;
+    range_analysis_result range_;
+    std::unordered_map<tinytc_value const *, tinytc_region *> param_region_;
+    std::unordered_map<tinytc_value const *, tinytc_value_t> narrowed_;
+};
+
+index_narrower::index_narrower(tinytc_func &fn, range_analysis_result range)
+    : i32_ty_{get<i32_type>(fn.ty()->context())},
+      index_ty_{get<index_type>(fn.ty()->context())}, range_{std::move(range)} {
+    for (auto &p : fn.params()) {
+        param_region_[&p] = &fn.body();
+    }
+}
+
+auto index_narrower::narrow(tinytc_value &v) -> tinytc_value_t {
+    auto def = v.defining_inst();
+    if (auto c = dyn_cast<cast_inst>(def); c && isa<i32_type>(*c.a().ty())) {
+        return &c.a();
+    }
+    if (auto it = narrowed_.find(&v); it != narrowed_.end()) {
+        return it->second;
+    }
+
+    // Insert directly after the definition such that the i32 value dominates all uses
+    auto [reg, ip] = [&]() -> std::pair<tinytc_region *, tinytc_region::iterator> {
+        if (def) {
+            return {def->parent(), ++def->iterator()};
+        }
+        auto reg = param_region_.at(&v);
+        return {reg, reg->begin()};
+    }();
+    auto narrowed = [&]() -> unique_handle<tinytc_inst_t> {
+        if (auto c = get_int_constant(v); c) {
+            return create<constant_inst>(*c, i32_ty_, v.loc());
+        }
+        return create<cast_inst>(&v, i32_ty_, v.loc());
+    }();
+    auto result = &narrowed->result(0);
+    reg->insts().insert(ip, narrowed.release());
+    range_.set(*result, range_.get(v));
+    return narrowed_[&v] = result;
+}
+
+void index_narrower::replace(tinytc_region &reg, tinytc_region::iterator it,
+                             unique_handle<tinytc_inst_t> narrowed) {
+    auto &old_result = it->result(0);
+    auto widened = create<cast_inst>(&narrowed->result(0), index_ty_, it->loc());
+    range_.set(narrowed->result(0), range_.get(old_result));
+    range_.set(widened->result(0), range_.get(old_result));
+    replace_all_uses(old_result, &widened->result(0));
+    reg.insts().insert(it, narrowed.release());
+    reg.insts().insert(it, widened.release());
+}
+
+auto index_narrower::narrow_arith(tinytc_region &reg, tinytc_region::iterator it) -> bool {
+    if (it->num_results() != 1 || !isa<index_type>(*it->result(0).ty()) || !fits(it->result(0))) {
+        return false;
+    }
+    if (auto a = dyn_cast<arith_inst>(it.get()); a) {
+        if (!fits(a.a()) || !fits(a.b())) {
+            return false;
+        }
+        if (isa<shl_inst>(*it) || isa<shr_inst>(*it)) {
+            auto const shift = range_.get(a.b());
+            if (shift.lo < 0 || shift.hi >= 32) {
+                return false;
+            }
+        }
+        auto narrowed =
+            create_arith(it->type_id(), narrow(a.a()), narrow(a.b()), i32_ty_, it->loc());
+        if (narrowed) {
+            replace(reg, it, std::move(narrowed));
+            return true;
+        }
+    } else if (auto a = dyn_cast<arith_unary_inst>(it.get()); a) {
+        if (!fits(a.a())) {
+            return false;
+        }
+        auto narrowed = create_arith_unary(it->type_id(), narrow(a.a()), i32_ty_, it->loc());
+        if (narrowed) {
+            replace(reg, it, std::move(narrowed));
+            return true;
+        }
+    }
+    return false;
+}
+
+auto index_narrower::narrow_loop(tinytc_region &reg, tinytc_region::iterator loop_it)
+    -> tinytc_region::iterator {
+    auto loop = for_inst(loop_it.get());
+    auto &loop_var = loop.loop_var();
+    if (!isa<index_type>(*loop_var.ty()) || !fits(loop.from()) || !fits(loop.to()) ||
+        !fits(loop_var)) {
+        return loop_it;
+    }
+    // The loop variable must not overflow when it is incremented past the upper bound
+    auto const step = loop.has_step() ? range_.get(loop.step()) : value_range{1, 1};
+    if (step.lo <= 0 || step.hi > int32_max || range_.get(loop.to()).hi > int32_max - step.hi) {
+        return loop_it;
+    }
+
+    auto init = std::vector<tinytc_value_t>{};
+    auto result_tys = std::vector<tinytc_type_t>{};
+    for (auto &init_val : loop.iter_init()) {
+        init.emplace_back(&init_val);
+    }
+    for (auto &r : loop.results()) {
+        result_tys.emplace_back(r.ty());
+    }
+    auto new_loop_handle =
+        create<for_inst>(narrow(loop.from()), narrow(loop.to()),
+                         loop.has_step() ? narrow(loop.step()) : nullptr, init, result_tys,
+                         loop.loc());
+    auto new_loop = for_inst(new_loop_handle.get());
+    new_loop.get().attr(loop.get().attr());
+
+    auto &body = loop.body();
+    auto &new_body = new_loop.body();
+    while (!body.empty()) {
+        auto in = body.begin().get();
+        body.insts().unlink(body.begin());
+        new_body.insts().push_back(in);
+    }
+    auto widened = create<cast_inst>(&new_loop.loop_var(), index_ty_, loop.loc());
+    range_.set(new_loop.loop_var(), range_.get(loop_var));
+    range_.set(widened->result(0), range_.get(loop_var));
+    replace_all_uses(loop_var, &widened->result(0));
+    new_body.insts().insert(new_body.begin(), widened.release());
+    for (std::size_t i = 0; i < init.size(); ++i) {
+        range_.set(new_loop.iter_arg(i), range_.get(loop.iter_arg(i)));
+        range_.set(new_loop.get().result(i), range_.get(loop.get().result(i)));
+        param_region_[&new_loop.iter_arg(i)] = &new_body;
+        replace_all_uses(loop.iter_arg(i), &new_loop.iter_arg(i));
+        replace_all_uses(loop.get().result(i), &new_loop.get().result(i));
+    }
+
+    auto new_it = reg.insts().insert(loop_it, new_loop_handle.release());
+    reg.insts().erase(loop_it);
+    return new_it;
+}
+
+auto index_narrower::run_on_region(tinytc_region &reg) -> bool {
+    bool changed = false;
+    auto it = reg.begin();
+    while (it != reg.end()) {
+        if (isa<for_inst>(*it)) {
+            auto new_it = narrow_loop(reg, it);
+            changed = changed || new_it != it;
+            it = new_it;
+        }
+        for (auto &subreg : it->child_regions()) {
+            for (auto &p : subreg.params()) {
+                param_region_[&p] = &subreg;
+            }
+            changed = run_on_region(subreg) || changed;
+        }
+        if (narrow_arith(reg, it)) {
+            it = reg.insts().erase(it);
+            changed = true;
+        } else {
+            ++it;
+        }
+    }
+    return changed;
+}
+
+} // namespace
+
+auto narrow_index_pass::run_on_function(tinytc_func &fn, analysis_manager &am) -> bool {
+    return index_narrower{fn, am.range()}.run_on_region(fn.body());
+}
+
+} // namespace tinytc
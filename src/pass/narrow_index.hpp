@@ -0,0 +1,34 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef NARROW_INDEX_20251016_HPP
+#define NARROW_INDEX_20251016_HPP
+
+#include "tinytc/types.h"
+
+namespace tinytc {
+
+class analysis_manager;
+
+/**
+ * @brief Rewrite index arithmetic to i32 arithmetic if the range analysis shows that it is safe
+ *
+ * An integer instruction of index type is replaced by the same instruction of i32 type if the
+ * ranges of the operands and of the result fit into i32. The result is widened with a cast to
+ * index, such that instructions requiring index operands (e.g. load, store, subview) remain
+ * valid; chains of arithmetic instructions use the i32 values directly. For-loops whose bounds
+ * and loop variable fit into i32 (including the final increment) get an i32 loop variable.
+ *
+ * Index values that enter the narrowed arithmetic are truncated once directly after their
+ * definition. The SPIR-V code generation computes memref offsets in 32 bit where the memref is
+ * small enough, so the widening casts are undone there and 64-bit arithmetic is only needed
+ * at the final pointer addition.
+ */
+class narrow_index_pass {
+  public:
+    auto run_on_function(::tinytc_func &fn, analysis_manager &am) -> bool;
+};
+
+} // namespace tinytc
+
+#endif // NARROW_INDEX_20251016_HPP
@@ -0,0 +1,507 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "pass/strength_reduction.hpp"
+#include "analysis/analysis_manager.hpp"
+#include "analysis/gcd.hpp"
+#include "codegen_tools.hpp"
+#include "node/func.hpp"
+#include "node/inst.hpp"
+#include "node/inst_view.hpp"
+#include "node/region.hpp"
+#include "node/type.hpp"
+#include "node/value.hpp"
+#include "node/visit.hpp"
+#include "number.hpp"
+#include "support/walk.hpp"
+#include "tinytc/types.hpp"
+#include "util/casting.hpp"
+#include "util/ilist.hpp"
+#include "util/ilist_base.hpp"
+#include "util/math.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace tinytc {
+
+namespace {
+
+//! Number of bits of the dividend of the magic number division; the dividend must lie in
+//! [0, 2^magic_bits) such that all intermediate values fit into i64
+constexpr std::int64_t magic_bits = 31;
+//! The magic number setup (a loop with magic_bits trips and an i64 division) only pays off if
+//! the loop executes at least this many divisions
+constexpr std::int64_t magic_min_divisions = 16;
+//! The initial value and increment of a loop-carried value cost two multiplications in front of
+//! the loop, hence the loop must have at least this many trips
+constexpr std::int64_t iv_min_trip_count = 3;
+//! Each loop-carried value occupies a register during the whole loop, hence the number of
+//! multiplications that are replaced per loop is limited
+constexpr std::size_t max_induction_variables = 4;
+
+//! Returns the trip count if the bounds and the step of the loop are constant
+auto constant_trip_count(for_inst loop) -> std::optional<std::int64_t> {
+    auto const from = get_int_constant(loop.from());
+    auto const to = get_int_constant(loop.to());
+    auto const step = loop.has_step() ? get_int_constant(loop.step()) : std::optional<std::int64_t>{1};
+    if (!from || !to || !step || *step <= 0) {
+        return std::nullopt;
+    }
+    return *from < *to ? (*to - *from + *step - 1) / *step : 0;
+}
+
+/**
+ * @brief Infer whether integer values are non-negative
+ *
+ * Loop variables are non-negative if the lower bound and the step are non-negative.
+ */
+class non_negative_analysis {
+  public:
+    non_negative_analysis(tinytc_func &fn);
+
+    auto operator()(tinytc_value const &v) -> bool;
+    //! Remove cached result; must be called before a value is destroyed
+    void forget(tinytc_value const &v) { known_.erase(&v); }
+
+  private:
+    auto compute(tinytc_inst &in) -> bool;
+
+    std::unordered_map<tinytc_value const *, bool> known_;
+};
+
+non_negative_analysis::non_negative_analysis(tinytc_func &fn) {
+    walk<walk_order::pre_order>(fn, [&](tinytc_inst &in) {
+        if (auto f = dyn_cast<for_inst>(&in); f) {
+            known_[&f.loop_var()] = (*this)(f.from()) && (!f.has_step() || (*this)(f.step()));
+        } else if (auto f = dyn_cast<foreach_inst>(&in); f) {
+            auto from = f.from().begin();
+            for (auto &loop_var : f.loop_vars()) {
+                known_[&loop_var] = (*this)(*from++);
+            }
+        }
+    });
+}
+
+auto non_negative_analysis::operator()(tinytc_value const &v) -> bool {
+    if (auto it = known_.find(&v); it != known_.end()) {
+        return it->second;
+    }
+    auto const result = v.defining_inst() ? compute(*v.defining_inst()) : false;
+    known_[&v] = result;
+    return result;
+}
+
+auto non_negative_analysis::compute(tinytc_inst &in) -> bool {
+    if (auto c = dyn_cast<constant_inst>(&in); c) {
+        auto const value = c.value();
+        auto const int_value = std::get_if<std::int64_t>(&value);
+        return int_value && *int_value >= 0;
+    }
+    if (isa<builtin_inst>(in) || isa<size_inst>(in)) {
+        return true;
+    }
+    if (auto c = dyn_cast<cast_inst>(&in); c) {
+        auto const from_ty = c.a().ty();
+        auto const to_ty = c.result().ty();
+        return isa<integer_type>(*from_ty) && isa<integer_type>(*to_ty) &&
+               size(to_ty) >= size(from_ty) && (*this)(c.a());
+    }
+    if (auto a = dyn_cast<arith_inst>(&in); a) {
+        if (isa<and_inst>(in) || isa<max_inst>(in)) {
+            return (*this)(a.a()) || (*this)(a.b());
+        }
+        if (isa<rem_inst>(in) || isa<shr_inst>(in)) {
+            return (*this)(a.a());
+        }
+        if (isa<add_inst>(in) || isa<mul_inst>(in) || isa<div_inst>(in) || isa<min_inst>(in)) {
+            return (*this)(a.a()) && (*this)(a.b());
+        }
+    }
+    return false;
+}
+
+//! Returns x^-1 mod 2^bits for odd x, sign-extended to 64 bit
+auto multiplicative_inverse(std::int64_t x, std::size_t bits) -> std::int64_t {
+    auto const ux = static_cast<std::uint64_t>(x);
+    auto inv = ux; // Correct to 3 bits; each Newton iteration doubles the number of correct bits
+    for (int i = 0; i < 5; ++i) {
+        inv *= 2 - ux * inv;
+    }
+    if (bits < 64) {
+        auto const shift = 64 - bits;
+        return static_cast<std::int64_t>(inv << shift) >> shift;
+    }
+    return static_cast<std::int64_t>(inv);
+}
+
+class strength_reducer {
+  public:
+    strength_reducer(gcd_analysis_result gcd, non_negative_analysis &non_negative)
+        : gcd_{std::move(gcd)}, non_negative_{non_negative} {}
+
+    auto run_on_region(tinytc_region &reg) -> bool;
+
+  private:
+    auto erase(tinytc_region &reg, tinytc_region::iterator it) -> tinytc_region::iterator;
+    auto reduce_arith(tinytc_region &reg, tinytc_region::iterator it) -> tinytc_value_t;
+    auto reduce_invariant_divisions(tinytc_region &reg, tinytc_region::iterator loop_it) -> bool;
+    auto reduce_induction_variables(tinytc_region &reg, tinytc_region::iterator loop_it)
+        -> tinytc_region::iterator;
+
+    gcd_analysis_result gcd_;
+    non_negative_analysis &non_negative_;
+};
+
+//! Inserts instructions in front of an iterator
+class inserter {
+  public:
+    inserter(tinytc_region &reg, tinytc_region::iterator ip, location const &loc)
+        : reg_{reg}, ip_{ip}, loc_{loc} {}
+
+    template <typename T, typename... Args> auto add(Args &&...args) -> tinytc_value_t {
+        auto in = create<T>(std::forward<Args>(args)..., loc_);
+        auto result = &in->result(0);
+        reg_.insts().insert(ip_, in.release());
+        return result;
+    }
+    auto constant(std::int64_t value, tinytc_type_t ty) -> tinytc_value_t {
+        return add<constant_inst>(value, ty);
+    }
+
+  private:
+    tinytc_region &reg_;
+    tinytc_region::iterator ip_;
+    location const &loc_;
+};
+
+void replace_all_uses(tinytc_value &from, tinytc_value_t to) {
+    auto u = from.use_begin();
+    while (from.has_uses()) {
+        u->set(to);
+        u = from.use_begin();
+    }
+}
+
+//! Values that are defined inside a loop
+auto variant_values(tinytc_inst &loop) -> std::unordered_set<tinytc_value const *> {
+    auto variant = std::unordered_set<tinytc_value const *>{};
+    walk<walk_order::pre_order>(loop, [&variant](tinytc_inst &in) {
+        for (auto &subreg : in.child_regions()) {
+            for (auto &p : subreg.params()) {
+                variant.insert(&p);
+            }
+        }
+        for (auto &res : in.results()) {
+            variant.insert(&res);
+        }
+    });
+    return variant;
+}
+
+auto strength_reducer::erase(tinytc_region &reg, tinytc_region::iterator it)
+    -> tinytc_region::iterator {
+    // Memory of erased values might be reused for new values, so cached facts are dropped
+    auto const forget = [this](tinytc_value const &v) {
+        gcd_.set(v, 1);
+        non_negative_.forget(v);
+    };
+    for (auto &res : it->results()) {
+        forget(res);
+    }
+    for (auto &subreg : it->child_regions()) {
+        for (auto &p : subreg.params()) {
+            forget(p);
+        }
+    }
+    return reg.insts().erase(it);
+}
+
+auto strength_reducer::run_on_region(tinytc_region &reg) -> bool {
+    bool changed = false;
+    auto it = reg.begin();
+    while (it != reg.end()) {
+        for (auto &subreg : it->child_regions()) {
+            changed = run_on_region(subreg) || changed;
+        }
+        if (isa<for_inst>(*it)) {
+            changed = reduce_invariant_divisions(reg, it) || changed;
+            auto new_it = reduce_induction_variables(reg, it);
+            changed = changed || new_it != it;
+            it = ++new_it;
+        } else if (auto replacement = reduce_arith(reg, it); replacement) {
+            replace_all_uses(it->result(0), replacement);
+            it = erase(reg, it);
+            changed = true;
+        } else {
+            ++it;
+        }
+    }
+    return changed;
+}
+
+auto strength_reducer::reduce_arith(tinytc_region &reg, tinytc_region::iterator it)
+    -> tinytc_value_t {
+    auto in = dyn_cast<arith_inst>(it.get());
+    if (!in) {
+        return nullptr;
+    }
+    auto ty = in.result().ty();
+    if (!isa<integer_type>(*ty)) {
+        return nullptr;
+    }
+    auto ins = inserter{reg, it, in.loc()};
+
+    if (isa<mul_inst>(in.get())) {
+        auto x = &in.a();
+        auto c = get_int_constant(in.b());
+        if (!c) {
+            x = &in.b();
+            c = get_int_constant(in.a());
+        }
+        if (c && *c > 1 && is_positive_power_of_two(*c)) {
+            return ins.add<shl_inst>(x, ins.constant(ilog2(*c), ty), ty);
+        }
+        return nullptr;
+    }
+
+    auto const d = get_int_constant(in.b());
+    if (!d || *d <= 1) {
+        return nullptr;
+    }
+    auto &x = in.a();
+    bool const divisible = gcd_.get(x) % *d == 0;
+    if (isa<div_inst>(in.get())) {
+        if (is_positive_power_of_two(*d)) {
+            if (divisible || non_negative_(x)) {
+                return ins.add<shr_inst>(&x, ins.constant(ilog2(*d), ty), ty);
+            }
+        } else if (divisible) {
+            // Exact division: x = q * 2^k * d_odd, hence q = (x >> k) * d_odd^-1 mod 2^bits
+            auto const k = std::countr_zero(static_cast<std::uint64_t>(*d));
+            tinytc_value_t x_odd = &x;
+            if (k > 0) {
+                x_odd = ins.add<shr_inst>(x_odd, ins.constant(k, ty), ty);
+            }
+            auto const d_inv = multiplicative_inverse(*d >> k, size(ty) * 8);
+            return ins.add<mul_inst>(x_odd, ins.constant(d_inv, ty), ty);
+        }
+    } else if (isa<rem_inst>(in.get())) {
+        if (divisible) {
+            return ins.constant(0, ty);
+        }
+        if (is_positive_power_of_two(*d) && non_negative_(x)) {
+            return ins.add<and_inst>(&x, ins.constant(*d - 1, ty), ty);
+        }
+    }
+    return nullptr;
+}
+
+auto strength_reducer::reduce_invariant_divisions(tinytc_region &reg,
+                                                  tinytc_region::iterator loop_it) -> bool {
+    auto loop = for_inst(loop_it.get());
+    auto variant = variant_values(loop.get());
+
+    auto const is_candidate = [&](tinytc_inst &in) {
+        auto a = dyn_cast<arith_inst>(&in);
+        return a && (isa<div_inst>(in) || isa<rem_inst>(in)) &&
+               isa<i32_type>(*a.result().ty()) && !variant.contains(&a.b()) &&
+               !get_int_constant(a.b()) && non_negative_(a.a()) && non_negative_(a.b());
+    };
+
+    if (auto trip_count = constant_trip_count(loop); trip_count) {
+        std::int64_t num_divisions = 0;
+        for (auto &in : loop.body()) {
+            num_divisions += is_candidate(in) ? 1 : 0;
+        }
+        if (*trip_count * num_divisions < magic_min_divisions) {
+            return false;
+        }
+    }
+
+    // Magic number m and shift s of each divisor
+    using magic_number = std::pair<tinytc_value_t, tinytc_value_t>;
+    auto magic = std::unordered_map<tinytc_value const *, magic_number>{};
+    auto const get_magic = [&](tinytc_value &d) {
+        if (auto it = magic.find(&d); it != magic.end()) {
+            return it->second;
+        }
+        // For 0 <= x < 2^N and d <= 2^l we have floor(x / d) = (x * m) >> (N + l) with
+        // m = ceil(2^(N + l) / d). We choose l = ceil(log2(d)) such that m <= 2^(N + 1) and
+        // the product fits into i64 for N = 31.
+        auto ctx = d.context();
+        auto i64_ty = get<i64_type>(ctx);
+        auto ins = inserter{reg, loop_it, loop.loc()};
+        auto c0 = ins.constant(0, i64_ty);
+        auto c1 = ins.constant(1, i64_ty);
+        auto c_bits = ins.constant(magic_bits, i64_ty);
+        // The setup is executed even if the loop has zero trips, so d might be zero here. A zero
+        // divisor is undefined inside the loop anyway, hence we clamp d to 1 to avoid a trap.
+        auto d64 = ins.add<max_inst>(ins.add<cast_inst>(&d, i64_ty), c1, i64_ty);
+
+        // l = number of k in [0, N) with 2^k < d
+        auto log2_loop_handle = create<for_inst>(c0, c_bits, nullptr, array_view{c0},
+                                                 array_view{i64_ty}, loop.loc());
+        auto log2_loop = for_inst(log2_loop_handle.get());
+        {
+            auto &body = log2_loop.body();
+            auto bi = inserter{body, body.end(), loop.loc()};
+            auto p = bi.add<shl_inst>(c1, &log2_loop.loop_var(), i64_ty);
+            auto t = bi.add<sub_inst>(d64, p, i64_ty);
+            t = bi.add<max_inst>(t, c0, i64_ty);
+            t = bi.add<min_inst>(t, c1, i64_ty);
+            auto l_next = bi.add<add_inst>(&log2_loop.iter_arg(0), t, i64_ty);
+            body.insts().push_back(create<yield_inst>(array_view{l_next}, loop.loc()).release());
+        }
+        auto l = &log2_loop.get().result(0);
+        reg.insts().insert(loop_it, log2_loop_handle.release());
+
+        auto s = ins.add<add_inst>(l, c_bits, i64_ty);
+        auto p = ins.add<shl_inst>(c1, s, i64_ty);
+        auto d_minus_1 = ins.add<sub_inst>(d64, c1, i64_ty);
+        auto p_ceil = ins.add<add_inst>(p, d_minus_1, i64_ty);
+        auto m = ins.add<div_inst>(p_ceil, d64, i64_ty);
+        return magic[&d] = std::make_pair(m, s);
+    };
+
+    // Quotients are shared between div and rem with the same operands
+    using operand_pair = std::pair<tinytc_value const *, tinytc_value const *>;
+    auto quotients = std::map<operand_pair, tinytc_value_t>{};
+
+    bool changed = false;
+    auto &body = loop.body();
+    auto it = body.begin();
+    while (it != body.end()) {
+        if (!is_candidate(*it)) {
+            ++it;
+            continue;
+        }
+        auto in = arith_inst(it.get());
+        auto ty = in.result().ty();
+        auto ins = inserter{body, it, in.loc()};
+        auto &q = quotients[std::make_pair(&in.a(), &in.b())];
+        if (!q) {
+            auto i64_ty = get<i64_type>(ty->context());
+            auto [m, s] = get_magic(in.b());
+            auto x64 = ins.add<cast_inst>(&in.a(), i64_ty);
+            auto q64 = ins.add<mul_inst>(x64, m, i64_ty);
+            q64 = ins.add<shr_inst>(q64, s, i64_ty);
+            q = ins.add<cast_inst>(q64, ty);
+        }
+        tinytc_value_t replacement = q;
+        if (isa<rem_inst>(in.get())) {
+            auto qd = ins.add<mul_inst>(replacement, &in.b(), ty);
+            replacement = ins.add<sub_inst>(&in.a(), qd, ty);
+        }
+        replace_all_uses(in.result(), replacement);
+        it = erase(body, it);
+        changed = true;
+    }
+    return changed;
+}
+
+auto strength_reducer::reduce_induction_variables(tinytc_region &reg,
+                                                  tinytc_region::iterator loop_it)
+    -> tinytc_region::iterator {
+    auto loop = for_inst(loop_it.get());
+    auto &loop_var = loop.loop_var();
+    auto ty = loop_var.ty();
+    if (auto tc = constant_trip_count(loop); tc && *tc < iv_min_trip_count) {
+        return loop_it;
+    }
+    auto variant = variant_values(loop.get());
+
+    // Collect mul i, c with loop-invariant c; shifts are as cheap as the add that would replace
+    // them and are kept
+    auto ivs = std::vector<std::pair<tinytc_inst_t, tinytc_value_t>>{};
+    for (auto &in : loop.body()) {
+        auto a = dyn_cast<arith_inst>(&in);
+        if (!a || !isa<mul_inst>(in) || ivs.size() >= max_induction_variables) {
+            continue;
+        }
+        if (&a.a() == &loop_var && !variant.contains(&a.b())) {
+            ivs.emplace_back(&in, &a.b());
+        } else if (&a.b() == &loop_var && !variant.contains(&a.a())) {
+            ivs.emplace_back(&in, &a.a());
+        }
+    }
+    if (ivs.empty()) {
+        return loop_it;
+    }
+
+    // j_0 = from * c, j_{n+1} = j_n + step * c
+    auto init = std::vector<tinytc_value_t>{};
+    auto result_tys = std::vector<tinytc_type_t>{};
+    for (auto &init_val : loop.iter_init()) {
+        init.emplace_back(&init_val);
+    }
+    for (auto &r : loop.results()) {
+        result_tys.emplace_back(r.ty());
+    }
+    auto const num_iter_args = init.size();
+    auto ins = inserter{reg, loop_it, loop.loc()};
+    auto increments = std::vector<tinytc_value_t>{};
+    for (auto &[in, c] : ivs) {
+        init.emplace_back(ins.add<mul_inst>(&loop.from(), c, ty));
+        result_tys.emplace_back(ty);
+        increments.emplace_back(loop.has_step() ? ins.add<mul_inst>(&loop.step(), c, ty) : c);
+    }
+
+    auto new_loop_handle =
+        create<for_inst>(&loop.from(), &loop.to(), loop.has_step() ? &loop.step() : nullptr,
+                         init, result_tys, loop.loc());
+    auto new_loop = for_inst(new_loop_handle.get());
+    new_loop.get().attr(loop.get().attr());
+    auto &body = loop.body();
+    auto &new_body = new_loop.body();
+    while (!body.empty()) {
+        auto in = body.begin().get();
+        body.insts().unlink(body.begin());
+        new_body.insts().push_back(in);
+    }
+    replace_all_uses(loop_var, &new_loop.loop_var());
+    for (std::size_t i = 0; i < num_iter_args; ++i) {
+        replace_all_uses(loop.iter_arg(i), &new_loop.iter_arg(i));
+    }
+
+    auto yielded = std::vector<tinytc_value_t>{};
+    if (num_iter_args > 0) {
+        auto y = get_yield(loop.loc(), new_body);
+        for (auto &op : y.get().operands()) {
+            yielded.emplace_back(&op);
+        }
+        erase(new_body, y.get().iterator());
+    }
+    auto body_ins = inserter{new_body, new_body.end(), loop.loc()};
+    for (std::size_t i = 0; i < ivs.size(); ++i) {
+        auto j = &new_loop.iter_arg(num_iter_args + i);
+        replace_all_uses(ivs[i].first->result(0), j);
+        erase(new_body, ivs[i].first->iterator());
+        yielded.emplace_back(body_ins.add<add_inst>(j, increments[i], ty));
+    }
+    new_body.insts().push_back(create<yield_inst>(yielded, loop.loc()).release());
+
+    for (std::size_t i = 0; i < num_iter_args; ++i) {
+        replace_all_uses(loop.get().result(i), &new_loop.get().result(i));
+    }
+    auto new_it = reg.insts().insert(loop_it, new_loop_handle.release());
+    erase(reg, loop_it);
+    return new_it;
+}
+
+} // namespace
+
+auto strength_reduction_pass::run_on_function(tinytc_func &fn, analysis_manager &am) -> bool {
+    auto non_negative = non_negative_analysis{fn};
+    return strength_reducer{am.gcd(), non_negative}.run_on_region(fn.body());
+}
+
+} // namespace tinytc
@@ -0,0 +1,41 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef STRENGTH_REDUCTION_20251016_HPP
+#define STRENGTH_REDUCTION_20251016_HPP
+
+#include "tinytc/types.h"
+
+namespace tinytc {
+
+class analysis_manager;
+
+/**
+ * @brief Replace integer arithmetic by cheaper equivalents
+ *
+ * The following rewrites are applied to scalar integer arithmetic:
+ *
+ * - mul x, 2^k -> shl x, k
+ * - div x, 2^k -> shr x, k if x is non-negative or divisible by 2^k
+ * - rem x, 2^k -> and x, 2^k-1 if x is non-negative; rem x, d -> 0 if x is divisible by d
+ * - div x, d -> mul (shr x, k), d_inv if x is divisible by the constant d = 2^k d_odd, where
+ *   d_inv is the multiplicative inverse of the odd number d_odd modulo 2^bits
+ * - mul i, c -> loop-carried value j, j += step * c, if i is the loop variable of a for-loop and
+ *   c is invariant in the loop; only a few multiplications per loop are replaced and loops with
+ *   a small constant trip count are skipped
+ * - div x, d and rem x, d with non-negative i32 operands and a non-constant divisor d that is
+ *   invariant in the enclosing for-loop -> multiplication with a magic number and shift in i64
+ *   arithmetic, where the magic number is computed in front of the loop from max(d, 1); loops
+ *   with a constant trip count must execute enough divisions to amortize the computation
+ *
+ * Divisibility is taken from the GCD analysis. Non-negativity is inferred from non-negative
+ * constants, builtins, sizes, loop variables with non-negative bounds, and arithmetic thereof.
+ */
+class strength_reduction_pass {
+  public:
+    auto run_on_function(::tinytc_func &fn, analysis_manager &am) -> bool;
+};
+
+} // namespace tinytc
+
+#endif // STRENGTH_REDUCTION_20251016_HPP
@@ -2,7 +2,9 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include "pass/work_group_size.hpp"
+#include "autotune.hpp"
 #include "codegen_tools.hpp"
+#include "compiler_context.hpp"
 #include "device_info.hpp"
 #include "error.hpp"
 #include "node/attr.hpp"
@@ -15,11 +17,14 @@
 #include "tinytc/builder.hpp"
 #include "tinytc/core.hpp"
 #include "tinytc/types.hpp"
+#include "util/casting.hpp"
 #include "util/overloaded.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <functional>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <unordered_set>
@@ -50,11 +55,17 @@ auto get_shapes(tinytc_func &fn) -> std::vector<blas_shape> {
                       if (c->dim() == 1) {
                           shape_set.insert(blas_shape{a, b, c->element_ty(), {c->shape(0), 0}});
                       } else if (c->dim() >= 2) {
-                          shape_set.insert(blas_shape{a,
-                                                      b,
-                                                      c->element_ty(),
-                                                      {c->shape(0), c->shape(1)},
-                                                      isa<gemm_inst>(in.get())});
+                          auto shape =
+                              blas_shape{a, b, c->element_ty(), {c->shape(0), c->shape(1)}};
+                          if (auto g = dyn_cast<gemm_inst>(&in.get()); g) {
+                              shape.is_gemm = true;
+                              shape.K = get_memref_type(g.A())->shape(
+                                  g.tA() == transpose::T ? 0 : 1);
+                          } else if (isa<gemm_batched_inst>(in.get())) {
+                              shape.is_gemm = true;
+                              shape.batch = c->shape(2);
+                          }
+                          shape_set.insert(shape);
                       }
                   },
                   [](inst_view) {}},
@@ -82,9 +93,29 @@ void work_group_size_pass::run_on_function(tinytc_func &fn) {
     const auto shapes = get_shapes(fn);
 
     auto ctx = fn.ty()->context();
+    const auto tuned = [&]() -> std::optional<tuning_config> {
+        auto db = ctx->tuning_db();
+        if (!db) {
+            return std::nullopt;
+        }
+        auto const result_size = [](blas_shape const &s) -> std::int64_t {
+            return s.is_gemm && !is_dynamic_value(s.shape[0]) && !is_dynamic_value(s.shape[1])
+                       ? s.shape[0] * s.shape[1]
+                       : 0;
+        };
+        auto largest = std::max_element(shapes.begin(), shapes.end(),
+                                        [&](blas_shape const &a, blas_shape const &b) {
+                                            return result_size(a) < result_size(b);
+                                        });
+        if (largest == shapes.end() || result_size(*largest) == 0) {
+            return std::nullopt;
+        }
+        return db->lookup(*info_, *largest);
+    }();
+
     const auto subgroup_size = [&] {
         if (!sgs_attr) {
-            auto sgs = suggest_subgroup_size(shapes, *info_);
+            auto sgs = tuned ? tuned->subgroup_size : suggest_subgroup_size(shapes, *info_);
             sgs_attr = get<integer_attr>(ctx, sgs);
             return sgs;
         } else {
@@ -101,7 +132,13 @@ void work_group_size_pass::run_on_function(tinytc_func &fn) {
 
     const auto work_group_size = [&] {
         if (!wgs_attr) {
-            auto tiling = suggest_local_tiling(shapes, cfg);
+            auto tiling = local_tiling{};
+            if (tuned && tuned->subgroup_size == subgroup_size &&
+                tuned->m_tiles * tuned->n_tiles * subgroup_size <= cfg.max_work_group_size) {
+                tiling = local_tiling{tuned->m_tiles, tuned->n_tiles};
+            } else {
+                tiling = suggest_local_tiling(shapes, cfg, info_->local_memory_size());
+            }
             auto wgs = std::array<std::int32_t, 2u>{tiling[0] * subgroup_size, tiling[1]};
             wgs_attr = get<array_attr>(
                 ctx, array_view{get<integer_attr>(ctx, wgs[0]), get<integer_attr>(ctx, wgs[1])});
@@ -119,9 +156,19 @@ void work_group_size_pass::run_on_function(tinytc_func &fn) {
         throw compilation_error(fn.loc(), status::unsupported_work_group_size);
     }
 
-    fn.attr(get_dictionary_attr_with_sorted(
-        ctx, {tinytc_named_attr_t{get<string_attr>(ctx, "subgroup_size"), sgs_attr},
-              tinytc_named_attr_t{get<string_attr>(ctx, "work_group_size"), wgs_attr}}));
+    // Keep the other function attributes, e.g. the ones tuning the lowering of linalg instructions
+    auto attrs = std::vector<tinytc_named_attr_t>{};
+    if (auto dict = fn.attr() ? dyn_cast<dictionary_attr>(fn.attr()) : nullptr; dict) {
+        for (auto const &na : dict->attrs()) {
+            auto name = dyn_cast<string_attr>(na.name);
+            if (!name || (name->str() != "subgroup_size" && name->str() != "work_group_size")) {
+                attrs.emplace_back(na);
+            }
+        }
+    }
+    attrs.emplace_back(tinytc_named_attr_t{get<string_attr>(ctx, "subgroup_size"), sgs_attr});
+    attrs.emplace_back(tinytc_named_attr_t{get<string_attr>(ctx, "work_group_size"), wgs_attr});
+    fn.attr(get<dictionary_attr>(ctx, attrs));
 }
 
 } // namespace tinytc
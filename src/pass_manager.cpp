@@ -0,0 +1,178 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "pass_manager.hpp"
+#include "analysis/analysis_manager.hpp"
+#include "compiler_context.hpp"
+#include "node/func.hpp"
+#include "node/prog.hpp"
+#include "pass/check_ir.hpp"
+#include "pass/common_subexpression_elimination.hpp"
+#include "pass/constant_propagation.hpp"
+#include "pass/dead_code_elimination.hpp"
+#include "pass/dump_cfg.hpp"
+#include "pass/dump_def_use.hpp"
+#include "pass/dump_gcd.hpp"
+#include "pass/dump_ir.hpp"
+#include "pass/insert_barrier.hpp"
+#include "pass/insert_lifetime_stop.hpp"
+#include "pass/loop_invariant_code_motion.hpp"
+#include "pass/loop_unroll.hpp"
+#include "pass/lower_coopmatrix.hpp"
+#include "pass/lower_foreach.hpp"
+#include "pass/lower_linalg.hpp"
+#include "pass/narrow_index.hpp"
+#include "pass/stack.hpp"
+#include "pass/strength_reduction.hpp"
+#include "pass/work_group_size.hpp"
+#include "pass_statistics.hpp"
+#include "support/arena.hpp"
+#include "tinytc/types.hpp"
+
+#include <algorithm>
+#include <iostream> // IWYU pragma: keep
+#include <iterator>
+#include <type_traits>
+
+namespace tinytc {
+
+namespace {
+
+template <typename PassT> struct optflag_setter {
+    PassT &pass;
+    tinytc_compiler_context_t ctx;
+
+    template <typename... Flags> void operator()(Flags &&...flags) {
+        (pass.set_opt_flag(flags, ctx->opt_flag(flags)), ...);
+    }
+};
+
+template <typename PassT> constexpr bool is_read_only_pass = false;
+template <> constexpr bool is_read_only_pass<check_ir_pass> = true;
+template <> constexpr bool is_read_only_pass<dump_cfg_pass> = true;
+template <> constexpr bool is_read_only_pass<dump_def_use_pass> = true;
+template <> constexpr bool is_read_only_pass<dump_gcd_pass> = true;
+template <> constexpr bool is_read_only_pass<dump_ir_pass> = true;
+
+template <typename PassT>
+auto invoke_function_pass(PassT &pass, tinytc_func &fn, analysis_manager &am) -> bool {
+    auto const run = [&] {
+        if constexpr (requires { pass.run_on_function(fn, am); }) {
+            return pass.run_on_function(fn, am);
+        } else {
+            return pass.run_on_function(fn);
+        }
+    };
+    if constexpr (std::is_same_v<decltype(run()), bool>) {
+        return run();
+    } else {
+        run();
+        return !is_read_only_pass<PassT>;
+    }
+}
+
+struct registered_pass {
+    char const *name;
+    pass_pipeline::run_fn run;
+};
+
+#define FUNCTION_PASS(NAME, CREATE_PASS, ...)                                                      \
+    registered_pass{NAME, [](tinytc_func &fn, analysis_manager &am, tinytc_compiler_context_t ctx, \
+                             ::tinytc_core_info const *) {                                         \
+                        auto pass = CREATE_PASS;                                                   \
+                        optflag_setter{pass, ctx}(__VA_ARGS__);                                    \
+                        return invoke_function_pass(pass, fn, am);                                 \
+                    }},
+#define FUNCTION_PASS_WITH_INFO(NAME, CREATE_PASS)                                                 \
+    registered_pass{NAME, [](tinytc_func &fn, analysis_manager &am, tinytc_compiler_context_t,     \
+                             ::tinytc_core_info const *info) {                                     \
+                        auto pass = CREATE_PASS(info);                                             \
+                        return invoke_function_pass(pass, fn, am);                                 \
+                    }},
+registered_pass const registered_passes[] = {
+#include "passes.def"
+};
+#undef FUNCTION_PASS
+#undef FUNCTION_PASS_WITH_INFO
+
+auto trim(std::string_view s) -> std::string_view {
+    auto const ws = std::string_view{" \t\n\r"};
+    auto const first = s.find_first_not_of(ws);
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    return s.substr(first, s.find_last_not_of(ws) - first + 1);
+}
+
+} // namespace
+
+pass_pipeline::pass_pipeline(tinytc_compiler_context_t ctx, ::tinytc_core_info const *info)
+    : ctx_(ctx), info_(info) {}
+
+pass_pipeline::pass_pipeline(std::string_view pipeline, tinytc_compiler_context_t ctx,
+                             ::tinytc_core_info const *info)
+    : pass_pipeline(ctx, info) {
+    while (!pipeline.empty()) {
+        auto const comma = pipeline.find(',');
+        add_pass(trim(pipeline.substr(0, comma)));
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        pipeline.remove_prefix(comma + 1);
+        if (pipeline.empty()) {
+            // Trailing comma
+            throw status::unknown_pass_name;
+        }
+    }
+}
+
+void pass_pipeline::add_pass(std::string_view name) {
+    auto it = std::find_if(std::begin(registered_passes), std::end(registered_passes),
+                           [&name](registered_pass const &p) { return name == p.name; });
+    if (it == std::end(registered_passes)) {
+        throw status::unknown_pass_name;
+    }
+    passes_.emplace_back(entry{it->name, it->run});
+}
+
+void pass_pipeline::run_on_function(tinytc_func &fn) const {
+    auto am = analysis_manager{fn, info_};
+    for (auto const &e : passes_) {
+        run_pass(e, fn, am);
+    }
+}
+
+void pass_pipeline::run_on_program(tinytc_prog &p) const {
+    auto ams = std::vector<analysis_manager>{};
+    for (auto &fn : p) {
+        ams.emplace_back(analysis_manager{fn, info_});
+    }
+    for (auto const &e : passes_) {
+        for (auto &am : ams) {
+            run_pass(e, am.fn(), am);
+        }
+    }
+}
+
+auto pass_pipeline::pass_names() -> std::vector<char const *> const & {
+    static auto const names = [] {
+        auto names = std::vector<char const *>{};
+        for (auto const &p : registered_passes) {
+            names.emplace_back(p.name);
+        }
+        return names;
+    }();
+    return names;
+}
+
+void pass_pipeline::run_pass(entry const &e, tinytc_func &fn, analysis_manager &am) const {
+    auto const arena_scope = ir_arena_scope(fn.arena());
+    bool changed = false;
+    instrument_pass(ctx_->pass_stats(), e.name, fn,
+                    [&] { changed = e.run(fn, am, ctx_, info_); });
+    if (changed) {
+        am.invalidate();
+    }
+}
+
+} // namespace tinytc
@@ -0,0 +1,79 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef PASS_MANAGER_20251016_HPP
+#define PASS_MANAGER_20251016_HPP
+
+#include "tinytc/types.h"
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace tinytc {
+
+class analysis_manager;
+
+/**
+ * @brief Sequence of function passes
+ *
+ * Pass names are resolved when the pipeline is built, such that running the pipeline does not
+ * involve any name lookup. Analysis results are cached per function in an analysis_manager and
+ * are only invalidated after a pass that reports a change.
+ *
+ * A pass reports a change by returning true from run_on_function; passes that return void are
+ * assumed to change the IR, unless they are known to only read the IR (check and dump passes).
+ * Passes that consume analyses implement run_on_function(tinytc_func &, analysis_manager &).
+ */
+class pass_pipeline {
+  public:
+    using run_fn = bool (*)(tinytc_func &, analysis_manager &, tinytc_compiler_context_t,
+                            ::tinytc_core_info const *);
+
+    /**
+     * @brief ctor
+     *
+     * @param ctx Compiler context; optimization flags are taken from the context
+     * @param info Core info; might be nullptr if no pass requires core info
+     */
+    pass_pipeline(tinytc_compiler_context_t ctx, ::tinytc_core_info const *info);
+    /**
+     * @brief Parse pipeline
+     *
+     * @param pipeline Comma-separated list of pass names, e.g. "constant-propagation,dump-ir"
+     * @param ctx Compiler context; optimization flags are taken from the context
+     * @param info Core info; might be nullptr if no pass requires core info
+     */
+    pass_pipeline(std::string_view pipeline, tinytc_compiler_context_t ctx,
+                  ::tinytc_core_info const *info);
+
+    //! Append pass; throws status::unknown_pass_name if the pass does not exist
+    void add_pass(std::string_view name);
+
+    inline auto size() const -> std::size_t { return passes_.size(); }
+    inline auto empty() const -> bool { return passes_.empty(); }
+
+    //! Run all passes on a single function; safe to call concurrently for different functions
+    void run_on_function(tinytc_func &fn) const;
+    //! Run all passes on every function; every pass is run on all functions before the next pass
+    void run_on_program(tinytc_prog &p) const;
+
+    //! Returns the names of all registered passes
+    static auto pass_names() -> std::vector<char const *> const &;
+
+  private:
+    struct entry {
+        char const *name;
+        run_fn run;
+    };
+
+    void run_pass(entry const &e, tinytc_func &fn, analysis_manager &am) const;
+
+    tinytc_compiler_context_t ctx_;
+    ::tinytc_core_info const *info_;
+    std::vector<entry> passes_;
+};
+
+} // namespace tinytc
+
+#endif // PASS_MANAGER_20251016_HPP
@@ -0,0 +1,117 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "pass_statistics.hpp"
+#include "node/inst.hpp"
+#include "support/json.hpp"
+#include "support/walk.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <sstream>
+#include <string_view>
+
+namespace tinytc {
+
+namespace {
+
+void write_json_fields(std::ostream &os, std::chrono::nanoseconds time,
+                       std::int64_t num_insts_before, std::int64_t num_insts_after,
+                       std::uint64_t num_allocations, std::uint64_t allocated_bytes,
+                       std::uint64_t num_heap_allocations, std::uint64_t heap_allocated_bytes) {
+    os << "\"time_ms\": " << std::chrono::duration<double, std::milli>(time).count()
+       << ", \"num_insts_before\": " << num_insts_before
+       << ", \"num_insts_after\": " << num_insts_after
+       << ", \"num_allocations\": " << num_allocations
+       << ", \"allocated_bytes\": " << allocated_bytes
+       << ", \"num_heap_allocations\": " << num_heap_allocations
+       << ", \"heap_allocated_bytes\": " << heap_allocated_bytes;
+}
+
+} // namespace
+
+void pass_statistics::add(pass_record record) {
+    auto lock = std::lock_guard{mutex_};
+    records_.emplace_back(std::move(record));
+}
+
+void pass_statistics::clear() {
+    auto lock = std::lock_guard{mutex_};
+    records_.clear();
+}
+
+auto pass_statistics::records() const -> std::vector<pass_record> {
+    auto lock = std::lock_guard{mutex_};
+    return records_;
+}
+
+auto pass_statistics::to_json(bool per_function) const -> std::string {
+    auto const recs = records();
+
+    struct summary {
+        std::string_view pass_name;
+        std::int64_t num_runs = 0;
+        std::chrono::nanoseconds time = {};
+        std::int64_t num_insts_before = 0;
+        std::int64_t num_insts_after = 0;
+        std::uint64_t num_allocations = 0;
+        std::uint64_t allocated_bytes = 0;
+        std::uint64_t num_heap_allocations = 0;
+        std::uint64_t heap_allocated_bytes = 0;
+    };
+    auto summaries = std::vector<summary>{};
+    for (auto const &r : recs) {
+        auto it = std::find_if(summaries.begin(), summaries.end(),
+                               [&](summary const &s) { return s.pass_name == r.pass_name; });
+        if (it == summaries.end()) {
+            it = summaries.insert(summaries.end(), summary{r.pass_name});
+        }
+        ++it->num_runs;
+        it->time += r.time;
+        it->num_insts_before += r.num_insts_before;
+        it->num_insts_after += r.num_insts_after;
+        it->num_allocations += r.num_allocations;
+        it->allocated_bytes += r.allocated_bytes;
+        it->num_heap_allocations += r.num_heap_allocations;
+        it->heap_allocated_bytes += r.heap_allocated_bytes;
+    }
+
+    auto oss = std::ostringstream{};
+    oss << "{\n  \"passes\": [";
+    for (std::size_t i = 0; i < summaries.size(); ++i) {
+        auto const &s = summaries[i];
+        oss << (i > 0 ? ",\n" : "\n") << "    {\"pass\": ";
+        write_json_string(oss, s.pass_name);
+        oss << ", \"num_runs\": " << s.num_runs << ", ";
+        write_json_fields(oss, s.time, s.num_insts_before, s.num_insts_after, s.num_allocations,
+                          s.allocated_bytes, s.num_heap_allocations, s.heap_allocated_bytes);
+        oss << "}";
+    }
+    oss << (summaries.empty() ? "]" : "\n  ]");
+    if (per_function) {
+        oss << ",\n  \"records\": [";
+        for (std::size_t i = 0; i < recs.size(); ++i) {
+            auto const &r = recs[i];
+            oss << (i > 0 ? ",\n" : "\n") << "    {\"pass\": ";
+            write_json_string(oss, r.pass_name);
+            oss << ", \"function\": ";
+            write_json_string(oss, r.function_name);
+            oss << ", ";
+            write_json_fields(oss, r.time, r.num_insts_before, r.num_insts_after,
+                              r.num_allocations, r.allocated_bytes, r.num_heap_allocations,
+                              r.heap_allocated_bytes);
+            oss << "}";
+        }
+        oss << (recs.empty() ? "]" : "\n  ]");
+    }
+    oss << "\n}\n";
+    return std::move(oss).str();
+}
+
+auto count_instructions(tinytc_func &fn) -> std::int64_t {
+    std::int64_t num_insts = 0;
+    walk<walk_order::pre_order>(fn, [&num_insts](tinytc_inst &) { ++num_insts; });
+    return num_insts;
+}
+
+} // namespace tinytc
@@ -0,0 +1,97 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef PASS_STATISTICS_20251016_HPP
+#define PASS_STATISTICS_20251016_HPP
+
+#include "node/func.hpp"
+#include "support/allocation_counter.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tinytc {
+
+//! Statistics of a single pass run on a single function
+struct pass_record {
+    std::string pass_name;
+    std::string function_name;
+    std::chrono::nanoseconds time;
+    std::int64_t num_insts_before;
+    std::int64_t num_insts_after;
+    std::uint64_t num_allocations; ///< IR node allocations made by the pass
+    std::uint64_t allocated_bytes; ///< Size of IR node allocations made by the pass
+    std::uint64_t num_heap_allocations; ///< Heap allocations made by the pass for IR nodes
+    std::uint64_t heap_allocated_bytes; ///< Size of heap allocations made by the pass for IR nodes
+};
+
+/**
+ * @brief Collects timing and IR statistics of pass runs
+ *
+ * Records may be added concurrently.
+ */
+class pass_statistics {
+  public:
+    void add(pass_record record);
+    void clear();
+
+    //! Returns copy of all records in the order they were added
+    auto records() const -> std::vector<pass_record>;
+
+    /**
+     * @brief Serialize statistics to JSON
+     *
+     * The JSON object contains the member "passes", an array with statistics accumulated per pass
+     * in order of first appearance. If per_function is true, the object also contains the member
+     * "records", an array with the statistics of every pass run on every function.
+     *
+     * @param per_function Include records of individual pass runs
+     *
+     * @return JSON string
+     */
+    auto to_json(bool per_function) const -> std::string;
+
+  private:
+    mutable std::mutex mutex_;
+    std::vector<pass_record> records_;
+};
+
+//! Count instructions in function, including instructions in nested regions
+auto count_instructions(tinytc_func &fn) -> std::int64_t;
+
+/**
+ * @brief Run pass on function and record statistics
+ *
+ * @param stats Statistics collector; the pass is run without instrumentation if nullptr
+ * @param pass_name Name of the pass
+ * @param fn Function
+ * @param run Callable that runs the pass on fn
+ */
+template <typename F>
+void instrument_pass(pass_statistics *stats, char const *pass_name, tinytc_func &fn, F &&run) {
+    if (!stats) {
+        std::forward<F>(run)();
+        return;
+    }
+    auto const num_insts_before = count_instructions(fn);
+    auto const allocs_before = ir_allocation_counter();
+    auto const start = std::chrono::steady_clock::now();
+    std::forward<F>(run)();
+    auto const end = std::chrono::steady_clock::now();
+    auto const allocs_after = ir_allocation_counter();
+    stats->add(pass_record{pass_name, std::string(fn.name()),
+                           std::chrono::duration_cast<std::chrono::nanoseconds>(end - start),
+                           num_insts_before, count_instructions(fn),
+                           allocs_after.num_allocations - allocs_before.num_allocations,
+                           allocs_after.num_bytes - allocs_before.num_bytes,
+                           allocs_after.num_heap_allocations - allocs_before.num_heap_allocations,
+                           allocs_after.num_heap_bytes - allocs_before.num_heap_bytes});
+}
+
+} // namespace tinytc
+
+#endif // PASS_STATISTICS_20251016_HPP
@@ -0,0 +1,350 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "grouped_gemm.hpp"
+#include "device_info.hpp"
+#include "error.hpp"
+#include "node/type.hpp"
+#include "number.hpp"
+#include "recipe.hpp"
+#include "tiling.hpp"
+#include "tinytc/builder.h"
+#include "tinytc/builder.hpp"
+#include "tinytc/core.h"
+#include "tinytc/core.hpp"
+#include "tinytc/types.h"
+#include "tinytc/types.hpp"
+#include "util/casting.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <source_location>
+#include <utility>
+#include <vector>
+
+namespace tinytc {
+
+auto grouped_gemm_kernel_name(grouped_gemm_kernel k) -> char const * {
+    switch (k) {
+    case grouped_gemm_kernel::gemm:
+        return "gemm";
+    case grouped_gemm_kernel::gemm_beta0:
+        return "gemm_beta0";
+    case grouped_gemm_kernel::num_kernels:
+        break;
+    }
+    throw status::invalid_arguments;
+}
+grouped_gemm_recipe::grouped_gemm_recipe(shared_handle<tinytc_prog_t> prg,
+                                         shared_handle<tinytc_binary_t> bin, tinytc_type_t ty,
+                                         transpose tA, transpose tB, std::int32_t M_block_size,
+                                         std::int32_t N_block_size)
+    : ::tinytc_recipe(std::move(prg), std::move(bin)), ty_(ty), tA_(tA), tB_(tB),
+      M_block_size_(M_block_size), N_block_size_(N_block_size) {}
+auto grouped_gemm_recipe::num_kernels() const -> int {
+    return static_cast<int>(grouped_gemm_kernel::num_kernels);
+}
+auto grouped_gemm_recipe::kernel_name(int kernel_num) const -> char const * {
+    return grouped_gemm_kernel_name(static_cast<grouped_gemm_kernel>(kernel_num));
+}
+
+} // namespace tinytc
+
+using namespace tinytc;
+
+extern "C" {
+tinytc_status_t tinytc_recipe_grouped_gemm_create(tinytc_recipe_t *recipe,
+                                                  const_tinytc_core_info_t info, tinytc_type_t ty,
+                                                  tinytc_transpose_t tA, tinytc_transpose_t tB,
+                                                  int32_t M_block_size, int32_t N_block_size) {
+    if (recipe == nullptr || info == nullptr || ty == nullptr || M_block_size < 0 ||
+        N_block_size < 0) {
+        return tinytc_status_invalid_arguments;
+    }
+
+    auto ctx = ty->context();
+    std::int32_t source_id = 0;
+    TINYTC_CHECK_STATUS(
+        tinytc_compiler_context_add_source(ctx, "recipe/grouped_gemm.cpp", "", &source_id));
+
+    auto const my_loc = [&](std::source_location const loc = std::source_location::current()) {
+        auto l = location{};
+        l.begin.source_id = source_id;
+        l.begin.line = loc.line();
+        l.begin.column = loc.column();
+        l.end = l.begin;
+        ++l.end.column;
+        return l;
+    };
+
+    if (M_block_size == 0 || N_block_size == 0) {
+        auto M_bs = std::int32_t{0}, N_bs = std::int32_t{0};
+        TINYTC_CHECK_STATUS(tinytc_recipe_grouped_gemm_suggest_block_size(info, &M_bs, &N_bs));
+        M_block_size = M_block_size == 0 ? M_bs : M_block_size;
+        N_block_size = N_block_size == 0 ? N_bs : N_block_size;
+    }
+
+    return exception_to_status_code(
+        [&] {
+            auto const bool_ty = get<boolean_type>(ctx);
+            auto const void_ty = get<void_type>(ctx);
+            auto const index_ty = get<index_type>(ctx);
+            auto const tA_ = enum_cast<transpose>(tA);
+            auto const tB_ = enum_cast<transpose>(tB);
+
+            auto const bshape = blas_shape{ty, ty, ty, {M_block_size, N_block_size}, true};
+            auto const [sgs, tiling] = suggest_subgroup_size_and_tiling(array_view(bshape), *info);
+
+            auto const stride = std::array<std::int64_t, 2u>{1, dynamic};
+            auto const memref_ty = [&](std::int64_t s0, std::int64_t s1) {
+                return get<memref_type>(ty, std::array{s0, s1}, stride, address_space::global);
+            };
+            auto const mt = memref_ty(dynamic, dynamic);
+
+            auto const body = [&](region_builder &bb, tinytc_value_t alpha, tinytc_value_t A,
+                                  tinytc_value_t B, bool is_beta_nonzero, tinytc_value_t beta_arg,
+                                  tinytc_value_t C) {
+                auto c0 = bb.constant_zero(index_ty, my_loc());
+                auto c1 = bb.constant_one(index_ty, my_loc());
+                auto c_M_block_size = bb.create<constant_inst>(M_block_size, index_ty, my_loc());
+                auto c_N_block_size = bb.create<constant_inst>(N_block_size, index_ty, my_loc());
+                auto c_M_block_size_m1 =
+                    bb.create<constant_inst>(M_block_size - 1, index_ty, my_loc());
+                auto c_N_block_size_m1 =
+                    bb.create<constant_inst>(N_block_size - 1, index_ty, my_loc());
+                auto gid = bb.create<group_id_inst>(comp3::x, index_ty, my_loc());
+                auto num_problems = bb.create<size_inst>(0, C, index_ty, my_loc());
+                auto beta = is_beta_nonzero ? beta_arg : bb.constant_zero(ty, my_loc());
+
+                auto const num_blocks = [&](region_builder &bb, tinytc_value_t size,
+                                            tinytc_value_t block_size_m1,
+                                            tinytc_value_t block_size) {
+                    auto s = bb.create<add_inst>(size, block_size_m1, index_ty, my_loc());
+                    return bb.create<div_inst>(s, block_size, index_ty, my_loc());
+                };
+
+                // Map the work-group to a (problem, tile) pair by computing the prefix sum over
+                // the number of tiles of each problem. The offset is the running prefix sum, while
+                // problem and tile_start only advance as long as all tiles of the problem precede
+                // the work-group's tile. After the loop, problem is the problem that contains the
+                // work-group's tile and tile_start is the number of tiles in preceding problems.
+                auto const init = std::array<tinytc_value_t, 3u>{c0, c0, c0};
+                auto const init_tys = std::array<tinytc_type_t, 3u>{index_ty, index_ty, index_ty};
+                auto const found_tys = std::array<tinytc_type_t, 2u>{index_ty, index_ty};
+                auto scan = bb.for_loop(
+                    c0, num_problems, nullptr, init, init_tys,
+                    [&](region_builder &bb, array_view<tinytc_value_t> p) {
+                        auto c = bb.create<load_inst>(C, array_view{p[0]}, mt, my_loc());
+                        auto M = bb.create<size_inst>(0, c, index_ty, my_loc());
+                        auto N = bb.create<size_inst>(1, c, index_ty, my_loc());
+                        auto M_blocks = num_blocks(bb, M, c_M_block_size_m1, c_M_block_size);
+                        auto N_blocks = num_blocks(bb, N, c_N_block_size_m1, c_N_block_size);
+                        auto tiles = bb.create<mul_inst>(M_blocks, N_blocks, index_ty, my_loc());
+                        auto next = bb.create<add_inst>(p[3], tiles, index_ty, my_loc());
+                        auto is_before =
+                            bb.create<less_than_equal_inst>(next, gid, bool_ty, my_loc());
+                        auto r = bb.ifelse(
+                            is_before,
+                            [&](region_builder &bb) {
+                                auto problem = bb.create<add_inst>(p[1], c1, index_ty, my_loc());
+                                bb.create<yield_inst>(array_view{problem, next}, my_loc());
+                            },
+                            [&](region_builder &bb) {
+                                bb.create<yield_inst>(array_view{p[1], p[2]}, my_loc());
+                            },
+                            found_tys, my_loc());
+                        bb.create<yield_inst>(array_view{r[0], r[1], next}, my_loc());
+                    },
+                    nullptr, my_loc());
+                auto problem = scan[0];
+                auto tile_start = scan[1];
+
+                // Surplus work-groups idle, such that an upper bound of the total number of tiles
+                // may be used as group count
+                auto has_tile = bb.create<less_than_inst>(problem, num_problems, bool_ty, my_loc());
+                bb.if_condition(
+                    has_tile,
+                    [&](region_builder &bb) {
+                        auto a = bb.create<load_inst>(A, array_view{problem}, mt, my_loc());
+                        auto b = bb.create<load_inst>(B, array_view{problem}, mt, my_loc());
+                        auto c = bb.create<load_inst>(C, array_view{problem}, mt, my_loc());
+                        auto M = bb.create<size_inst>(0, c, index_ty, my_loc());
+                        auto N = bb.create<size_inst>(1, c, index_ty, my_loc());
+                        auto K = bb.create<size_inst>(tA_ == transpose::T ? 0 : 1, a, index_ty,
+                                                      my_loc());
+                        auto M_blocks = num_blocks(bb, M, c_M_block_size_m1, c_M_block_size);
+                        auto tile = bb.create<sub_inst>(gid, tile_start, index_ty, my_loc());
+                        auto tm = bb.create<rem_inst>(tile, M_blocks, index_ty, my_loc());
+                        auto tn = bb.create<div_inst>(tile, M_blocks, index_ty, my_loc());
+                        auto m = bb.create<mul_inst>(tm, c_M_block_size, index_ty, my_loc());
+                        auto n = bb.create<mul_inst>(tn, c_N_block_size, index_ty, my_loc());
+                        auto M_rem = bb.create<sub_inst>(M, m, index_ty, my_loc());
+                        auto N_rem = bb.create<sub_inst>(N, n, index_ty, my_loc());
+                        auto M_size =
+                            bb.create<min_inst>(M_rem, c_M_block_size, index_ty, my_loc());
+                        auto N_size =
+                            bb.create<min_inst>(N_rem, c_N_block_size, index_ty, my_loc());
+
+                        // M_size, N_size are nullptr for full tiles
+                        auto const tile_gemm = [&](region_builder &bb, tinytc_value_t M_size,
+                                                   tinytc_value_t N_size) {
+                            auto const M_static = M_size ? dynamic : M_block_size;
+                            auto const N_static = N_size ? dynamic : N_block_size;
+                            auto const subview = [&](tinytc_value_t operand, transpose t,
+                                                     tinytc_value_t offset, std::int64_t size,
+                                                     tinytc_value_t dyn_size) {
+                                auto offsets = std::array<std::int64_t, 2u>{dynamic, 0};
+                                auto static_sizes = std::array<std::int64_t, 2u>{size, dynamic};
+                                auto sizes = std::vector<tinytc_value_t>{};
+                                if (dyn_size) {
+                                    sizes.emplace_back(dyn_size);
+                                }
+                                sizes.emplace_back(K);
+                                if (t == transpose::T) {
+                                    std::swap(offsets[0], offsets[1]);
+                                    std::swap(static_sizes[0], static_sizes[1]);
+                                    std::reverse(sizes.begin(), sizes.end());
+                                }
+                                return bb.create<subview_inst>(
+                                    offsets, static_sizes, operand, array_view{offset}, sizes,
+                                    memref_ty(static_sizes[0], static_sizes[1]), my_loc());
+                            };
+                            auto const tB_K_first =
+                                tB_ == transpose::T ? transpose::N : transpose::T;
+                            auto a_tile = subview(a, tA_, m, M_static, M_size);
+                            auto b_tile = subview(b, tB_K_first, n, N_static, N_size);
+                            auto c_sizes = std::vector<tinytc_value_t>{};
+                            for (auto s : {M_size, N_size}) {
+                                if (s) {
+                                    c_sizes.emplace_back(s);
+                                }
+                            }
+                            auto c_tile = bb.create<subview_inst>(
+                                std::array{dynamic, dynamic}, std::array{M_static, N_static}, c,
+                                std::array{m, n}, c_sizes, memref_ty(M_static, N_static),
+                                my_loc());
+                            bb.create<gemm_inst>(false, tA_, tB_, alpha, a_tile, b_tile, beta,
+                                                 c_tile, my_loc());
+                        };
+
+                        auto is_M_full =
+                            bb.create<equal_inst>(M_size, c_M_block_size, bool_ty, my_loc());
+                        auto is_N_full =
+                            bb.create<equal_inst>(N_size, c_N_block_size, bool_ty, my_loc());
+                        auto is_full = bb.create<and_inst>(is_M_full, is_N_full, bool_ty, my_loc());
+                        bb.ifelse(
+                            is_full,
+                            [&](region_builder &bb) { tile_gemm(bb, nullptr, nullptr); },
+                            [&](region_builder &bb) { tile_gemm(bb, M_size, N_size); }, {},
+                            my_loc());
+                    },
+                    my_loc());
+            };
+
+            auto const kernel = [&](char const *name, bool is_beta_nonzero) {
+                auto gt = get<group_type>(mt, dynamic, 0);
+                auto f = create_func(name, {ty, gt, gt, ty, gt}, void_ty, my_loc());
+                auto fn_body = get_body(f.get());
+                auto params = std::array<tinytc_value_t, 5u>{};
+                get_parameters(fn_body, params);
+                set_name(params[0], "alpha");
+                set_name(params[1], "A");
+                set_name(params[2], "B");
+                set_name(params[3], "beta");
+                set_name(params[4], "C");
+                auto const wgs = tiling.work_group_size(sgs);
+                auto const wgs_attr = tinytc_named_attr_t{
+                    get<string_attr>(ctx, "work_group_size"),
+                    get<array_attr>(ctx, array_view{get<integer_attr>(ctx, wgs[0]),
+                                                    get<integer_attr>(ctx, wgs[1])})};
+                set_attr(f.get(), get_dictionary_attr_with_sorted(ctx, wgs_attr));
+
+                auto bb = region_builder{fn_body};
+                body(bb, params[0], params[1], params[2], is_beta_nonzero, params[3], params[4]);
+                return f;
+            };
+
+            auto p = create_prog(ctx, my_loc());
+            add_function(p.get(),
+                         kernel(grouped_gemm_kernel_name(grouped_gemm_kernel::gemm), true));
+            add_function(p.get(),
+                         kernel(grouped_gemm_kernel_name(grouped_gemm_kernel::gemm_beta0), false));
+            auto bin = compile_to_spirv_and_assemble(p.get(), info);
+            *recipe = std::make_unique<grouped_gemm_recipe>(std::move(p), std::move(bin), ty, tA_,
+                                                            tB_, M_block_size, N_block_size)
+                          .release();
+        },
+        ctx);
+}
+
+tinytc_status_t tinytc_recipe_grouped_gemm_suggest_block_size(const_tinytc_core_info_t info,
+                                                              int32_t *M_block_size,
+                                                              int32_t *N_block_size) {
+    if (info == nullptr || M_block_size == nullptr || N_block_size == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return tinytc::exception_to_status_code([&] {
+        if (info->minmax_work_group_size() <= 0) {
+            throw tinytc::status::invalid_core_info;
+        }
+        *M_block_size = std::min(64, info->minmax_work_group_size());
+        *N_block_size = 64;
+    });
+}
+
+tinytc_status_t tinytc_recipe_grouped_gemm_set_args(
+    tinytc_recipe_handler_t handler, int64_t num_problems, int64_t howmany, size_t alpha_size,
+    const void *alpha_value, tinytc_mem_type_t A_type, const void *A_value,
+    tinytc_mem_type_t B_type, const void *B_value, size_t beta_size, const void *beta_value,
+    tinytc_mem_type_t C_type, const void *C_value, tinytc_mem_type_t M_type, const void *M_value,
+    tinytc_mem_type_t N_type, const void *N_value, tinytc_mem_type_t K_type, const void *K_value,
+    tinytc_mem_type_t ldA_type, const void *ldA_value, tinytc_mem_type_t ldB_type,
+    const void *ldB_value, tinytc_mem_type_t ldC_type, const void *ldC_value) {
+    if (handler == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    auto recipe = dynamic_cast<grouped_gemm_recipe const *>(handler->get_recipe());
+    if (recipe == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return tinytc::exception_to_status_code([&] {
+        auto scalar_size = size(recipe->ty());
+        if (scalar_size != alpha_size || scalar_size != beta_size) {
+            throw status::invalid_kernel_arguments;
+        }
+        if (tinytc::is_argument_zero(recipe->ty(), beta_size, beta_value)) {
+            handler->active_kernel(static_cast<std::uint32_t>(grouped_gemm_kernel::gemm_beta0));
+        } else {
+            handler->active_kernel(static_cast<std::uint32_t>(grouped_gemm_kernel::gemm));
+        }
+        std::uint32_t arg_index = 0;
+        auto const group_arg = [&](tinytc_mem_type_t type, const void *value,
+                                   tinytc_mem_type_t shape0_type, const void *shape0_value,
+                                   tinytc_mem_type_t shape1_type, const void *shape1_value,
+                                   tinytc_mem_type_t ld_type, const void *ld_value) {
+            handler->mem_arg(arg_index++, value, type);
+            handler->mem_arg(arg_index++, shape0_value, shape0_type);
+            handler->mem_arg(arg_index++, shape1_value, shape1_type);
+            handler->mem_arg(arg_index++, ld_value, ld_type);
+            handler->arg(arg_index++, sizeof(int64_t), &num_problems);
+        };
+        handler->arg(arg_index++, alpha_size, alpha_value);
+        if (recipe->tA() == transpose::T) {
+            group_arg(A_type, A_value, K_type, K_value, M_type, M_value, ldA_type, ldA_value);
+        } else {
+            group_arg(A_type, A_value, M_type, M_value, K_type, K_value, ldA_type, ldA_value);
+        }
+        if (recipe->tB() == transpose::T) {
+            group_arg(B_type, B_value, N_type, N_value, K_type, K_value, ldB_type, ldB_value);
+        } else {
+            group_arg(B_type, B_value, K_type, K_value, N_type, N_value, ldB_type, ldB_value);
+        }
+        handler->arg(arg_index++, beta_size, beta_value);
+        group_arg(C_type, C_value, M_type, M_value, N_type, N_value, ldC_type, ldC_value);
+        handler->howmany(howmany);
+    });
+}
+}
@@ -0,0 +1,42 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GROUPED_GEMM_20251016_HPP
+#define GROUPED_GEMM_20251016_HPP
+
+#include "../recipe.hpp"
+#include "tinytc/types.h"
+#include "tinytc/types.hpp"
+
+#include <cstdint>
+
+namespace tinytc {
+
+template <typename T> class shared_handle;
+
+enum class grouped_gemm_kernel : int { gemm = 0, gemm_beta0 = 1, num_kernels = 2 };
+auto grouped_gemm_kernel_name(grouped_gemm_kernel k) -> char const *;
+
+struct grouped_gemm_recipe : ::tinytc_recipe {
+  public:
+    grouped_gemm_recipe(shared_handle<tinytc_prog_t> prg, shared_handle<tinytc_binary_t> bin,
+                        tinytc_type_t ty, transpose tA, transpose tB, std::int32_t M_block_size,
+                        std::int32_t N_block_size);
+    auto num_kernels() const -> int override;
+    auto kernel_name(int kernel_num) const -> char const * override;
+
+    inline auto ty() const -> tinytc_type_t { return ty_; }
+    inline auto tA() const -> transpose { return tA_; }
+    inline auto tB() const -> transpose { return tB_; }
+    inline auto M_block_size() const -> std::int32_t { return M_block_size_; }
+    inline auto N_block_size() const -> std::int32_t { return N_block_size_; }
+
+  private:
+    tinytc_type_t ty_;
+    transpose tA_, tB_;
+    std::int32_t M_block_size_, N_block_size_;
+};
+
+} // namespace tinytc
+
+#endif // GROUPED_GEMM_20251016_HPP
@@ -0,0 +1,343 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "specialization.hpp"
+#include "error.hpp"
+#include "node/attr.hpp"
+#include "node/func.hpp"
+#include "node/prog.hpp"
+#include "node/type.hpp"
+#include "node/value.hpp"
+#include "pass/clone.hpp"
+#include "support/arena.hpp"
+#include "tinytc/core.h"
+#include "tinytc/types.h"
+#include "util/casting.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace tinytc {
+
+namespace {
+
+auto make_modes_attr(tinytc_compiler_context_t ctx, std::vector<std::int64_t> const &modes)
+    -> tinytc_attr_t {
+    auto values = std::vector<tinytc_attr_t>{};
+    values.reserve(modes.size());
+    for (auto const &mode : modes) {
+        values.emplace_back(integer_attr::get(ctx, mode));
+    }
+    return array_attr::get(ctx, values);
+}
+
+//! Returns dict with the entries of updates added or replaced
+auto update_dictionary(tinytc_compiler_context_t ctx, tinytc_attr_t dict,
+                       std::vector<tinytc_named_attr_t> updates) -> tinytc_attr_t {
+    if (updates.empty()) {
+        return dict;
+    }
+    auto attrs = std::vector<tinytc_named_attr_t>{};
+    if (dict) {
+        auto d = dyn_cast_or_throw<dictionary_attr>(
+            dict, [] { return status::ir_expected_dictionary_attribute; });
+        for (auto const &a : d->attrs()) {
+            if (std::none_of(updates.begin(), updates.end(),
+                             [&](tinytc_named_attr_t const &u) { return u.name == a.name; })) {
+                attrs.emplace_back(a);
+            }
+        }
+    }
+    attrs.insert(attrs.end(), updates.begin(), updates.end());
+    dictionary_attr::sort(attrs);
+    return dictionary_attr::get(ctx, attrs);
+}
+
+/**
+ * @brief Replace dynamic values by the specialized values
+ *
+ * @param values Static values of the memref type; modified
+ * @param spec_size Number of specialized values; 0 if no value is specialized
+ * @param spec Specialized values; TINYTC_DYNAMIC keeps the mode dynamic
+ * @param what "shape" or "stride"; used in error messages
+ * @param loc Location of the function
+ *
+ * @return Modes that were specialized
+ */
+auto specialize_values(std::vector<std::int64_t> &values, std::size_t spec_size,
+                       std::int64_t const *spec, char const *what, location const &loc)
+    -> std::vector<std::int64_t> {
+    auto modes = std::vector<std::int64_t>{};
+    if (spec_size == 0) {
+        return modes;
+    }
+    if (spec_size != values.size() || spec == nullptr) {
+        auto oss = std::ostringstream{};
+        oss << "Specialized " << what << " must have " << values.size() << " modes";
+        throw compilation_error(loc, status::invalid_arguments, std::move(oss).str());
+    }
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (is_dynamic_value(spec[i])) {
+            continue;
+        }
+        if (spec[i] < 0) {
+            auto oss = std::ostringstream{};
+            oss << "Specialized " << what << " of mode " << i << " must not be negative";
+            throw compilation_error(loc, status::invalid_arguments, std::move(oss).str());
+        }
+        if (is_dynamic_value(values[i])) {
+            values[i] = spec[i];
+            modes.emplace_back(static_cast<std::int64_t>(i));
+        } else if (values[i] != spec[i]) {
+            auto oss = std::ostringstream{};
+            oss << "Specialized " << what << " of mode " << i << " does not match static "
+                << what << " [" << spec[i] << "!=" << values[i] << "]";
+            throw compilation_error(loc, status::invalid_arguments, std::move(oss).str());
+        }
+    }
+    return modes;
+}
+
+} // namespace
+
+auto specialize_function(tinytc_func &fn, array_view<tinytc_memref_specialization_t> specs)
+    -> unique_handle<tinytc_func_t> {
+    auto ctx = fn.ty()->context();
+    auto param_types = std::vector<tinytc_type_t>{};
+    param_types.reserve(fn.num_params());
+    for (auto const &p : fn.params()) {
+        param_types.emplace_back(p.ty());
+    }
+    auto param_attrs = std::vector<tinytc_attr_t>(fn.num_params(), nullptr);
+    for (std::size_t i = 0; i < fn.num_params(); ++i) {
+        param_attrs[i] = fn.param_attr(i);
+    }
+
+    for (auto const &spec : specs) {
+        if (spec.param_no >= fn.num_params()) {
+            throw compilation_error(fn.loc(), status::invalid_arguments,
+                                    "Specialized parameter number is out of range");
+        }
+        auto &ty = param_types[spec.param_no];
+        auto g = dyn_cast<group_type>(ty);
+        auto mr = dyn_cast<memref_type>(g ? g->element_ty() : ty);
+        if (!mr) {
+            throw compilation_error(fn.loc(), status::ir_expected_memref);
+        }
+
+        auto shape = std::vector<std::int64_t>(mr->dim());
+        auto stride = std::vector<std::int64_t>(mr->dim());
+        for (std::int64_t i = 0; i < mr->dim(); ++i) {
+            shape[i] = mr->shape(i);
+            stride[i] = mr->stride(i);
+        }
+        auto const shape_modes =
+            specialize_values(shape, spec.shape_size, spec.shape, "shape", fn.loc());
+        auto const stride_modes =
+            specialize_values(stride, spec.stride_size, spec.stride, "stride", fn.loc());
+        ty = memref_type::get(mr->element_ty(), shape, stride, mr->addrspace());
+        if (g) {
+            ty = group_type::get(ty, g->size(), g->offset());
+        }
+
+        auto updates = std::vector<tinytc_named_attr_t>{};
+        if (spec.alignment > 0) {
+            updates.emplace_back(tinytc_named_attr_t{string_attr::get(ctx, "alignment"),
+                                                     integer_attr::get(ctx, spec.alignment)});
+        }
+        if (!shape_modes.empty()) {
+            updates.emplace_back(tinytc_named_attr_t{string_attr::get(ctx, specialized_shape_attr),
+                                                     make_modes_attr(ctx, shape_modes)});
+        }
+        if (!stride_modes.empty()) {
+            updates.emplace_back(tinytc_named_attr_t{string_attr::get(ctx, specialized_stride_attr),
+                                                     make_modes_attr(ctx, stride_modes)});
+        }
+        param_attrs[spec.param_no] =
+            update_dictionary(ctx, param_attrs[spec.param_no], std::move(updates));
+    }
+
+    auto clone = unique_handle{
+        std::make_unique<tinytc_func>(std::string(fn.name()), param_types, fn.ty(), fn.loc())
+            .release()};
+    clone->attr(fn.attr());
+    for (std::size_t i = 0; i < param_attrs.size(); ++i) {
+        if (param_attrs[i]) {
+            clone->param_attr(i, param_attrs[i]);
+        }
+    }
+
+    auto const arena_scope = ir_arena_scope(clone->arena());
+    auto cloner = inst_cloner{};
+    for (auto p_orig = fn.body().param_begin(), p_cloned = clone->body().param_begin();
+         p_orig != fn.body().param_end(); ++p_orig, ++p_cloned) {
+        if (p_orig->has_name()) {
+            p_cloned->name(p_orig->name());
+        }
+        cloner.set_subs(&(*p_orig), &(*p_cloned));
+    }
+    cloner.clone_region(fn.body(), clone->body());
+    return clone;
+}
+
+auto clone_program(tinytc_prog &prg) -> shared_handle<tinytc_prog_t> {
+    auto clone =
+        shared_handle{std::make_unique<tinytc_prog>(prg.share_context(), prg.loc()).release()};
+    for (auto &fn : prg) {
+        clone->push_back(specialize_function(fn, {}));
+    }
+    return clone;
+}
+
+auto specialize_program(tinytc_prog &prg, std::string_view func_name,
+                        array_view<tinytc_memref_specialization_t> specs)
+    -> shared_handle<tinytc_prog_t> {
+    auto clone =
+        shared_handle{std::make_unique<tinytc_prog>(prg.share_context(), prg.loc()).release()};
+    bool found = false;
+    for (auto &fn : prg) {
+        if (fn.name() == func_name) {
+            clone->push_back(specialize_function(fn, specs));
+            found = true;
+        } else {
+            clone->push_back(specialize_function(fn, {}));
+        }
+    }
+    if (!found) {
+        throw compilation_error(prg.loc(), status::invalid_arguments,
+                                "Program has no function named " + std::string(func_name));
+    }
+    return clone;
+}
+
+auto make_specialization_key(std::string_view func_name,
+                             array_view<tinytc_memref_specialization_t> specs) -> std::string {
+    auto sorted = std::vector<tinytc_memref_specialization_t>(specs.begin(), specs.end());
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](auto const &a, auto const &b) { return a.param_no < b.param_no; });
+
+    auto oss = std::ostringstream{};
+    oss << func_name;
+    auto const write_values = [&oss](std::size_t size, std::int64_t const *values) {
+        oss << '[';
+        for (std::size_t i = 0; i < size; ++i) {
+            oss << (i > 0 ? "," : "") << values[i];
+        }
+        oss << ']';
+    };
+    for (auto const &spec : sorted) {
+        oss << ';' << spec.param_no << ':';
+        write_values(spec.shape_size, spec.shape);
+        write_values(spec.stride_size, spec.stride);
+        oss << spec.alignment;
+    }
+    return std::move(oss).str();
+}
+
+} // namespace tinytc
+
+using namespace tinytc;
+
+tinytc_specialization_cache::tinytc_specialization_cache(
+    tinytc_prog &prg, shared_handle<tinytc_core_info_t> info)
+    : prg_{clone_program(prg)}, info_(std::move(info)) {}
+
+auto tinytc_specialization_cache::get(std::string_view func_name,
+                                      array_view<tinytc_memref_specialization_t> specs)
+    -> shared_handle<tinytc_binary_t> {
+    auto const key = make_specialization_key(func_name, specs);
+    {
+        auto lock = std::lock_guard{mutex_};
+        if (auto it = binaries_.find(key); it != binaries_.end()) {
+            return it->second;
+        }
+    }
+
+    // Compile without holding the lock such that different specializations compile concurrently
+    auto specialized = specialize_program(*prg_, func_name, specs);
+    tinytc_binary_t bin;
+    CHECK_STATUS(
+        tinytc_prog_compile_to_spirv_and_assemble(&bin, specialized.get(), info_.get()));
+    auto lock = std::lock_guard{mutex_};
+    return binaries_.try_emplace(key, shared_handle{bin}).first->second;
+}
+
+auto tinytc_specialization_cache::size() const -> std::size_t {
+    auto lock = std::lock_guard{mutex_};
+    return binaries_.size();
+}
+
+extern "C" {
+
+tinytc_status_t tinytc_prog_specialize(tinytc_prog_t *specialized, tinytc_prog_t prg,
+                                       char const *func_name, size_t spec_size,
+                                       const tinytc_memref_specialization_t *specs) {
+    if (specialized == nullptr || prg == nullptr || func_name == nullptr ||
+        (spec_size > 0 && specs == nullptr)) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code(
+        [&] {
+            *specialized =
+                specialize_program(*prg, func_name, array_view(specs, spec_size)).release();
+        },
+        prg->context());
+}
+
+tinytc_status_t tinytc_specialization_cache_create(tinytc_specialization_cache_t *cache,
+                                                   tinytc_prog_t prg, tinytc_core_info_t info) {
+    if (cache == nullptr || prg == nullptr || info == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code(
+        [&] {
+            *cache = std::make_unique<tinytc_specialization_cache>(*prg, shared_handle{info, true})
+                         .release();
+        },
+        prg->context());
+}
+
+tinytc_status_t tinytc_specialization_cache_get_binary(
+    tinytc_specialization_cache_t cache, char const *func_name, size_t spec_size,
+    const tinytc_memref_specialization_t *specs, tinytc_binary_t *bin) {
+    if (cache == nullptr || func_name == nullptr || (spec_size > 0 && specs == nullptr) ||
+        bin == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code(
+        [&] { *bin = cache->get(func_name, array_view(specs, spec_size)).release(); },
+        cache->context());
+}
+
+tinytc_status_t tinytc_specialization_cache_get_size(const_tinytc_specialization_cache_t cache,
+                                                     size_t *size) {
+    if (cache == nullptr || size == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    return exception_to_status_code([&] { *size = cache->size(); });
+}
+
+tinytc_status_t tinytc_specialization_cache_release(tinytc_specialization_cache_t obj) {
+    if (obj == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    auto ref_count = obj->dec_ref();
+    if (ref_count == 0) {
+        delete obj;
+    }
+    return tinytc_status_success;
+}
+
+tinytc_status_t tinytc_specialization_cache_retain(tinytc_specialization_cache_t obj) {
+    if (obj == nullptr) {
+        return tinytc_status_invalid_arguments;
+    }
+    obj->inc_ref();
+    return tinytc_status_success;
+}
+}
@@ -0,0 +1,111 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef SPECIALIZATION_20251016_HPP
+#define SPECIALIZATION_20251016_HPP
+
+#include "node/prog.hpp"
+#include "reference_counted.hpp"
+#include "tinytc/core.hpp"
+#include "tinytc/types.h"
+#include "tinytc/types.hpp"
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace tinytc {
+
+//! Parameter attribute listing the shape modes whose kernel arguments are ignored
+constexpr static char specialized_shape_attr[] = "specialized_shape";
+//! Parameter attribute listing the stride modes whose kernel arguments are ignored
+constexpr static char specialized_stride_attr[] = "specialized_stride";
+
+/**
+ * @brief Clone function and replace dynamic shapes and strides of memref parameters by constants
+ *
+ * The kernel signature of the specialized function is identical to the signature of the original
+ * function: the kernel arguments of specialized modes are kept but ignored. The specialized
+ * modes are recorded in the parameter attributes "specialized_shape" and "specialized_stride".
+ *
+ * @param fn Function
+ * @param specs Specializations
+ *
+ * @return Specialized function
+ */
+auto specialize_function(tinytc_func &fn, array_view<tinytc_memref_specialization_t> specs)
+    -> unique_handle<tinytc_func_t>;
+
+/**
+ * @brief Deep copy of program
+ *
+ * @param prg Program
+ *
+ * @return Copy of the program that shares the compiler context with prg
+ */
+auto clone_program(tinytc_prog &prg) -> shared_handle<tinytc_prog_t>;
+
+/**
+ * @brief Clone program and specialize one function
+ *
+ * @param prg Program
+ * @param func_name Name of the function that is specialized; other functions are copied
+ * @param specs Specializations
+ *
+ * @return Specialized program
+ */
+auto specialize_program(tinytc_prog &prg, std::string_view func_name,
+                        array_view<tinytc_memref_specialization_t> specs)
+    -> shared_handle<tinytc_prog_t>;
+
+/**
+ * @brief Compute key identifying a specialization
+ *
+ * The key is independent of the order of specs.
+ *
+ * @param func_name Function name
+ * @param specs Specializations
+ *
+ * @return Key
+ */
+auto make_specialization_key(std::string_view func_name,
+                             array_view<tinytc_memref_specialization_t> specs) -> std::string;
+
+} // namespace tinytc
+
+/**
+ * @brief Memoizes binaries of specialized programs
+ *
+ * The cache owns a copy of the program, hence the program passed to the cache may be modified
+ * or compiled afterwards. Lookups are thread-safe.
+ */
+struct tinytc_specialization_cache : tinytc::reference_counted {
+  public:
+    tinytc_specialization_cache(tinytc_prog &prg, tinytc::shared_handle<tinytc_core_info_t> info);
+
+    /**
+     * @brief Get binary of specialized program; the binary is compiled on the first request
+     *
+     * @param func_name Name of the function that is specialized
+     * @param specs Specializations
+     *
+     * @return Binary
+     */
+    auto get(std::string_view func_name,
+             tinytc::array_view<tinytc_memref_specialization_t> specs)
+        -> tinytc::shared_handle<tinytc_binary_t>;
+
+    //! Number of cached binaries
+    auto size() const -> std::size_t;
+
+    inline auto context() const -> tinytc_compiler_context_t { return prg_->context(); }
+
+  private:
+    tinytc::shared_handle<tinytc_prog_t> prg_;
+    tinytc::shared_handle<tinytc_core_info_t> info_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, tinytc::shared_handle<tinytc_binary_t>> binaries_;
+};
+
+#endif // SPECIALIZATION_20251016_HPP
@@ -18,6 +18,7 @@
 #include "node/type.hpp"
 #include "node/value.hpp"
 #include "node/visit.hpp"
+#include "specialization.hpp"
 #include "spv/coopmatrix_impl_block.hpp"
 #include "spv/coopmatrix_impl_dpas.hpp"
 #include "spv/enums.hpp"
@@ -26,6 +27,7 @@
 #include "spv/pass/capex.hpp"
 #include "spv/uniquifier.hpp"
 #include "spv/visit.hpp"
+#include "support/thread_pool.hpp"
 #include "tinytc/core.hpp"
 #include "tinytc/types.hpp"
 #include "util/casting.hpp"
@@ -63,8 +65,17 @@ auto convert_prog_to_spirv(tinytc_prog &p, tinytc_core_info const &info)
                                  MemoryModel::OpenCL);
     }
 
+    auto funcs = std::vector<tinytc_func *>{};
     for (auto &fn : p) {
-        conv.run_on_function(fn);
+        funcs.emplace_back(&fn);
+    }
+    auto analyses = std::vector<function_analyses>(funcs.size());
+    auto const pool = p.context()->thread_pool();
+    parallel_for(pool.get(), funcs.size(),
+                 [&](std::size_t i) { analyses[i] = conv.analyze(*funcs[i]); });
+    // Conversion itself is serial as all functions share the module and its uniquifier
+    for (std::size_t i = 0; i < funcs.size(); ++i) {
+        conv.run_on_function(*funcs[i], std::move(analyses[i]));
     }
 
     // Add missing capabilites and extensions
@@ -157,13 +168,21 @@ auto inst_converter::get_pointer_helper(MemoryReadWriteInst in) -> spv_inst * {
             return val(in.operand());
         }
 
-        auto idx0 = val(in.index_list()[0]);
-        spv_inst *offset =
-            memref_ty->stride(0) != 1 ? mod_->add<OpIMul>(spv_index_ty, idx0, dv->stride(0)) : idx0;
+        // The offset is computed in the offset type and only widened for the pointer addition
+        auto offset_ty = get_spv_offset_ty(unique_, memref_ty);
+        auto const to_offset = [&](spv_inst *a) {
+            return make_offset_conversion(unique_, offset_ty, spv_index_ty, a);
+        };
+        auto idx0 = to_offset(val(in.index_list()[0]));
+        spv_inst *offset = memref_ty->stride(0) != 1
+                               ? mod_->add<OpIMul>(offset_ty, idx0, to_offset(dv->stride(0)))
+                               : idx0;
         for (std::int64_t i = 1; i < memref_ty->dim(); ++i) {
-            auto tmp = mod_->add<OpIMul>(spv_index_ty, val(in.index_list()[i]), dv->stride(i));
-            offset = mod_->add<OpIAdd>(spv_index_ty, offset, tmp);
+            auto tmp = mod_->add<OpIMul>(offset_ty, to_offset(val(in.index_list()[i])),
+                                         to_offset(dv->stride(i)));
+            offset = mod_->add<OpIAdd>(offset_ty, offset, tmp);
         }
+        offset = make_offset_conversion(unique_, spv_index_ty, offset_ty, offset);
         return mod_->add<OpInBoundsPtrAccessChain>(spv_pointer_ty, val(in.operand()), offset,
                                                    std::vector<spv_inst *>{});
     }
@@ -739,7 +758,11 @@ void inst_converter::operator()(subview_inst in) {
         stride_out.reserve(mt->dim());
         auto dyn_offsets = in.offsets();
         auto dyn_sizes = in.sizes();
-        auto offset_acc = unique_.null_constant(spv_index_ty);
+        auto offset_ty = get_spv_offset_ty(unique_, mt);
+        auto const to_offset = [&](spv_inst *a) {
+            return make_offset_conversion(unique_, offset_ty, spv_index_ty, a);
+        };
+        auto offset_acc = unique_.null_constant(offset_ty);
         for (std::int64_t i = 0, joffset = 0, jsize = 0; i < mt->dim(); ++i) {
             const std::int64_t offset = in.static_offsets()[i];
 
@@ -749,8 +772,9 @@ void inst_converter::operator()(subview_inst in) {
                 }
                 return unique_.constant(offset);
             };
-            auto tmp = mod_->add<OpIMul>(spv_index_ty, offset_inst(), dv->stride(i));
-            offset_acc = mod_->add<OpIAdd>(spv_index_ty, offset_acc, tmp);
+            auto tmp =
+                mod_->add<OpIMul>(offset_ty, to_offset(offset_inst()), to_offset(dv->stride(i)));
+            offset_acc = mod_->add<OpIAdd>(offset_ty, offset_acc, tmp);
 
             const std::int64_t size = in.static_sizes()[i];
             if (size > 0 || is_dynamic_value(size)) {
@@ -764,7 +788,7 @@ void inst_converter::operator()(subview_inst in) {
                 stride_out.emplace_back(dv->stride(i));
             }
         }
-        return offset_acc;
+        return make_offset_conversion(unique_, spv_index_ty, offset_ty, offset_acc);
     };
 
     auto offset = make_offset_and_shape_stride();
@@ -878,7 +902,12 @@ auto inst_converter::run_on_region_with_yield(tinytc_region &reg, std::int64_t n
     return yielded_vals;
 }
 
-void inst_converter::run_on_function(tinytc_func &fn) {
+auto inst_converter::analyze(tinytc_func &fn) const -> function_analyses {
+    return function_analyses{stack_high_water_mark{}.run_on_function(fn),
+                             gcd_analysis{info_->alignment()}.run_on_function(fn)};
+}
+
+void inst_converter::run_on_function(tinytc_func &fn, function_analyses fa) {
     try {
         core_cfg_ = info_->get_core_config(fn.subgroup_size());
     } catch (std::out_of_range const &e) {
@@ -889,7 +918,7 @@ void inst_converter::run_on_function(tinytc_func &fn) {
 
     // Stack
     auto const make_stack = [&] {
-        const auto high_water_mark = stack_high_water_mark{}.run_on_function(fn);
+        const auto high_water_mark = fa.stack_high_water_mark;
         if (high_water_mark > 0) {
             auto stack_element_ty = unique_.int_ty(8);
             auto stack_array_ty = unique_.array_ty(stack_element_ty, high_water_mark);
@@ -906,15 +935,32 @@ void inst_converter::run_on_function(tinytc_func &fn) {
     };
     make_stack();
 
+    // Specialized modes keep their kernel argument, such that the kernel signature matches the
+    // signature of the generic kernel
+    auto const specialized_modes = [&](std::size_t arg_no, char const *name) {
+        auto modes = std::vector<std::int64_t>{};
+        if (auto modes_attr = get_attr(fn.param_attr(arg_no), name); modes_attr) {
+            modes = get_array_attr_as<std::int64_t>(modes_attr);
+        }
+        return modes;
+    };
+    auto const is_specialized = [](std::vector<std::int64_t> const &modes, std::int64_t mode) {
+        return std::find(modes.begin(), modes.end(), mode) != modes.end();
+    };
+
     // Function type
     auto fun_ty = unique_.function_ty(unique_.void_ty(), [&] {
         auto params = std::vector<spv_inst *>{};
         params.reserve(fn.num_params());
+        std::size_t arg_no = 0;
         for (auto const &p : fn.params()) {
             params.emplace_back(spv_ty(p.ty()));
             auto dv = make_dope_vector(p);
             if (dv) {
-                for (std::int64_t i = 0; i < dv->num_dynamic(); ++i) {
+                auto const num_specialized = static_cast<std::int64_t>(
+                    specialized_modes(arg_no, specialized_shape_attr).size() +
+                    specialized_modes(arg_no, specialized_stride_attr).size());
+                for (std::int64_t i = 0; i < dv->num_dynamic() + num_specialized; ++i) {
                     params.emplace_back(dv->ty());
                 }
                 if (is_dynamic_value(dv->static_size())) {
@@ -924,6 +970,7 @@ void inst_converter::run_on_function(tinytc_func &fn) {
                     params.emplace_back(dv->offset_ty());
                 }
             }
+            ++arg_no;
         }
         return params;
     }());
@@ -935,7 +982,7 @@ void inst_converter::run_on_function(tinytc_func &fn) {
     tiling_[1] = work_group_size[1];
 
     matrix_impl_ = [&]() -> std::unique_ptr<coopmatrix_impl> {
-        const auto gcd = gcd_analysis{info_->alignment()}.run_on_function(fn);
+        auto gcd = std::move(fa.gcd);
         if (info_->matrix().have_dpas()) {
             return std::make_unique<coopmatrix_impl_dpas>(unique_, core_cfg_, std::move(gcd));
         } else if (info_->have_spirv_feature(spirv_feature::subgroup_buffer_block_io)) {
@@ -946,19 +993,30 @@ void inst_converter::run_on_function(tinytc_func &fn) {
 
     auto void_ty = unique_.void_ty();
     auto fun = mod_->add<OpFunction>(void_ty, FunctionControl::None, fun_ty);
+    std::size_t arg_no = 0;
     for (auto const &p : fn.params()) {
         declare(p, mod_->add<OpFunctionParameter>(spv_ty(p.ty())));
         auto dv = get_dope_vector(p);
         if (dv) {
-            auto const make_dope_par = [&](spv_inst *ty, std::int64_t s) {
-                return is_dynamic_value(s) ? mod_->add<OpFunctionParameter>(ty)
-                                           : unique_.constant(s);
+            auto const make_dope_par = [&](spv_inst *ty, std::int64_t s,
+                                           bool specialized = false) -> spv_inst * {
+                if (is_dynamic_value(s)) {
+                    return mod_->add<OpFunctionParameter>(ty);
+                }
+                if (specialized) {
+                    mod_->add<OpFunctionParameter>(ty); // ignored
+                }
+                return unique_.constant(s);
             };
+            auto const shape_modes = specialized_modes(arg_no, specialized_shape_attr);
+            auto const stride_modes = specialized_modes(arg_no, specialized_stride_attr);
             for (std::int64_t i = 0; i < dv->dim(); ++i) {
-                dv->shape(i, make_dope_par(dv->ty(), dv->static_shape(i)));
+                dv->shape(i, make_dope_par(dv->ty(), dv->static_shape(i),
+                                           is_specialized(shape_modes, i)));
             }
             for (std::int64_t i = 0; i < dv->dim(); ++i) {
-                dv->stride(i, make_dope_par(dv->ty(), dv->static_stride(i)));
+                dv->stride(i, make_dope_par(dv->ty(), dv->static_stride(i),
+                                            is_specialized(stride_modes, i)));
             }
             if (dv->size_ty()) {
                 dv->size(make_dope_par(dv->size_ty(), dv->static_size()));
@@ -967,6 +1025,7 @@ void inst_converter::run_on_function(tinytc_func &fn) {
                 dv->offset(make_dope_par(dv->offset_ty(), dv->static_offset()));
             }
         }
+        ++arg_no;
     }
 
     mod_->add<OpLabel>();
@@ -4,6 +4,7 @@
 #ifndef CONVERTER_20241111_HPP
 #define CONVERTER_20241111_HPP
 
+#include "analysis/gcd.hpp"
 #include "device_info.hpp"
 #include "node/inst_view.hpp"
 #include "spv/coopmatrix_impl.hpp"
@@ -25,6 +26,13 @@ namespace tinytc::spv {
 auto convert_prog_to_spirv(tinytc_prog &p, tinytc_core_info const &info)
     -> shared_handle<tinytc_spv_mod_t>;
 
+//! Analyses required to convert a function; computed ahead of conversion such that the
+//! analyses of different functions may run concurrently
+struct function_analyses {
+    std::int64_t stack_high_water_mark;
+    gcd_analysis_result gcd;
+};
+
 class inst_converter {
   public:
     inst_converter(tinytc_spv_mod &m, tinytc_core_info const &info);
@@ -79,7 +87,8 @@ class inst_converter {
     void run_on_region(tinytc_region &reg);
     auto run_on_region_with_yield(tinytc_region &reg, std::int64_t num_results)
         -> std::vector<spv_inst *>;
-    void run_on_function(tinytc_func &fn);
+    auto analyze(tinytc_func &fn) const -> function_analyses;
+    void run_on_function(tinytc_func &fn, function_analyses fa);
 
     inline auto unique() -> uniquifier & { return unique_; }
 
@@ -20,6 +20,7 @@
 #include <complex>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <type_traits>
 #include <variant>
@@ -44,6 +45,50 @@ auto get_spv_pointer_index_ty(uniquifier &unique, tinytc_compiler_context_t ctx,
     return get_spv_ty(unique, dyn_cast<memref_type>(memref_ty));
 }
 
+auto get_spv_offset_ty(uniquifier &unique, memref_type const *ty, checked_flag chk)
+    -> spv_inst * {
+    auto ctx = ty->context();
+    if (ctx->opt_flag(optflag::assume_small_buffers)) {
+        return unique.int_ty(32);
+    }
+    auto const static_span_fits_i32 = [&] {
+        constexpr std::int64_t max_span = std::numeric_limits<std::int32_t>::max();
+        std::int64_t span = 1;
+        for (std::int64_t i = 0; i < ty->dim(); ++i) {
+            auto const shape = ty->shape(i);
+            auto const stride = ty->stride(i);
+            if (is_dynamic_value(shape) || is_dynamic_value(stride) || shape > max_span ||
+                stride > max_span) {
+                return false;
+            }
+            if (shape > 0) {
+                span += (shape - 1) * stride;
+            }
+            if (span > max_span) {
+                return false;
+            }
+        }
+        return span * static_cast<std::int64_t>(size(ty->element_ty())) <= max_span;
+    };
+    if (ctx->opt_level() >= 1 && chk == checked_flag::none && static_span_fits_i32()) {
+        return unique.int_ty(32);
+    }
+    return get_spv_index_ty(unique, ctx);
+}
+
+auto make_offset_conversion(uniquifier &unique, spv_inst *to_ty, spv_inst *from_ty, spv_inst *a)
+    -> spv_inst * {
+    if (to_ty == from_ty) {
+        return a;
+    }
+    if (auto c = dyn_cast<OpConstant>(a); c && to_ty == unique.int_ty(32)) {
+        if (auto v = std::get_if<std::int64_t>(&c->op0()); v) {
+            return unique.constant(static_cast<std::int32_t>(*v));
+        }
+    }
+    return unique.mod().add<OpSConvert>(to_ty, a);
+}
+
 auto get_spv_ty_non_coopmatrix(uniquifier &unique, tinytc_type_t ty) -> spv_inst * {
     return visit(overloaded{[&](boolean_type &) -> spv_inst * { return unique.bool_ty(); },
                             [&](i8_type &) -> spv_inst * { return unique.int_ty(8); },
@@ -29,6 +29,26 @@ auto get_spv_pointer_index_ty(uniquifier &unique, tinytc_compiler_context_t ctx,
                               address_space addrspace = address_space::global) -> spv_inst *;
 auto get_spv_ty_non_coopmatrix(uniquifier &unique, tinytc_type_t ty) -> spv_inst *;
 
+/**
+ * @brief Returns the integer type in which element offsets into a memref are computed
+ *
+ * Offsets are computed in i32 if the assume_small_buffers optimization flag is set or if the
+ * optimization level is at least 1 and the memref has static shape and stride and spans less than
+ * 2 GiB. Checked accesses may use positions outside the memref; therefore, i32 is only chosen for
+ * memrefs with static shape and stride if chk is none.
+ *
+ * @param unique Uniquifier
+ * @param ty Memref type
+ * @param chk Checked flag of the access
+ *
+ * @return i32 or index type
+ */
+auto get_spv_offset_ty(uniquifier &unique, memref_type const *ty,
+                       checked_flag chk = checked_flag::none) -> spv_inst *;
+//! Converts an integer value of type from_ty to to_ty; constants are converted at compile time
+auto make_offset_conversion(uniquifier &unique, spv_inst *to_ty, spv_inst *from_ty, spv_inst *a)
+    -> spv_inst *;
+
 auto get_last_label(tinytc_spv_mod &mod) -> spv_inst *;
 
 auto split_re_im(uniquifier &unique, tinytc_type_t val_ty, address_space as, spv_inst *pointer,
@@ -76,8 +76,9 @@ auto coopmatrix_impl::memory_read(cooperative_matrix_memory_read_inst in, dope_v
         std::swap(stride[0], stride[1]);
     }
 
-    auto walker = matrix_walker(*unique_, cfg().subgroup_size, layout, pos0, pos1, shape[0],
-                                shape[1], stride[0], stride[1], in.checked());
+    auto walker = matrix_walker(*unique_, cfg().subgroup_size, layout,
+                                get_spv_offset_ty(*unique_, ot, in.checked()), pos0, pos1,
+                                shape[0], shape[1], stride[0], stride[1], in.checked());
 
     auto &mod = unique_->mod();
     spv_inst *result = mod.add<OpUndef>(matrix_ty);
@@ -142,8 +143,9 @@ void coopmatrix_impl::memory_write(cooperative_matrix_memory_write_inst in, dope
         std::swap(stride[0], stride[1]);
     }
 
-    auto walker = matrix_walker(*unique_, cfg().subgroup_size, layout, pos0, pos1, shape[0],
-                                shape[1], stride[0], stride[1], in.checked());
+    auto walker = matrix_walker(*unique_, cfg().subgroup_size, layout,
+                                get_spv_offset_ty(*unique_, ot, in.checked()), pos0, pos1,
+                                shape[0], shape[1], stride[0], stride[1], in.checked());
 
     const std::int32_t cols_per_store = [&]() -> std::int32_t {
         if (max_cols_per_store == 1) {
@@ -57,8 +57,10 @@ auto coopmatrix_impl_block::load(cooperative_matrix_load_inst in, dope_vector co
         return coopmatrix_impl::load(in, odv, operand, pos0, pos1);
     }
 
-    auto walker = matrix_walker(unique(), cfg().subgroup_size, layout, pos0, pos1, odv.shape(0),
-                                odv.shape(1), odv.stride(0), odv.stride(1), in.checked(), 0);
+    auto walker = matrix_walker(unique(), cfg().subgroup_size, layout,
+                                get_spv_offset_ty(unique(), ot, in.checked()), pos0, pos1,
+                                odv.shape(0), odv.shape(1), odv.stride(0), odv.stride(1),
+                                in.checked(), 0);
 
     const auto io_sty = get_io_sty(sty);
     const std::int32_t blocks_per_load =
@@ -167,8 +169,11 @@ void coopmatrix_impl_block::store(cooperative_matrix_store_inst in, dope_vector
         return;
     }
 
-    auto walker = matrix_walker(unique(), cfg().subgroup_size, layout, pos0, pos1, odv.shape(0),
-                                odv.shape(1), odv.stride(0), odv.stride(1), in.checked(), 0);
+    auto walker = matrix_walker(unique(), cfg().subgroup_size, layout,
+                                get_spv_offset_ty(unique(), get_memref_type(in.operand()),
+                                                  in.checked()),
+                                pos0, pos1, odv.shape(0), odv.shape(1), odv.stride(0),
+                                odv.stride(1), in.checked(), 0);
 
     const auto io_sty = get_io_sty(sty);
     const std::int32_t blocks_per_store =
@@ -15,11 +15,17 @@ namespace tinytc::spv {
 class spv_inst;
 class uniquifier;
 
+/**
+ * @brief Walks the memory locations of a cooperative matrix
+ *
+ * Offsets and bounds checks are computed in offset_ty (cf. get_spv_offset_ty); positions,
+ * shapes, and strides are passed in the index type and the offset is widened to the index type.
+ */
 class matrix_walker {
   public:
     matrix_walker(uniquifier &unique, std::int32_t sgs, coopmatrix_layout const &layout,
-                  spv_inst *pos0, spv_inst *pos1, spv_inst *shape0, spv_inst *shape1,
-                  spv_inst *stride0, spv_inst *stride1, checked_flag chk,
+                  spv_inst *offset_ty, spv_inst *pos0, spv_inst *pos1, spv_inst *shape0,
+                  spv_inst *shape1, spv_inst *stride0, spv_inst *stride1, checked_flag chk,
                   std::int32_t constant_p = -1);
 
     void advance_block();
@@ -42,6 +48,7 @@ class matrix_walker {
     coopmatrix_layout const &layout_;
     checked_flag chk_;
     spv_inst *index_ty_;
+    spv_inst *offset_ty_;
     spv_inst *row_inc_;
     std::int64_t col_inc_factor_;
     spv_inst *col_inc_;
@@ -0,0 +1,38 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef ALLOCATION_COUNTER_20251016_HPP
+#define ALLOCATION_COUNTER_20251016_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tinytc {
+
+struct allocation_counter {
+    std::uint64_t num_allocations = 0;
+    std::uint64_t num_bytes = 0;
+    std::uint64_t num_heap_allocations = 0;
+    std::uint64_t num_heap_bytes = 0;
+
+    //! Count IR node allocation
+    inline void count(std::size_t bytes) noexcept {
+        ++num_allocations;
+        num_bytes += bytes;
+    }
+    //! Count heap allocation made for IR nodes (single node or arena chunk)
+    inline void count_heap(std::size_t bytes) noexcept {
+        ++num_heap_allocations;
+        num_heap_bytes += bytes;
+    }
+};
+
+//! Counts allocations of IR nodes made by the calling thread
+inline auto ir_allocation_counter() noexcept -> allocation_counter & {
+    thread_local auto counter = allocation_counter{};
+    return counter;
+}
+
+} // namespace tinytc
+
+#endif // ALLOCATION_COUNTER_20251016_HPP
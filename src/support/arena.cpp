@@ -0,0 +1,78 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "support/arena.hpp"
+#include "support/allocation_counter.hpp"
+#include "tinytc/types.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace tinytc {
+
+auto arena::create() -> arena * { return new arena(); }
+
+void arena::release(arena *a) noexcept {
+    if (a && a->dec_ref() == 0) {
+        delete a;
+    }
+}
+
+arena::~arena() {
+    for (auto &chunk : chunks_) {
+        std::free(chunk);
+    }
+}
+
+auto arena::allocate(std::size_t size) -> void * {
+    auto const sc = size_class(size);
+    if (sc >= free_lists_.size()) {
+        void *p = std::malloc(size);
+        if (p == nullptr) {
+            throw status::bad_alloc;
+        }
+        ir_allocation_counter().count_heap(size);
+        inc_ref();
+        return p;
+    }
+
+    void *p = nullptr;
+    if (auto block = free_lists_[sc]; block) {
+        free_lists_[sc] = block->next;
+        p = block;
+    } else {
+        auto const block_size = sc * granularity;
+        if (static_cast<std::size_t>(end_ - cur_) < block_size) {
+            chunks_.reserve(chunks_.size() + 1);
+            auto chunk = static_cast<std::uint8_t *>(std::malloc(chunk_size));
+            if (chunk == nullptr) {
+                throw status::bad_alloc;
+            }
+            ir_allocation_counter().count_heap(chunk_size);
+            chunks_.emplace_back(chunk);
+            cur_ = chunk;
+            end_ = chunk + chunk_size;
+        }
+        p = cur_;
+        cur_ += block_size;
+    }
+    inc_ref();
+    return p;
+}
+
+void arena::deallocate(void *p, std::size_t size) noexcept {
+    auto const sc = size_class(size);
+    if (sc >= free_lists_.size()) {
+        std::free(p);
+    } else {
+        free_lists_[sc] = new (p) free_block{free_lists_[sc]};
+    }
+    release(this);
+}
+
+auto current_ir_arena() noexcept -> arena *& {
+    thread_local arena *current = nullptr;
+    return current;
+}
+
+} // namespace tinytc
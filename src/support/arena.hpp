@@ -0,0 +1,92 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef ARENA_20251016_HPP
+#define ARENA_20251016_HPP
+
+#include "reference_counted.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace tinytc {
+
+/**
+ * @brief Bump allocator for IR nodes with per-size free lists
+ *
+ * Memory is carved from large chunks and only returned to the system in bulk when the arena dies.
+ * Deallocated blocks are kept in a free list per size class and are reused by later allocations
+ * of the same size class, such that passes that erase and create instructions do not grow the
+ * arena without bound. Blocks larger than max_small_size are served by the heap.
+ *
+ * The arena is reference counted: the owner holds one reference and every live block holds one
+ * reference, hence blocks that outlive their owner stay valid. The arena must only be used by
+ * one thread at a time.
+ */
+class arena : public reference_counted {
+  public:
+    constexpr static std::size_t granularity = alignof(std::max_align_t);
+    constexpr static std::size_t max_small_size = 1024;
+    constexpr static std::size_t chunk_size = 64 * 1024;
+
+    //! Create arena; the caller owns one reference
+    static auto create() -> arena *;
+    //! Drop one reference; the arena is destroyed when the last reference is dropped
+    static void release(arena *a) noexcept;
+
+    auto allocate(std::size_t size) -> void *;
+    void deallocate(void *p, std::size_t size) noexcept;
+
+    //! Number of chunks requested from the heap
+    inline auto num_chunks() const noexcept -> std::size_t { return chunks_.size(); }
+
+  private:
+    struct free_block {
+        free_block *next;
+    };
+
+    arena() = default;
+    ~arena();
+
+    static auto size_class(std::size_t size) noexcept -> std::size_t {
+        return (size + granularity - 1) / granularity;
+    }
+
+    std::vector<void *> chunks_;
+    std::uint8_t *cur_ = nullptr;
+    std::uint8_t *end_ = nullptr;
+    std::array<free_block *, max_small_size / granularity + 1> free_lists_ = {};
+};
+
+struct arena_releaser {
+    inline void operator()(arena *a) const noexcept { arena::release(a); }
+};
+//! Owning reference to an arena
+using arena_ptr = std::unique_ptr<arena, arena_releaser>;
+
+//! Returns the arena used for IR nodes created by the calling thread or nullptr for the heap
+auto current_ir_arena() noexcept -> arena *&;
+
+//! Sets the arena used for IR nodes created by the calling thread for the life time of the scope
+class ir_arena_scope {
+  public:
+    inline ir_arena_scope(arena *a) noexcept : previous_(current_ir_arena()) {
+        current_ir_arena() = a;
+    }
+    inline ~ir_arena_scope() { current_ir_arena() = previous_; }
+
+    ir_arena_scope(ir_arena_scope const &) = delete;
+    ir_arena_scope(ir_arena_scope &&) = delete;
+    ir_arena_scope &operator=(ir_arena_scope const &) = delete;
+    ir_arena_scope &operator=(ir_arena_scope &&) = delete;
+
+  private:
+    arena *previous_;
+};
+
+} // namespace tinytc
+
+#endif // ARENA_20251016_HPP
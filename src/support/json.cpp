@@ -0,0 +1,36 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "support/json.hpp"
+
+#include <iomanip>
+
+namespace tinytc {
+
+void write_json_string(std::ostream &os, std::string_view str) {
+    os << '"';
+    for (char c : str) {
+        switch (c) {
+        case '"':
+            os << "\\\"";
+            break;
+        case '\\':
+            os << "\\\\";
+            break;
+        case '\n':
+            os << "\\n";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                   << std::dec << std::setfill(' ');
+            } else {
+                os << c;
+            }
+            break;
+        }
+    }
+    os << '"';
+}
+
+} // namespace tinytc
@@ -0,0 +1,17 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef JSON_20251016_HPP
+#define JSON_20251016_HPP
+
+#include <ostream>
+#include <string_view>
+
+namespace tinytc {
+
+//! Write str as quoted JSON string
+void write_json_string(std::ostream &os, std::string_view str);
+
+} // namespace tinytc
+
+#endif // JSON_20251016_HPP
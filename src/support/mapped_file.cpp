@@ -0,0 +1,57 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "support/mapped_file.hpp"
+
+#include <fstream>
+#include <ios>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TINYTC_MAPPED_FILE_MMAP
+#endif
+
+namespace fs = std::filesystem;
+
+namespace tinytc {
+
+auto map_file(fs::path const &path, std::size_t &size) -> std::shared_ptr<std::uint8_t const> {
+#ifdef TINYTC_MAPPED_FILE_MMAP
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return {};
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return {};
+    }
+    size = static_cast<std::size_t>(st.st_size);
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        return {};
+    }
+    return std::shared_ptr<std::uint8_t const>(
+        static_cast<std::uint8_t const *>(addr),
+        [size](std::uint8_t const *p) { munmap(const_cast<std::uint8_t *>(p), size); });
+#else
+    auto f = std::ifstream(path, std::ios::binary | std::ios::ate);
+    if (!f.good()) {
+        return {};
+    }
+    size = static_cast<std::size_t>(f.tellg());
+    auto buffer = std::make_shared<std::vector<std::uint8_t>>(size);
+    f.seekg(0);
+    if (!f.read(reinterpret_cast<char *>(buffer->data()), size)) {
+        return {};
+    }
+    return std::shared_ptr<std::uint8_t const>(buffer, buffer->data());
+#endif
+}
+
+} // namespace tinytc
@@ -0,0 +1,30 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef MAPPED_FILE_20251016_HPP
+#define MAPPED_FILE_20251016_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+namespace tinytc {
+
+/**
+ * @brief Map file read-only into memory
+ *
+ * The file is memory-mapped if the platform supports mmap and read into a buffer otherwise.
+ * The mapping is released when the last copy of the returned pointer is destroyed.
+ *
+ * @param path File path
+ * @param size [out] File size in bytes
+ *
+ * @return Pointer to file content or nullptr if the file cannot be opened or is empty
+ */
+auto map_file(std::filesystem::path const &path, std::size_t &size)
+    -> std::shared_ptr<std::uint8_t const>;
+
+} // namespace tinytc
+
+#endif // MAPPED_FILE_20251016_HPP
@@ -0,0 +1,120 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "support/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace tinytc {
+
+thread_pool::thread_pool(std::size_t num_workers) {
+    workers_.reserve(num_workers);
+    for (std::size_t i = 0; i < num_workers; ++i) {
+        workers_.emplace_back([this] { work(); });
+    }
+}
+
+thread_pool::~thread_pool() {
+    {
+        auto lock = std::lock_guard{mutex_};
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &w : workers_) {
+        w.join();
+    }
+}
+
+void thread_pool::submit(std::function<void()> task, std::int32_t priority) {
+    {
+        auto lock = std::lock_guard{mutex_};
+        tasks_[priority].emplace_back(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+void thread_pool::work() {
+    for (;;) {
+        auto task = std::function<void()>{};
+        {
+            auto lock = std::unique_lock{mutex_};
+            cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            auto highest = tasks_.begin();
+            task = std::move(highest->second.front());
+            highest->second.pop_front();
+            if (highest->second.empty()) {
+                tasks_.erase(highest);
+            }
+        }
+        task();
+    }
+}
+
+void parallel_for(thread_pool *pool, std::size_t n, std::function<void(std::size_t)> const &body) {
+    if (pool == nullptr || n <= 1) {
+        for (std::size_t i = 0; i < n; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    // The state is shared with the helper tasks as a helper might only start after all
+    // iterations have been completed
+    struct loop_state {
+        std::function<void(std::size_t)> const *body;
+        std::size_t n;
+        std::atomic<std::size_t> next = 0;
+        std::size_t done = 0;
+        std::vector<std::exception_ptr> errors;
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+    auto state = std::make_shared<loop_state>();
+    state->body = &body;
+    state->n = n;
+    state->errors.resize(n);
+
+    auto const run = [](loop_state &s) {
+        std::size_t num_done = 0;
+        for (std::size_t i = s.next++; i < s.n; i = s.next++) {
+            try {
+                (*s.body)(i);
+            } catch (...) {
+                s.errors[i] = std::current_exception();
+            }
+            ++num_done;
+        }
+        if (num_done > 0) {
+            auto lock = std::lock_guard{s.mutex};
+            s.done += num_done;
+            if (s.done == s.n) {
+                s.cv.notify_all();
+            }
+        }
+    };
+
+    auto const num_helpers = std::min(pool->num_workers(), n - 1);
+    for (std::size_t i = 0; i < num_helpers; ++i) {
+        pool->submit([state, run] { run(*state); });
+    }
+    run(*state);
+    {
+        auto lock = std::unique_lock{state->mutex};
+        state->cv.wait(lock, [&] { return state->done == state->n; });
+    }
+
+    for (auto &error : state->errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+} // namespace tinytc
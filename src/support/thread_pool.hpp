@@ -0,0 +1,71 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef THREAD_POOL_20251016_HPP
+#define THREAD_POOL_20251016_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tinytc {
+
+/**
+ * @brief Fixed-size pool of worker threads
+ *
+ * Tasks with higher priority are executed first; tasks with equal priority are executed in FIFO
+ * order. The destructor waits until all submitted tasks have finished.
+ */
+class thread_pool {
+  public:
+    /**
+     * @brief ctor
+     *
+     * @param num_workers Number of worker threads; must be larger than 0
+     */
+    thread_pool(std::size_t num_workers);
+    ~thread_pool();
+
+    thread_pool(thread_pool const &) = delete;
+    thread_pool(thread_pool &&) = delete;
+    thread_pool &operator=(thread_pool const &) = delete;
+    thread_pool &operator=(thread_pool &&) = delete;
+
+    //! Enqueue task; the task must not throw
+    void submit(std::function<void()> task, std::int32_t priority = 0);
+
+    inline auto num_workers() const -> std::size_t { return workers_.size(); }
+
+  private:
+    void work();
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::map<std::int32_t, std::deque<std::function<void()>>, std::greater<>> tasks_;
+    bool stop_ = false;
+    std::vector<std::thread> workers_;
+};
+
+/**
+ * @brief Call body(i) for i in [0, n)
+ *
+ * The calling thread participates in the work and at most pool->num_workers() tasks are submitted
+ * to the pool, hence parallel_for may be called from within a task running on the same pool.
+ * If one or more calls of body throw, the exception thrown by the call with the smallest index
+ * is rethrown, such that errors are reported deterministically.
+ *
+ * @param pool Thread pool; body is called serially in ascending order if pool is nullptr
+ * @param n Number of iterations
+ * @param body Loop body
+ */
+void parallel_for(thread_pool *pool, std::size_t n, std::function<void(std::size_t)> const &body);
+
+} // namespace tinytc
+
+#endif // THREAD_POOL_20251016_HPP
@@ -21,7 +21,8 @@ namespace tinytc {
 
 auto blas_shape::operator==(blas_shape const &other) const -> bool {
     return op1_ty == other.op1_ty && op2_ty == other.op2_ty && dst_ty == other.dst_ty &&
-           is_gemm == other.is_gemm && shape == other.shape;
+           is_gemm == other.is_gemm && shape == other.shape && K == other.K &&
+           batch == other.batch;
 }
 auto blas_shape::operator!=(blas_shape const &other) const -> bool { return !(*this == other); }
 
@@ -86,8 +87,8 @@ auto suggest_subgroup_size(array_view<blas_shape> const &shapes, ::tinytc_core_i
     return sensible_subgroup_sizes.back();
 }
 
-auto suggest_local_tiling(array_view<blas_shape> const &shapes, core_config const &core_cfg)
-    -> local_tiling {
+auto suggest_local_tiling(array_view<blas_shape> const &shapes, core_config const &core_cfg,
+                          std::int64_t local_memory_size) -> local_tiling {
     if (shapes.empty()) {
         return {1, 1};
     }
@@ -112,8 +113,38 @@ auto suggest_local_tiling(array_view<blas_shape> const &shapes, core_config cons
     auto M = max_shapei(shapes, 0);
     auto N = max_shapei(shapes, 1);
 
-    return suggest_local_tiling(size(max_ty->op1_ty), size(max_ty->op2_ty),
-                                size(acc_type(max_ty->dst_ty)), {M, N}, core_cfg);
+    auto tiling = suggest_local_tiling(size(max_ty->op1_ty), size(max_ty->op2_ty),
+                                       size(acc_type(max_ty->dst_ty)), {M, N}, core_cfg);
+
+    // GEMMs with a long K mode and few blocks of C split the K loop over additional subgroups;
+    // the partial blocks of C are reduced in shared local memory
+    auto const max_threads = core_cfg.max_work_group_size / core_cfg.subgroup_size;
+    std::int32_t k_splits = 1;
+    for (auto const &shape : shapes) {
+        if (!shape.is_gemm || is_dynamic_value(shape.shape[0]) ||
+            is_dynamic_value(shape.shape[1]) || is_dynamic_value(shape.K)) {
+            continue;
+        }
+        auto splits = choose_k_splits(tiling.m_tiles() * tiling.n_tiles(), max_threads, shape.K);
+        auto const c_bytes = shape.shape[0] * shape.shape[1] *
+                             static_cast<std::int64_t>(size(acc_type(shape.dst_ty)));
+        while (splits > 1 && (splits - 1) * c_bytes > local_memory_size / 2) {
+            splits /= 2;
+        }
+        k_splits = std::max(k_splits, splits);
+    }
+    // Batched GEMMs with few blocks of C pack several problems into one work-group
+    std::int32_t batch_packs = 1;
+    for (auto const &shape : shapes) {
+        if (shape.batch != 0) {
+            auto const packs = choose_batch_packing(tiling.m_tiles() * tiling.n_tiles(),
+                                                    max_threads, shape.batch);
+            batch_packs = std::max(batch_packs, packs);
+        }
+    }
+    tiling[1] *= std::max(k_splits, batch_packs);
+
+    return tiling;
 }
 
 auto suggest_local_tiling(std::size_t A_size, std::size_t B_size, std::size_t C_size,
@@ -161,13 +192,14 @@ auto suggest_subgroup_size_and_tiling(array_view<blas_shape> const &shapes,
     -> std::tuple<std::int32_t, local_tiling> {
     auto const sgs = suggest_subgroup_size(shapes, dev_info);
     auto const core_cfg = dev_info.get_core_config(sgs);
-    auto const tiling = suggest_local_tiling(shapes, core_cfg);
+    auto const tiling = suggest_local_tiling(shapes, core_cfg, dev_info.local_memory_size());
     return std::make_tuple(sgs, tiling);
 }
 
 } // namespace tinytc
 
 std::size_t std::hash<tinytc::blas_shape>::operator()(tinytc::blas_shape const &x) const {
-    return tinytc::fnv1a_combine(x.op1_ty, x.op2_ty, x.dst_ty, x.is_gemm, x.shape[0], x.shape[1]);
+    return tinytc::fnv1a_combine(x.op1_ty, x.op2_ty, x.dst_ty, x.is_gemm, x.shape[0], x.shape[1],
+                                 x.K, x.batch);
 }
 
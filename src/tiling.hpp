@@ -59,6 +59,8 @@ struct blas_shape {
      */
     std::array<std::int64_t, 2u> shape;
     bool is_gemm = false;
+    std::int64_t K = dynamic; ///< Size of the reduction mode of GEMMs
+    std::int64_t batch = 0;   ///< Number of problems of batched GEMMs; 0 if not batched
     auto operator==(blas_shape const &other) const -> bool; ///< equal
     auto operator!=(blas_shape const &other) const -> bool; ///< not equal
 };
@@ -78,13 +80,17 @@ auto suggest_local_tiling(std::size_t A_size, std::size_t B_size, std::size_t C_
 /**
  * @brief Suggest a local tiling based on blas sizes
  *
+ * GEMMs with few blocks of C and a long K mode get additional subgroups that work on parts of
+ * the K loop, if the partial blocks of C fit into shared local memory.
+ *
  * @param shapes Shapes that occur in kernel
  * @param core_cfg Core configuration for subgroup size
+ * @param local_memory_size Shared local memory size in bytes
  *
  * @return
  */
-auto suggest_local_tiling(array_view<blas_shape> const &shapes, core_config const &core_cfg)
-    -> local_tiling;
+auto suggest_local_tiling(array_view<blas_shape> const &shapes, core_config const &core_cfg,
+                          std::int64_t local_memory_size = 0) -> local_tiling;
 
 /**
  * @brief Suggest both, subgroup size and tiling, based on blas sizes.
@@ -103,6 +103,9 @@ void opencl_test_runtime::submit(kernel_t &kernel, std::int64_t howmany) {
     CL_CHECK_STATUS(
         clEnqueueNDRangeKernel(q_, kernel.get(), 3u, NULL, gs.data(), ls.data(), 0, NULL, NULL));
 }
+void opencl_test_runtime::submit(tinytc_recipe_handler_t handler) {
+    ::tinytc::submit_no_event(handler, q_);
+}
 void opencl_test_runtime::synchronize() { CL_CHECK_STATUS(clFinish(q_)); }
 
 bool opencl_test_runtime::supports_fp64() {
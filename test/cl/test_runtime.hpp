@@ -50,6 +50,7 @@ class opencl_test_runtime {
     void set_mem_arg(kernel_t &kernel, std::uint32_t arg_index, const void *arg_value,
                      tinytc::mem_type type);
     void submit(kernel_t &kernel, std::int64_t howmany = 1);
+    void submit(tinytc_recipe_handler_t handler);
     void synchronize();
 
     bool supports_fp64();
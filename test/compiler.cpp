@@ -0,0 +1,991 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "support/arena.hpp"
+#include "support/thread_pool.hpp"
+#include "tinytc/builder.hpp"
+#include "tinytc/core.hpp"
+#include "tinytc/types.h"
+#include "tinytc/types.hpp"
+
+#include <doctest/doctest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace tinytc;
+
+namespace {
+
+constexpr char test_kernel[] = R"(
+func @axpby(%alpha: f32, %A: memref<f32x64>, %B: memref<f32x64>) {
+    %one = constant 1.0 : f32
+    axpby %alpha, %A, %one, %B
+}
+)";
+
+class temporary_directory {
+  public:
+    temporary_directory() {
+        auto rd = std::random_device{};
+        path_ = std::filesystem::temp_directory_path() /
+                ("tinytc-test-" + std::to_string(rd()) + std::to_string(rd()));
+    }
+    ~temporary_directory() {
+        auto ec = std::error_code{};
+        std::filesystem::remove_all(path_, ec);
+    }
+    temporary_directory(temporary_directory const &) = delete;
+    temporary_directory &operator=(temporary_directory const &) = delete;
+
+    auto path() const -> std::filesystem::path const & { return path_; }
+    auto number_of_entries() const -> std::size_t {
+        std::size_t num = 0;
+        for (auto const &entry : std::filesystem::directory_iterator(path_)) {
+            num += entry.path().extension() == ".bin" ? 1 : 0;
+        }
+        return num;
+    }
+    auto total_size() const -> std::uintmax_t {
+        std::uintmax_t size = 0;
+        for (auto const &entry : std::filesystem::directory_iterator(path_)) {
+            size += entry.file_size();
+        }
+        return size;
+    }
+
+  private:
+    std::filesystem::path path_;
+};
+
+auto compile(tinytc_compiler_context_t ctx, const_tinytc_core_info_t info)
+    -> shared_handle<tinytc_binary_t> {
+    auto prg = parse_string(test_kernel, ctx);
+    return compile_to_spirv_and_assemble(prg.get(), info);
+}
+
+auto same_binary(tinytc_binary_t a, tinytc_binary_t b) -> bool {
+    auto const ra = get_raw(a);
+    auto const rb = get_raw(b);
+    return ra.format == rb.format && ra.data_size == rb.data_size &&
+           std::memcmp(ra.data, rb.data, ra.data_size) == 0 &&
+           get_core_features(a) == get_core_features(b);
+}
+
+} // namespace
+
+TEST_CASE("binary cache") {
+    auto tmp = temporary_directory{};
+    auto info = create_core_info_intel_from_arch(intel_gpu_architecture::pvc);
+    auto ctx = create_compiler_context();
+    set_binary_cache(ctx.get(), tmp.path().c_str());
+
+    auto miss = compile(ctx.get(), info.get());
+    REQUIRE(tmp.number_of_entries() == 1);
+    auto hit = compile(ctx.get(), info.get());
+    CHECK(tmp.number_of_entries() == 1);
+    CHECK(same_binary(miss.get(), hit.get()));
+
+    SUBCASE("cache is shared between contexts") {
+        auto ctx2 = create_compiler_context();
+        set_binary_cache(ctx2.get(), tmp.path().c_str());
+        auto hit2 = compile(ctx2.get(), info.get());
+        CHECK(tmp.number_of_entries() == 1);
+        CHECK(same_binary(miss.get(), hit2.get()));
+        CHECK(get_compiler_context(hit2.get()).get() == ctx2.get());
+    }
+    SUBCASE("compiler options are part of the key") {
+        set_optimization_level(ctx.get(), 0);
+        compile(ctx.get(), info.get());
+        CHECK(tmp.number_of_entries() == 2);
+        set_optimization_flag(ctx.get(), optflag::unsafe_fp_math, true);
+        compile(ctx.get(), info.get());
+        CHECK(tmp.number_of_entries() == 3);
+    }
+    SUBCASE("core info is part of the key") {
+        set_core_features(info.get(), tinytc_core_feature_flag_large_register_file);
+        auto large_grf = compile(ctx.get(), info.get());
+        CHECK(tmp.number_of_entries() == 2);
+        CHECK(get_core_features(large_grf.get()) == tinytc_core_feature_flag_large_register_file);
+    }
+    SUBCASE("disable cache") {
+        set_binary_cache(ctx.get(), nullptr);
+        set_optimization_level(ctx.get(), 0);
+        compile(ctx.get(), info.get());
+        CHECK(tmp.number_of_entries() == 1);
+    }
+}
+
+TEST_CASE("binary cache eviction") {
+    auto tmp = temporary_directory{};
+    auto info = create_core_info_intel_from_arch(intel_gpu_architecture::pvc);
+    auto ctx = create_compiler_context();
+    set_binary_cache(ctx.get(), tmp.path().c_str());
+    // The unoptimized binary is the largest one
+    set_optimization_level(ctx.get(), 0);
+    compile(ctx.get(), info.get());
+    auto const entry_size = tmp.total_size();
+
+    // Only a single entry fits into the cache
+    set_binary_cache(ctx.get(), tmp.path().c_str(), entry_size + entry_size / 4);
+    for (std::int32_t opt_level = 0; opt_level < 3; ++opt_level) {
+        set_optimization_level(ctx.get(), opt_level);
+        compile(ctx.get(), info.get());
+        CHECK(tmp.number_of_entries() == 1);
+    }
+}
+
+TEST_CASE("parallel for") {
+    auto pool = thread_pool(3);
+    auto result = std::vector<int>(100, 0);
+    parallel_for(&pool, result.size(), [&](std::size_t i) { result[i] = static_cast<int>(i); });
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        CHECK(result[i] == static_cast<int>(i));
+    }
+
+    auto const throw_odd = [](std::size_t i) {
+        if (i % 2 == 1) {
+            throw std::runtime_error(std::to_string(i));
+        }
+    };
+    for (auto p : {&pool, static_cast<thread_pool *>(nullptr)}) {
+        try {
+            parallel_for(p, 100, throw_odd);
+            FAIL("parallel_for must rethrow");
+        } catch (std::runtime_error const &e) {
+            CHECK(std::string(e.what()) == "1");
+        }
+    }
+
+    // Nested loops must not dead-lock
+    auto sum = std::vector<int>(8, 0);
+    parallel_for(&pool, sum.size(), [&](std::size_t i) {
+        auto inner = std::vector<int>(16, 1);
+        parallel_for(&pool, inner.size(), [&](std::size_t j) { inner[j] = static_cast<int>(j); });
+        for (auto v : inner) {
+            sum[i] += v;
+        }
+    });
+    for (auto v : sum) {
+        CHECK(v == 120);
+    }
+}
+
+TEST_CASE("parallel compilation") {
+    auto info = create_core_info_intel_from_arch(intel_gpu_architecture::pvc);
+    auto const source = [] {
+        auto oss = std::ostringstream{};
+        for (int i = 0; i < 16; ++i) {
+            auto const M = 16 * (1 + i % 4);
+            auto const N = 8 * (1 + i / 4);
+            oss << "func @gemm" << i << "(%A: memref<f32x" << M << "x32>, %B: memref<f32x32x" << N
+                << ">, %C: memref<f32x" << M << "x" << N << ">) {\n"
+                << "    %one = constant 1.0 : f32\n"
+                << "    %zero = constant 0.0 : f32\n"
+                << "    gemm %one, %A, %B, %zero, %C\n"
+                << "}\n";
+        }
+        return std::move(oss).str();
+    }();
+    auto const compile_with = [&](std::int32_t num_threads) {
+        auto ctx = create_compiler_context();
+        set_num_threads(ctx.get(), num_threads);
+        auto prg = parse_string(source, ctx.get());
+        return compile_to_spirv_and_assemble(prg.get(), info.get());
+    };
+
+    auto serial = compile_with(1);
+    for (std::int32_t num_threads : {0, 2, 4}) {
+        auto parallel = compile_with(num_threads);
+        CHECK(same_binary(serial.get(), parallel.get()));
+    }
+
+    // Changing the number of threads does not disturb a running compilation
+    auto ctx = create_compiler_context();
+    set_num_threads(ctx.get(), 4);
+    auto prg = parse_string(source, ctx.get());
+    auto concurrent = decltype(serial){};
+    auto compiler =
+        std::thread([&] { concurrent = compile_to_spirv_and_assemble(prg.get(), info.get()); });
+    for (std::int32_t num_threads : {1, 3, 0, 2}) {
+        set_num_threads(ctx.get(), num_threads);
+    }
+    compiler.join();
+    CHECK(same_binary(serial.get(), concurrent.get()));
+}
+
+TEST_CASE("concurrent interning") {
+    constexpr std::int64_t num_threads = 4;
+    constexpr std::int64_t num_shapes = 64;
+    auto ctx = create_compiler_context();
+    auto f32_ty = get<f32_type>(ctx.get());
+
+    auto interned = std::vector<std::vector<tinytc_type_t>>(num_threads);
+    auto threads = std::vector<std::thread>{};
+    for (std::int64_t t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            auto &tys = interned[t];
+            tys.resize(num_shapes);
+            // Traverse shapes in different order per thread
+            for (std::int64_t i = 0; i < num_shapes; ++i) {
+                auto const j = (i * (1 + 2 * t) + t) % num_shapes;
+                tys[j] = get<memref_type>(f32_ty, array_view{j + 1, std::int64_t{8}},
+                                          array_view<std::int64_t>{}, address_space::global);
+                get<group_type>(tys[j], dynamic, 0);
+                get<integer_attr>(ctx.get(), j);
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    for (std::int64_t i = 0; i < num_shapes; ++i) {
+        auto ty = get<memref_type>(f32_ty, array_view{i + 1, std::int64_t{8}},
+                                   array_view<std::int64_t>{}, address_space::global);
+        for (std::int64_t t = 0; t < num_threads; ++t) {
+            CHECK(interned[t][i] == ty);
+        }
+    }
+}
+
+TEST_CASE("pass statistics") {
+    auto info = create_core_info_intel_from_arch(intel_gpu_architecture::pvc);
+    // Pin the register file such that the pipeline runs once
+    set_core_features(info.get(), tinytc_core_feature_flag_small_register_file);
+    auto ctx = create_compiler_context();
+    CHECK(std::string(get_pass_statistics(ctx.get(), true).get()).empty());
+
+    set_pass_statistics(ctx.get(), true);
+    auto prg = parse_string(R"(
+func @gemm(%A: memref<f32x32x32>, %B: memref<f32x32x32>, %C: memref<f32x32x32>) {
+    %one = constant 1.0 : f32
+    %zero = constant 0.0 : f32
+    gemm %one, %A, %B, %zero, %C
+}
+)",
+                            ctx.get());
+    compile_to_spirv_and_assemble(prg.get(), info.get());
+
+    auto const summary = std::string(get_pass_statistics(ctx.get(), false).get());
+    CHECK(summary.find("\"passes\"") != std::string::npos);
+    CHECK(summary.find("\"records\"") == std::string::npos);
+    auto const first = summary.find("\"pass\": \"");
+    REQUIRE(first != std::string::npos);
+    CHECK(summary.find("\"pass\": \"check-ir\"") == first);
+
+    // lower-linalg expands the gemm and must therefore allocate new instructions
+    auto const lower_linalg = summary.find("\"pass\": \"lower-linalg\"");
+    REQUIRE(lower_linalg != std::string::npos);
+    auto const lower_linalg_line =
+        summary.substr(lower_linalg, summary.find('\n', lower_linalg) - lower_linalg);
+    CHECK(lower_linalg_line.find("\"num_runs\": 1,") != std::string::npos);
+    CHECK(lower_linalg_line.find("\"num_insts_before\": 3,") != std::string::npos);
+    CHECK(lower_linalg_line.find("\"num_allocations\": 0,") == std::string::npos);
+    // ...which are served by the arena of the function
+    auto const field = [&lower_linalg_line](std::string const &key) {
+        auto const pos = lower_linalg_line.find("\"" + key + "\": ");
+        REQUIRE(pos != std::string::npos);
+        return std::stoull(lower_linalg_line.substr(pos + key.size() + 4));
+    };
+    CHECK(field("num_heap_allocations") < field("num_allocations"));
+
+    auto const detailed = std::string(get_pass_statistics(ctx.get(), true).get());
+    CHECK(detailed.find("\"records\"") != std::string::npos);
+    CHECK(detailed.find("\"function\": \"gemm\"") != std::string::npos);
+
+    set_pass_statistics(ctx.get(), false);
+    CHECK(std::string(get_pass_statistics(ctx.get(), true).get()).empty());
+}
+
+TEST_CASE("arena") {
+    auto a = arena_ptr(arena::create());
+
+    auto p0 = a->allocate(24);
+    auto p1 = a->allocate(24);
+    auto p2 = a->allocate(2 * arena::max_small_size);
+    CHECK(p0 != p1);
+    CHECK(reinterpret_cast<std::uintptr_t>(p0) % arena::granularity == 0);
+    CHECK(reinterpret_cast<std::uintptr_t>(p1) % arena::granularity == 0);
+    CHECK(a->num_chunks() == 1);
+
+    // freed blocks are reused by allocations of the same size class
+    a->deallocate(p0, 24);
+    CHECK(a->allocate(arena::granularity * 2 - 1) == p0);
+    a->deallocate(p2, 2 * arena::max_small_size);
+
+    auto blocks = std::vector<void *>{};
+    for (std::size_t i = 0; i < arena::chunk_size / arena::max_small_size; ++i) {
+        blocks.emplace_back(a->allocate(arena::max_small_size));
+    }
+    CHECK(a->num_chunks() == 2);
+    for (auto &b : blocks) {
+        a->deallocate(b, arena::max_small_size);
+    }
+    a->deallocate(p0, 24);
+    a->deallocate(p1, 24);
+
+    // live blocks keep the arena alive
+    auto raw = a.release();
+    auto p3 = raw->allocate(64);
+    arena::release(raw);
+    raw->deallocate(p3, 64);
+}
+
+TEST_CASE("pass pipeline") {
+    auto info = create_core_info_intel_from_arch(intel_gpu_architecture::pvc);
+    constexpr char src[] = R"(
+func @dce(%A: memref<f32x64>) {
+    parallel {
+        %c0 = constant 0 : index
+        %c1 = constant 1 : index
+        %c2 = add %c1, %c1 : index
+        %x = load %A[%c2] : f32
+        store %x, %A[%c0]
+        %unused = add %c2, %c2 : index
+    }
+}
+func @axpby(%alpha: f32, %A: memref<f32x64>, %B: memref<f32x64>) {
+    %one = constant 1.0 : f32
+    axpby %alpha, %A, %one, %B
+}
+)";
+
+    auto ctx_single = create_compiler_context();
+    auto prg_single = parse_string(src, ctx_single.get());
+    for (auto const &name : {"constant-propagation", "dead-code-elimination", "insert-barrier",
+                             "work-group-size", "lower-linalg"}) {
+        run_function_pass(name, prg_single.get(), info.get());
+    }
+
+    auto ctx_pipeline = create_compiler_context();
+    auto prg_pipeline = parse_string(src, ctx_pipeline.get());
+    run_function_pass_pipeline(
+        "constant-propagation, dead-code-elimination,insert-barrier,work-group-size,lower-linalg",
+        prg_pipeline.get(), info.get());
+
+    CHECK(std::string(print_to_string(prg_pipeline.get()).get()) ==
+          std::string(print_to_string(prg_single.get()).get()));
+
+    auto prg = parse_string(src, ctx_pipeline.get());
+    CHECK_THROWS_AS(run_function_pass_pipeline("check-ir,no-such-pass", prg.get(), info.get()),
+                    status);
+    CHECK_THROWS_AS(run_function_pass_pipeline("check-ir,", prg.get(), info.get()), status);
+    CHECK_THROWS_AS(run_function_pass_pipeline("check-ir,,dump-ir", prg.get(), info.get()),
+                    status);
+    CHECK_THROWS_AS(run_function_pass("check-ir,dump-ir", prg.get(), info.get()), status);
+    run_function_pass_pipeline("", prg.get(), info.get());
+}
+
+TEST_CASE("shape specialization") {
+    auto info = create_core_info_intel_from_arch(intel_gpu_architecture::pvc);
+    auto ctx = create_compiler_context();
+    set_error_reporter(ctx.get(), [](char const *, const tinytc_location_t *, void *) {});
+    auto prg = parse_string(R"(
+func @gemm(%A: memref<f32x?x?>, %B: memref<f32x?x32>, %C: memref<f32x?x32>) {
+    %one = constant 1.0 : f32
+    %zero = constant 0.0 : f32
+    gemm %one, %A, %B, %zero, %C
+}
+)",
+                            ctx.get());
+
+    std::int64_t const A_shape[] = {64, 48};
+    std::int64_t const B_shape[] = {48, 32};
+    std::int64_t const C_shape[] = {64, dynamic};
+    auto specs = std::vector<tinytc_memref_specialization_t>{{0, 2, A_shape, 0, nullptr, 64},
+                                                             {1, 2, B_shape, 0, nullptr, 0},
+                                                             {2, 2, C_shape, 0, nullptr, 0}};
+
+    auto specialized = specialize(prg.get(), "gemm", specs);
+    auto const text = std::string(print_to_string(specialized.get()).get());
+    CHECK(text.find("memref<f32x64x48,strided<1,?>>") != std::string::npos);
+    CHECK(text.find("memref<f32x48x32,strided<1,?>>") != std::string::npos);
+    CHECK(text.find("specialized_shape") != std::string::npos);
+    CHECK(text.find("alignment") != std::string::npos);
+    // The original program is not modified
+    CHECK(std::string(print_to_string(prg.get()).get()).find("memref<f32x?x?>") !=
+          std::string::npos);
+
+    // The kernel signature is unchanged
+    auto const count_params = [&](tinytc_prog_t p) {
+        auto const mod = compile_to_spirv(p, info.get());
+        auto const asm_text = std::string(print_to_string(mod.get()).get());
+        std::size_t num = 0;
+        for (auto pos = asm_text.find("OpFunctionParameter"); pos != std::string::npos;
+             pos = asm_text.find("OpFunctionParameter", pos + 1)) {
+            ++num;
+        }
+        return num;
+    };
+    auto generic = specialize(prg.get(), "gemm", {});
+    CHECK(count_params(specialized.get()) == count_params(generic.get()));
+
+    SUBCASE("cache") {
+        auto cache = create_specialization_cache(prg.get(), info.get());
+        auto bin1 = get_binary(cache.get(), "gemm", specs);
+        CHECK(get_size(cache.get()) == 1);
+        std::swap(specs[0], specs[2]);
+        auto bin2 = get_binary(cache.get(), "gemm", specs);
+        CHECK(get_size(cache.get()) == 1);
+        CHECK(bin1.get() == bin2.get());
+        specs[1].alignment = 16;
+        auto bin3 = get_binary(cache.get(), "gemm", specs);
+        CHECK(get_size(cache.get()) == 2);
+        CHECK(bin1.get() != bin3.get());
+    }
+    SUBCASE("invalid specializations") {
+        std::int64_t const wrong_B[] = {48, 16};
+        auto bad = tinytc_memref_specialization_t{1, 2, wrong_B, 0, nullptr, 0};
+        CHECK_THROWS(specialize(prg.get(), "gemm", bad));
+        bad = tinytc_memref_specialization_t{1, 1, B_shape, 0, nullptr, 0};
+        CHECK_THROWS(specialize(prg.get(), "gemm", bad));
+        bad = tinytc_memref_specialization_t{3, 2, B_shape, 0, nullptr, 0};
+        CHECK_THROWS(specialize(prg.get(), "gemm", bad));
+        CHECK_THROWS(specialize(prg.get(), "unknown", {}));
+    }
+    SUBCASE("group") {
+        auto gprg = parse_string(R"(
+func @group(%A: group<memref<f32x?x?>x?>, %B: memref<f32x?x?>) {
+    %gid = group_id.x : index
+    %a = load %A[%gid] : memref<f32x?x?>
+    %one = constant 1.0 : f32
+    axpby %one, %a, %one, %B
+}
+)",
+                                 ctx.get());
+        std::int64_t const shape[] = {16, 16};
+        auto gspecs = std::vector<tinytc_memref_specialization_t>{{0, 2, shape, 0, nullptr, 0},
+                                                                  {1, 2, shape, 0, nullptr, 0}};
+        auto gspecialized = specialize(gprg.get(), "group", gspecs);
+        auto const gtext = std::string(print_to_string(gspecialized.get()).get());
+        CHECK(gtext.find("group<memref<f32x16x16,strided<1,?>>x?>") != std::string::npos);
+        CHECK(gtext.find("] : memref<f32x16x16,strided<1,?>>") != std::string::npos);
+        compile_to_spirv(gspecialized.get(), info.get());
+    }
+}
+
+TEST_CASE("bytecode") {
+    auto ctx = create_compiler_context();
+    set_error_reporter(ctx.get(), [](char const *, const tinytc_location_t *, void *) {});
+    auto prg = parse_string(R"(
+func @kernel(%K0: memref<c32x8x?,strided<1,?>>, %K1: group<memref<f32x16x?>x?, offset: ?>,
+             %n: index) attributes{subgroup_size=16, work_group_size=[16,1]} {
+    %gid = group_id.x : index
+    %a = load %K1[%gid] : memref<f32x16x?>
+    %c0 = constant 0 : index
+    %z = constant [1.0, -2.5] : c32
+    %s = for %i=%c0,%n init(%acc=%z) -> (c32) {
+        %c = cast %i : c32
+        %acc_next = add %acc, %c : c32
+        yield (%acc_next)
+    }
+    %c4 = constant 4 : index
+    %v = subview %K0[%c4:4,0:2] : memref<c32x4x2,strided<1,?>>
+    parallel {
+        %m = cooperative_matrix_load %a[%c0,%c0] : coopmatrix<f32x16x1,matrix_acc>
+        %p = cooperative_matrix_apply (%x,%y,%val)=%m -> coopmatrix<f32x16x1,matrix_acc> {
+            %one = constant 1.0 : f32
+            %r = add %val, %one : f32
+            yield (%r)
+        }
+        cooperative_matrix_store %p, %a[%c0,%c0]
+    }
+}
+)",
+                            ctx.get());
+    auto const text = std::string(print_to_string(prg.get()).get());
+
+    auto bytecode = serialize(prg.get());
+    auto ctx2 = create_compiler_context();
+    auto prg2 = deserialize(bytecode, ctx2.get());
+    CHECK(std::string(print_to_string(prg2.get()).get()) == text);
+    CHECK(serialize(prg2.get()) == bytecode);
+
+    SUBCASE("file") {
+        auto tmp = temporary_directory{};
+        std::filesystem::create_directory(tmp.path());
+        auto const path = tmp.path() / "kernel.ttcb";
+        serialize_to_file(prg.get(), path.c_str());
+        auto prg3 = deserialize_file(path.c_str());
+        CHECK(std::string(print_to_string(prg3.get()).get()) == text);
+    }
+    SUBCASE("invalid bytecode") {
+        auto bad = bytecode;
+        bad[0] = 'X';
+        CHECK_THROWS_AS(deserialize(bad), status);
+        bad = bytecode;
+        bad[4] += 1; // version
+        CHECK_THROWS_AS(deserialize(bad), status);
+        for (std::size_t size = 0; size < bytecode.size(); ++size) {
+            CHECK_THROWS_AS(deserialize(array_view(bytecode.data(), size)), status);
+        }
+        // Flipping bytes must be rejected or yield a valid program, but never crash
+        for (std::size_t i = 5; i < bytecode.size(); ++i) {
+            bad = bytecode;
+            bad[i] ^= 0x5a;
+            try {
+                deserialize(bad);
+            } catch (status const &) {
+            }
+        }
+        // Out-of-range enumerators (e.g. matrix use, address space, flags) must be rejected
+        for (std::size_t i = 5; i < bytecode.size(); ++i) {
+            bad = bytecode;
+            bad[i] = 0x7f;
+            try {
+                auto p = deserialize(bad);
+                CHECK(serialize(p.get()).size() > 0);
+            } catch (status const &) {
+            }
+        }
+    }
+}
+
+TEST_CASE("async compilation") {
+    auto info = create_core_info_intel_from_arch(intel_gpu_architecture::pvc);
+    auto ctx = create_compiler_context();
+    auto const submit = [&](compile_priority priority, tinytc_compile_callback_t callback,
+                            void *user_data) {
+        // The job owns a copy of the program, hence the program may be released right away
+        auto prg = parse_string(test_kernel, ctx.get());
+        return compile_async(prg.get(), info.get(), priority, callback, user_data);
+    };
+
+    SUBCASE("result matches synchronous compilation") {
+        set_async_compile_num_threads(4);
+        auto jobs = std::vector<shared_handle<tinytc_compile_job_t>>{};
+        for (int i = 0; i < 8; ++i) {
+            jobs.emplace_back(submit(compile_priority::normal, nullptr, nullptr));
+        }
+        auto sync = compile(ctx.get(), info.get());
+        for (auto &job : jobs) {
+            auto bin = wait(job.get());
+            CHECK(get_state(job.get()) == compile_job_state::success);
+            CHECK(same_binary(bin.get(), sync.get()));
+        }
+    }
+    SUBCASE("priority and cancellation") {
+        set_async_compile_num_threads(1);
+
+        // Keep the single worker busy such that the following jobs stay queued
+        struct gate {
+            std::promise<void> started;
+            std::future<void> release;
+        };
+        auto release = std::promise<void>{};
+        auto g = gate{std::promise<void>{}, release.get_future()};
+        auto started = g.started.get_future();
+        auto blocking = submit(
+            compile_priority::normal,
+            [](tinytc_status_t, tinytc_binary_t, void *user_data) {
+                auto &g = *static_cast<gate *>(user_data);
+                g.started.set_value();
+                g.release.wait();
+            },
+            &g);
+        started.wait();
+
+        struct record {
+            char const *name;
+            std::vector<std::pair<std::string, tinytc_status_t>> *log;
+        };
+        auto const log_callback = [](tinytc_status_t status, tinytc_binary_t bin,
+                                     void *user_data) {
+            auto &r = *static_cast<record *>(user_data);
+            CHECK((bin != nullptr) == (status == tinytc_status_success));
+            r.log->emplace_back(r.name, status);
+        };
+        auto log = std::vector<std::pair<std::string, tinytc_status_t>>{};
+        auto low_rec = record{"low", &log};
+        auto cancelled_rec = record{"cancelled", &log};
+        auto high_rec = record{"high", &log};
+        auto low = submit(compile_priority::low, log_callback, &low_rec);
+        auto cancelled = submit(compile_priority::normal, log_callback, &cancelled_rec);
+        auto high = submit(compile_priority::high, log_callback, &high_rec);
+
+        CHECK(get_state(blocking.get()) == compile_job_state::success);
+        CHECK(get_state(low.get()) == compile_job_state::queued);
+        cancel(cancelled.get());
+        CHECK(get_state(cancelled.get()) == compile_job_state::cancelled);
+        try {
+            wait(cancelled.get());
+            FAIL("wait must throw for cancelled job");
+        } catch (status const &st) {
+            CHECK(st == status::compilation_cancelled);
+        }
+
+        release.set_value();
+        CHECK(wait(high.get()));
+        CHECK(wait(low.get()));
+        cancel(low.get());
+        CHECK(get_state(low.get()) == compile_job_state::success);
+
+        // Blocks until all callbacks have returned
+        set_async_compile_num_threads(1);
+        REQUIRE(log.size() == 3);
+        CHECK(log[0] == std::make_pair(std::string("high"), tinytc_status_success));
+        CHECK(log[1] ==
+              std::make_pair(std::string("cancelled"), tinytc_status_compilation_cancelled));
+        CHECK(log[2] == std::make_pair(std::string("low"), tinytc_status_success));
+    }
+}
+
+TEST_CASE("fat binary") {
+    auto ctx = create_compiler_context();
+    set_num_threads(ctx.get(), 2);
+    auto prg = parse_string(test_kernel, ctx.get());
+    auto const text = std::string(print_to_string(prg.get()).get());
+
+    auto tgl = create_core_info_intel_from_arch(intel_gpu_architecture::tgl);
+    auto pvc = create_core_info_intel_from_arch(intel_gpu_architecture::pvc);
+    auto pvc_large_grf = create_core_info_intel_from_arch(intel_gpu_architecture::pvc);
+    set_core_features(pvc_large_grf.get(), tinytc_core_feature_flag_large_register_file);
+    auto targets = std::vector<const_tinytc_core_info_t>{tgl.get(), pvc.get(), pvc_large_grf.get()};
+    auto fat = compile_to_fat_binary(prg.get(), targets);
+    CHECK(get_size(fat.get()) == 3);
+    CHECK(std::string(print_to_string(prg.get()).get()) == text);
+
+    auto const check_selection = [&](tinytc_fat_binary_t f) {
+        for (auto target : targets) {
+            auto expected = compile(ctx.get(), target);
+            CHECK(same_binary(get_binary(f, target).get(), expected.get()));
+        }
+        // Revision of PVC; large register file is not requested
+        auto const pvc_ip = static_cast<std::uint32_t>(intel_gpu_architecture::pvc);
+        auto pvc_rev = create_core_info_intel(pvc_ip + 3, 8, 8, {16, 32});
+        auto bin = get_binary(f, pvc_rev.get());
+        CHECK(get_core_features(bin.get()) == 0);
+        CHECK(same_binary(bin.get(), get_binary(f, pvc.get()).get()));
+
+        auto bmg = create_core_info_intel_from_arch(intel_gpu_architecture::bmg);
+        CHECK_THROWS_AS(get_binary(f, bmg.get()), status);
+    };
+    check_selection(fat.get());
+
+    SUBCASE("memory") {
+        auto const raw = get_raw(fat.get());
+        auto data = std::vector<std::uint8_t>(raw.begin(), raw.end());
+        check_selection(create_fat_binary(ctx.get(), data).get());
+
+        for (std::size_t size = 0; size < 16 + 3 * 32; ++size) {
+            CHECK_THROWS_AS(create_fat_binary(ctx.get(), array_view(data.data(), size)), status);
+        }
+        data[16 + 31] = 0xff; // size of first entry
+        CHECK_THROWS_AS(create_fat_binary(ctx.get(), data), status);
+    }
+    SUBCASE("file") {
+        auto tmp = temporary_directory{};
+        std::filesystem::create_directory(tmp.path());
+        auto const path = tmp.path() / "kernel.ttcf";
+        auto const raw = get_raw(fat.get());
+        std::ofstream(path, std::ios::binary)
+            .write(reinterpret_cast<char const *>(raw.data()), raw.size());
+        check_selection(create_fat_binary_from_file(ctx.get(), path.c_str()).get());
+    }
+}
+
+TEST_CASE("autotuning") {
+    constexpr char gemm_kernel[] = R"(
+func @gemm(%A: memref<f32x64x32>, %B: memref<f32x32x48>, %C: memref<f32x64x48>) {
+    %one = constant 1.0 : f32
+    %zero = constant 0.0 : f32
+    gemm %one, %A, %B, %zero, %C
+}
+)";
+
+    auto ctx = create_compiler_context();
+    auto pvc = create_core_info_intel_from_arch(intel_gpu_architecture::pvc);
+    auto f32_ty = get<f32_type>(ctx.get());
+    auto const problem = gemm_tuning_problem{pvc.get(), f32_ty, f32_ty, f32_ty, 64, 48, 32};
+    auto const reference = tuning_config{16, 1, 1, 32, 8, 8};
+
+    SUBCASE("static cost model") {
+        auto const cost = estimate_gemm_cost(problem, reference);
+        CHECK(cost > 0.0);
+        auto idle = reference;
+        idle.m_tiles = 16; // only 4 subgroups have rows to work on
+        CHECK(estimate_gemm_cost(problem, idle) > cost);
+        auto invalid = reference;
+        invalid.subgroup_size = 7;
+        CHECK_THROWS_AS(estimate_gemm_cost(problem, invalid), status);
+    }
+    SUBCASE("tuning database") {
+        auto tmp = temporary_directory{};
+        std::filesystem::create_directory(tmp.path());
+        auto const path = tmp.path() / "tuning.db";
+        set_tuning_database(ctx.get(), path.c_str());
+        auto const best = autotune_gemm(problem);
+        CHECK(std::filesystem::exists(path));
+        CHECK(estimate_gemm_cost(problem, best) <= estimate_gemm_cost(problem, reference));
+
+        auto ctx2 = create_compiler_context();
+        set_tuning_database(ctx2.get(), path.c_str());
+        auto prg = parse_string(gemm_kernel, ctx2.get());
+        run_function_pass("work-group-size", prg.get(), pvc.get());
+        auto const text = std::string(print_to_string(prg.get()).get());
+        auto const sgs = (std::ostringstream{} << "subgroup_size=" << best.subgroup_size).str();
+        auto const wgs = (std::ostringstream{} << "work_group_size=["
+                                               << best.m_tiles * best.subgroup_size << ","
+                                               << best.n_tiles << "]")
+                             .str();
+        CHECK(text.find(sgs) != std::string::npos);
+        CHECK(text.find(wgs) != std::string::npos);
+        CHECK_NOTHROW(compile_to_spirv_and_assemble(prg.get(), pvc.get()));
+
+        // Entries that gemm_cost_model rejects are ignored when loading the database
+        auto const untuned_text = [&] {
+            auto ctx3 = create_compiler_context();
+            set_tuning_database(ctx3.get(), nullptr);
+            auto prg3 = parse_string(gemm_kernel, ctx3.get());
+            run_function_pass("work-group-size", prg3.get(), pvc.get());
+            return std::string(print_to_string(prg3.get()).get());
+        }();
+        auto lines = std::vector<std::string>{};
+        for (auto f = std::ifstream(path); std::getline(f, lines.emplace_back());) {
+        }
+        for (auto const &bad_cfg : {"16 0 1 32 8 8", "16 1 1 24 8 8", "16 1 1 32 8 -1"}) {
+            auto f = std::ofstream(path);
+            for (auto const &line : lines) {
+                auto iss = std::istringstream{line};
+                auto token = std::string{};
+                auto key = std::ostringstream{};
+                for (int i = 0; i < 7 && iss >> token; ++i) {
+                    key << (i > 0 ? " " : "") << token;
+                }
+                f << (line.empty() || line[0] == '#' ? line : key.str() + " " + bad_cfg) << '\n';
+            }
+            f.close();
+            auto ctx3 = create_compiler_context();
+            set_tuning_database(ctx3.get(), path.c_str());
+            auto prg3 = parse_string(gemm_kernel, ctx3.get());
+            run_function_pass("work-group-size", prg3.get(), pvc.get());
+            CHECK(std::string(print_to_string(prg3.get()).get()) == untuned_text);
+            CHECK_NOTHROW(compile_to_spirv_and_assemble(prg3.get(), pvc.get()));
+        }
+    }
+    SUBCASE("measurement callback") {
+        auto const measure = [](const tinytc_gemm_tuning_problem_t *,
+                                const tinytc_tuning_config_t *cfg, double *cost, void *user_data) {
+            ++*static_cast<int *>(user_data);
+            *cost = cfg->m_tiles == 2 && cfg->k_block_size == 2 ? 1.0 : 2.0;
+            return tinytc_status_success;
+        };
+        int calls = 0;
+        auto const best = autotune_gemm(problem, measure, &calls);
+        CHECK(calls > 1);
+        CHECK(best.m_tiles == 2);
+        CHECK(best.k_block_size == 2);
+
+        auto const fail = [](const tinytc_gemm_tuning_problem_t *, const tinytc_tuning_config_t *,
+                             double *, void *) { return tinytc_status_compute_runtime_error; };
+        CHECK_THROWS_AS(autotune_gemm(problem, fail), status);
+        auto const reject = [](const tinytc_gemm_tuning_problem_t *, const tinytc_tuning_config_t *,
+                               double *cost, void *) {
+            *cost = std::numeric_limits<double>::infinity();
+            return tinytc_status_success;
+        };
+        CHECK_THROWS_AS(autotune_gemm(problem, reject), status);
+    }
+}
+
+TEST_CASE("cost model") {
+    constexpr char kernels[] = R"(
+func @gemm(%A: memref<f32x64x32>, %B: memref<f32x32x48>, %C: memref<f32x64x48>) {
+    %one = constant 1.0 : f32
+    %zero = constant 0.0 : f32
+    gemm %one, %A, %B, %zero, %C
+}
+func @staged(%a: f32, %b: f32, %A: memref<f32x32x32>, %B: memref<f32x32x32>,
+             %D: memref<f32x32x32>) {
+    %C = alloca : memref<f32x32x32,local>
+    gemm %a, %A, %B, %b, %C
+    gemm %a, %C, %B, %b, %D
+}
+func @dynamic(%A: memref<f32x?>) {
+    %one = constant 1.0 : f32
+    axpby %one, %A, %one, %A
+}
+)";
+
+    auto ctx = create_compiler_context();
+    auto pvc = create_core_info_intel_from_arch(intel_gpu_architecture::pvc);
+    auto prg = parse_string(kernels, ctx.get());
+    auto const ir_before = std::string(print_to_string(prg.get()).get());
+
+    auto const gemm = estimate_cost(prg.get(), "gemm", pvc.get());
+    CHECK(gemm.flops == 2 * 64 * 48 * 32);
+    CHECK(gemm.global_bytes >= (64 * 32 + 32 * 48 + 64 * 48) * 4);
+    CHECK(gemm.local_bytes == 0);
+    CHECK(gemm.arithmetic_intensity > 0.0);
+    CHECK(gemm.barriers == 0);
+    CHECK(gemm.slm_size == 0);
+    CHECK(gemm.register_pressure > 0);
+    CHECK(gemm.register_space == 8192);
+    CHECK(gemm.occupancy > 0.0);
+    CHECK(gemm.occupancy <= 1.0);
+    CHECK(!gemm.dynamic_trip_count);
+
+    auto const staged = estimate_cost(prg.get(), "staged", pvc.get());
+    CHECK(staged.flops >= 2 * 2 * 32 * 32 * 32);
+    CHECK(staged.local_bytes > 0);
+    CHECK(staged.barriers == 1);
+    CHECK(staged.slm_size == 32 * 32 * 4);
+
+    CHECK(estimate_cost(prg.get(), "dynamic", pvc.get()).dynamic_trip_count);
+    CHECK_THROWS_AS(estimate_cost(prg.get(), "missing", pvc.get()), status);
+
+    auto const report = std::string(get_cost_report(prg.get(), pvc.get()).get());
+    CHECK(report.find("\"name\": \"gemm\"") != std::string::npos);
+    CHECK(report.find("\"name\": \"staged\"") != std::string::npos);
+    CHECK(report.find("\"flops\": 196608") != std::string::npos);
+
+    // The analysis runs on a copy of the program
+    CHECK(std::string(print_to_string(prg.get()).get()) == ir_before);
+}
+
+TEST_CASE("register file selection") {
+    constexpr char spilling_kernel[] = R"(
+func @spill(%A: memref<f32x64x64>, %B: memref<f32x64x64>) {
+    parallel {
+        %c0 = constant 0 : index
+        %c32 = constant 32 : index
+        %0 = cooperative_matrix_load %A[%c0,%c0] : coopmatrix<f32x64x32,matrix_acc>
+        %1 = cooperative_matrix_load %A[%c0,%c32] : coopmatrix<f32x64x32,matrix_acc>
+        %2 = add %0, %1 : coopmatrix<f32x64x32,matrix_acc>
+        %3 = sub %0, %1 : coopmatrix<f32x64x32,matrix_acc>
+        cooperative_matrix_store %2, %B[%c0,%c0]
+        cooperative_matrix_store %3, %B[%c0,%c32]
+    }
+}
+)";
+
+    auto ctx = create_compiler_context();
+    auto info = create_core_info_intel_from_arch(intel_gpu_architecture::pvc);
+    auto const compile_spill = [&] {
+        auto prg = parse_string(spilling_kernel, ctx.get());
+        return compile_to_spirv_and_assemble(prg.get(), info.get());
+    };
+
+    CHECK(get_core_features(compile_spill().get()) ==
+          tinytc_core_feature_flag_large_register_file);
+    CHECK(get_core_features(compile(ctx.get(), info.get()).get()) == 0);
+
+    set_core_features(info.get(), tinytc_core_feature_flag_small_register_file);
+    CHECK(get_core_features(compile_spill().get()) ==
+          tinytc_core_feature_flag_small_register_file);
+
+    set_core_features(info.get(), tinytc_core_feature_flag_large_register_file);
+    CHECK(get_core_features(compile_spill().get()) ==
+          tinytc_core_feature_flag_large_register_file);
+
+    CHECK_THROWS_AS(set_core_features(info.get(), tinytc_core_feature_flag_large_register_file |
+                                                      tinytc_core_feature_flag_small_register_file),
+                    status);
+
+    auto tgl = create_core_info_intel_from_arch(intel_gpu_architecture::tgl);
+    auto prg = parse_string(spilling_kernel, ctx.get());
+    CHECK(get_core_features(compile_to_spirv_and_assemble(prg.get(), tgl.get()).get()) == 0);
+}
+
+TEST_CASE("software pipelining") {
+    constexpr char gemm_template[] = R"(
+func @gemm(%A: memref<f16x64x?>, %B: memref<f16x?x64>, %C: memref<f16x64x64>)
+    attributes{$attributes, subgroup_size=16, work_group_size=[32,2]} {
+    %one = constant 1.0 : f16
+    gemm %one, %A, %B, %one, %C
+}
+)";
+
+    auto ctx = create_compiler_context();
+    auto pvc = create_core_info_intel_from_arch(intel_gpu_architecture::pvc);
+    auto const lower = [&](char const *attributes) {
+        auto src = std::string(gemm_template);
+        src.replace(src.find("$attributes"), 11, attributes);
+        auto prg = parse_string(src, ctx.get());
+        run_function_pass("lower-linalg", prg.get(), pvc.get());
+        return std::string(print_to_string(prg.get()).get());
+    };
+
+    auto const pipelined = lower("prefetch_distance=3");
+    CHECK(pipelined.find("cooperative_matrix_prefetch 0, %A") != std::string::npos);
+    CHECK(pipelined.find("cooperative_matrix_prefetch 0, %B") != std::string::npos);
+    CHECK(pipelined.find("min ") != std::string::npos);
+
+    // Prefetching and load rotation are controlled independently
+    auto const no_prefetch = lower("prefetch_distance=0");
+    CHECK(no_prefetch.find("cooperative_matrix_prefetch") == std::string::npos);
+    CHECK(no_prefetch.find("min ") != std::string::npos);
+
+    auto const not_pipelined = lower("software_pipelining=false");
+    CHECK(not_pipelined.find("cooperative_matrix_prefetch") == std::string::npos);
+    CHECK(not_pipelined.find("min ") == std::string::npos);
+
+    CHECK_THROWS_AS(lower("prefetch_distance=-1"), status);
+    CHECK_THROWS_AS(lower("software_pipelining=1"), status);
+}
+
+TEST_CASE("slm staging") {
+    constexpr char gemm_template[] = R"(
+func @gemm(%A: memref<f16x128x64>, %B: memref<f16x64x96>, %C: memref<f32x128x96>)
+    attributes{slm_staging=$staging, subgroup_size=16, work_group_size=[64,4]} {
+    %one = constant 1.0 : f16
+    %zero = constant 0.0 : f32
+    gemm %one, %A, %B, %zero, %C
+}
+)";
+
+    auto ctx = create_compiler_context();
+    auto pvc = create_core_info_intel_from_arch(intel_gpu_architecture::pvc);
+    auto const lower = [&](char const *staging) {
+        auto src = std::string(gemm_template);
+        src.replace(src.find("$staging"), 8, staging);
+        auto prg = parse_string(src, ctx.get());
+        run_function_pass("work-group-size", prg.get(), pvc.get());
+        run_function_pass("lower-linalg", prg.get(), pvc.get());
+        return std::string(print_to_string(prg.get()).get());
+    };
+
+    auto const staged = lower("true");
+    CHECK(staged.find("slm_staging=true") != std::string::npos);
+    CHECK(staged.find("alloca : memref<f16x") != std::string::npos);
+    CHECK(staged.find(",local>") != std::string::npos);
+    CHECK(staged.find("barrier.local") != std::string::npos);
+    CHECK(staged.find("lifetime_stop") != std::string::npos);
+
+    auto const not_staged = lower("false");
+    CHECK(not_staged.find("alloca") == std::string::npos);
+    CHECK(not_staged.find("barrier.local") == std::string::npos);
+}
+
+TEST_CASE("grouped gemm recipe") {
+    auto ctx = create_compiler_context();
+    auto pvc = create_core_info_intel_from_arch(intel_gpu_architecture::pvc);
+    auto rec = create_grouped_gemm(pvc.get(), get<f32_type>(ctx.get()), transpose::N, transpose::T,
+                                   32, 32);
+    auto const code = std::string(print_to_string(get_prog(rec.get()).get()).get());
+
+    // The scan over the tile counts carries the running prefix sum separately from the problem
+    // and its first tile, which must not advance once the work-group's problem was passed
+    auto const scan = code.find("for ");
+    REQUIRE(scan != std::string::npos);
+    auto const scan_end = code.find('\n', scan);
+    CHECK(code.substr(scan, scan_end - scan).find("-> (index,index,index)") != std::string::npos);
+    auto const found = code.find("if ", scan);
+    REQUIRE(found != std::string::npos);
+    auto const found_end = code.find('\n', found);
+    CHECK(code.substr(found, found_end - found).find("-> (index,index)") != std::string::npos);
+}
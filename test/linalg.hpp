@@ -133,6 +133,35 @@ TEST_CASE_TEMPLATE(RUNTIME_NAME " gemm packed alpha=-1 beta=2", T, TEST_PRECISIO
     test::test_blas_a3<runtime_class>(op, -1, 2);
 }
 
+TEST_CASE_TEMPLATE(RUNTIME_NAME " gemm split-K alpha=-1 beta=2", T, TEST_PRECISIONS) {
+    std::int64_t M = 20, N = 12, K = 2100;
+
+    auto op = test::gemm<T, T, T, T, T>(transpose::N, transpose::N, {{M, K}}, {{K, N}}, {{M, N}});
+    test::test_blas_a3<runtime_class>(op, -1, 2);
+}
+
+TEST_CASE_TEMPLATE(RUNTIME_NAME " gemm_batched alpha=1 beta=0", T, TEST_PRECISIONS) {
+    auto MM = std::vector<std::int64_t>{8, 53};
+    auto NN = std::vector<std::int64_t>{5, 33};
+    auto KK = std::vector<std::int64_t>{16};
+    auto HH = std::vector<std::int64_t>{1, 13};
+
+    std::int64_t M = {}, N = {}, K = {}, howmany = {};
+    DOCTEST_TENSOR4_TEST(MM, NN, KK, HH);
+
+    auto op = test::gemm_batched<T, T, T, T, T>(transpose::N, transpose::N, {{M, K, howmany}},
+                                                {{K, N, howmany}}, {{M, N, howmany}});
+    test::test_blas_a3<runtime_class>(op, 1, 0);
+}
+
+TEST_CASE_TEMPLATE(RUNTIME_NAME " gemm_batched broadcast alpha=-1 beta=2", T, TEST_PRECISIONS) {
+    std::int64_t M = 20, N = 12, K = 9, batch = 7;
+
+    auto op = test::gemm_batched<T, T, T, T, T>(transpose::T, transpose::N, {{K, M, batch}},
+                                                {{K, N}}, {{M, N, batch}});
+    test::test_blas_a3<runtime_class>(op, -1, 2);
+}
+
 TEST_CASE_TEMPLATE(RUNTIME_NAME " gemm non-packed alpha=1 beta=0 transA transB", T,
                    TEST_PRECISIONS) {
     std::int64_t M = 16, N = 32, K = 8;
@@ -208,6 +237,37 @@ TEST_CASE(RUNTIME_NAME " gemm packed mixed precision") {
     test::test_blas_a3<runtime_class>(op, 1, 0);
 }
 
+TEST_CASE_TEMPLATE(RUNTIME_NAME " gemm relu beta=1", T, TEST_PRECISIONS) {
+    auto MM = std::vector<std::int64_t>{20, 32};
+    auto NN = std::vector<std::int64_t>{5, 23};
+
+    std::int64_t M = {}, N = {}, K = 16;
+    DOCTEST_TENSOR2_TEST(MM, NN);
+
+    auto op = test::gemm<T, T, T, T, T>(transpose::N, transpose::N, {{M, K}}, {{K, N}}, {{M, N}},
+                                        test::gemm_epilogue::relu);
+    test::test_blas_a3<runtime_class>(op, 1, 1);
+    test::test_blas_a3<runtime_class>(op, -1, 1);
+}
+
+TEST_CASE(RUNTIME_NAME " gemm slm staging alpha=1 beta=2") {
+    auto MM = std::vector<std::int64_t>{32, 67};
+    auto NN = std::vector<std::int64_t>{32, 45};
+    auto KK = std::vector<std::int64_t>{64, 300};
+
+    std::int64_t M = {}, N = {}, K = {};
+    DOCTEST_TENSOR3_TEST(MM, NN, KK);
+
+    // i8 is lowered to the matrix extension, which is required for staging in SLM
+    using gemm_i8 = test::gemm<std::int8_t, std::int8_t, std::int8_t, std::int32_t, std::int32_t>;
+    auto op = gemm_i8(transpose::N, transpose::N, {{M, K}}, {{K, N}}, {{M, N}},
+                      test::gemm_epilogue::none, true);
+    test::test_blas_a3<runtime_class>(op, 1, 2);
+    auto opT = gemm_i8(transpose::T, transpose::T, {{K, M}}, {{N, K}}, {{M, N}},
+                       test::gemm_epilogue::none, true);
+    test::test_blas_a3<runtime_class>(opT, 1, 2);
+}
+
 TEST_CASE_TEMPLATE(RUNTIME_NAME " gemv packed alpha=1 beta=0", T, TEST_PRECISIONS) {
     auto NN = std::vector<std::uint32_t>{21};
     auto MM = std::vector<std::uint32_t>{16, 23};
@@ -25,6 +25,24 @@ auto gemm_mnk(transpose tA, transpose tB, tensor_layout const &A, tensor_layout
     return {M, N, K};
 }
 
+auto gemm_batched_mnkb(transpose tA, transpose tB, tensor_layout const &A, tensor_layout const &B,
+                      tensor_layout const &C) -> std::array<std::int64_t, 4u> {
+    if (A.dim() < 2 || A.dim() > 3 || B.dim() < 2 || B.dim() > 3 || C.dim() != 3) {
+        throw std::runtime_error("expected batch of matrices");
+    }
+    const int A_kmode = tA == transpose::T ? 1 : 0;
+    const int B_nmode = tB == transpose::T ? 0 : 1;
+    const auto M = C.shape(0);
+    const auto N = C.shape(1);
+    const auto K = A.shape(1 - A_kmode);
+    const auto batch = C.shape(2);
+    if (M != A.shape(A_kmode) || K != B.shape(1 - B_nmode) || N != B.shape(B_nmode) ||
+        (A.dim() == 3 && A.shape(2) != batch) || (B.dim() == 3 && B.shape(2) != batch)) {
+        throw std::runtime_error("incompatible batched matmul");
+    }
+    return {M, N, K, batch};
+}
+
 auto gemv_mk(transpose tA, tensor_layout const &A, tensor_layout const &B, tensor_layout const &C)
     -> std::array<std::int64_t, 2u> {
     if (A.dim() != 2 || B.dim() != 1 || C.dim() != 1) {
@@ -80,8 +98,8 @@ auto hadamard_mn(tensor_layout const &A, tensor_layout const &B, tensor_layout c
 auto make_blas_a3_prog(char const *name, tensor_layout const &layoutA, tensor_layout const &layoutB,
                        tensor_layout const &layoutC, tinytc_type_t alpha_ty, tinytc_type_t A_ty,
                        tinytc_type_t B_ty, tinytc_type_t beta_ty, tinytc_type_t C_ty,
-                       std::function<void(region_builder &, array_view<tinytc_value_t>)> make_op)
-    -> shared_handle<tinytc_prog_t> {
+                       std::function<void(region_builder &, array_view<tinytc_value_t>)> make_op,
+                       bool slm_staging) -> shared_handle<tinytc_prog_t> {
     auto ctx = get_compiler_context(alpha_ty);
     auto p = create_prog(ctx.get());
 
@@ -94,6 +112,11 @@ auto make_blas_a3_prog(char const *name, tensor_layout const &layoutA, tensor_la
 
     auto void_ty = get<void_type>(ctx.get());
     auto f = create_func(name, {alpha_ty, At, Bt, beta_ty, Ct}, void_ty);
+    if (slm_staging) {
+        auto const slm_attr = tinytc_named_attr_t{get<string_attr>(ctx.get(), "slm_staging"),
+                                                  get<boolean_attr>(ctx.get(), true)};
+        set_attr(f.get(), get_dictionary_attr_with_sorted(ctx.get(), slm_attr));
+    }
     auto fn_body = get_body(f.get());
     auto params = std::array<tinytc_value_t, 5u>{};
     get_parameters(fn_body, params);
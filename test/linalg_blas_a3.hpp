@@ -10,6 +10,7 @@
 #include "tinytc/types.h"
 #include "tinytc/types.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <functional>
@@ -19,6 +20,8 @@ namespace tinytc::test {
 
 auto gemm_mnk(transpose tA, transpose tB, tensor_layout const &A, tensor_layout const &B,
               tensor_layout const &C) -> std::array<std::int64_t, 3u>;
+auto gemm_batched_mnkb(transpose tA, transpose tB, tensor_layout const &A, tensor_layout const &B,
+                      tensor_layout const &C) -> std::array<std::int64_t, 4u>;
 auto gemv_mk(transpose tA, tensor_layout const &A, tensor_layout const &B, tensor_layout const &C)
     -> std::array<std::int64_t, 2u>;
 auto ger_mn(tensor_layout const &A, tensor_layout const &B, tensor_layout const &C)
@@ -31,20 +34,24 @@ auto hadamard_mn(tensor_layout const &A, tensor_layout const &B, tensor_layout c
 auto make_blas_a3_prog(char const *name, tensor_layout const &layoutA, tensor_layout const &layoutB,
                        tensor_layout const &layoutC, tinytc_type_t alpha_ty, tinytc_type_t A_ty,
                        tinytc_type_t B_ty, tinytc_type_t beta_ty, tinytc_type_t C_ty,
-                       std::function<void(region_builder &, array_view<tinytc_value_t>)> make_op)
-    -> shared_handle<tinytc_prog_t>;
+                       std::function<void(region_builder &, array_view<tinytc_value_t>)> make_op,
+                       bool slm_staging = false) -> shared_handle<tinytc_prog_t>;
 
 template <typename AlphaT, typename AT, typename BT, typename BetaT, typename CT>
 auto make_blas_a3_prog(char const *name, tensor_layout const &layoutA, tensor_layout const &layoutB,
                        tensor_layout const &layoutC,
-                       std::function<void(region_builder &, array_view<tinytc_value_t>)> make_op)
-    -> shared_handle<tinytc_prog_t> {
+                       std::function<void(region_builder &, array_view<tinytc_value_t>)> make_op,
+                       bool slm_staging = false) -> shared_handle<tinytc_prog_t> {
     auto ctx = create_compiler_context();
     return make_blas_a3_prog(name, layoutA, layoutB, layoutC, to_type<AlphaT>(ctx.get()),
                              to_type<AT>(ctx.get()), to_type<BT>(ctx.get()),
-                             to_type<BetaT>(ctx.get()), to_type<CT>(ctx.get()), std::move(make_op));
+                             to_type<BetaT>(ctx.get()), to_type<CT>(ctx.get()), std::move(make_op),
+                             slm_staging);
 }
 
+//! Element-wise operation on C following the gemm, which lower-linalg fuses into the gemm
+enum class gemm_epilogue { none, relu };
+
 template <typename AlphaT, typename AT, typename BT, typename BetaT, typename CT> class gemm {
   public:
     using alpha_type = AlphaT;
@@ -55,9 +62,10 @@ template <typename AlphaT, typename AT, typename BT, typename BetaT, typename CT
     static constexpr char const *kernel_name = "gemm";
 
     gemm(transpose tA, transpose tB, tensor_layout layoutA, tensor_layout layoutB,
-         tensor_layout layoutC)
+         tensor_layout layoutC, gemm_epilogue epilogue = gemm_epilogue::none,
+         bool slm_staging = false)
         : tA_(tA), tB_(tB), lA_{std::move(layoutA)}, lB_{std::move(layoutB)},
-          lC_{std::move(layoutC)} {}
+          lC_{std::move(layoutC)}, epilogue_(epilogue), slm_staging_(slm_staging) {}
 
     auto lA() const -> tensor_layout const & { return lA_; }
     auto lB() const -> tensor_layout const & { return lB_; }
@@ -68,7 +76,23 @@ template <typename AlphaT, typename AT, typename BT, typename BetaT, typename CT
             kernel_name, lA_, lB_, lC_, [&](region_builder &bb, array_view<tinytc_value_t> params) {
                 bb.create<gemm_inst>(false, tA_, tB_, params[0], params[1], params[2], params[3],
                                      params[4]);
-            });
+                if (epilogue_ == gemm_epilogue::relu) {
+                    auto ctx = get_compiler_context(get_type(params[0]));
+                    auto C_ty = to_type<CT>(ctx.get());
+                    auto index_ty = get<index_type>(ctx.get());
+                    auto zero = bb.constant_zero(C_ty);
+                    auto from = bb.constant_zero(index_ty);
+                    auto m = bb.create<size_inst>(0, params[4], index_ty);
+                    auto n = bb.create<size_inst>(1, params[4], index_ty);
+                    bb.foreach_loop({from, from}, {m, n},
+                                    [&](region_builder &bb, array_view<tinytc_value_t> idx) {
+                                        auto c = bb.create<load_inst>(params[4], idx, C_ty);
+                                        auto r = bb.create<max_inst>(c, zero, C_ty);
+                                        bb.create<store_inst>(r, params[4], idx);
+                                    });
+                }
+            },
+            slm_staging_);
     }
     void reference_impl(AlphaT alpha, AT const *A, BT const *B, BetaT beta, CT *C) {
         const auto [M, N, K] = gemm_mnk(tA_, tB_, lA_, lB_, lC_);
@@ -81,6 +105,65 @@ template <typename AlphaT, typename AT, typename BT, typename BetaT, typename CT
                 }
                 auto &c = C[lC_.linear_index({m, n})];
                 c = alpha * c_acc + beta * c;
+                if (epilogue_ == gemm_epilogue::relu) {
+                    c = std::max(CT{0}, c);
+                }
+            }
+        }
+    }
+
+  private:
+    transpose tA_, tB_;
+    tensor_layout lA_, lB_, lC_;
+    gemm_epilogue epilogue_;
+    bool slm_staging_;
+};
+
+//! gemm over the last mode of C; A or B are broadcast over the batch if they are matrices
+template <typename AlphaT, typename AT, typename BT, typename BetaT, typename CT>
+class gemm_batched {
+  public:
+    using alpha_type = AlphaT;
+    using A_type = AT;
+    using B_type = BT;
+    using beta_type = BetaT;
+    using C_type = CT;
+    static constexpr char const *kernel_name = "gemm_batched";
+
+    gemm_batched(transpose tA, transpose tB, tensor_layout layoutA, tensor_layout layoutB,
+                 tensor_layout layoutC)
+        : tA_(tA), tB_(tB), lA_{std::move(layoutA)}, lB_{std::move(layoutB)},
+          lC_{std::move(layoutC)} {}
+
+    auto lA() const -> tensor_layout const & { return lA_; }
+    auto lB() const -> tensor_layout const & { return lB_; }
+    auto lC() const -> tensor_layout const & { return lC_; }
+
+    auto make_prog() const -> shared_handle<tinytc_prog_t> {
+        return make_blas_a3_prog<AlphaT, AT, BT, BetaT, CT>(
+            kernel_name, lA_, lB_, lC_, [&](region_builder &bb, array_view<tinytc_value_t> params) {
+                bb.create<gemm_batched_inst>(false, tA_, tB_, params[0], params[1], params[2],
+                                             params[3], params[4]);
+            });
+    }
+    void reference_impl(AlphaT alpha, AT const *A, BT const *B, BetaT beta, CT *C) {
+        const auto [M, N, K, batch] = gemm_batched_mnkb(tA_, tB_, lA_, lB_, lC_);
+        auto const index = [](tensor_layout const &l, std::array<std::int64_t, 2u> idx,
+                              std::int64_t b) {
+            auto idx3 = std::array<std::int64_t, 3u>{idx[0], idx[1], b};
+            return l.linear_index(array_view(idx3.data(), l.dim()));
+        };
+        for (std::int64_t b = 0; b < batch; ++b) {
+            for (std::int64_t n = 0; n < N; ++n) {
+                for (std::int64_t m = 0; m < M; ++m) {
+                    CT c_acc = CT{0};
+                    for (std::int64_t k = 0; k < K; ++k) {
+                        c_acc = c_acc + A[index(lA_, make_index_2d(tA_, m, k), b)] *
+                                            B[index(lB_, make_index_2d(tB_, k, n), b)];
+                    }
+                    auto &c = C[lC_.linear_index({m, n, b})];
+                    c = alpha * c_acc + beta * c;
+                }
             }
         }
     }
@@ -0,0 +1,164 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef RECIPE_20251016_HPP
+#define RECIPE_20251016_HPP
+
+#include "linalg_runner.hpp"
+#include "tinytc/builder.hpp"
+#include "tinytc/core.hpp"
+#include "tinytc/tinytc.hpp"
+#include "tinytc/types.h"
+#include "tinytc/types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <doctest/doctest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using runtime_class = RUNTIME_CLASS;
+using namespace tinytc;
+
+struct gemm_size {
+    std::int64_t M, N, K;
+};
+
+//! Grouped GEMM with padded leading dimensions; howmany exceeds the number of tiles
+template <typename T>
+void test_grouped_gemm(transpose tA, transpose tB, std::vector<gemm_size> const &sizes, T alpha,
+                       T beta, std::int32_t M_block_size = 0, std::int32_t N_block_size = 0) {
+    auto gpu_rt = std::make_shared<runtime_class>();
+    if constexpr (test::requires_dp_v<T>) {
+        if (!gpu_rt->supports_fp64()) {
+            WARN_MESSAGE(false, "Double precision tests need double precision device support");
+            return;
+        }
+    }
+
+    auto info = gpu_rt->get_core_info();
+    if (M_block_size == 0 || N_block_size == 0) {
+        CHECK_STATUS(tinytc_recipe_grouped_gemm_suggest_block_size(info.get(), &M_block_size,
+                                                                   &N_block_size));
+    }
+
+    auto M = std::vector<std::int64_t>{}, N = std::vector<std::int64_t>{},
+         K = std::vector<std::int64_t>{};
+    auto ldA = std::vector<std::int64_t>{}, ldB = std::vector<std::int64_t>{},
+         ldC = std::vector<std::int64_t>{};
+    auto A_ref = std::vector<std::vector<T>>{}, B_ref = std::vector<std::vector<T>>{},
+         C_ref = std::vector<std::vector<T>>{};
+    std::int64_t num_tiles = 0;
+    for (auto const &s : sizes) {
+        const auto A_rows = tA == transpose::T ? s.K : s.M;
+        const auto A_cols = tA == transpose::T ? s.M : s.K;
+        const auto B_rows = tB == transpose::T ? s.N : s.K;
+        const auto B_cols = tB == transpose::T ? s.K : s.N;
+        M.emplace_back(s.M);
+        N.emplace_back(s.N);
+        K.emplace_back(s.K);
+        ldA.emplace_back(A_rows + 1);
+        ldB.emplace_back(B_rows + 1);
+        ldC.emplace_back(s.M + 1);
+        A_ref.emplace_back(test::make_test_data<T>(ldA.back() * A_cols));
+        B_ref.emplace_back(test::make_test_data<T>(ldB.back() * B_cols));
+        C_ref.emplace_back(test::make_test_data<T>(ldC.back() * s.N));
+        const auto M_tiles = (s.M + M_block_size - 1) / M_block_size;
+        const auto N_tiles = (s.N + N_block_size - 1) / N_block_size;
+        num_tiles += M_tiles * N_tiles;
+    }
+
+    auto const to_device = [&](void const *data, std::size_t bytes) {
+        auto buf = gpu_rt->create_buffer(bytes);
+        gpu_rt->memcpy_h2d(buf, data, bytes);
+        return buf;
+    };
+    auto buffers = std::vector<runtime_class::mem_t>{};
+    auto const array_to_device = [&](std::vector<std::vector<T>> const &matrices) {
+        auto ptrs = std::vector<runtime_class::mem_t>{};
+        for (auto const &m : matrices) {
+            ptrs.emplace_back(to_device(m.data(), m.size() * sizeof(T)));
+            buffers.emplace_back(ptrs.back());
+        }
+        buffers.emplace_back(to_device(ptrs.data(), ptrs.size() * sizeof(runtime_class::mem_t)));
+        return ptrs;
+    };
+    auto const sizes_to_device = [&](std::vector<std::int64_t> const &s) {
+        buffers.emplace_back(to_device(s.data(), s.size() * sizeof(std::int64_t)));
+        return buffers.back();
+    };
+    array_to_device(A_ref);
+    auto A = buffers.back();
+    array_to_device(B_ref);
+    auto B = buffers.back();
+    auto C_ptrs = array_to_device(C_ref);
+    auto C = buffers.back();
+    auto M_d = sizes_to_device(M), N_d = sizes_to_device(N), K_d = sizes_to_device(K);
+    auto ldA_d = sizes_to_device(ldA), ldB_d = sizes_to_device(ldB), ldC_d = sizes_to_device(ldC);
+
+    auto ctx = create_compiler_context();
+    auto rec = create_grouped_gemm(info.get(), to_type<T>(ctx.get()), tA, tB, M_block_size,
+                                   N_block_size);
+    auto handler = gpu_rt->get_recipe_handler(rec.get());
+    set_grouped_gemm_args(handler.get(), static_cast<std::int64_t>(sizes.size()), num_tiles + 2,
+                          alpha, A, B, beta, C, M_d, N_d, K_d, ldA_d, ldB_d, ldC_d);
+    gpu_rt->submit(handler.get());
+    gpu_rt->synchronize();
+
+    for (std::size_t p = 0; p < sizes.size(); ++p) {
+        auto const a = [&](std::int64_t m, std::int64_t k) {
+            return tA == transpose::T ? A_ref[p][k + m * ldA[p]] : A_ref[p][m + k * ldA[p]];
+        };
+        auto const b = [&](std::int64_t k, std::int64_t n) {
+            return tB == transpose::T ? B_ref[p][n + k * ldB[p]] : B_ref[p][k + n * ldB[p]];
+        };
+        for (std::int64_t n = 0; n < N[p]; ++n) {
+            for (std::int64_t m = 0; m < M[p]; ++m) {
+                T c_acc = T{0};
+                for (std::int64_t k = 0; k < K[p]; ++k) {
+                    c_acc = c_acc + a(m, k) * b(k, n);
+                }
+                auto &c = C_ref[p][m + n * ldC[p]];
+                c = alpha * c_acc + beta * c;
+            }
+        }
+
+        auto C_host = std::vector<T>(C_ref[p].size());
+        gpu_rt->memcpy_d2h(C_host.data(), C_ptrs[p], C_host.size() * sizeof(T));
+        INFO("problem ", p);
+        test::compare_data(C_host, C_ref[p]);
+    }
+
+    for (auto &buf : buffers) {
+        gpu_rt->free_buffer(buf);
+    }
+}
+
+TEST_CASE_TEMPLATE(RUNTIME_NAME " grouped gemm", T, TEST_PRECISIONS) {
+    auto const sizes =
+        std::vector<gemm_size>{{63, 17, 33}, {8, 64, 1}, {100, 5, 64}, {1, 1, 70}, {128, 96, 16}};
+
+    transpose tA = {}, tB = {};
+    for (auto ta : {transpose::N, transpose::T}) {
+        for (auto tb : {transpose::N, transpose::T}) {
+            DOCTEST_SUBCASE((std::string(to_string(ta)) + to_string(tb)).c_str()) {
+                tA = ta;
+                tB = tb;
+            }
+        }
+    }
+
+    test_grouped_gemm<T>(tA, tB, sizes, 1, 0);
+    test_grouped_gemm<T>(tA, tB, sizes, -1, 2);
+}
+
+TEST_CASE_TEMPLATE(RUNTIME_NAME " grouped gemm uneven tile counts", T, TEST_PRECISIONS) {
+    // Tile counts are 4, 1, 0, 4 for 32x32 tiles; work-groups 1 to 3 must not be mapped to the
+    // second problem, whose tile count alone is smaller than their group id
+    auto const sizes =
+        std::vector<gemm_size>{{128, 32, 16}, {20, 7, 5}, {0, 16, 8}, {45, 40, 9}};
+    test_grouped_gemm<T>(transpose::N, transpose::N, sizes, 1, 1, 32, 32);
+}
+
+#endif // RECIPE_20251016_HPP
@@ -13,7 +13,8 @@ namespace tinytc::test {
 template <typename T>
 concept test_runtime_gpu =
     requires(T rt, std::size_t bytes, typename T::mem_t buf, typename T::const_mem_t const_buf,
-             void *dst, void const *src, int value, tinytc_recipe_t rec, tinytc_prog_t p,
+             void *dst, void const *src, int value, tinytc_recipe_t rec,
+             tinytc_recipe_handler_t handler, tinytc_prog_t p,
              typename T::kernel_bundle_t const &bundle, char const *name,
              typename T::kernel_t &kernel, std::uint32_t arg_index, std::size_t arg_size,
              const void *arg_value, ::tinytc::mem_type type, std::int64_t howmany,
@@ -42,6 +43,7 @@ concept test_runtime_gpu =
         rt.set_arg(kernel, arg_index, arg_size, arg_value);
         rt.set_mem_arg(kernel, arg_index, arg_value, type);
         rt.submit(kernel, howmany);
+        rt.submit(handler);
         { rt.supports_fp64() } -> std::same_as<bool>;
         rt.synchronize();
     };
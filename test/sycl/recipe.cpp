@@ -0,0 +1,9 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "test_runtime.hpp"
+
+#define RUNTIME_CLASS sycl_test_runtime
+#define RUNTIME_NAME "sycl"
+#include "../recipe.hpp"
+#undef RUNTIME_CLASS
@@ -67,6 +67,7 @@ void sycl_test_runtime::submit(kernel_t &kernel, std::int64_t howmany) {
         kernel, sycl::range<3u>{1u, 1u, static_cast<std::size_t>(howmany)});
     q_.submit([&](sycl::handler &h) { h.parallel_for(exe_range, kernel); });
 }
+void sycl_test_runtime::submit(tinytc_recipe_handler_t handler) { ::tinytc::submit(handler, q_); }
 void sycl_test_runtime::synchronize() { q_.wait(); }
 
 bool sycl_test_runtime::supports_fp64() { return q_.get_device().has(sycl::aspect::fp64); }
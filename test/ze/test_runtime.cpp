@@ -91,6 +91,9 @@ void level_zero_test_runtime::submit(kernel_t &kernel, std::int64_t howmany) {
     ZE_CHECK_STATUS(
         zeCommandListAppendLaunchKernel(list_, kernel.get(), &group_count, nullptr, 0, nullptr));
 }
+void level_zero_test_runtime::submit(tinytc_recipe_handler_t handler) {
+    ::tinytc::submit(handler, list_);
+}
 void level_zero_test_runtime::synchronize() {
     ZE_CHECK_STATUS(zeCommandListHostSynchronize(list_, UINT64_MAX));
 }
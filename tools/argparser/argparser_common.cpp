@@ -7,7 +7,9 @@
 #include "util/fnv1a.hpp"
 
 #include <cstring>
+#include <initializer_list>
 #include <ostream>
+#include <string_view>
 
 namespace tinytc::cmd {
 
@@ -25,6 +27,9 @@ void add_optflag_states(arg_parser &parser, optflag_states &flags) {
         case "unsafe-fp-math"_fnv1a:
             flag = optflag::unsafe_fp_math;
             break;
+        case "assume-small-buffers"_fnv1a:
+            flag = optflag::assume_small_buffers;
+            break;
         default:
             return parser_status::invalid_argument;
         };
@@ -49,6 +54,21 @@ void list_optimization_flags(std::ostream &os) {
         os << ' ';
     }
     os << "unsafe-fp-math" << std::endl;
+    for (int i = 0; i < arg_parser::optindent; ++i) {
+        os << ' ';
+    }
+    os << "assume-small-buffers" << std::endl;
+}
+
+auto core_feature_flag(std::string_view name) -> tinytc_core_feature_flags_t {
+    switch (fnv1a(name)) {
+    case "large-register-file"_fnv1a:
+        return tinytc_core_feature_flag_large_register_file;
+    case "small-register-file"_fnv1a:
+        return tinytc_core_feature_flag_small_register_file;
+    default:
+        return 0;
+    };
 }
 
 void add_core_feature_flags(arg_parser &parser, tinytc_core_feature_flags_t &flags) {
@@ -60,14 +80,10 @@ void add_core_feature_flags(arg_parser &parser, tinytc_core_feature_flags_t &fla
             clear = true;
             str = str + disable_prefix_len;
         }
-        tinytc_core_feature_flags_t flag = 0;
-        switch (fnv1a(str, std::strlen(str))) {
-        case "large-register-file"_fnv1a:
-            flag = tinytc_core_feature_flag_large_register_file;
-            break;
-        default:
+        auto const flag = core_feature_flag(str);
+        if (flag == 0) {
             return parser_status::invalid_argument;
-        };
+        }
         if (clear) {
             val &= ~flag;
         } else {
@@ -83,10 +99,12 @@ void add_core_feature_flags(arg_parser &parser, tinytc_core_feature_flags_t &fla
 
 void list_core_feature_flags(std::ostream &os) {
     os << "Core feature flags:" << std::endl;
-    for (int i = 0; i < arg_parser::optindent; ++i) {
-        os << ' ';
+    for (char const *name : {"large-register-file", "small-register-file"}) {
+        for (int i = 0; i < arg_parser::optindent; ++i) {
+            os << ' ';
+        }
+        os << name << std::endl;
     }
-    os << "large-register-file" << std::endl;
 }
 
 } // namespace tinytc::cmd
@@ -9,6 +9,7 @@
 
 #include <cstdint>
 #include <iosfwd>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -21,6 +22,8 @@ void add_optflag_states(arg_parser &parser, optflag_states &flags);
 void set_optflags(tinytc_compiler_context_t ctx, optflag_states const &flags);
 void list_optimization_flags(std::ostream &os);
 
+//! Returns the core feature flag with the given name or 0 if the name is unknown
+auto core_feature_flag(std::string_view name) -> tinytc_core_feature_flags_t;
 void add_core_feature_flags(arg_parser &parser, tinytc_core_feature_flags_t &flags);
 void list_core_feature_flags(std::ostream &os);
 
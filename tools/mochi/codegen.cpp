@@ -723,6 +723,70 @@ void generate_inst_cpp(std::ostream &os, objects const &obj) {
        "}\nreturn \"unknown\";\n"
        "}\n\n");
 
+    sw("auto properties_size(IK ik) -> std::uint32_t {\n"
+       "switch (ik) {\n");
+    for (auto &i : obj.insts()) {
+        walk_down<walk_order::pre_order, inst, true>(i.get(), [&sw](inst *in) {
+            sw("case IK::%s: return sizeof(%s::properties);\n", in->kind_name(),
+               in->class_name());
+        });
+    }
+    sw("default: break;\n"
+       "}\nthrow status::invalid_arguments;\n"
+       "}\n\n");
+
+    sw("auto has_valid_layout(tinytc_inst &in) -> bool {\n"
+       "switch (in.type_id()) {\n");
+    for (auto &i : obj.insts()) {
+        walk_down<walk_order::pre_order, inst, true>(i.get(), [&sw](inst *in) {
+            sw("case IK::%s: {\n", in->kind_name());
+            sw("[[maybe_unused]] auto &props = %s{&in}.props();\n", in->class_name());
+            auto quantities = std::vector<quantifier>{};
+            std::int32_t num_static_results = 0, num_child_regions = 0;
+            bool variadic_results = false;
+            sw("std::int32_t const begin[] = {");
+            walk_up<walk_order::post_order, inst>(in, [&](inst *in) {
+                for (auto &o : in->ops()) {
+                    if (o.has_offset_property) {
+                        sw("props.%s, ", o.offset_name());
+                    } else {
+                        sw("%d, ", static_cast<std::int32_t>(quantities.size()));
+                    }
+                    quantities.emplace_back(o.quantity);
+                }
+                num_child_regions += in->regs().size();
+                for (auto &r : in->rets()) {
+                    if (r.quantity == quantifier::many) {
+                        variadic_results = true;
+                    } else {
+                        ++num_static_results;
+                    }
+                }
+            });
+            sw("in.num_operands()};\n");
+            sw("return begin[0] == 0 && in.num_child_regions() == %d && in.num_results() %s %d",
+               num_child_regions, variadic_results ? ">=" : "==", num_static_results);
+            for (std::int32_t k = 0; k < static_cast<std::int32_t>(quantities.size()); ++k) {
+                switch (quantities[k]) {
+                case quantifier::single:
+                    sw(" && begin[%d] == begin[%d] + 1", k + 1, k);
+                    break;
+                case quantifier::optional:
+                    sw(" && begin[%d] <= begin[%d] && begin[%d] <= begin[%d] + 1", k, k + 1, k + 1,
+                       k);
+                    break;
+                case quantifier::many:
+                    sw(" && begin[%d] <= begin[%d]", k, k + 1);
+                    break;
+                }
+            }
+            sw(";\n}\n");
+        });
+    }
+    sw("default: break;\n"
+       "}\nreturn false;\n"
+       "}\n\n");
+
     for (auto &i : obj.insts()) {
         walk_down<walk_order::pre_order, inst, true>(
             i.get(), [&sw](inst *in) { generate_inst_create(sw, in); });
@@ -744,7 +808,11 @@ void generate_inst_hpp(std::ostream &os, objects const &obj) {
         );
     }
     sw("};\n\n");
-    sw("auto to_string(IK ik) -> char const*;\n\n");
+    sw("auto to_string(IK ik) -> char const*;\n");
+    sw("//! Size of the properties struct; throws status::invalid_arguments for abstract kinds\n");
+    sw("auto properties_size(IK ik) -> std::uint32_t;\n");
+    sw("//! Check that the number of operands, results, and child regions matches the kind\n");
+    sw("auto has_valid_layout(tinytc_inst &in) -> bool;\n\n");
 
     for (auto &i : obj.insts()) {
         walk_down<walk_order::pre_order, inst>(i.get(),
@@ -919,6 +987,41 @@ void generate_visit_hpp(std::ostream &os, objects const &obj) {
             });
         }
         sw("default: break;\n}\n}\n");
+
+        sw("template <typename Visitor> void visit_props(Visitor && visitor, tinytc_inst &in) {\n");
+        sw("switch(in.type_id()) {\n");
+        for (auto &i : obj.insts()) {
+            walk_down<walk_order::pre_order, inst, true>(i.get(), [&sw](inst *in) {
+                sw("case IK::%s: {\n", in->kind_name());
+                sw("[[maybe_unused]] auto &props = %s{&in}.props();\n", in->class_name());
+                walk_up<walk_order::post_order, inst>(in, [&sw](inst *in) {
+                    for (auto &p : in->props()) {
+                        sw("visitor(props.%s);\n", p.name);
+                    }
+                });
+                sw("return;\n}\n");
+            });
+        }
+        sw("default: break;\n}\nthrow status::internal_compiler_error;\n}\n");
+
+        sw("template <typename Visitor> void visit_operand_offsets(Visitor && visitor, tinytc_inst "
+           "&in) {\n");
+        sw("switch(in.type_id()) {\n");
+        for (auto &i : obj.insts()) {
+            walk_down<walk_order::pre_order, inst, true>(i.get(), [&sw](inst *in) {
+                sw("case IK::%s: {\n", in->kind_name());
+                sw("[[maybe_unused]] auto &props = %s{&in}.props();\n", in->class_name());
+                walk_up<walk_order::post_order, inst>(in, [&sw](inst *in) {
+                    for (auto &o : in->ops()) {
+                        if (o.has_offset_property) {
+                            sw("visitor(props.%s);\n", o.offset_name());
+                        }
+                    }
+                });
+                sw("return;\n}\n");
+            });
+        }
+        sw("default: break;\n}\nthrow status::internal_compiler_error;\n}\n");
     }
 
     if (!obj.types().empty()) {
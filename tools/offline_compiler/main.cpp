@@ -8,18 +8,63 @@
 #include "tinytc/types.hpp"
 
 #include <cstdint>
+#include <cstring>
 #include <exception>
+#include <fstream>
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
 
 using namespace tinytc;
 
+namespace {
+
+auto is_bytecode_file(char const *filename) -> bool {
+    char magic[4] = {};
+    auto stream = std::ifstream(filename, std::ios::binary);
+    return stream.read(magic, sizeof(magic)) && std::memcmp(magic, "TTCB", sizeof(magic)) == 0;
+}
+
+//! Parse device name optionally followed by "+" separated core feature flags
+auto parse_target(char const *str, shared_handle<tinytc_core_info_t> &val) -> cmd::parser_status {
+    auto const spec = std::string_view(str);
+    auto plus = spec.find('+');
+    val = create_core_info_intel_from_name(std::string(spec.substr(0, plus)).c_str());
+    if (!val) {
+        return cmd::parser_status::invalid_argument;
+    }
+    tinytc_core_feature_flags_t features = 0;
+    while (plus != std::string_view::npos) {
+        auto const next = spec.find('+', plus + 1);
+        auto const name = next == std::string_view::npos ? spec.substr(plus + 1)
+                                                         : spec.substr(plus + 1, next - plus - 1);
+        auto const flag = cmd::core_feature_flag(name);
+        if (flag == 0) {
+            return cmd::parser_status::invalid_argument;
+        }
+        features |= flag;
+        plus = next;
+    }
+    set_core_features(val.get(), features);
+    return cmd::parser_status::success;
+}
+
+} // namespace
+
 int main(int argc, char **argv) {
     char const *filename = nullptr;
     auto info = shared_handle<tinytc_core_info_t>{};
+    auto targets = std::vector<shared_handle<tinytc_core_info_t>>{};
     tinytc_core_feature_flags_t core_features = 0;
     std::int32_t opt_level = 2;
+    std::int32_t num_threads = 1;
     auto flags = cmd::optflag_states{};
     bool emit_asm = false;
+    bool emit_bytecode = false;
+    bool time_passes = false;
+    bool pass_stats = false;
+    char const *cost_report = nullptr;
     bool help = false;
 
     auto parser = cmd::arg_parser{};
@@ -39,11 +84,32 @@ int main(int argc, char **argv) {
                     }
                     return cmd::parser_status::success;
                 });
+        parser
+            .set_short_opt('j', &num_threads,
+                           "Number of compiler threads (0 = number of hardware threads), "
+                           "default is 1")
+            .validator([](std::int32_t num) { return 0 <= num; });
+        parser
+            .set_long_opt("target", &targets,
+                          "Compile for device and write fat binary; device name optionally "
+                          "followed by \"+\" separated core feature flags, e.g. "
+                          "\"pvc+large-register-file\"; may be repeated")
+            .converter(parse_target);
         parser.set_short_opt('S', &emit_asm, "Compile only; do not assemble");
+        parser.set_long_opt("emit-bytecode", &emit_bytecode,
+                            "Do not compile; write the program as bytecode");
         parser.set_short_opt('h', &help, "Show help");
         parser.set_long_opt("help", &help, "Show help");
+        parser.set_long_opt("time-passes", &time_passes,
+                            "Print time spent in each pass as JSON to stderr");
+        parser.set_long_opt("pass-stats", &pass_stats,
+                            "Print statistics of every pass run on every function as JSON to "
+                            "stderr");
+        parser.set_long_opt("cost-report", &cost_report,
+                            "Write static cost estimate of every function as JSON to file");
         parser.add_positional_arg("file-name", &filename,
-                                  "Path to source code; leave empty to read from stdin");
+                                  "Path to source code or bytecode; leave empty to read source "
+                                  "code from stdin");
         cmd::add_optflag_states(parser, flags);
         cmd::add_core_feature_flags(parser, core_features);
 
@@ -73,16 +139,47 @@ int main(int argc, char **argv) {
             std::cerr << what << std::endl;
         });
         set_optimization_level(ctx.get(), opt_level);
+        set_num_threads(ctx.get(), num_threads);
         cmd::set_optflags(ctx.get(), flags);
+        set_pass_statistics(ctx.get(), time_passes || pass_stats);
         set_core_features(info.get(), core_features);
         auto p = [&] {
             if (!filename) {
                 return parse_stdin(ctx.get());
             }
+            if (is_bytecode_file(filename)) {
+                return deserialize_file(filename, ctx.get());
+            }
             return parse_file(filename, ctx.get());
         }();
 
-        if (emit_asm) {
+        if (cost_report) {
+            auto report = get_cost_report(p.get(), info.get());
+            auto stream = std::ofstream(cost_report);
+            if (!(stream << report.get())) {
+                std::cerr << "Could not write cost report to " << cost_report << std::endl;
+                return 1;
+            }
+        }
+
+        if (!targets.empty()) {
+            if (emit_asm || emit_bytecode) {
+                std::cerr << "--target cannot be combined with -S or --emit-bytecode" << std::endl;
+                return 1;
+            }
+            auto target_infos = std::vector<const_tinytc_core_info_t>{};
+            for (auto &target : targets) {
+                set_core_features(target.get(),
+                                  get_core_features(target.get()) | core_features);
+                target_infos.emplace_back(target.get());
+            }
+            auto fat = compile_to_fat_binary(p.get(), target_infos);
+            auto const raw_data = get_raw(fat.get());
+            std::cout.write(reinterpret_cast<char const *>(raw_data.data()), raw_data.size());
+        } else if (emit_bytecode) {
+            auto const bytecode = serialize(p.get());
+            std::cout.write(reinterpret_cast<char const *>(bytecode.data()), bytecode.size());
+        } else if (emit_asm) {
             auto mod = compile_to_spirv(p.get(), info.get());
             auto spvasm = print_to_string(mod.get());
             std::cout << spvasm.get();
@@ -91,6 +188,9 @@ int main(int argc, char **argv) {
             auto raw_data = get_raw(bin.get());
             std::cout.write(reinterpret_cast<char const *>(raw_data.data), raw_data.data_size);
         }
+        if (time_passes || pass_stats) {
+            std::cerr << get_pass_statistics(ctx.get(), pass_stats).get();
+        }
     } catch (status const &st) {
         std::cerr << "Error (" << static_cast<int>(st) << "): " << to_string(st) << std::endl;
         return 1;
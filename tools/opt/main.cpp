@@ -8,9 +8,9 @@
 #include "tinytc/types.hpp"
 
 #include <cstdint>
-#include <cstring>
 #include <exception>
 #include <iostream>
+#include <string>
 #include <vector>
 
 using namespace tinytc;
@@ -22,6 +22,8 @@ int main(int argc, char **argv) {
     tinytc_core_feature_flags_t core_features = 0;
     std::int32_t opt_level = 2;
     auto flags = cmd::optflag_states{};
+    bool time_passes = false;
+    bool pass_stats = false;
     bool help = false;
 
     auto parser = cmd::arg_parser{};
@@ -41,9 +43,15 @@ int main(int argc, char **argv) {
                     }
                     return cmd::parser_status::success;
                 });
-        parser.set_short_opt('p', &pass_names, "Run pass");
+        parser.set_short_opt('p', &pass_names,
+                             "Run pass or comma-separated pipeline of passes; may be repeated");
         parser.set_short_opt('h', &help, "Show help");
         parser.set_long_opt("help", &help, "Show help");
+        parser.set_long_opt("time-passes", &time_passes,
+                            "Print time spent in each pass as JSON to stderr");
+        parser.set_long_opt("pass-stats", &pass_stats,
+                            "Print statistics of every pass run on every function as JSON to "
+                            "stderr");
         parser.add_positional_arg("file-name", &filename,
                                   "Path to source code; leave empty to read from stdin");
         cmd::add_optflag_states(parser, flags);
@@ -86,8 +94,16 @@ int main(int argc, char **argv) {
         return 0;
     }
 
-    if (pass_names.empty() || std::strncmp(pass_names.back(), "dump", 4) != 0) {
-        pass_names.emplace_back("dump-ir");
+    auto pipeline = std::string{};
+    for (auto const &pass_name : pass_names) {
+        if (!pipeline.empty()) {
+            pipeline += ',';
+        }
+        pipeline += pass_name;
+    }
+    auto const last_pass = pipeline.substr(pipeline.find_last_of(',') + 1);
+    if (!last_pass.starts_with("dump")) {
+        pipeline += pipeline.empty() ? "dump-ir" : ",dump-ir";
     }
 
     try {
@@ -97,6 +113,7 @@ int main(int argc, char **argv) {
         });
         set_optimization_level(ctx.get(), opt_level);
         cmd::set_optflags(ctx.get(), flags);
+        set_pass_statistics(ctx.get(), time_passes || pass_stats);
         set_core_features(info.get(), core_features);
         auto p = [&] {
             if (!filename) {
@@ -105,8 +122,9 @@ int main(int argc, char **argv) {
             return parse_file(filename, ctx.get());
         }();
 
-        for (auto const &pass_name : pass_names) {
-            run_function_pass(pass_name, p.get(), info.get());
+        run_function_pass_pipeline(pipeline.c_str(), p.get(), info.get());
+        if (time_passes || pass_stats) {
+            std::cerr << get_pass_statistics(ctx.get(), pass_stats).get();
         }
     } catch (status const &st) {
         std::cerr << "Error (" << static_cast<int>(st) << "): " << to_string(st) << std::endl;